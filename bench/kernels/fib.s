@@ -0,0 +1,37 @@
+# Recursive fibonacci. Exercises procedure calls, returns and stack accesses.
+
+.text
+main:
+        li   a0, 18
+        jal  ra, fib
+        li   t0, 2584           # fib(18)
+        bne  a0, t0, fail
+
+pass:
+        li   a0, 42
+        li   a7, 93
+        ecall
+fail:
+        li   a0, 0
+        li   a7, 93
+        ecall
+
+# a0: n. Returns fib(n) in a0.
+fib:
+        li   t0, 2
+        blt  a0, t0, fib_done
+        addi sp, sp, -16
+        sw   ra, 0(sp)
+        sw   a0, 4(sp)
+        addi a0, a0, -1
+        jal  ra, fib
+        sw   a0, 8(sp)
+        lw   a0, 4(sp)
+        addi a0, a0, -2
+        jal  ra, fib
+        lw   t1, 8(sp)
+        add  a0, a0, t1
+        lw   ra, 0(sp)
+        addi sp, sp, 16
+fib_done:
+        ret
@@ -0,0 +1,76 @@
+# 16x16 integer matrix multiplication, C = A * B, repeated 4 times.
+# Exercises multiplication, nested loops and strided loads.
+
+.data
+A:      .zero 1024
+B:      .zero 1024
+C:      .zero 1024
+
+.text
+main:
+        # A[i][j] = i + j, B[i][j] = i - j
+        la   s0, A
+        la   s1, B
+        li   s3, 16
+        li   t0, 0
+init_i:
+        li   t1, 0
+init_j:
+        add  t2, t0, t1
+        sw   t2, 0(s0)
+        sub  t2, t0, t1
+        sw   t2, 0(s1)
+        addi s0, s0, 4
+        addi s1, s1, 4
+        addi t1, t1, 1
+        blt  t1, s3, init_j
+        addi t0, t0, 1
+        blt  t0, s3, init_i
+
+        li   s4, 4              # repetitions
+rep:
+        la   s2, C
+        li   t0, 0              # i
+mul_i:
+        li   t1, 0              # j
+mul_j:
+        li   t3, 0              # k
+        li   t4, 0              # sum
+        slli t5, t0, 6
+        la   a0, A
+        add  a0, a0, t5         # &A[i][0]
+        slli t5, t1, 2
+        la   a1, B
+        add  a1, a1, t5         # &B[0][j]
+mul_k:
+        lw   a2, 0(a0)
+        lw   a3, 0(a1)
+        mul  a2, a2, a3
+        add  t4, t4, a2
+        addi a0, a0, 4
+        addi a1, a1, 64
+        addi t3, t3, 1
+        blt  t3, s3, mul_k
+        sw   t4, 0(s2)
+        addi s2, s2, 4
+        addi t1, t1, 1
+        blt  t1, s3, mul_j
+        addi t0, t0, 1
+        blt  t0, s3, mul_i
+        addi s4, s4, -1
+        bnez s4, rep
+
+        # C[1][1] = sum_k (1 + k) * (k - 1) = 1224
+        la   t0, C
+        lw   t1, 68(t0)
+        li   t2, 1224
+        bne  t1, t2, fail
+
+pass:
+        li   a0, 42
+        li   a7, 93
+        ecall
+fail:
+        li   a0, 0
+        li   a7, 93
+        ecall
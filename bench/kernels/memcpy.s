@@ -0,0 +1,49 @@
+# Copies a 4 KiB buffer word by word, 32 times.
+# Exercises load/store throughput and the data cache.
+
+.data
+src:    .zero 4096
+dst:    .zero 4096
+
+.text
+main:
+        # Initialize the source buffer
+        la   t0, src
+        li   t1, 1024
+        li   t2, 0
+init:
+        sw   t2, 0(t0)
+        addi t0, t0, 4
+        addi t2, t2, 1
+        blt  t2, t1, init
+
+        li   s0, 32             # repetitions
+rep:
+        la   t0, src
+        la   t1, dst
+        li   t2, 1024
+copy:
+        lw   t3, 0(t0)
+        sw   t3, 0(t1)
+        addi t0, t0, 4
+        addi t1, t1, 4
+        addi t2, t2, -1
+        bnez t2, copy
+        addi s0, s0, -1
+        bnez s0, rep
+
+        la   t0, dst
+        li   t1, 4092
+        add  t0, t0, t1
+        lw   t1, 0(t0)
+        li   t2, 1023
+        bne  t1, t2, fail
+
+pass:
+        li   a0, 42
+        li   a7, 93
+        ecall
+fail:
+        li   a0, 0
+        li   a7, 93
+        ecall
@@ -0,0 +1,40 @@
+# Sieve of Eratosthenes over [0, 8192).
+# Exercises byte accesses and data dependent branches.
+
+.data
+sieve:  .zero 8192
+
+.text
+main:
+        la   s0, sieve
+        li   s1, 8192
+        li   s2, 0              # prime count
+        li   t0, 2              # i
+outer:
+        add  t1, s0, t0
+        lbu  t2, 0(t1)
+        bnez t2, next           # composite
+        addi s2, s2, 1
+        add  t3, t0, t0         # j = 2i
+inner:
+        bge  t3, s1, next
+        add  t4, s0, t3
+        li   t5, 1
+        sb   t5, 0(t4)
+        add  t3, t3, t0
+        j    inner
+next:
+        addi t0, t0, 1
+        blt  t0, s1, outer
+
+        li   t0, 1028           # number of primes below 8192
+        bne  s2, t0, fail
+
+pass:
+        li   a0, 42
+        li   a7, 93
+        ecall
+fail:
+        li   a0, 0
+        li   a7, 93
+        ecall
@@ -0,0 +1,34 @@
+# Prints a counter and a short line through the PrintInt and Write syscalls,
+# 4096 times. Exercises the ecall trap path and the buffered console output.
+
+.data
+line:   .string " ripes\n"
+
+.text
+main:
+        li   s0, 0
+        li   s1, 4096           # iterations
+loop:
+        mv   a0, s0
+        li   a7, 1              # PrintInt
+        ecall
+
+        li   a0, 1              # stdout
+        la   a1, line
+        li   a2, 7
+        li   a7, 64             # Write
+        ecall
+        li   t0, 7
+        bne  a0, t0, fail       # Write returns the number of bytes written
+
+        addi s0, s0, 1
+        blt  s0, s1, loop
+
+pass:
+        li   a0, 42
+        li   a7, 93
+        ecall
+fail:
+        li   a0, 0
+        li   a7, 93
+        ecall
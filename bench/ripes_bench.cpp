@@ -0,0 +1,377 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <optional>
+
+#include "cachesim/cachesim.h"
+#include "cachesim/l1cacheshim.h"
+#include "processorhandler.h"
+#include "processorregistry.h"
+#include "ripessettings.h"
+#include "rvisainfo_common.h"
+#include "syscall/systemio.h"
+
+#if !defined(RISCV32_TEST_DIR) || !defined(RISCV64_TEST_DIR) ||                \
+    !defined(BENCH_KERNEL_DIR)
+static_assert(false, "Benchmark workload directories must be defined");
+#endif
+
+/** Ripes simulator throughput benchmark
+ *
+ * Runs a fixed set of workloads on every processor model and measures host
+ * wall time, simulated cycles/s and retired instructions/s. Workloads follow
+ * the conventions of the bundled riscv-tests: upon completion, the program
+ * performs an Exit2 ecall with a0 = 42 on success.
+ *
+ * Results are emitted as JSON, and may be compared against a stored baseline
+ * result file (--baseline). The benchmark fails if any processor/workload pair
+ * regressed by more than --threshold percent in simulated cycles/s.
+ */
+
+using namespace Ripes;
+
+// Ecall success code of the riscv-tests
+static constexpr unsigned s_success = 42;
+static constexpr unsigned s_ecallreg = 10;   // a0
+static constexpr unsigned s_ecallopreg = 17; // a7
+
+// Upper bound on the number of cycles a single program may execute.
+static constexpr long long s_maxCycles = 50000000;
+
+// riscv-tests which are not supported by the assembler, or which depend on the
+// host file system.
+const auto s_excludedTests = {"f",      "ldst",  "move", "recoding",
+                              "memory", "ecall", "brk"};
+
+struct Workload {
+  QString name;
+  QStringList files;
+};
+
+struct Measurement {
+  double assembleMs = 0;
+  std::vector<double> wallMs;
+  long long cycles = 0;
+  long long retired = 0;
+};
+
+class Benchmark {
+public:
+  Benchmark(unsigned warmup, unsigned reps, bool caches)
+      : m_warmup(warmup), m_reps(reps), m_caches(caches) {}
+
+  QJsonArray run(const std::vector<ProcessorID> &processors,
+                 const QStringList &workloadFilter);
+  bool failed() const { return m_failed; }
+
+private:
+  std::vector<Workload> workloads(unsigned bits) const;
+  std::optional<Measurement> measure(const Workload &workload);
+  bool runProgram(const std::shared_ptr<Program> &program);
+  void attachCaches();
+
+  unsigned m_warmup;
+  unsigned m_reps;
+  bool m_caches;
+  bool m_failed = false;
+  bool m_stop = false;
+  bool m_success = false;
+
+  std::vector<std::unique_ptr<L1CacheShim>> m_cacheShims;
+  std::vector<std::shared_ptr<CacheSim>> m_cacheSims;
+};
+
+static bool skipTest(const QString &test) {
+  for (const auto &t : s_excludedTests)
+    if (test.startsWith(t))
+      return true;
+  return false;
+}
+
+std::vector<Workload> Benchmark::workloads(unsigned bits) const {
+  std::vector<Workload> workloads;
+
+  // All of the riscv-tests are run in sequence, as a single workload.
+  Workload riscvTests{"riscv-tests", {}};
+  const QString testDir = bits == 32 ? RISCV32_TEST_DIR : RISCV64_TEST_DIR;
+  for (const auto &test : QDir(testDir).entryList({"*.s"})) {
+    if (!skipTest(test))
+      riscvTests.files << testDir + QDir::separator() + test;
+  }
+  workloads.push_back(riscvTests);
+
+  // Synthetic kernels run as individual workloads.
+  const QString kernelDir = BENCH_KERNEL_DIR;
+  for (const auto &kernel : QDir(kernelDir).entryList({"*.s"})) {
+    workloads.push_back({QFileInfo(kernel).baseName(),
+                         {kernelDir + QDir::separator() + kernel}});
+  }
+  return workloads;
+}
+
+void Benchmark::attachCaches() {
+  m_cacheShims.clear();
+  m_cacheSims.clear();
+  if (!m_caches)
+    return;
+
+  for (auto type : {L1CacheShim::CacheType::InstrCache,
+                    L1CacheShim::CacheType::DataCache}) {
+    auto cache = std::make_shared<CacheSim>(nullptr);
+    auto shim = std::make_unique<L1CacheShim>(type, nullptr);
+    shim->setNextLevelCache(cache);
+    m_cacheSims.push_back(cache);
+    m_cacheShims.push_back(std::move(shim));
+  }
+}
+
+bool Benchmark::runProgram(const std::shared_ptr<Program> &program) {
+  ProcessorHandler::get()->loadProgram(program);
+  RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+
+  m_stop = false;
+  m_success = false;
+  auto *proc = ProcessorHandler::getProcessorNonConst();
+  while (!m_stop && proc->getCycleCount() < s_maxCycles)
+    proc->clock();
+  return m_success;
+}
+
+std::optional<Measurement> Benchmark::measure(const Workload &workload) {
+  Measurement m;
+
+  // Assemble all programs of the workload up front.
+  std::vector<std::shared_ptr<Program>> programs;
+  QElapsedTimer timer;
+  for (const auto &file : workload.files) {
+    QFile f(file);
+    if (!f.open(QIODevice::ReadOnly)) {
+      std::cerr << "Could not open " << file.toStdString() << std::endl;
+      return {};
+    }
+    const QString source = f.readAll();
+    timer.start();
+    auto res = ProcessorHandler::getAssembler()->assembleRaw(source);
+    m.assembleMs += timer.nsecsElapsed() / 1e6;
+    if (res.errors.size() != 0) {
+      std::cerr << "Could not assemble " << file.toStdString() << ":\n"
+                << res.errors.toString().toStdString() << std::endl;
+      return {};
+    }
+    programs.push_back(std::make_shared<Program>(res.program));
+  }
+
+  for (unsigned rep = 0; rep < m_warmup + m_reps; ++rep) {
+    long long cycles = 0;
+    long long retired = 0;
+    qint64 elapsed = 0;
+    for (const auto &program : programs) {
+      timer.start();
+      const bool success = runProgram(program);
+      elapsed += timer.nsecsElapsed();
+      if (!success) {
+        std::cerr << "Workload '" << workload.name.toStdString()
+                  << "' failed on "
+                  << enumToString(ProcessorHandler::getID()).toStdString()
+                  << std::endl;
+        return {};
+      }
+      cycles += ProcessorHandler::getProcessor()->getCycleCount();
+      retired += ProcessorHandler::getProcessor()->getInstructionsRetired();
+      SystemIO::reset();
+    }
+
+    if (rep >= m_warmup)
+      m.wallMs.push_back(elapsed / 1e6);
+    m.cycles = cycles;
+    m.retired = retired;
+  }
+  return m;
+}
+
+QJsonArray Benchmark::run(const std::vector<ProcessorID> &processors,
+                          const QStringList &workloadFilter) {
+  QJsonArray results;
+  for (const auto id : processors) {
+    ProcessorHandler::selectProcessor(id, {"M"});
+    attachCaches();
+
+    // Terminate execution on the Exit2 ecall of the workloads; forward
+    // everything else to the trap handler installed by ProcessorHandler, such
+    // that syscalls are measured along the same path as in the GUI and CLI.
+    auto *processor = ProcessorHandler::getProcessorNonConst();
+    processor->trapHandler = [this, trap = processor->trapHandler] {
+      const auto *proc = ProcessorHandler::getProcessor();
+      const unsigned function = proc->getRegister(RVISA::GPR, s_ecallopreg);
+      if (function == RVABI::Exit2 || function == RVABI::Exit) {
+        m_success = proc->getRegister(RVISA::GPR, s_ecallreg) == s_success;
+        m_stop = true;
+      } else {
+        trap();
+      }
+    };
+
+    const unsigned bits = ProcessorHandler::currentISA()->bits();
+    for (const auto &workload : workloads(bits)) {
+      if (!workloadFilter.isEmpty() && !workloadFilter.contains(workload.name))
+        continue;
+
+      const auto m = measure(workload);
+      if (!m) {
+        m_failed = true;
+        continue;
+      }
+
+      auto wall = m->wallMs;
+      std::sort(wall.begin(), wall.end());
+      const double median = wall.at(wall.size() / 2);
+      const double seconds = median / 1e3;
+
+      QJsonObject result;
+      result["processor"] = enumToString(id);
+      result["workload"] = workload.name;
+      result["assemble_ms"] = m->assembleMs;
+      result["wall_ms"] = median;
+      result["wall_ms_min"] = wall.front();
+      result["wall_ms_max"] = wall.back();
+      result["cycles"] = m->cycles;
+      result["retired"] = m->retired;
+      result["cycles_per_s"] = m->cycles / seconds;
+      result["instrs_per_s"] = m->retired / seconds;
+      results.append(result);
+
+      std::cerr << enumToString(id).toStdString() << "\t"
+                << workload.name.toStdString() << "\t"
+                << static_cast<long long>(m->cycles / seconds)
+                << " cycles/s" << std::endl;
+    }
+  }
+  return results;
+}
+
+/// Compares @p results against @p baseline. Returns false if any
+/// processor/workload pair regressed by more than @p threshold percent.
+static bool compareToBaseline(const QJsonArray &results,
+                              const QJsonArray &baseline, double threshold) {
+  auto key = [](const QJsonObject &o) {
+    return o["processor"].toString() + "/" + o["workload"].toString();
+  };
+  std::map<QString, QJsonObject> baselineMap;
+  for (const auto &b : baseline)
+    baselineMap[key(b.toObject())] = b.toObject();
+
+  bool ok = true;
+  for (const auto &r : results) {
+    const auto result = r.toObject();
+    auto it = baselineMap.find(key(result));
+    if (it == baselineMap.end())
+      continue;
+
+    const auto &base = it->second;
+    if (base["cycles"].toInteger() != result["cycles"].toInteger()) {
+      std::cerr << "NOTE: " << key(result).toStdString()
+                << ": simulated cycle count changed from "
+                << base["cycles"].toInteger() << " to "
+                << result["cycles"].toInteger() << std::endl;
+    }
+
+    const double before = base["cycles_per_s"].toDouble();
+    const double after = result["cycles_per_s"].toDouble();
+    const double change = (after - before) / before * 100.0;
+    if (change < -threshold) {
+      std::cerr << "REGRESSION: " << key(result).toStdString() << ": "
+                << change << "% cycles/s" << std::endl;
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  QCoreApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Ripes simulator throughput benchmark");
+  parser.addHelpOption();
+  parser.addOption(QCommandLineOption(
+      "reps", "Number of measured repetitions.", "n", "5"));
+  parser.addOption(QCommandLineOption(
+      "warmup", "Number of unmeasured warmup repetitions.", "n", "1"));
+  parser.addOption(QCommandLineOption(
+      "proc", "Comma-separated list of processors to run. Default: all.",
+      "names"));
+  parser.addOption(QCommandLineOption(
+      "workload", "Comma-separated list of workloads to run. Default: all.",
+      "names"));
+  parser.addOption(
+      QCommandLineOption("caches", "Simulate L1 instruction/data caches."));
+  parser.addOption(QCommandLineOption(
+      "output", "JSON result file. If not set, results are printed to stdout.",
+      "path"));
+  parser.addOption(QCommandLineOption(
+      "baseline", "JSON result file to compare results against.", "path"));
+  parser.addOption(QCommandLineOption(
+      "threshold",
+      "Maximum allowed cycles/s regression, in percent, with respect to the "
+      "baseline.",
+      "percent", "10"));
+  parser.process(app);
+
+  std::vector<ProcessorID> processors;
+  const QStringList procFilter =
+      parser.isSet("proc") ? parser.value("proc").split(",") : QStringList();
+  for (int i = 0; i < ProcessorID::NUM_PROCESSORS; i++) {
+    const auto id = static_cast<ProcessorID>(i);
+    if (procFilter.isEmpty() || procFilter.contains(enumToString(id)))
+      processors.push_back(id);
+  }
+  const QStringList workloadFilter = parser.isSet("workload")
+                                         ? parser.value("workload").split(",")
+                                         : QStringList();
+
+  Benchmark bench(parser.value("warmup").toUInt(),
+                  std::max(1u, parser.value("reps").toUInt()),
+                  parser.isSet("caches"));
+  const QJsonArray results = bench.run(processors, workloadFilter);
+
+  QJsonObject output;
+  output["reps"] = parser.value("reps").toInt();
+  output["warmup"] = parser.value("warmup").toInt();
+  output["caches"] = parser.isSet("caches");
+  output["results"] = results;
+  const QByteArray json = QJsonDocument(output).toJson(QJsonDocument::Indented);
+
+  if (parser.isSet("output")) {
+    QFile outFile(parser.value("output"));
+    if (!outFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      std::cerr << "Could not open output file" << std::endl;
+      return 1;
+    }
+    outFile.write(json);
+  } else {
+    std::cout << json.toStdString();
+  }
+
+  bool ok = !bench.failed();
+  if (parser.isSet("baseline")) {
+    QFile baselineFile(parser.value("baseline"));
+    if (!baselineFile.open(QIODevice::ReadOnly)) {
+      std::cerr << "Could not open baseline file" << std::endl;
+      return 1;
+    }
+    const auto baseline = QJsonDocument::fromJson(baselineFile.readAll());
+    ok &= compareToBaseline(results, baseline.object()["results"].toArray(),
+                            parser.value("threshold").toDouble());
+  }
+  return ok ? 0 : 1;
+}
@@ -6,8 +6,11 @@
 #include <QTimer>
 #include <iostream>
 
+#include "src/cli/bpeval.h"
 #include "src/cli/clioptions.h"
 #include "src/cli/clirunner.h"
+#include "src/cli/parallelrunner.h"
+#include "src/cli/simpointrunner.h"
 #include "src/mainwindow.h"
 
 using namespace std;
@@ -18,11 +21,17 @@ void initParser(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
       "\n"
       "program on an arbitrary processor model and subsequent reporting of \n"
       "execution telemetry.\nCommand line mode is enabled when the '--mode "
-      "cli' argument is provided.";
+      "cli' argument is provided.\nBranch traces recorded in command line "
+      "mode (--branch-trace) are\nevaluated against a set of branch "
+      "predictors with '--mode bpeval'.\nSampled simulation of long-running "
+      "programs is enabled with '--mode simpoint', and\ncheckpoint-parallel "
+      "simulation with '--mode parallel'.";
 
   helpText.prepend("Ripes command line interface.\n");
   parser.setApplicationDescription(helpText);
-  QCommandLineOption modeOption("mode", "Ripes mode [gui, cli]", "mode", "gui");
+  QCommandLineOption modeOption(
+      "mode", "Ripes mode [gui, cli, bpeval, simpoint, parallel]", "mode",
+      "gui");
   parser.addOption(modeOption);
   Ripes::addCLIOptions(parser, options);
 }
@@ -31,7 +40,10 @@ enum CommandLineParseResult {
   CommandLineError,
   CommandLineHelpRequested,
   CommandLineGUI,
-  CommandLineCLI
+  CommandLineCLI,
+  CommandLineBPEval,
+  CommandLineSimPoint,
+  CommandLineParallel
 };
 
 CommandLineParseResult parseCommandLine(QCommandLineParser &parser,
@@ -49,6 +61,12 @@ CommandLineParseResult parseCommandLine(QCommandLineParser &parser,
     return CommandLineGUI;
   else if (parser.value("mode") == "cli")
     return CommandLineCLI;
+  else if (parser.value("mode") == "bpeval")
+    return CommandLineBPEval;
+  else if (parser.value("mode") == "simpoint")
+    return CommandLineSimPoint;
+  else if (parser.value("mode") == "parallel")
+    return CommandLineParallel;
   else {
     errorMessage = "Invalid mode: " + parser.value("mode");
     return CommandLineError;
@@ -85,6 +103,41 @@ int CLIMode(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
   return Ripes::CLIRunner(options).run();
 }
 
+int BPEvalMode(QCommandLineParser &parser) {
+  QString err;
+  Ripes::BPEvalOptions options;
+  if (!Ripes::parseBPEvalOptions(parser, err, options)) {
+    std::cerr << "ERROR: " << err.toStdString() << std::endl;
+    parser.showHelp();
+    return 0;
+  }
+  return Ripes::runBPEval(options);
+}
+
+int SimPointMode(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
+  QString err;
+  Ripes::SimPointOptions spOptions;
+  if (!Ripes::parseCLIOptions(parser, err, options) ||
+      !Ripes::parseSimPointOptions(parser, err, spOptions)) {
+    std::cerr << "ERROR: " << err.toStdString() << std::endl;
+    parser.showHelp();
+    return 0;
+  }
+  return Ripes::SimPointRunner(options, spOptions).run();
+}
+
+int ParallelMode(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
+  QString err;
+  Ripes::ParallelOptions pOptions;
+  if (!Ripes::parseCLIOptions(parser, err, options) ||
+      !Ripes::parseParallelOptions(parser, err, options, pOptions)) {
+    std::cerr << "ERROR: " << err.toStdString() << std::endl;
+    parser.showHelp();
+    return 0;
+  }
+  return Ripes::ParallelRunner(options, pOptions).run();
+}
+
 int main(int argc, char **argv) {
   Q_INIT_RESOURCE(icons);
   Q_INIT_RESOURCE(examples);
@@ -110,5 +163,11 @@ int main(int argc, char **argv) {
     return guiMode(app);
   case CommandLineCLI:
     return CLIMode(parser, options);
+  case CommandLineBPEval:
+    return BPEvalMode(parser);
+  case CommandLineSimPoint:
+    return SimPointMode(parser, options);
+  case CommandLineParallel:
+    return ParallelMode(parser, options);
   }
 }
@@ -0,0 +1,188 @@
+#include "archcheckpoint.h"
+
+#include "processorhandler.h"
+
+#include <QDataStream>
+#include <QFile>
+
+#include <algorithm>
+
+namespace Ripes {
+
+static constexpr AInt s_wordMask = ~static_cast<AInt>(3);
+static constexpr char s_magic[4] = {'R', 'C', 'K', 'P'};
+static constexpr quint32 s_version = 2;
+
+MemoryWriteTracker::MemoryWriteTracker(QObject *parent) : QObject(parent) {
+  // Writes must be observed for each cycle, in the thread that the processor
+  // is clocked in (direct connection).
+  connect(ProcessorHandler::get(), &ProcessorHandler::processorClocked, this,
+          &MemoryWriteTracker::processorWasClocked, Qt::DirectConnection);
+  connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this,
+          &MemoryWriteTracker::processorReset);
+  connect(ProcessorHandler::get(), &ProcessorHandler::memoryWritten, this,
+          &MemoryWriteTracker::markWritten, Qt::DirectConnection);
+  processorReset();
+}
+
+void MemoryWriteTracker::processorReset() {
+  m_words.clear();
+  // The first instruction of the program may already be accessing memory.
+  processorWasClocked();
+}
+
+void MemoryWriteTracker::processorWasClocked() {
+  const auto access = ProcessorHandler::getProcessor()->dataMemAccess();
+  if (access.type == MemoryAccess::Write)
+    markWritten(access.address, access.bytes);
+}
+
+void MemoryWriteTracker::markWritten(AInt address, unsigned bytes) {
+  const AInt end = address + std::max(bytes, 1u);
+  for (AInt word = address & s_wordMask; word < end; word += 4)
+    m_words.insert(word);
+}
+
+ArchCheckpoint ArchCheckpoint::capture(const MemoryWriteTracker &tracker) {
+  const auto *proc = ProcessorHandler::getProcessor();
+  ArchCheckpoint cp;
+  cp.instructions = proc->getInstructionsRetired();
+  cp.pc = proc->getPcForStage({0, 0});
+  for (const auto &regFile : ProcessorHandler::currentISA()->regInfos()) {
+    auto &values = cp.registers[regFile->regFileName()];
+    for (unsigned i = 0; i < regFile->regCnt(); ++i)
+      values.push_back(proc->getRegister(regFile->regFileName(), i));
+  }
+  auto &memory = ProcessorHandler::getMemory();
+  for (const AInt word : tracker.words())
+    cp.memory[word] = static_cast<uint32_t>(memory.readMemConst(word, 4));
+  cp.process = ProcessState::snapshot();
+  return cp;
+}
+
+void ArchCheckpoint::restore() const {
+  for (const auto &[addr, value] : memory)
+    ProcessorHandler::writeMem(addr, value, 4);
+  for (const auto &[regFile, values] : registers)
+    for (unsigned i = 0; i < values.size(); ++i)
+      ProcessorHandler::setRegisterValue(regFile, i, values[i]);
+  ProcessorHandler::getProcessorNonConst()->setProgramCounter(pc);
+  // Without the program break, a brk after the checkpoint would assume the
+  // heap to be empty, and zero the restored heap.
+  ProcessState::restore(process);
+}
+
+QString ArchCheckpoint::write(const QString &path) const {
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    return "Could not open checkpoint file '" + path + "' for writing";
+
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_6_0);
+  out.writeRawData(s_magic, sizeof(s_magic));
+  out << s_version << static_cast<quint64>(instructions)
+      << static_cast<quint64>(pc);
+  out << static_cast<quint32>(registers.size());
+  for (const auto &[regFile, values] : registers) {
+    out << QString::fromUtf8(regFile.data(), regFile.size());
+    out << static_cast<quint32>(values.size());
+    for (const VInt value : values)
+      out << static_cast<quint64>(value);
+  }
+  out << static_cast<quint64>(memory.size());
+  for (const auto &[addr, value] : memory)
+    out << static_cast<quint64>(addr) << static_cast<quint32>(value);
+  out << process.heapStart.has_value();
+  if (process.heapStart)
+    out << static_cast<quint64>(*process.heapStart);
+  out << static_cast<quint64>(process.programBreak);
+  out << process.mapTop.has_value();
+  if (process.mapTop)
+    out << static_cast<quint64>(*process.mapTop);
+  out << static_cast<quint64>(process.mappings.size());
+  for (const auto &[addr, length] : process.mappings)
+    out << static_cast<quint64>(addr) << static_cast<quint64>(length);
+
+  if (out.status() != QDataStream::Ok)
+    return "Failed to write checkpoint file '" + path + "'";
+  return QString();
+}
+
+QString ArchCheckpoint::read(const QString &path, ArchCheckpoint &checkpoint) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly))
+    return "Could not open checkpoint file '" + path + "'";
+
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_6_0);
+  char magic[sizeof(s_magic)] = {};
+  quint32 version = 0;
+  in.readRawData(magic, sizeof(magic));
+  in >> version;
+  if (!std::equal(magic, magic + sizeof(magic), s_magic) ||
+      version != s_version)
+    return "'" + path + "' is not a checkpoint file of a supported version";
+
+  checkpoint = ArchCheckpoint();
+  quint64 instructions, pc;
+  quint32 nRegFiles;
+  in >> instructions >> pc >> nRegFiles;
+  checkpoint.instructions = instructions;
+  checkpoint.pc = pc;
+
+  const auto regFileNames = ProcessorHandler::currentISA()->regFileNames();
+  for (quint32 i = 0; i < nRegFiles && in.status() == QDataStream::Ok; ++i) {
+    QString name;
+    quint32 nRegs;
+    in >> name >> nRegs;
+    auto regFile = std::find_if(
+        regFileNames.begin(), regFileNames.end(), [&](const auto &regFileName) {
+          return name ==
+                 QString::fromUtf8(regFileName.data(), regFileName.size());
+        });
+    if (regFile == regFileNames.end())
+      return "Register file '" + name +
+             "' of the checkpoint is not implemented by the processor";
+    auto &values = checkpoint.registers[*regFile];
+    for (quint32 j = 0; j < nRegs; ++j) {
+      quint64 value;
+      in >> value;
+      values.push_back(value);
+    }
+  }
+
+  quint64 nWords;
+  in >> nWords;
+  for (quint64 i = 0; i < nWords && in.status() == QDataStream::Ok; ++i) {
+    quint64 addr;
+    quint32 value;
+    in >> addr >> value;
+    checkpoint.memory[addr] = value;
+  }
+
+  bool hasHeapStart = false, hasMapTop = false;
+  quint64 value, programBreak, nMappings = 0;
+  in >> hasHeapStart;
+  if (hasHeapStart) {
+    in >> value;
+    checkpoint.process.heapStart = value;
+  }
+  in >> programBreak >> hasMapTop;
+  checkpoint.process.programBreak = programBreak;
+  if (hasMapTop) {
+    in >> value;
+    checkpoint.process.mapTop = value;
+  }
+  in >> nMappings;
+  for (quint64 i = 0; i < nMappings && in.status() == QDataStream::Ok; ++i) {
+    quint64 addr, length;
+    in >> addr >> length;
+    checkpoint.process.mappings[addr] = length;
+  }
+
+  if (in.status() != QDataStream::Ok)
+    return "Checkpoint file '" + path + "' is truncated";
+  return QString();
+}
+
+} // namespace Ripes
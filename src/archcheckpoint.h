@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <map>
+#include <set>
+#include <string_view>
+#include <vector>
+
+#include "isa/isa_types.h"
+#include "syscall/processstate.h"
+
+namespace Ripes {
+
+/**
+ * @brief The MemoryWriteTracker class
+ * Records the (word-aligned) addresses of all data memory written by the
+ * current processor and by system calls since the processor was last reset.
+ *
+ * Writes performed by the processor are determined from
+ * RipesProcessor::dataMemAccess after each cycle. This is only exact for the
+ * single-cycle processors, which access data memory combinationally: the
+ * access reported after a cycle is that of the instruction about to execute.
+ */
+class MemoryWriteTracker : public QObject {
+  Q_OBJECT
+public:
+  MemoryWriteTracker(QObject *parent = nullptr);
+
+  /// Word-aligned addresses of all words written since the last reset.
+  const std::set<AInt> &words() const { return m_words; }
+
+private:
+  void processorWasClocked();
+  void processorReset();
+  void markWritten(AInt address, unsigned bytes);
+
+  std::set<AInt> m_words;
+};
+
+/**
+ * @brief The ArchCheckpoint struct
+ * Architectural state of a program at an instruction boundary: the program
+ * counter, the register files, the contents of all memory written since the
+ * program was loaded, and the program break and memory mappings of the
+ * process. Restoring a checkpoint on a freshly reset processor which
+ * implements the same ISA and has the same program loaded resumes execution of
+ * the program at the checkpoint.
+ *
+ * Checkpoint files are written through QDataStream (version Qt_6_0):
+ *
+ *   char[4]  magic "RCKP"
+ *   quint32  format version
+ *   quint64  instructions, pc
+ *   quint32  number of register files, each followed by
+ *              QString  register file name
+ *              quint32  number of registers, followed by a quint64 each
+ *   quint64  number of memory words, followed by a {quint64 address, quint32
+ *            value} pair each
+ *   bool     heap start is set, followed by a quint64 heap start if so
+ *   quint64  program break
+ *   bool     top of the mapping area is set, followed by a quint64 if so
+ *   quint64  number of mappings, followed by a {quint64 address, quint64
+ *            length} pair each
+ */
+struct ArchCheckpoint {
+  /// Number of instructions retired before the checkpoint.
+  uint64_t instructions = 0;
+  AInt pc = 0;
+  std::map<std::string_view, std::vector<VInt>> registers;
+  /// 32-bit words of memory written since the program was loaded, indexed by
+  /// their (word-aligned) address.
+  std::map<AInt, uint32_t> memory;
+  /// Program break and memory mappings (see ProcessState).
+  ProcessState::Snapshot process;
+
+  /// Captures the state of the current processor, which must be a
+  /// single-cycle processor; all instructions before its PC have completed.
+  static ArchCheckpoint capture(const MemoryWriteTracker &tracker);
+
+  /// Restores the checkpoint onto the current processor.
+  void restore() const;
+
+  /// Writes the checkpoint to @p path. Returns an error message on failure.
+  QString write(const QString &path) const;
+  /// Reads the checkpoint at @p path. Register files are resolved against the
+  /// ISA of the current processor. Returns an error message on failure.
+  static QString read(const QString &path, ArchCheckpoint &checkpoint);
+};
+
+} // namespace Ripes
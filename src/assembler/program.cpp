@@ -2,6 +2,8 @@
 
 #include "processorhandler.h"
 
+#include <QtConcurrent/QtConcurrent>
+
 namespace Ripes {
 
 const ProgramSection *Program::getSection(const QString &name) const {
@@ -103,12 +105,54 @@ QString Program::calculateHash(const QByteArray &data) {
 }
 
 bool Program::isSameSource(const QByteArray &data) const {
+  const auto *deferred = deferredSourceInfo();
+  const QString &hash = deferred ? deferred->hash : sourceHash;
+
   /// We consider no source program to be equal to this program if no source
   /// hash has been set.
-  if (sourceHash.isEmpty())
+  if (hash.isEmpty())
     return false;
 
-  return sourceHash == calculateHash(data);
+  return hash == calculateHash(data);
+}
+
+const Program::SourceMapping &Program::getSourceMapping() const {
+  if (const auto *deferred = deferredSourceInfo())
+    return deferred->mapping;
+  return sourceMapping;
+}
+
+void Program::deferSourceInfo(std::function<SourceInfo()> loader) {
+  m_deferredSourceInfo = std::make_shared<DeferredSourceInfo>();
+  m_deferredSourceInfo->loader = std::move(loader);
+}
+
+QFuture<void> Program::loadSourceInfo() {
+  if (!m_deferredSourceInfo)
+    return QFuture<void>();
+
+  auto &deferred = *m_deferredSourceInfo;
+  if (deferred.loader) {
+    // The worker keeps the deferred state alive, should the program be
+    // destroyed before the worker finishes.
+    deferred.future =
+        QtConcurrent::run([state = m_deferredSourceInfo,
+                           loader = std::move(deferred.loader)] {
+          state->info = loader();
+        });
+    deferred.loader = nullptr;
+  }
+  return deferred.future;
+}
+
+const Program::SourceInfo *Program::deferredSourceInfo() const {
+  if (!m_deferredSourceInfo)
+    return nullptr;
+
+  const auto &deferred = *m_deferredSourceInfo;
+  if (deferred.loader || !deferred.future.isFinished())
+    return nullptr;
+  return &deferred.info;
 }
 
 } // namespace Ripes
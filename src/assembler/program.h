@@ -1,10 +1,13 @@
 #pragma once
 
 #include <QByteArray>
+#include <QFuture>
 #include <QHash>
 #include <QMap>
 #include <QMetaType>
 #include <QString>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <set>
 #include <vector>
@@ -42,6 +45,14 @@ struct ProgramSection {
   QByteArray data;
 };
 
+/// A loadable segment of an executable (a PT_LOAD program header). Memory
+/// beyond the file-backed data, up to memSize, is zero-initialized.
+struct ProgramSegment {
+  AInt address;
+  QByteArray data;
+  AInt memSize;
+};
+
 class DisassembledProgram {
 public:
   /// Associates the given address and index with the disassembled instruction
@@ -87,10 +98,20 @@ public:
   // lines}
   using SourceMapping = std::map<VInt, std::set<unsigned>>;
 
+  struct SourceInfo {
+    SourceMapping mapping;
+    QString hash;
+  };
+
   AInt entryPoint = 0;
   std::map<QString, ProgramSection> sections;
+  /// Segments to load into memory. If empty, the sections are loaded.
+  std::vector<ProgramSegment> segments;
   ReverseSymbolMap symbols;
   SourceMapping sourceMapping;
+  /// Keeps alive the memory which section, segment and debug data refers to,
+  /// such as a memory-mapped executable. Null if the data is owned.
+  std::shared_ptr<const void> mapping;
 
   // Hash of the source code which this program resulted from. Expected to be a
   // SHA-1 hash (fastest).
@@ -98,6 +119,16 @@ public:
   // Returns true if data is equal to the sourceHash of this program.
   bool isSameSource(const QByteArray &data) const;
 
+  /// Defers building the source mapping and source hash to @p loader, which is
+  /// run on a worker thread once loadSourceInfo() is called. Until @p loader
+  /// has finished, the program has no source information.
+  void deferSourceInfo(std::function<SourceInfo()> loader);
+
+  /// Starts building the deferred source information, if not yet started. The
+  /// returned future finishes once the source information is available. An
+  /// empty future is returned if the source information is not deferred.
+  QFuture<void> loadSourceInfo();
+
   /// Returns the program section corresponding to the provided name. Return
   /// nullptr if no section was found with the given name.
   const ProgramSection *getSection(const QString &name) const;
@@ -111,8 +142,22 @@ public:
   static QString calculateHash(const QByteArray &data);
 
 private:
+  struct DeferredSourceInfo {
+    std::function<SourceInfo()> loader;
+    QFuture<void> future;
+    SourceInfo info;
+  };
+
+  /// Returns the deferred source information if it has been built, and
+  /// nullptr otherwise.
+  const SourceInfo *deferredSourceInfo() const;
+
   /// A caching of the disassembled version of this program.
   mutable DisassembledProgram disassembled;
+
+  /// Source information which is built asynchronously, if deferred. Shared
+  /// between copies of the program.
+  std::shared_ptr<DeferredSourceInfo> m_deferredSourceInfo;
 };
 
 } // namespace Ripes
@@ -0,0 +1,202 @@
+#include "branchtrace.h"
+
+#include "processorhandler.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <iterator>
+
+namespace Ripes {
+
+static constexpr size_t s_headerSize = 32;
+// Size of the record buffer before it is written to the file.
+static constexpr size_t s_bufferSize = 1 << 16;
+
+static constexpr uint8_t s_kindMask = 0b11;
+static constexpr uint8_t s_takenBit = 1 << 2;
+static constexpr uint8_t s_compressedBit = 1 << 3;
+
+static void putLE(std::vector<uint8_t> &out, uint64_t value, unsigned bytes) {
+  for (unsigned i = 0; i < bytes; ++i)
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+static uint64_t getLE(const uint8_t *in, unsigned bytes) {
+  uint64_t value = 0;
+  for (unsigned i = 0; i < bytes; ++i)
+    value |= static_cast<uint64_t>(in[i]) << (8 * i);
+  return value;
+}
+
+static void putVarint(std::vector<uint8_t> &out, int64_t value) {
+  uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^
+                    static_cast<uint64_t>(value >> 63);
+  while (zigzag >= 0x80) {
+    out.push_back(static_cast<uint8_t>(zigzag) | 0x80);
+    zigzag >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(zigzag));
+}
+
+static bool getVarint(const uint8_t *&in, const uint8_t *end, int64_t &value) {
+  uint64_t zigzag = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (in == end)
+      return false;
+    const uint8_t byte = *in++;
+    zigzag |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      value = static_cast<int64_t>(zigzag >> 1) ^
+              -static_cast<int64_t>(zigzag & 1);
+      return true;
+    }
+  }
+  return false;
+}
+
+QString BranchTrace::read(const QString &path, BranchTrace &trace) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly))
+    return "Could not open branch trace '" + path + "'";
+  const QByteArray data = file.readAll();
+  const auto *in = reinterpret_cast<const uint8_t *>(data.constData());
+  const auto *end = in + data.size();
+
+  if (data.size() < static_cast<qsizetype>(s_headerSize) ||
+      !std::equal(std::begin(s_magic), std::end(s_magic), data.constData()))
+    return "'" + path + "' is not a branch trace";
+  if (getLE(in + 4, 4) != s_version)
+    return "Unsupported branch trace version in '" + path + "'";
+  trace.xlen = getLE(in + 8, 4);
+  trace.instructions = getLE(in + 16, 8);
+  const uint64_t nRecords = getLE(in + 24, 8);
+  in += s_headerSize;
+
+  trace.records.clear();
+  trace.records.reserve(nRecords);
+  const AInt mask = trace.xlen == 64 ? ~AInt(0) : (AInt(1) << trace.xlen) - 1;
+  AInt lastNextPC = 0;
+  for (uint64_t i = 0; i < nRecords; ++i) {
+    Record record;
+    int64_t pcDelta, targetDelta;
+    if (in == end)
+      return "Truncated branch trace '" + path + "'";
+    const uint8_t flags = *in++;
+    if (!getVarint(in, end, pcDelta) || !getVarint(in, end, targetDelta))
+      return "Truncated branch trace '" + path + "'";
+    record.kind = static_cast<Kind>(flags & s_kindMask);
+    record.taken = flags & s_takenBit;
+    record.compressed = flags & s_compressedBit;
+    record.pc = (lastNextPC + pcDelta) & mask;
+    record.nextPC = (record.pc + targetDelta) & mask;
+    lastNextPC = record.nextPC;
+    trace.records.push_back(record);
+  }
+  return QString();
+}
+
+BranchTraceRecorder::BranchTraceRecorder(const QString &fileName,
+                                         QObject *parent)
+    : RetirementObserver(parent), m_fileName(fileName) {
+  m_buffer.reserve(s_bufferSize + 32);
+}
+
+BranchTraceRecorder::~BranchTraceRecorder() {
+  if (!m_file)
+    return;
+  flush();
+  // Patch the instruction and record counts into the header.
+  writeHeader();
+  std::fclose(m_file);
+}
+
+void BranchTraceRecorder::writeHeader() {
+  std::vector<uint8_t> header(std::begin(BranchTrace::s_magic),
+                              std::end(BranchTrace::s_magic));
+  putLE(header, BranchTrace::s_version, 4);
+  putLE(header, ProcessorHandler::currentISA()->bits(), 4);
+  putLE(header, 0, 4);
+  putLE(header, m_instructions, 8);
+  putLE(header, m_records, 8);
+  std::fseek(m_file, 0, SEEK_SET);
+  std::fwrite(header.data(), 1, header.size(), m_file);
+  std::fseek(m_file, 0, SEEK_END);
+}
+
+void BranchTraceRecorder::flush() {
+  if (m_file)
+    std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+  m_buffer.clear();
+}
+
+void BranchTraceRecorder::observerReset() {
+  // Restart the trace; it always reflects the execution since the last reset.
+  if (m_file)
+    std::fclose(m_file);
+  m_file = std::fopen(m_fileName.toLocal8Bit().constData(), "wb");
+  m_buffer.clear();
+  m_instructions = 0;
+  m_records = 0;
+  m_pending = false;
+  m_lastNextPC = 0;
+  m_slotKind.assign(numSlots(), s_unknownKind);
+  if (m_file)
+    writeHeader();
+}
+
+void BranchTraceRecorder::instructionRetired(AInt pc, long long) {
+  m_instructions++;
+
+  // The outcome of the previously retired control-flow instruction is given by
+  // the PC of this instruction.
+  if (m_pending) {
+    const unsigned size = (m_pendingFlags & s_compressedBit) ? 2 : 4;
+    uint8_t flags = m_pendingFlags;
+    if (pc != m_pendingPC + size)
+      flags |= s_takenBit;
+    m_buffer.push_back(flags);
+    putVarint(m_buffer, static_cast<int64_t>(m_pendingPC - m_lastNextPC));
+    putVarint(m_buffer, static_cast<int64_t>(pc - m_pendingPC));
+    m_lastNextPC = pc;
+    m_records++;
+    m_pending = false;
+    if (m_buffer.size() >= s_bufferSize)
+      flush();
+  }
+
+  uint8_t &kind = m_slotKind[slotForPC(pc)];
+  if (kind == s_unknownKind) {
+    const uint32_t instr = instructionAt(pc);
+    const unsigned xlen = ProcessorHandler::currentISA()->bits();
+    kind = RVISA::instrSize(instr) == 2 ? s_compressedBit : 0;
+    switch (RVISA::classifyInstr(instr, xlen)) {
+    case InstrClass::Branch:
+      kind |= static_cast<uint8_t>(BranchTrace::Kind::Branch);
+      break;
+    case InstrClass::Jump:
+      switch (RVISA::controlTransfer(instr, xlen)) {
+      case ControlTransfer::Call:
+        kind |= static_cast<uint8_t>(BranchTrace::Kind::Call);
+        break;
+      case ControlTransfer::Return:
+        kind |= static_cast<uint8_t>(BranchTrace::Kind::Return);
+        break;
+      case ControlTransfer::None:
+        kind |= static_cast<uint8_t>(BranchTrace::Kind::Jump);
+        break;
+      }
+      break;
+    default:
+      kind = s_noKind;
+      break;
+    }
+  }
+  if (kind != s_noKind) {
+    m_pending = true;
+    m_pendingPC = pc;
+    m_pendingFlags = kind;
+  }
+}
+
+} // namespace Ripes
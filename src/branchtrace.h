@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QString>
+#include <cstdio>
+#include <vector>
+
+#include "isa/rvinstrclass.h"
+#include "retirementobserver.h"
+
+namespace Ripes {
+
+/**
+ * A branch trace is a binary file recording every control-flow instruction of
+ * the retired instruction stream. The file starts with a fixed-size header:
+ *
+ *   char[4]  magic "RBTR"
+ *   uint32   format version
+ *   uint32   XLEN of the traced processor
+ *   uint32   reserved (0)
+ *   uint64   number of instructions retired while tracing
+ *   uint64   number of records
+ *
+ * followed by one variable-length record per control-flow instruction:
+ *
+ *   uint8    flags; bits [1:0] kind, bit 2 taken, bit 3 compressed
+ *   varint   zigzag(pc - next PC of the previous record)
+ *   varint   zigzag(next PC - pc)
+ *
+ * where varints are LEB128-encoded and "next PC" is the address of the
+ * instruction retiring after the control-flow instruction. All integers are
+ * little-endian. Since most records follow shortly after the previous one and
+ * most targets are near the instruction, records are typically 3-5 bytes.
+ */
+struct BranchTrace {
+  enum class Kind : uint8_t { Branch, Jump, Call, Return };
+
+  struct Record {
+    AInt pc = 0;
+    AInt nextPC = 0;
+    Kind kind = Kind::Branch;
+    bool taken = false;
+    bool compressed = false;
+  };
+
+  static constexpr char s_magic[4] = {'R', 'B', 'T', 'R'};
+  static constexpr uint32_t s_version = 1;
+
+  unsigned xlen = 32;
+  uint64_t instructions = 0;
+  std::vector<Record> records;
+
+  /// Reads the branch trace at @p path. Returns an error message on failure.
+  static QString read(const QString &path, BranchTrace &trace);
+};
+
+/**
+ * @brief The BranchTraceRecorder class
+ * Writes the branch trace of the retired instruction stream of the current
+ * processor to a file. The trace is restarted whenever the processor is reset.
+ * The header is finalized when the recorder is destroyed.
+ */
+class BranchTraceRecorder : public RetirementObserver {
+  Q_OBJECT
+public:
+  BranchTraceRecorder(const QString &fileName, QObject *parent = nullptr);
+  ~BranchTraceRecorder();
+
+  bool isOpen() const { return m_file != nullptr; }
+  uint64_t records() const { return m_records; }
+
+protected:
+  void instructionRetired(AInt pc, long long cycle) override;
+  void observerReset() override;
+
+private:
+  static constexpr uint8_t s_unknownKind = 0xFF;
+  static constexpr uint8_t s_noKind = 0xFE;
+
+  void writeHeader();
+  void flush();
+
+  QString m_fileName;
+  std::FILE *m_file = nullptr;
+  std::vector<uint8_t> m_buffer;
+
+  /// Per-slot cache of the flags byte of the instruction (kind and size), or
+  /// s_noKind if the instruction is not a control-flow instruction.
+  std::vector<uint8_t> m_slotKind;
+
+  bool m_pending = false;
+  AInt m_pendingPC = 0;
+  uint8_t m_pendingFlags = 0;
+  AInt m_lastNextPC = 0;
+
+  uint64_t m_instructions = 0;
+  uint64_t m_records = 0;
+};
+
+} // namespace Ripes
@@ -1,6 +1,8 @@
 #include "l1cacheshim.h"
 
 #include "processorhandler.h"
+#include "regionofinterest.h"
+#include "selfprofiler.h"
 
 namespace Ripes {
 
@@ -45,6 +47,9 @@ void L1CacheShim::processorReversed() {
 }
 
 void L1CacheShim::processorWasClocked() {
+  SelfProfiler::Scope scope(SelfProfiler::L1CacheShim);
+  if (RegionOfInterest::outsideROI())
+    return;
   if (m_type == CacheType::DataCache) {
     const auto dataAccess = ProcessorHandler::getProcessor()->dataMemAccess();
 
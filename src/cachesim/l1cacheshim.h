@@ -22,6 +22,7 @@ public:
   void access(AInt address, MemoryAccess::Type type) override;
 
   void setType(CacheType type);
+  CacheType type() const { return m_type; }
 
 private:
   void processorReset();
@@ -3,6 +3,7 @@
 
 #include "memorytab.h"
 #include "memoryviewerwidget.h"
+#include "perfcounters.h"
 #include "ripessettings.h"
 
 #include <QTabBar>
@@ -40,6 +41,18 @@ CacheTabWidget::CacheTabWidget(QWidget *parent)
   m_l1dShim->setNextLevelCache(m_ui->dataCacheWidget->getCacheSim());
   m_l1iShim->setNextLevelCache(m_ui->instructionCacheWidget->getCacheSim());
 
+  // Expose the L1 cache misses through the hardware performance counters.
+  PerformanceCounters::setEventSource(
+      PerformanceCounters::DCacheMisses,
+      [cache = m_ui->dataCacheWidget->getCacheSim()] {
+        return cache->getMisses();
+      });
+  PerformanceCounters::setEventSource(
+      PerformanceCounters::ICacheMisses,
+      [cache = m_ui->instructionCacheWidget->getCacheSim()] {
+        return cache->getMisses();
+      });
+
 #ifdef N_CACHES_ENABLED
   m_addTabIdx = m_ui->tabWidget->addTab(new QLabel("Placeholder"),
                                         QIcon((":/icons/plus.svg")), QString());
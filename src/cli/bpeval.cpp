@@ -0,0 +1,495 @@
+#include "bpeval.h"
+#include "branchtrace.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <thread>
+
+namespace Ripes {
+
+namespace {
+
+/// A conditional branch of the trace; the only input to direction predictors.
+struct CondBranch {
+  AInt pc;
+  bool taken;
+};
+
+class DirectionPredictor {
+public:
+  virtual ~DirectionPredictor() {}
+  /// Predicts the branch at @p pc, and trains the predictor with the actual
+  /// outcome @p taken. Returns true if the branch was predicted correctly.
+  virtual bool access(AInt pc, bool taken) = 0;
+  /// Storage requirements of the predictor, in bits.
+  virtual uint64_t storageBits() const = 0;
+};
+
+inline unsigned pcHash(AInt pc) { return static_cast<unsigned>(pc >> 1); }
+
+inline void train2Bit(uint8_t &counter, bool taken) {
+  if (taken && counter < 3)
+    counter++;
+  else if (!taken && counter > 0)
+    counter--;
+}
+
+class BimodalPredictor : public DirectionPredictor {
+public:
+  BimodalPredictor(unsigned log2Entries)
+      : m_counters(1u << log2Entries, 1), m_mask((1u << log2Entries) - 1) {}
+  bool predict(AInt pc) const { return m_counters[pcHash(pc) & m_mask] >= 2; }
+  bool access(AInt pc, bool taken) override {
+    uint8_t &counter = m_counters[pcHash(pc) & m_mask];
+    const bool correct = (counter >= 2) == taken;
+    train2Bit(counter, taken);
+    return correct;
+  }
+  uint64_t storageBits() const override { return 2 * m_counters.size(); }
+
+private:
+  std::vector<uint8_t> m_counters;
+  unsigned m_mask;
+};
+
+class GSharePredictor : public DirectionPredictor {
+public:
+  GSharePredictor(unsigned log2Entries, unsigned historyBits)
+      : m_counters(1u << log2Entries, 1), m_mask((1u << log2Entries) - 1),
+        m_historyBits(historyBits),
+        m_historyMask(historyBits >= 64 ? ~uint64_t(0)
+                                        : (uint64_t(1) << historyBits) - 1) {}
+  bool access(AInt pc, bool taken) override {
+    uint8_t &counter =
+        m_counters[(pcHash(pc) ^ static_cast<unsigned>(m_history)) & m_mask];
+    const bool correct = (counter >= 2) == taken;
+    train2Bit(counter, taken);
+    m_history = ((m_history << 1) | taken) & m_historyMask;
+    return correct;
+  }
+  uint64_t storageBits() const override {
+    return 2 * m_counters.size() + m_historyBits;
+  }
+
+private:
+  std::vector<uint8_t> m_counters;
+  unsigned m_mask;
+  unsigned m_historyBits;
+  uint64_t m_historyMask;
+  uint64_t m_history = 0;
+};
+
+class TournamentPredictor : public DirectionPredictor {
+public:
+  TournamentPredictor(unsigned log2Entries, unsigned historyBits)
+      : m_bimodal(log2Entries), m_gshare(log2Entries, historyBits),
+        m_chooser(1u << log2Entries, 1), m_mask((1u << log2Entries) - 1) {}
+  bool access(AInt pc, bool taken) override {
+    const bool bimodalCorrect = m_bimodal.access(pc, taken);
+    const bool gshareCorrect = m_gshare.access(pc, taken);
+    uint8_t &choice = m_chooser[pcHash(pc) & m_mask];
+    const bool correct = choice >= 2 ? gshareCorrect : bimodalCorrect;
+    // The chooser is only trained when the predictors disagree.
+    if (bimodalCorrect != gshareCorrect)
+      train2Bit(choice, gshareCorrect);
+    return correct;
+  }
+  uint64_t storageBits() const override {
+    return m_bimodal.storageBits() + m_gshare.storageBits() +
+           2 * m_chooser.size();
+  }
+
+private:
+  BimodalPredictor m_bimodal;
+  GSharePredictor m_gshare;
+  std::vector<uint8_t> m_chooser;
+  unsigned m_mask;
+};
+
+/**
+ * A reduced TAGE predictor: a bimodal base predictor and four partially tagged
+ * tables indexed by geometrically increasing global history lengths. Omits the
+ * loop predictor, statistical corrector and the alternate prediction for newly
+ * allocated entries of the full design.
+ */
+class TAGELitePredictor : public DirectionPredictor {
+public:
+  static constexpr unsigned s_tables = 4;
+  static constexpr unsigned s_tagBits = 9;
+  static constexpr unsigned s_minHistory = 4;
+  // Number of branches between gradual resets of the useful counters.
+  static constexpr uint64_t s_usefulResetPeriod = 1 << 18;
+
+  TAGELitePredictor(unsigned log2Entries, unsigned maxHistory)
+      : m_base(log2Entries), m_log2Entries(log2Entries) {
+    maxHistory = std::max(maxHistory, s_minHistory);
+    m_history.assign(maxHistory + 1, 0);
+    for (unsigned i = 0; i < s_tables; ++i) {
+      // Geometric series of history lengths from s_minHistory to maxHistory.
+      const double ratio =
+          static_cast<double>(maxHistory) / static_cast<double>(s_minHistory);
+      const unsigned length = static_cast<unsigned>(
+          s_minHistory * std::pow(ratio, i / double(s_tables - 1)) + 0.5);
+      auto &table = m_tables[i];
+      table.entries.assign(1u << log2Entries, Entry());
+      table.index = {length, log2Entries};
+      table.tag0 = {length, s_tagBits};
+      table.tag1 = {length, s_tagBits - 1};
+    }
+  }
+
+  bool access(AInt pc, bool taken) override {
+    const unsigned mask = (1u << m_log2Entries) - 1;
+    std::array<unsigned, s_tables> idx, tag;
+    int provider = -1, alt = -1;
+    for (unsigned i = 0; i < s_tables; ++i) {
+      const auto &table = m_tables[i];
+      idx[i] = (pcHash(pc) ^ (pcHash(pc) >> m_log2Entries) ^
+                table.index.value) &
+               mask;
+      tag[i] = (pcHash(pc) ^ table.tag0.value ^ (table.tag1.value << 1)) &
+               ((1u << s_tagBits) - 1);
+      if (table.entries[idx[i]].tag == tag[i]) {
+        alt = provider;
+        provider = i;
+      }
+    }
+
+    // The base predictor is only trained if no tagged table provides the
+    // prediction.
+    const bool basePrediction = m_base.predict(pc);
+    auto predictionOf = [&](int table) {
+      return table < 0 ? basePrediction
+                       : m_tables[table].entries[idx[table]].ctr >= 0;
+    };
+    const bool prediction = predictionOf(provider);
+    const bool altPrediction = predictionOf(alt);
+
+    if (provider >= 0) {
+      Entry &entry = m_tables[provider].entries[idx[provider]];
+      if (prediction != altPrediction) {
+        if (prediction == taken)
+          entry.u = static_cast<uint8_t>(std::min(entry.u + 1, 3));
+        else if (entry.u > 0)
+          entry.u--;
+      }
+      entry.ctr =
+          static_cast<int8_t>(std::clamp(entry.ctr + (taken ? 1 : -1), -4, 3));
+    } else {
+      m_base.access(pc, taken);
+    }
+
+    // On a misprediction, allocate an entry in a table with a longer history
+    // than the provider.
+    if (prediction != taken) {
+      bool allocated = false;
+      for (unsigned i = provider + 1; i < s_tables && !allocated; ++i) {
+        Entry &entry = m_tables[i].entries[idx[i]];
+        if (entry.u == 0) {
+          entry = {static_cast<uint16_t>(tag[i]),
+                   static_cast<int8_t>(taken ? 0 : -1), 0};
+          allocated = true;
+        }
+      }
+      if (!allocated) {
+        for (unsigned i = provider + 1; i < s_tables; ++i) {
+          Entry &entry = m_tables[i].entries[idx[i]];
+          if (entry.u > 0)
+            entry.u--;
+        }
+      }
+    }
+
+    if (++m_branches % s_usefulResetPeriod == 0) {
+      for (auto &table : m_tables)
+        for (auto &entry : table.entries)
+          entry.u >>= 1;
+    }
+
+    pushHistory(taken);
+    return prediction == taken;
+  }
+
+  uint64_t storageBits() const override {
+    // tag, 3-bit counter and 2-bit useful counter per tagged entry.
+    return m_base.storageBits() +
+           s_tables * (uint64_t(1) << m_log2Entries) * (s_tagBits + 3 + 2) +
+           m_history.size() - 1;
+  }
+
+private:
+  struct Entry {
+    // Tags are s_tagBits wide; an unallocated entry never matches.
+    uint16_t tag = 0xFFFF;
+    int8_t ctr = 0;
+    uint8_t u = 0;
+  };
+
+  /// A global history of length 'length' folded (xor'ed) into 'width' bits,
+  /// updated incrementally as the history is shifted.
+  struct FoldedHistory {
+    unsigned length = 0;
+    unsigned width = 1;
+    unsigned value = 0;
+    void update(bool newest, bool oldest) {
+      value = (value << 1) | newest;
+      value ^= static_cast<unsigned>(oldest) << (length % width);
+      value ^= value >> width;
+      value &= (1u << width) - 1;
+    }
+  };
+
+  struct Table {
+    std::vector<Entry> entries;
+    FoldedHistory index, tag0, tag1;
+  };
+
+  /// Returns the outcome of the branch @p age conditional branches ago.
+  bool historyAt(unsigned age) const {
+    return m_history[(m_head + age) % m_history.size()];
+  }
+
+  void pushHistory(bool taken) {
+    m_head = (m_head + m_history.size() - 1) % m_history.size();
+    m_history[m_head] = taken;
+    for (auto &table : m_tables) {
+      const bool oldest = historyAt(table.index.length);
+      table.index.update(taken, oldest);
+      table.tag0.update(taken, oldest);
+      table.tag1.update(taken, oldest);
+    }
+  }
+
+  BimodalPredictor m_base;
+  unsigned m_log2Entries;
+  std::array<Table, s_tables> m_tables;
+  // Circular buffer of conditional branch outcomes; m_head is the newest.
+  std::vector<uint8_t> m_history;
+  unsigned m_head = 0;
+  uint64_t m_branches = 0;
+};
+
+std::unique_ptr<DirectionPredictor> createPredictor(const BPEvalConfig &cfg) {
+  switch (cfg.type) {
+  case BPEvalConfig::Type::Bimodal:
+    return std::make_unique<BimodalPredictor>(cfg.log2Entries);
+  case BPEvalConfig::Type::GShare:
+    return std::make_unique<GSharePredictor>(cfg.log2Entries, cfg.historyBits);
+  case BPEvalConfig::Type::Tournament:
+    return std::make_unique<TournamentPredictor>(cfg.log2Entries,
+                                                 cfg.historyBits);
+  case BPEvalConfig::Type::TAGE:
+    return std::make_unique<TAGELitePredictor>(cfg.log2Entries,
+                                               cfg.historyBits);
+  }
+  return nullptr;
+}
+
+struct BPEvalResult {
+  uint64_t storageBits = 0;
+  uint64_t mispredictions = 0;
+};
+
+const std::map<BPEvalConfig::Type, QString> s_typeNames = {
+    {BPEvalConfig::Type::Bimodal, "bimodal"},
+    {BPEvalConfig::Type::GShare, "gshare"},
+    {BPEvalConfig::Type::Tournament, "tournament"},
+    {BPEvalConfig::Type::TAGE, "tage"}};
+
+/// The default design space: each predictor type over a range of table sizes.
+std::vector<BPEvalConfig> defaultConfigs() {
+  std::vector<BPEvalConfig> configs;
+  for (const auto type :
+       {BPEvalConfig::Type::Bimodal, BPEvalConfig::Type::GShare,
+        BPEvalConfig::Type::Tournament}) {
+    for (unsigned log2Entries = 8; log2Entries <= 16; log2Entries += 2)
+      configs.push_back({type, log2Entries, log2Entries});
+  }
+  for (unsigned log2Entries = 7; log2Entries <= 11; ++log2Entries)
+    configs.push_back({BPEvalConfig::Type::TAGE, log2Entries, 64});
+  return configs;
+}
+
+} // namespace
+
+QString BPEvalConfig::name() const {
+  QString name = s_typeNames.at(type) + ":" + QString::number(log2Entries);
+  if (type != Type::Bimodal)
+    name += ":" + QString::number(historyBits);
+  return name;
+}
+
+bool BPEvalConfig::parse(const QString &spec, BPEvalConfig &config) {
+  const QStringList parts = spec.split(":");
+  if (parts.size() < 2 || parts.size() > 3)
+    return false;
+  auto it = std::find_if(s_typeNames.begin(), s_typeNames.end(),
+                         [&](const auto &t) { return t.second == parts[0]; });
+  if (it == s_typeNames.end())
+    return false;
+  config.type = it->first;
+
+  bool ok;
+  config.log2Entries = parts[1].toUInt(&ok);
+  if (!ok || config.log2Entries == 0 || config.log2Entries > 24)
+    return false;
+  // By default, the history spans the index of the tables (TAGE: 64).
+  config.historyBits =
+      config.type == Type::TAGE ? 64 : config.log2Entries;
+  if (parts.size() == 3) {
+    config.historyBits = parts[2].toUInt(&ok);
+    const unsigned maxHistory = config.type == Type::TAGE ? 1024 : 64;
+    if (!ok || config.historyBits > maxHistory)
+      return false;
+  }
+  return true;
+}
+
+bool parseBPEvalOptions(QCommandLineParser &parser, QString &errorMessage,
+                        BPEvalOptions &options) {
+  if (!parser.isSet("branch-trace")) {
+    errorMessage = "No branch trace specified (--branch-trace).";
+    return false;
+  }
+  options.traceFile = parser.value("branch-trace");
+
+  if (parser.isSet("bp-configs")) {
+    for (const auto &spec :
+         parser.value("bp-configs").split(",", Qt::SkipEmptyParts)) {
+      BPEvalConfig config;
+      if (!BPEvalConfig::parse(spec, config)) {
+        errorMessage = "Invalid predictor configuration '" + spec +
+                       "' specified (--bp-configs).";
+        return false;
+      }
+      options.configs.push_back(config);
+    }
+  } else {
+    options.configs = defaultConfigs();
+  }
+
+  if (parser.isSet("jobs")) {
+    bool ok;
+    options.jobs = parser.value("jobs").toUInt(&ok);
+    if (!ok) {
+      errorMessage = "Invalid number of jobs specified (--jobs).";
+      return false;
+    }
+  }
+
+  options.outputFile = parser.value("output");
+  options.jsonOutput = parser.isSet("json");
+  return true;
+}
+
+int runBPEval(const BPEvalOptions &options) {
+  BranchTrace trace;
+  const QString err = BranchTrace::read(options.traceFile, trace);
+  if (!err.isEmpty()) {
+    std::cerr << "ERROR: " << err.toStdString() << std::endl;
+    return 1;
+  }
+
+  // Direction predictors only observe conditional branches; extract these once
+  // and share them (read-only) between all workers.
+  std::vector<CondBranch> branches;
+  for (const auto &record : trace.records)
+    if (record.kind == BranchTrace::Kind::Branch)
+      branches.push_back({record.pc, record.taken});
+  trace.records.clear();
+  trace.records.shrink_to_fit();
+
+  std::vector<BPEvalResult> results(options.configs.size());
+  std::atomic<size_t> next = 0;
+  auto worker = [&] {
+    for (size_t i = next++; i < options.configs.size(); i = next++) {
+      auto predictor = createPredictor(options.configs[i]);
+      uint64_t mispredictions = 0;
+      for (const auto &branch : branches)
+        mispredictions += !predictor->access(branch.pc, branch.taken);
+      results[i] = {predictor->storageBits(), mispredictions};
+    }
+  };
+
+  unsigned jobs = options.jobs;
+  if (jobs == 0)
+    jobs = std::max(1u, std::thread::hardware_concurrency());
+  jobs = std::min<size_t>(jobs, options.configs.size());
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < jobs; ++i)
+    threads.emplace_back(worker);
+  for (auto &thread : threads)
+    thread.join();
+
+  // Open output stream
+  std::unique_ptr<QTextStream> stream;
+  std::unique_ptr<QFile> outputFile;
+  if (options.outputFile.isEmpty()) {
+    stream = std::make_unique<QTextStream>(stdout, QIODevice::WriteOnly);
+  } else {
+    outputFile = std::make_unique<QFile>(options.outputFile);
+    if (!outputFile->open(QIODevice::Truncate | QIODevice::Text |
+                          QIODevice::WriteOnly)) {
+      std::cerr << "ERROR: Failed to open output file" << std::endl;
+      return 1;
+    }
+    stream = std::make_unique<QTextStream>(outputFile.get());
+  }
+
+  auto mpki = [&](uint64_t mispredictions) {
+    return trace.instructions > 0 ? 1000.0 * mispredictions /
+                                        static_cast<double>(trace.instructions)
+                                  : 0.0;
+  };
+  auto accuracy = [&](uint64_t mispredictions) {
+    if (branches.empty())
+      return 100.0;
+    return 100.0 * (1.0 - static_cast<double>(mispredictions) /
+                              static_cast<double>(branches.size()));
+  };
+
+  if (options.jsonOutput) {
+    QJsonArray configs;
+    for (size_t i = 0; i < options.configs.size(); ++i) {
+      QJsonObject config;
+      config["predictor"] = options.configs[i].name();
+      config["storage bits"] = static_cast<qint64>(results[i].storageBits);
+      config["mispredictions"] = static_cast<qint64>(results[i].mispredictions);
+      config["accuracy"] = accuracy(results[i].mispredictions);
+      config["MPKI"] = mpki(results[i].mispredictions);
+      configs.append(config);
+    }
+    QJsonObject report;
+    report["instructions"] = static_cast<qint64>(trace.instructions);
+    report["conditional branches"] = static_cast<qint64>(branches.size());
+    report["configurations"] = configs;
+    *stream << QJsonDocument(report).toJson(QJsonDocument::Indented);
+  } else {
+    *stream << "Instructions:\t" << trace.instructions << "\n";
+    *stream << "Conditional branches:\t" << branches.size() << "\n\n";
+    *stream << "predictor\tstorage (KiB)\tmispredictions\taccuracy (%)\tMPKI\n";
+    for (size_t i = 0; i < options.configs.size(); ++i) {
+      *stream << options.configs[i].name() << "\t"
+              << QString::number(results[i].storageBits / 8192.0, 'f', 2)
+              << "\t" << results[i].mispredictions << "\t"
+              << QString::number(accuracy(results[i].mispredictions), 'f', 2)
+              << "\t"
+              << QString::number(mpki(results[i].mispredictions), 'f', 3)
+              << "\n";
+    }
+  }
+  return 0;
+}
+
+} // namespace Ripes
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QCommandLineParser>
+#include <QString>
+#include <vector>
+
+namespace Ripes {
+
+/**
+ * Offline branch predictor evaluation ("--mode bpeval"). A branch trace
+ * recorded through --branch-trace is replayed through a set of direction
+ * predictor configurations, each evaluated concurrently on a separate thread.
+ * For each configuration, the number of mispredicted conditional branches per
+ * thousand retired instructions (MPKI) is reported.
+ */
+struct BPEvalConfig {
+  enum class Type { Bimodal, GShare, Tournament, TAGE };
+  Type type = Type::Bimodal;
+  // log2 of the number of entries of each predictor table.
+  unsigned log2Entries = 12;
+  // Global history length. For TAGE, the longest history length of the tagged
+  // tables.
+  unsigned historyBits = 12;
+
+  QString name() const;
+  /// Parses a "type:log2entries[:history]" specification.
+  static bool parse(const QString &spec, BPEvalConfig &config);
+};
+
+struct BPEvalOptions {
+  QString traceFile;
+  std::vector<BPEvalConfig> configs;
+  unsigned jobs = 0;
+  QString outputFile;
+  bool jsonOutput = false;
+};
+
+/// Parses the bpeval mode options. Returns true if options were parsed
+/// successfully.
+bool parseBPEvalOptions(QCommandLineParser &parser, QString &errorMessage,
+                        BPEvalOptions &options);
+
+/// Runs the branch predictor evaluation. Returns the process exit code.
+int runBPEval(const BPEvalOptions &options);
+
+} // namespace Ripes
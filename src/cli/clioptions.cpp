@@ -41,11 +41,218 @@ void addCLIOptions(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
       "Simulation timeout in milliseconds. If simulation does not finish "
       "within the specified time, it will be aborted.",
       "ms", "0"));
+  parser.addOption(QCommandLineOption(
+      "no-dwarf", "Do not load the DWARF debug information of ELF files."));
   parser.addOption(QCommandLineOption("v", "Verbose output"));
   parser.addOption(QCommandLineOption(
       "output", "Report output file. If not set, report is printed to stdout.",
       "path"));
   parser.addOption(QCommandLineOption("json", "JSON-formatted report."));
+  parser.addOption(QCommandLineOption(
+      "flamegraph",
+      "Write the function level profile of the program to a file, in the "
+      "collapsed-stack format used by flame graph tools.",
+      "path"));
+
+  parser.addOption(QCommandLineOption(
+      "sample-interval",
+      "Append a record of execution statistics (IPC, cache hits/misses, "
+      "stalls, ...) to the sample stream every N cycles.",
+      "cycles", "0"));
+  parser.addOption(QCommandLineOption(
+      "sample-output",
+      "Sample stream output file. If not set, samples are printed to stdout.",
+      "path"));
+  parser.addOption(QCommandLineOption(
+      "sample-format", "Sample stream format. Options: [jsonl, csv]", "format",
+      "jsonl"));
+  parser.addOption(QCommandLineOption(
+      "icache",
+      "Simulate an L1 instruction cache. The cache geometry is specified as "
+      "the log2 of the number of lines, ways and words per line.",
+      "lines,ways,words"));
+  parser.addOption(QCommandLineOption(
+      "dcache",
+      "Simulate an L1 data cache. The cache geometry is specified as the log2 "
+      "of the number of lines, ways and words per line.",
+      "lines,ways,words"));
+
+  QStringList bpOptions;
+  for (const auto &it : BranchPredictorTypeNames)
+    bpOptions.push_back(it.second);
+  parser.addOption(QCommandLineOption(
+      "bp",
+      "Branch predictor of processors with dynamic branch prediction. "
+      "Options: [" +
+          bpOptions.join(", ") + "]",
+      "type"));
+  parser.addOption(QCommandLineOption(
+      "bp-pht",
+      "Number of pattern history table entries of the branch predictor.",
+      "entries"));
+  parser.addOption(QCommandLineOption(
+      "bp-history", "Number of global history bits of the branch predictor.",
+      "bits"));
+  parser.addOption(QCommandLineOption(
+      "bp-btb", "Number of branch target buffer entries.", "entries"));
+  parser.addOption(QCommandLineOption(
+      "bp-ras", "Number of return address stack entries.", "entries"));
+
+  parser.addOption(QCommandLineOption(
+      "branch-trace",
+      "Write the branch trace of the program to a file (cli mode). The branch "
+      "trace to evaluate (bpeval mode).",
+      "path"));
+  parser.addOption(QCommandLineOption(
+      "bp-configs",
+      "Comma-separated list of branch predictor configurations to evaluate "
+      "(bpeval mode), formatted as type:log2entries[:history]. Types: "
+      "[bimodal, gshare, tournament, tage]",
+      "configs"));
+  parser.addOption(QCommandLineOption(
+      "jobs",
+      "Number of threads to evaluate branch predictors with (bpeval mode), or "
+      "of worker processes to simulate intervals with (parallel mode). 0 uses "
+      "all available cores.",
+      "n", "0"));
+
+  parser.addOption(QCommandLineOption(
+      "simpoint-interval",
+      "Number of instructions per interval (simpoint mode).", "n", "100000"));
+  parser.addOption(QCommandLineOption(
+      "simpoint-warmup",
+      "Number of instructions simulated in detail before each simulation "
+      "point to warm up caches and branch predictors (simpoint mode). "
+      "Defaults to the interval length.",
+      "n"));
+  parser.addOption(QCommandLineOption(
+      "simpoint-maxk", "Maximum number of simulation points (simpoint mode).",
+      "n", "10"));
+  parser.addOption(QCommandLineOption(
+      "simpoint-validate",
+      "Additionally simulate the whole program in detail, and report the "
+      "error of the estimates (simpoint mode)."));
+
+  parser.addOption(QCommandLineOption(
+      "parallel-interval",
+      "Number of instructions simulated by each worker (parallel mode).", "n",
+      "10000000"));
+  parser.addOption(QCommandLineOption(
+      "parallel-warmup",
+      "Number of instructions simulated before each interval to warm up "
+      "caches, branch predictors and the pipeline (parallel mode).",
+      "n", "100000"));
+  parser.addOption(QCommandLineOption(
+      "checkpoint",
+      "Resume the program from an architectural checkpoint written in "
+      "parallel mode, measuring the resumed execution as a region of "
+      "interest.",
+      "path"));
+  parser.addOption(QCommandLineOption(
+      "checkpoint-warmup",
+      "Number of instructions simulated after resuming from a checkpoint, "
+      "before the region of interest begins.",
+      "n", "0"));
+  parser.addOption(QCommandLineOption(
+      "checkpoint-length",
+      "Number of instructions in the region of interest after resuming from a "
+      "checkpoint. 0 simulates until the program finishes.",
+      "n", "0"));
+
+  parser.addOption(QCommandLineOption(
+      "issue-width",
+      "Comma-separated list of issue widths of the N-wide in-order issue "
+      "model (issue report).",
+      "widths", "2,4,8"));
+  parser.addOption(QCommandLineOption(
+      "issue-alus", "Number of ALUs of the issue model. Defaults to the width.",
+      "n"));
+  parser.addOption(QCommandLineOption(
+      "issue-mem",
+      "Number of memory ports of the issue model. Defaults to width/2.", "n"));
+  parser.addOption(QCommandLineOption(
+      "issue-muldiv",
+      "Number of mul/div units of the issue model. Defaults to width/4.",
+      "n"));
+  parser.addOption(QCommandLineOption(
+      "issue-rf-read",
+      "Number of register file read ports of the issue model. Defaults to "
+      "2*width.",
+      "n"));
+  parser.addOption(QCommandLineOption(
+      "issue-rf-write",
+      "Number of register file write ports of the issue model. Defaults to "
+      "the width.",
+      "n"));
+
+  parser.addOption(QCommandLineOption(
+      "ooo-width",
+      "Instructions dispatched, issued and committed per cycle by the "
+      "out-of-order processors.",
+      "n"));
+  parser.addOption(QCommandLineOption(
+      "ooo-rob", "Number of reorder buffer entries.", "entries"));
+  parser.addOption(QCommandLineOption(
+      "ooo-rs", "Number of reservation station entries.", "entries"));
+  parser.addOption(QCommandLineOption(
+      "ooo-lsq", "Number of load/store queue entries.", "entries"));
+  parser.addOption(QCommandLineOption(
+      "ooo-load-latency",
+      "Cycles from issuing a load until its result may be used.", "cycles"));
+
+  parser.addOption(QCommandLineOption(
+      "mul-latency",
+      "Cycles from a multiply instruction executing until its result may be "
+      "used, for the processors with hazard detection.",
+      "cycles"));
+  parser.addOption(QCommandLineOption(
+      "div-latency",
+      "Cycles from a divide or remainder instruction executing until its "
+      "result may be used, for the processors with hazard detection.",
+      "cycles"));
+  parser.addOption(QCommandLineOption(
+      "mul-iterative",
+      "Model a non-pipelined multiplier, which accepts a new operation once "
+      "the previous result is ready."));
+  parser.addOption(QCommandLineOption(
+      "div-pipelined",
+      "Model a pipelined divider, which accepts a new operation every "
+      "cycle."));
+  parser.addOption(QCommandLineOption(
+      "hpm-events",
+      "Count stalled and flushed cycles in the hpmcounter CSRs. Counting "
+      "slows down simulation; otherwise, the counters read as zero."));
+
+  parser.addOption(QCommandLineOption(
+      "pipeline",
+      "Comma-separated microarchitecture of the parametric 5-stage processors "
+      "(RV32_5S_PARAM, RV64_5S_PARAM): the stage in which branches are solved "
+      "[id, ex, mem], and any of [nofw (no forwarding), nohz (no hazard "
+      "detection), db (delayed branches), bp (dynamic branch prediction)]. "
+      "E.g. \"mem,db\".",
+      "config"));
+
+  parser.addOption(QCommandLineOption(
+      "vcd", "Write a VCD trace of the processor signals to a file.", "path"));
+  parser.addOption(QCommandLineOption(
+      "vcd-signals",
+      "Comma-separated wildcard patterns of the hierarchical names of the "
+      "signals to trace (e.g. \"*.alu.*,*.pc_reg.*\").",
+      "patterns", "*"));
+  parser.addOption(QCommandLineOption(
+      "vcd-start", "First cycle to include in the VCD trace.", "cycle", "0"));
+  parser.addOption(QCommandLineOption(
+      "vcd-stop",
+      "Last cycle to include in the VCD trace. -1 traces until the end of "
+      "simulation.",
+      "cycle", "-1"));
+  parser.addOption(
+      QCommandLineOption("vcd-gzip", "Write a gzip-compressed VCD trace."));
+
+  parser.addOption(QCommandLineOption(
+      "roi-only",
+      "Skip detailed modelling (cache simulation, profiling, sampling and "
+      "tracing) outside of the regions of interest marked by the program."));
 
   parser.addOption(QCommandLineOption("all", "Enable all report options."));
 
@@ -57,6 +264,19 @@ void addCLIOptions(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
   options.telemetry.push_back(std::make_shared<PipelineTelemetry>());
   options.telemetry.push_back(std::make_shared<RegisterTelemetry>());
   options.telemetry.push_back(std::make_shared<RunInfoTelemetry>(&parser));
+  options.telemetry.push_back(std::make_shared<SelfProfTelemetry>());
+  options.telemetry.push_back(std::make_shared<ROITelemetry>());
+  options.telemetry.push_back(std::make_shared<BranchTelemetry>());
+  options.telemetry.push_back(std::make_shared<MulDivTelemetry>());
+  auto profiler = std::make_shared<ExecutionProfiler>();
+  options.telemetry.push_back(std::make_shared<ProfileTelemetry>(profiler));
+  options.telemetry.push_back(std::make_shared<IMixTelemetry>(profiler));
+  options.functionProfiler = std::make_shared<FunctionProfiler>();
+  options.telemetry.push_back(
+      std::make_shared<CallGraphTelemetry>(options.functionProfiler));
+  options.issueModel = std::make_shared<IssueModel>();
+  options.telemetry.push_back(
+      std::make_shared<IssueTelemetry>(options.issueModel));
 
   for (auto &telemetry : options.telemetry) {
     QString desc = "Report " + telemetry->description();
@@ -65,9 +285,237 @@ void addCLIOptions(QCommandLineParser &parser, Ripes::CLIModeOptions &options) {
   }
 }
 
+/// Parses a "lines,ways,words" cache geometry specification.
+static bool parseCacheOption(QCommandLineParser &parser, const QString &name,
+                             QString &errorMessage,
+                             std::optional<CachePreset> &preset) {
+  if (!parser.isSet(name))
+    return true;
+
+  const QStringList parts = parser.value(name).split(",");
+  std::vector<int> values;
+  for (const auto &part : parts) {
+    bool ok;
+    const int v = part.toInt(&ok);
+    if (!ok || v < 0) {
+      values.clear();
+      break;
+    }
+    values.push_back(v);
+  }
+  if (values.size() != 3) {
+    errorMessage = "Invalid cache configuration '" + parser.value(name) +
+                   "' specified (--" + name + ").";
+    return false;
+  }
+
+  preset = CachePreset{name,
+                       /*blocks=*/values[2],
+                       /*lines=*/values[0],
+                       /*ways=*/values[1],
+                       WritePolicy::WriteBack,
+                       WriteAllocPolicy::WriteAllocate,
+                       ReplPolicy::LRU};
+  return true;
+}
+
+/// Parses the branch predictor options. Options which are not set retain the
+/// defaults of BranchPredictorConfig.
+static bool parseBranchPredictorOptions(
+    QCommandLineParser &parser, QString &errorMessage,
+    std::optional<BranchPredictorConfig> &config) {
+  const QStringList sizeOptions = {"bp-pht", "bp-history", "bp-btb", "bp-ras"};
+  if (!parser.isSet("bp") &&
+      llvm::none_of(sizeOptions, [&](auto &o) { return parser.isSet(o); }))
+    return true;
+
+  BranchPredictorConfig cfg;
+  if (parser.isSet("bp")) {
+    auto it = llvm::find_if(BranchPredictorTypeNames, [&](const auto &t) {
+      return t.second == parser.value("bp");
+    });
+    if (it == BranchPredictorTypeNames.end()) {
+      errorMessage =
+          "Invalid branch predictor '" + parser.value("bp") + "' (--bp).";
+      return false;
+    }
+    cfg.type = it->first;
+  }
+
+  std::vector<std::pair<QString, unsigned *>> sizes = {
+      {"bp-pht", &cfg.phtEntries},
+      {"bp-history", &cfg.historyBits},
+      {"bp-btb", &cfg.btbEntries},
+      {"bp-ras", &cfg.rasEntries}};
+  for (auto &[name, value] : sizes) {
+    if (!parser.isSet(name))
+      continue;
+    bool ok;
+    *value = parser.value(name).toUInt(&ok);
+    if (!ok) {
+      errorMessage = "Invalid value '" + parser.value(name) +
+                     "' specified (--" + name + ").";
+      return false;
+    }
+  }
+  config = cfg;
+  return true;
+}
+
+/// Parses the issue model options into one configuration per issue width.
+static bool parseIssueOptions(QCommandLineParser &parser, QString &errorMessage,
+                              IssueModel &model) {
+  std::vector<IssueModel::Config> configs;
+  for (const auto &w : parser.value("issue-width").split(",")) {
+    bool ok;
+    const unsigned width = w.toUInt(&ok);
+    if (!ok || width == 0) {
+      errorMessage =
+          "Invalid issue width '" + w + "' specified (--issue-width).";
+      return false;
+    }
+    configs.push_back(IssueModel::Config::forWidth(width));
+  }
+
+  const std::vector<std::pair<QString, unsigned IssueModel::Config::*>>
+      resources = {{"issue-alus", &IssueModel::Config::alus},
+                   {"issue-mem", &IssueModel::Config::memPorts},
+                   {"issue-muldiv", &IssueModel::Config::mulDivUnits},
+                   {"issue-rf-read", &IssueModel::Config::rfReadPorts},
+                   {"issue-rf-write", &IssueModel::Config::rfWritePorts}};
+  for (const auto &[name, field] : resources) {
+    if (!parser.isSet(name))
+      continue;
+    bool ok;
+    const unsigned value = parser.value(name).toUInt(&ok);
+    if (!ok || value == 0) {
+      errorMessage = "Invalid value '" + parser.value(name) +
+                     "' specified (--" + name + ").";
+      return false;
+    }
+    for (auto &cfg : configs)
+      cfg.*field = value;
+  }
+  model.setConfigs(configs);
+  return true;
+}
+
+/// Parses the out-of-order processor options. Options which are not set retain
+/// the defaults of OoOConfig.
+static bool parseOoOOptions(QCommandLineParser &parser, QString &errorMessage,
+                            std::optional<OoOConfig> &config) {
+  OoOConfig cfg;
+  const std::vector<std::pair<QString, unsigned *>> values = {
+      {"ooo-width", &cfg.width},
+      {"ooo-rob", &cfg.robEntries},
+      {"ooo-rs", &cfg.rsEntries},
+      {"ooo-lsq", &cfg.lsqEntries},
+      {"ooo-load-latency", &cfg.loadLatency}};
+  bool anySet = false;
+  for (const auto &[name, value] : values) {
+    if (!parser.isSet(name))
+      continue;
+    bool ok;
+    *value = parser.value(name).toUInt(&ok);
+    if (!ok || *value == 0) {
+      errorMessage = "Invalid value '" + parser.value(name) +
+                     "' specified (--" + name + ").";
+      return false;
+    }
+    anySet = true;
+  }
+  if (cfg.width > OoOConfig::s_maxWidth) {
+    errorMessage = "Out-of-order width must be at most " +
+                   QString::number(OoOConfig::s_maxWidth) + " (--ooo-width).";
+    return false;
+  }
+  if (anySet)
+    config = cfg;
+  return true;
+}
+
+/// Parses the functional unit latency options. Options which are not set
+/// retain the defaults of FULatencies.
+static bool parseFULatencyOptions(QCommandLineParser &parser,
+                                  QString &errorMessage,
+                                  std::optional<FULatencies> &latencies) {
+  FULatencies fu;
+  bool anySet = false;
+  for (const auto &[name, unit] :
+       std::vector<std::pair<QString, FULatencies::Unit *>>{
+           {"mul-latency", &fu.mul}, {"div-latency", &fu.div}}) {
+    if (!parser.isSet(name))
+      continue;
+    bool ok;
+    unit->latency = parser.value(name).toUInt(&ok);
+    if (!ok || unit->latency == 0 ||
+        unit->latency > FULatencies::s_maxLatency) {
+      errorMessage = "Invalid latency '" + parser.value(name) +
+                     "' specified (--" + name + "). Must be in [1, " +
+                     QString::number(FULatencies::s_maxLatency) + "].";
+      return false;
+    }
+    anySet = true;
+  }
+  if (parser.isSet("mul-iterative")) {
+    fu.mul.pipelined = false;
+    anySet = true;
+  }
+  if (parser.isSet("div-pipelined")) {
+    fu.div.pipelined = true;
+    anySet = true;
+  }
+  if (anySet)
+    latencies = fu;
+  return true;
+}
+
+/// Parses the parametric pipeline option. Parameters which are not listed
+/// retain the defaults of PipelineConfig.
+static bool parsePipelineOption(QCommandLineParser &parser,
+                                QString &errorMessage,
+                                std::optional<PipelineConfig> &config) {
+  if (!parser.isSet("pipeline"))
+    return true;
+
+  PipelineConfig cfg;
+  for (const QString &param :
+       parser.value("pipeline").split(",", Qt::SkipEmptyParts)) {
+    const QString p = param.trimmed().toLower();
+    auto stage = llvm::find_if(BranchStageNames, [&](const auto &it) {
+      return it.second.toLower() == p;
+    });
+    if (stage != BranchStageNames.end())
+      cfg.branchStage = stage->first;
+    else if (p == "nofw")
+      cfg.forwarding = false;
+    else if (p == "nohz")
+      cfg.hazardDetection = false;
+    else if (p == "db")
+      cfg.delayedBranch = true;
+    else if (p == "bp")
+      cfg.prediction = true;
+    else {
+      errorMessage = "Invalid pipeline parameter '" + param +
+                     "' specified (--pipeline).";
+      return false;
+    }
+  }
+  if (cfg.prediction && (cfg.delayedBranch ||
+                         cfg.branchStage != PipelineConfig::BranchStage::ID)) {
+    errorMessage = "Dynamic branch prediction requires branches to be solved "
+                   "in ID without delay slots (--pipeline).";
+    return false;
+  }
+  config = cfg;
+  return true;
+}
+
 bool parseCLIOptions(QCommandLineParser &parser, QString &errorMessage,
                      CLIModeOptions &options) {
   options.verbose = parser.isSet("v");
+  options.loadDebugInfo = !parser.isSet("no-dwarf");
+  options.hpmEvents = parser.isSet("hpm-events");
 
   if (!parser.isSet("src")) {
     errorMessage = "No source file specified (--src)";
@@ -139,6 +587,80 @@ bool parseCLIOptions(QCommandLineParser &parser, QString &errorMessage,
   }
 
   options.outputFile = parser.value("output");
+  if (parser.isSet("sample-interval")) {
+    bool ok;
+    options.sampleInterval = parser.value("sample-interval").toUInt(&ok);
+    if (!ok) {
+      errorMessage = "Invalid sample interval specified (--sample-interval).";
+      return false;
+    }
+  }
+  options.sampleOutputFile = parser.value("sample-output");
+  if (parser.value("sample-format") == "jsonl") {
+    options.sampleFormat = TimeSeriesSampler::Format::JSONLines;
+  } else if (parser.value("sample-format") == "csv") {
+    options.sampleFormat = TimeSeriesSampler::Format::CSV;
+  } else {
+    errorMessage = "Invalid sample format (--sample-format)";
+    return false;
+  }
+
+  if (!parseCacheOption(parser, "icache", errorMessage, options.icache) ||
+      !parseCacheOption(parser, "dcache", errorMessage, options.dcache))
+    return false;
+
+  if (!parseBranchPredictorOptions(parser, errorMessage, options.bp))
+    return false;
+
+  if (!parseOoOOptions(parser, errorMessage, options.ooo))
+    return false;
+
+  if (!parseFULatencyOptions(parser, errorMessage, options.fuLatencies))
+    return false;
+
+  if (!parsePipelineOption(parser, errorMessage, options.pipeline))
+    return false;
+
+  if (parser.isSet("vcd")) {
+    VCDTracer::Config vcd;
+    vcd.file = parser.value("vcd");
+    vcd.signalPatterns =
+        parser.value("vcd-signals").split(",", Qt::SkipEmptyParts);
+    bool startOk, stopOk;
+    vcd.startCycle = parser.value("vcd-start").toLongLong(&startOk);
+    vcd.stopCycle = parser.value("vcd-stop").toLongLong(&stopOk);
+    if (!startOk || !stopOk || vcd.startCycle < 0) {
+      errorMessage = "Invalid VCD trace window (--vcd-start, --vcd-stop).";
+      return false;
+    }
+    vcd.compress = parser.isSet("vcd-gzip");
+    options.vcd = vcd;
+  }
+
+  options.branchTraceFile = parser.value("branch-trace");
+
+  options.checkpointFile = parser.value("checkpoint");
+  if (!options.checkpointFile.isEmpty()) {
+    bool warmupOk, lengthOk;
+    options.checkpointWarmup =
+        parser.value("checkpoint-warmup").toULongLong(&warmupOk);
+    options.checkpointLength =
+        parser.value("checkpoint-length").toULongLong(&lengthOk);
+    if (!warmupOk || !lengthOk) {
+      errorMessage = "Invalid checkpoint interval (--checkpoint-warmup, "
+                     "--checkpoint-length).";
+      return false;
+    }
+  }
+
+  if (!parseIssueOptions(parser, errorMessage, *options.issueModel))
+    return false;
+
+  RegionOfInterest::setROIOnly(parser.isSet("roi-only"));
+
+  options.flamegraphFile = parser.value("flamegraph");
+  if (!options.flamegraphFile.isEmpty())
+    options.functionProfiler->setEnabled(true);
 
   // Validate register initializations
   if (parser.isSet("reginit")) {
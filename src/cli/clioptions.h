@@ -1,9 +1,17 @@
 #pragma once
 
 #include "assembler/program.h"
+#include "cachesim/cachesim.h"
 #include "processorregistry.h"
+#include "processors/interface/branchpredictor.h"
+#include "processors/interface/fulatencies.h"
+#include "processors/interface/oooconfig.h"
+#include "processors/interface/pipelineconfig.h"
 #include "telemetry.h"
+#include "timeseriessampler.h"
+#include "vcdtracer.h"
 #include <QCommandLineParser>
+#include <optional>
 #include <set>
 
 namespace Ripes {
@@ -18,6 +26,60 @@ struct CLIModeOptions {
   bool jsonOutput = false;
   int timeout = 0;
   RegisterInitialization regInit;
+  // Whether to load the DWARF information (source line mapping) of ELF files.
+  bool loadDebugInfo = true;
+  // Path to write a collapsed-stack function profile to, if set.
+  QString flamegraphFile = "";
+
+  // Cycle interval of time-series samples. 0 disables sampling.
+  unsigned sampleInterval = 0;
+  QString sampleOutputFile = "";
+  TimeSeriesSampler::Format sampleFormat =
+      TimeSeriesSampler::Format::JSONLines;
+
+  // L1 cache configurations, if caches are to be simulated.
+  std::optional<CachePreset> icache;
+  std::optional<CachePreset> dcache;
+
+  // Branch predictor configuration, if the settings defaults are to be
+  // overridden.
+  std::optional<BranchPredictorConfig> bp;
+
+  // Out-of-order processor configuration, if the settings defaults are to be
+  // overridden.
+  std::optional<OoOConfig> ooo;
+
+  // Multiply/divide unit latencies, if the settings defaults are to be
+  // overridden.
+  std::optional<FULatencies> fuLatencies;
+  // Whether to count pipeline stall and flush events in the hpmcounter CSRs.
+  bool hpmEvents = false;
+
+  // Microarchitecture of the parametric pipelines, if the settings defaults
+  // are to be overridden.
+  std::optional<PipelineConfig> pipeline;
+
+  // Path to write the branch trace of the program to, if set.
+  QString branchTraceFile = "";
+
+  // Architectural checkpoint to resume the program from, if set. The first
+  // checkpointWarmup instructions after the checkpoint only warm up caches and
+  // branch predictors; the following checkpointLength instructions (0: until
+  // the program finishes) are measured as a region of interest.
+  QString checkpointFile = "";
+  uint64_t checkpointWarmup = 0;
+  uint64_t checkpointLength = 0;
+
+  // Trace-driven issue model shared between the issue telemetry and the
+  // --issue-* options.
+  std::shared_ptr<IssueModel> issueModel;
+
+  // VCD trace configuration, if a VCD trace is to be written.
+  std::optional<VCDTracer::Config> vcd;
+
+  // Function profiler shared between call graph telemetry and flame graph
+  // output.
+  std::shared_ptr<FunctionProfiler> functionProfiler;
 
   // A list of enabled telemetry options.
   std::vector<std::shared_ptr<Telemetry>> telemetry;
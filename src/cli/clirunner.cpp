@@ -1,14 +1,20 @@
 #include "clirunner.h"
+#include "archcheckpoint.h"
 #include "ccmanager.h"
 #include "io/iomanager.h"
 #include "loaddialog.h"
+#include "perfcounters.h"
 #include "processorhandler.h"
+#include "processors/ripesvsrtlprocessor.h"
 #include "programutilities.h"
+#include "regionofinterest.h"
 #include "syscall/systemio.h"
 
 #include <QJsonDocument>
 #include <QJsonObject>
 
+#include <limits>
+
 namespace Ripes {
 
 /**
@@ -50,8 +56,21 @@ static QString qVariantToString(QVariant &v) {
 CLIRunner::CLIRunner(const CLIModeOptions &options)
     : QObject(), m_options(options) {
   info("Ripes CLI mode", false, true);
+  // The datapath of parametric processors is configured upon construction.
+  if (m_options.pipeline)
+    ProcessorHandler::setPipelineConfig(*m_options.pipeline);
   ProcessorHandler::selectProcessor(m_options.proc, m_options.isaExtensions,
                                     m_options.regInit);
+  createCaches();
+  if (m_options.bp)
+    ProcessorHandler::setBranchPredictorConfig(*m_options.bp);
+  if (m_options.ooo)
+    ProcessorHandler::setOoOConfig(*m_options.ooo);
+  if (m_options.fuLatencies)
+    ProcessorHandler::setFULatencies(*m_options.fuLatencies);
+  if (m_options.vcd)
+    ProcessorHandler::setVCDTrace(m_options.vcd);
+  PerformanceCounters::setEnabled(m_options.hpmEvents);
 
   // Connect systemIO output to stdout.
   connect(&SystemIO::get(), &SystemIO::doPrint, this, [&](auto text) {
@@ -75,7 +94,7 @@ int CLIRunner::run() {
   if (processInput())
     return 1;
 
-  if (runModel())
+  if (m_options.checkpointFile.isEmpty() ? runModel() : runFromCheckpoint())
     return 1;
 
   if (postRun())
@@ -142,7 +161,7 @@ int CLIRunner::processInput() {
       error(info.errorMessage);
       return 1;
     }
-    if (!loadElfFile(p, file)) {
+    if (!loadElfFile(p, file, m_options.loadDebugInfo)) {
       error("Error while loading ELF file: '" + m_options.src + "'");
       return 1;
     }
@@ -224,6 +243,9 @@ int CLIRunner::runModel() {
   if (m_options.verbose)
     infoTimer.start(1000);
 
+  if (createSampler() || createBranchTraceRecorder())
+    return 1;
+
   // Start simulation
   ProcessorHandler::run();
   if (m_options.timeout != 0)
@@ -235,6 +257,12 @@ int CLIRunner::runModel() {
 
   timeoutTimer.stop();
   infoTimer.stop();
+  if (m_sampler)
+    m_sampler->flush();
+  // Finalize the VCD and branch traces.
+  if (m_options.vcd)
+    ProcessorHandler::setVCDTrace(std::nullopt);
+  m_branchTrace.reset();
   if (hadTimeout) {
     ProcessorHandler::stopRun();
     error("Simulation did not finish within the specified timeout (" +
@@ -245,6 +273,158 @@ int CLIRunner::runModel() {
   return 0;
 }
 
+/**
+ * Restores the architectural checkpoint given in the CLI options onto the
+ * freshly loaded program, and simulates the warmup instructions followed by
+ * the measured interval. Branch prediction and functional unit stalls are
+ * reported alongside the region of interest statistics, such that intervals
+ * simulated separately may be combined into whole-program totals.
+ *
+ * @return 0 on success, or 1 if the checkpoint could not be restored.
+ */
+int CLIRunner::runFromCheckpoint() {
+  info("Running model from checkpoint", false, true);
+
+  ArchCheckpoint checkpoint;
+  const QString err =
+      ArchCheckpoint::read(m_options.checkpointFile, checkpoint);
+  if (!err.isEmpty()) {
+    error(err);
+    return 1;
+  }
+  checkpoint.restore();
+  info("Resuming after " + QString::number(checkpoint.instructions) +
+       " instructions");
+
+  RegionOfInterest::addCounter("branch_mispredictions", [] {
+    const auto *bp = ProcessorHandler::getProcessor()->branchPredictor();
+    return bp ? bp->stats().mispredictions() : 0;
+  });
+  RegionOfInterest::addCounter("branch_penalty_cycles", [] {
+    const auto *bp = ProcessorHandler::getProcessor()->branchPredictor();
+    return bp ? bp->stats().penaltyCycles : 0;
+  });
+  RegionOfInterest::addCounter("fu_latency_stalls", [] {
+    const auto *fu = ProcessorHandler::getProcessor()->functionalUnitStats();
+    return fu ? fu->latencyStalls : 0;
+  });
+  RegionOfInterest::addCounter("fu_structural_stalls", [] {
+    const auto *fu = ProcessorHandler::getProcessor()->functionalUnitStats();
+    return fu ? fu->structuralStalls : 0;
+  });
+
+  runUntilRetired(m_options.checkpointWarmup);
+  RegionOfInterest::begin();
+  runUntilRetired(m_options.checkpointLength == 0
+                      ? std::numeric_limits<uint64_t>::max()
+                      : m_options.checkpointWarmup +
+                            m_options.checkpointLength);
+  RegionOfInterest::end();
+  return 0;
+}
+
+void CLIRunner::runUntilRetired(uint64_t instructions) {
+  auto *proc = ProcessorHandler::getProcessorNonConst();
+  auto *design = dynamic_cast<vsrtl::SimDesign *>(proc);
+  if (design)
+    design->setEnableSignals(false);
+  while (!proc->finished() &&
+         static_cast<uint64_t>(proc->getInstructionsRetired()) < instructions)
+    proc->clock();
+  if (design)
+    design->setEnableSignals(true);
+}
+
+void CLIRunner::reselectProcessor(ProcessorID id) {
+  const auto program = ProcessorHandler::getProgram();
+  ProcessorHandler::selectProcessor(id, m_options.isaExtensions,
+                                    m_options.regInit);
+  // The program is dropped if the ISAs of the processors differ.
+  if (program && !ProcessorHandler::getProgram())
+    ProcessorHandler::loadProgram(std::make_shared<Program>(*program));
+}
+
+ProcessorID CLIRunner::functionalProcessor() const {
+  return ProcessorHandler::currentISA()->bits() == 64 ? ProcessorID::RV64_SS
+                                                      : ProcessorID::RV32_SS;
+}
+
+/**
+ * Instantiates the L1 instruction and data caches requested through the CLI
+ * options. Each cache is attached to the processor through an L1CacheShim.
+ */
+void CLIRunner::createCaches() {
+  auto addCache = [&](const QString &name, L1CacheShim::CacheType type,
+                      const CachePreset &preset) {
+    auto cache = std::make_shared<CacheSim>(nullptr);
+    cache->setPreset(preset);
+    auto shim = std::make_unique<L1CacheShim>(type, nullptr);
+    shim->setNextLevelCache(cache);
+    m_cacheShims.push_back(std::move(shim));
+    m_caches.push_back({name, cache});
+    RegionOfInterest::addCounter(name + "_hits",
+                                 [cache] { return cache->getHits(); });
+    RegionOfInterest::addCounter(name + "_misses",
+                                 [cache] { return cache->getMisses(); });
+    PerformanceCounters::setEventSource(
+        type == L1CacheShim::CacheType::InstrCache
+            ? PerformanceCounters::ICacheMisses
+            : PerformanceCounters::DCacheMisses,
+        [cache] { return cache->getMisses(); });
+  };
+
+  if (m_options.icache)
+    addCache("l1i", L1CacheShim::CacheType::InstrCache, *m_options.icache);
+  if (m_options.dcache)
+    addCache("l1d", L1CacheShim::CacheType::DataCache, *m_options.dcache);
+}
+
+/**
+ * Creates the time-series sampler and opens its output stream, if a sample
+ * interval was specified.
+ *
+ * @return 0 on success, or 1 if the sample output file could not be opened.
+ */
+int CLIRunner::createSampler() {
+  if (m_options.sampleInterval == 0)
+    return 0;
+
+  if (m_options.sampleOutputFile.isEmpty()) {
+    m_sampleFile = std::make_unique<QFile>();
+    m_sampleFile->open(stdout, QIODevice::WriteOnly);
+  } else {
+    m_sampleFile = std::make_unique<QFile>(m_options.sampleOutputFile);
+    if (!m_sampleFile->open(QIODevice::Truncate | QIODevice::Text |
+                            QIODevice::WriteOnly)) {
+      error("Failed to open sample output file");
+      return 1;
+    }
+  }
+  m_sampler = std::make_unique<TimeSeriesSampler>(
+      m_options.sampleInterval, m_options.sampleFormat, m_sampleFile.get(),
+      m_caches);
+  return 0;
+}
+
+/**
+ * Creates the branch trace recorder, if a branch trace file was specified.
+ *
+ * @return 0 on success, or 1 if the branch trace file could not be opened.
+ */
+int CLIRunner::createBranchTraceRecorder() {
+  if (m_options.branchTraceFile.isEmpty())
+    return 0;
+
+  m_branchTrace = std::make_unique<BranchTraceRecorder>(
+      m_options.branchTraceFile);
+  m_branchTrace->setEnabled(true);
+  if (!m_branchTrace->isOpen()) {
+    error("Failed to open branch trace file");
+    return 1;
+  }
+  return 0;
+}
+
 /**
  * Handles post-execution tasks.
  * Open output file (if specified) or defaults to stdout and prints telemetry
@@ -293,6 +473,17 @@ int CLIRunner::postRun() {
   if (!m_options.outputFile.isEmpty())
     outputFile->close();
 
+  if (!m_options.flamegraphFile.isEmpty()) {
+    QFile flamegraphFile(m_options.flamegraphFile);
+    if (!flamegraphFile.open(QIODevice::Truncate | QIODevice::Text |
+                             QIODevice::WriteOnly)) {
+      error("Failed to open flame graph output file");
+      return 1;
+    }
+    QTextStream(&flamegraphFile)
+        << m_options.functionProfiler->collapsedStacks();
+  }
+
   return 0;
 }
 
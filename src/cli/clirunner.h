@@ -1,6 +1,9 @@
 #pragma once
 
+#include "branchtrace.h"
+#include "cachesim/l1cacheshim.h"
 #include "clioptions.h"
+#include <QFile>
 #include <QObject>
 
 namespace Ripes {
@@ -17,20 +20,54 @@ public:
   /// Runs the CLI mode.
   int run();
 
-private:
+protected:
   /// Process the provided source file (assembling, compiling, loading, ...)
   int processInput();
 
+  void info(QString msg, bool alwaysPrint = false, bool header = false,
+            const QString &prefix = "INFO");
+  void error(const QString &msg);
+
+  /// Clocks the current processor until it has retired @p instructions
+  /// instructions in total, or has finished.
+  static void runUntilRetired(uint64_t instructions);
+
+  /// Selects processor @p id with the configured ISA extensions and register
+  /// initialization. The loaded program is retained if the ISA changes.
+  void reselectProcessor(ProcessorID id);
+
+  /// The single-cycle processor implementing the ISA of the current
+  /// processor, used for fast functional execution.
+  ProcessorID functionalProcessor() const;
+
+  CLIModeOptions m_options;
+
+  std::vector<TimeSeriesSampler::SampledCache> m_caches;
+  std::vector<std::unique_ptr<L1CacheShim>> m_cacheShims;
+
+private:
   /// Runs the processor model until the program is finished.
   int runModel();
 
+  /// Resumes the program from the checkpoint given in the CLI options, and
+  /// measures the interval following its warmup as a region of interest.
+  int runFromCheckpoint();
+
   /// Prints requested telemetry to the console/output file.
   int postRun();
-  void info(QString msg, bool alwaysPrint = false, bool header = false,
-            const QString &prefix = "INFO");
-  void error(const QString &msg);
 
-  CLIModeOptions m_options;
+  /// Instantiates the L1 caches requested through the CLI options.
+  void createCaches();
+
+  /// Creates the time-series sampler, if sampling was requested.
+  int createSampler();
+
+  /// Creates the branch trace recorder, if a branch trace was requested.
+  int createBranchTraceRecorder();
+
+  std::unique_ptr<QFile> m_sampleFile;
+  std::unique_ptr<TimeSeriesSampler> m_sampler;
+  std::unique_ptr<BranchTraceRecorder> m_branchTrace;
 };
 
 } // namespace Ripes
@@ -0,0 +1,325 @@
+#include "parallelrunner.h"
+#include "archcheckpoint.h"
+#include "processorhandler.h"
+#include "syscall/systemio.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <algorithm>
+#include <thread>
+
+namespace Ripes {
+
+// Options of the coordinating process, which are not passed on to the workers.
+static const QStringList s_coordinatorOptions = {
+    "mode",    "v",          "output",     "json", "all",         "jobs",
+    "timeout", "flamegraph", "bp-configs", "vcd",  "branch-trace"};
+static const QStringList s_coordinatorPrefixes = {
+    "parallel-", "checkpoint", "simpoint-", "sample-", "vcd-"};
+
+bool parseParallelOptions(QCommandLineParser &parser, QString &errorMessage,
+                          const CLIModeOptions &cliOptions,
+                          ParallelOptions &options) {
+  bool intervalOk, warmupOk;
+  options.intervalLength =
+      parser.value("parallel-interval").toULongLong(&intervalOk);
+  options.warmup = parser.value("parallel-warmup").toULongLong(&warmupOk);
+  if (!intervalOk || options.intervalLength == 0 || !warmupOk) {
+    errorMessage =
+        "Invalid interval specified (--parallel-interval, --parallel-warmup).";
+    return false;
+  }
+  if (parser.isSet("jobs")) {
+    bool ok;
+    options.jobs = parser.value("jobs").toUInt(&ok);
+    if (!ok) {
+      errorMessage = "Invalid number of jobs specified (--jobs).";
+      return false;
+    }
+  }
+
+  // Workers report through the region of interest telemetry; any other
+  // telemetry is not reported in parallel mode.
+  QStringList excluded = s_coordinatorOptions;
+  for (const auto &telemetry : cliOptions.telemetry)
+    excluded << telemetry->key();
+  for (const auto &name : parser.optionNames()) {
+    if (excluded.contains(name) ||
+        std::any_of(s_coordinatorPrefixes.begin(), s_coordinatorPrefixes.end(),
+                    [&](const QString &prefix) {
+                      return name.startsWith(prefix);
+                    }))
+      continue;
+    const QString flag = (name.size() == 1 ? "-" : "--") + name;
+    const QStringList values = parser.values(name);
+    if (values.isEmpty())
+      options.workerArguments << flag;
+    for (const auto &value : values)
+      options.workerArguments << flag << value;
+  }
+  return true;
+}
+
+ParallelRunner::ParallelRunner(const CLIModeOptions &options,
+                               const ParallelOptions &pOptions)
+    : CLIRunner(options), m_pOptions(pOptions) {
+  // Caches are only simulated by the workers.
+  m_cacheShims.clear();
+
+  m_jobs = m_pOptions.jobs;
+  if (m_jobs == 0)
+    m_jobs = std::max(1u, std::thread::hardware_concurrency());
+}
+
+int ParallelRunner::run() {
+  if (processInput())
+    return 1;
+
+  QTemporaryDir dir;
+  if (!dir.isValid()) {
+    error("Failed to create a temporary directory for checkpoints");
+    return 1;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  if (takeCheckpoints(dir.path()))
+    return 1;
+  m_checkpointTime = timer.elapsed();
+
+  // Program output is only printed by the functional pass. The output is
+  // buffered and delivered through the event loop; flush it before the workers
+  // start.
+  SystemIO::flushOutput();
+  QCoreApplication::processEvents();
+
+  timer.restart();
+  if (simulateIntervals(dir.path()))
+    return 1;
+  m_simulationTime = timer.elapsed();
+
+  stitch();
+  return report();
+}
+
+int ParallelRunner::takeCheckpoints(const QString &dir) {
+  info("Taking checkpoints", false, true);
+  reselectProcessor(functionalProcessor());
+  const auto *proc = ProcessorHandler::getProcessor();
+  MemoryWriteTracker tracker;
+  for (uint64_t start = 0;; start += m_pOptions.intervalLength) {
+    runUntilRetired(start - std::min(start, m_pOptions.warmup));
+    if (proc->finished())
+      break;
+
+    const auto checkpoint = ArchCheckpoint::capture(tracker);
+    const QString path = QDir(dir).filePath(
+        "interval" + QString::number(m_intervals.size()) + ".ckpt");
+    const QString err = checkpoint.write(path);
+    if (!err.isEmpty()) {
+      error(err);
+      return 1;
+    }
+    m_intervals.push_back({start, start - checkpoint.instructions, {}});
+  }
+
+  if (m_intervals.empty()) {
+    error("No instructions were executed.");
+    return 1;
+  }
+  info("Wrote " + QString::number(m_intervals.size()) + " checkpoints");
+  return 0;
+}
+
+int ParallelRunner::simulateIntervals(const QString &dir) {
+  info("Simulating " + QString::number(m_intervals.size()) +
+           " intervals with " + QString::number(m_jobs) + " workers",
+       false, true);
+
+  auto filePath = [&](size_t i, const QString &suffix) {
+    return QDir(dir).filePath("interval" + QString::number(i) + suffix);
+  };
+
+  QEventLoop loop;
+  std::vector<std::unique_ptr<QProcess>> workers(m_intervals.size());
+  size_t next = 0;
+  unsigned running = 0;
+  bool failed = false;
+
+  auto fail = [&](size_t i, const QString &msg) {
+    error("Worker for interval " + QString::number(i) + " " + msg);
+    QFile log(filePath(i, ".log"));
+    if (log.open(QIODevice::ReadOnly | QIODevice::Text))
+      info(QString::fromUtf8(log.readAll()).trimmed(), true, false, "WORKER");
+    failed = true;
+  };
+
+  std::function<void()> launch = [&] {
+    while (!failed && running < m_jobs && next < m_intervals.size()) {
+      const size_t i = next++;
+      auto &worker = workers[i];
+      worker = std::make_unique<QProcess>();
+      worker->setProcessChannelMode(QProcess::MergedChannels);
+      worker->setStandardOutputFile(filePath(i, ".log"));
+      connect(worker.get(), &QProcess::finished, &loop,
+              [&, i](int exitCode, QProcess::ExitStatus status) {
+                running--;
+                if (status != QProcess::NormalExit)
+                  fail(i, "crashed");
+                else if (exitCode != 0)
+                  fail(i, "exited with code " + QString::number(exitCode));
+                launch();
+              });
+
+      QStringList arguments = m_pOptions.workerArguments;
+      arguments << "--mode"
+                << "cli"
+                << "--roi"
+                << "--json"
+                << "--output" << filePath(i, ".json") << "--checkpoint"
+                << filePath(i, ".ckpt") << "--checkpoint-warmup"
+                << QString::number(m_intervals[i].warmup)
+                << "--checkpoint-length"
+                << QString::number(m_pOptions.intervalLength);
+      worker->start(QCoreApplication::applicationFilePath(), arguments);
+      if (!worker->waitForStarted()) {
+        fail(i, "could not be started: " + worker->errorString());
+        break;
+      }
+      running++;
+    }
+    if (running == 0)
+      loop.quit();
+  };
+
+  launch();
+  if (running > 0)
+    loop.exec();
+  if (failed)
+    return 1;
+
+  for (size_t i = 0; i < m_intervals.size(); ++i) {
+    QFile output(filePath(i, ".json"));
+    if (!output.open(QIODevice::ReadOnly)) {
+      error("Worker for interval " + QString::number(i) +
+            " did not write a report");
+      return 1;
+    }
+    m_intervals[i].stats = QJsonDocument::fromJson(output.readAll())
+                               .object()
+                               .value("region of interest")
+                               .toObject()
+                               .toVariantMap();
+  }
+  return 0;
+}
+
+void ParallelRunner::stitch() {
+  // Per-interval values which are not summed; CPI and IPC are recomputed from
+  // the totals.
+  static const QStringList s_derived = {"CPI", "IPC", "regions", "snapshots"};
+
+  QVariantMap cpiStack;
+  for (const auto &interval : m_intervals) {
+    for (auto it = interval.stats.begin(); it != interval.stats.end(); ++it) {
+      if (s_derived.contains(it.key()))
+        continue;
+      if (it.key() == "CPI stack") {
+        const auto stack = it.value().toMap();
+        for (auto c = stack.begin(); c != stack.end(); ++c)
+          cpiStack[c.key()] = cpiStack.value(c.key()).toULongLong() +
+                              c.value().toULongLong();
+      } else {
+        m_totals[it.key()] = m_totals.value(it.key()).toULongLong() +
+                             it.value().toULongLong();
+      }
+    }
+  }
+  m_totals["CPI stack"] = cpiStack;
+
+  const double cycles = m_totals.value("cycles").toULongLong();
+  const double instructions = m_totals.value("instructions").toULongLong();
+  m_totals["CPI"] = instructions > 0 ? cycles / instructions : 0.0;
+  m_totals["IPC"] = cycles > 0 ? instructions / cycles : 0.0;
+}
+
+int ParallelRunner::report() {
+  std::unique_ptr<QTextStream> stream;
+  std::unique_ptr<QFile> outputFile;
+  if (m_options.outputFile.isEmpty()) {
+    stream = std::make_unique<QTextStream>(stdout, QIODevice::WriteOnly);
+  } else {
+    outputFile = std::make_unique<QFile>(m_options.outputFile);
+    if (!outputFile->open(QIODevice::Truncate | QIODevice::Text |
+                          QIODevice::WriteOnly)) {
+      error("Failed to open output file");
+      return 1;
+    }
+    stream = std::make_unique<QTextStream>(outputFile.get());
+  }
+
+  if (m_options.jsonOutput) {
+    QJsonArray intervals;
+    for (const auto &interval : m_intervals) {
+      QJsonObject i = QJsonObject::fromVariantMap(interval.stats);
+      i["start"] = static_cast<qint64>(interval.start);
+      i["warmup"] = static_cast<qint64>(interval.warmup);
+      intervals.append(i);
+    }
+    QJsonObject report = QJsonObject::fromVariantMap(m_totals);
+    report["interval length"] = static_cast<qint64>(m_pOptions.intervalLength);
+    report["warmup"] = static_cast<qint64>(m_pOptions.warmup);
+    report["workers"] = static_cast<int>(m_jobs);
+    report["intervals"] = intervals;
+    report["checkpointing time (ms)"] = m_checkpointTime;
+    report["parallel simulation time (ms)"] = m_simulationTime;
+    *stream << QJsonDocument(report).toJson(QJsonDocument::Indented);
+    return 0;
+  }
+
+  const auto cpiStack = m_totals.value("CPI stack").toMap();
+  const double cycles = m_totals.value("cycles").toULongLong();
+  *stream << "Instructions:\t" << m_totals.value("instructions").toULongLong()
+          << "\n";
+  *stream << "Cycles:\t" << m_totals.value("cycles").toULongLong() << "\n";
+  *stream << "CPI:\t" << m_totals.value("CPI").toDouble() << "\n";
+  *stream << "IPC:\t" << m_totals.value("IPC").toDouble() << "\n";
+  *stream << "CPI stack:\n";
+  for (auto it = cpiStack.begin(); it != cpiStack.end(); ++it)
+    *stream << "  " << it.key() << "\t" << it.value().toULongLong() << "\t"
+            << QString::number(
+                   cycles > 0 ? 100.0 * it.value().toULongLong() / cycles : 0,
+                   'f', 2)
+            << "%\n";
+  for (auto it = m_totals.begin(); it != m_totals.end(); ++it)
+    if (!QStringList{"instructions", "cycles", "CPI", "IPC", "CPI stack"}
+             .contains(it.key()))
+      *stream << it.key() << ":\t" << it.value().toULongLong() << "\n";
+
+  *stream << "\nIntervals:\t" << m_intervals.size() << " x "
+          << m_pOptions.intervalLength << " (warmup " << m_pOptions.warmup
+          << ")\n";
+  *stream << "Workers:\t" << m_jobs << "\n\n";
+  *stream << "start\tinstructions\tcycles\tCPI\n";
+  for (const auto &interval : m_intervals)
+    *stream << interval.start << "\t"
+            << interval.stats.value("instructions").toULongLong() << "\t"
+            << interval.stats.value("cycles").toULongLong() << "\t"
+            << QString::number(interval.stats.value("CPI").toDouble(), 'f', 3)
+            << "\n";
+  *stream << "\nCheckpointing time (ms):\t" << m_checkpointTime << "\n";
+  *stream << "Parallel simulation time (ms):\t" << m_simulationTime << "\n";
+  return 0;
+}
+
+} // namespace Ripes
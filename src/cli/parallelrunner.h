@@ -0,0 +1,79 @@
+#pragma once
+
+#include "clirunner.h"
+
+#include <QCommandLineParser>
+#include <QVariantMap>
+
+namespace Ripes {
+
+struct ParallelOptions {
+  // Number of instructions simulated by each worker.
+  uint64_t intervalLength = 10000000;
+  // Number of instructions simulated before each interval to warm up caches,
+  // branch predictors and the pipeline.
+  uint64_t warmup = 100000;
+  // Number of concurrent worker processes. 0 uses all available cores.
+  unsigned jobs = 0;
+  // Command line options passed on to each worker (source file, processor,
+  // caches, ...).
+  QStringList workerArguments;
+};
+
+/// Parses the parallel mode options. Returns true if options were parsed
+/// successfully.
+bool parseParallelOptions(QCommandLineParser &parser, QString &errorMessage,
+                          const CLIModeOptions &cliOptions,
+                          ParallelOptions &options);
+
+/**
+ * Checkpoint-parallel simulation ("--mode parallel"). The program is first
+ * executed on the single-cycle processor, writing an architectural checkpoint
+ * shortly before the start of each interval. Each interval is then simulated
+ * on the selected processor by a separate worker process (Ripes in cli mode,
+ * resuming from the checkpoint), and the cycles, CPI stack, cache and stall
+ * statistics of all intervals are summed into whole-program totals.
+ *
+ * Workers are separate processes since the ProcessorHandler only holds a
+ * single processor.
+ */
+class ParallelRunner : public CLIRunner {
+  Q_OBJECT
+public:
+  struct IntervalResult {
+    // Instructions retired before the interval.
+    uint64_t start = 0;
+    // Instructions simulated by the worker before the interval.
+    uint64_t warmup = 0;
+    // Region of interest statistics reported by the worker.
+    QVariantMap stats;
+  };
+
+  ParallelRunner(const CLIModeOptions &options,
+                 const ParallelOptions &pOptions);
+
+  int run();
+
+  const std::vector<IntervalResult> &intervals() const { return m_intervals; }
+  /// Statistics of the whole program, in the format of the region of interest
+  /// report.
+  const QVariantMap &totals() const { return m_totals; }
+
+private:
+  /// Writes a checkpoint for each interval to @p dir.
+  int takeCheckpoints(const QString &dir);
+  /// Simulates each interval in a worker process.
+  int simulateIntervals(const QString &dir);
+  void stitch();
+  int report();
+
+  ParallelOptions m_pOptions;
+  unsigned m_jobs = 1;
+
+  std::vector<IntervalResult> m_intervals;
+  QVariantMap m_totals;
+  long long m_checkpointTime = 0;
+  long long m_simulationTime = 0;
+};
+
+} // namespace Ripes
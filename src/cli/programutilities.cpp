@@ -1,9 +1,14 @@
 #include "programutilities.h"
 #include "dwarf/dwarf++.hh"
-#include "elfio/elfio.hpp"
+#include "elfio/elf_types.hpp"
 #include "statusmanager.h"
 
 #include <QRegularExpression>
+#include <QTemporaryFile>
+
+#include <cstring>
+#include <map>
+#include <memory>
 
 namespace Ripes {
 
@@ -25,34 +30,173 @@ QString loadFlatBinaryFile(Program &program, const QString &filepath,
 
 using namespace ELFIO;
 /**
- * @brief The ELFIODwarfLoader class provides
+ * @brief The FileMapping class
+ * A read-only memory mapping of a file, which the loaded program refers to (see
+ * Program::mapping). On Windows, a mapped file cannot be removed or rewritten,
+ * such as the output file of the compiler when recompiling, and a private
+ * temporary copy of the file is mapped instead.
+ */
+class FileMapping {
+public:
+  ~FileMapping() {
+    // Unmapped before the (temporary) file is closed and removed.
+    if (m_base)
+      m_file->unmap(m_base);
+  }
+
+  bool map(const QString &fileName) {
+#ifdef Q_OS_WIN
+    QFile source(fileName);
+    auto copy = std::make_unique<QTemporaryFile>();
+    if (!source.open(QIODevice::ReadOnly) || !copy->open())
+      return false;
+    while (!source.atEnd()) {
+      const QByteArray chunk = source.read(1 << 20);
+      if (chunk.isEmpty() || copy->write(chunk) != chunk.size())
+        return false;
+    }
+    if (!copy->flush())
+      return false;
+    m_file = std::move(copy);
+#else
+    // The compiler output is removed before recompiling (see CCManager), such
+    // that the mapping keeps referring to the previous file.
+    m_file = std::make_unique<QFile>(fileName);
+    if (!m_file->open(QIODevice::ReadOnly))
+      return false;
+#endif
+    m_size = m_file->size();
+    m_base = m_size > 0 ? m_file->map(0, m_size) : nullptr;
+    return m_base;
+  }
+
+  const char *data() const { return reinterpret_cast<const char *>(m_base); }
+  qint64 size() const { return m_size; }
+
+private:
+  std::unique_ptr<QFile> m_file;
+  uchar *m_base = nullptr;
+  qint64 m_size = 0;
+};
+
+/**
+ * @brief The MappedDwarfLoader class provides
  * a loader implementation for Dwarf sections
- * using the ELFIO library.
+ * which refers to the debug sections of a mapped ELF file.
  */
-class ELFIODwarfLoader : public ::dwarf::loader {
+class MappedDwarfLoader : public ::dwarf::loader {
 public:
-  ELFIODwarfLoader(elfio &reader) : reader(reader) {}
+  MappedDwarfLoader(const std::shared_ptr<const FileMapping> &mapping)
+      : m_mapping(mapping) {}
+
+  void addSection(const QString &name, const char *data, size_t size) {
+    m_sections[name.toStdString()] =
+        QByteArray::fromRawData(data, static_cast<qsizetype>(size));
+  }
+  bool empty() const { return m_sections.empty(); }
 
   const void *load(::dwarf::section_type section, size_t *size_out) override {
-    auto sec = reader.sections[::dwarf::elf::section_type_to_name(section)];
-    if (sec == nullptr)
+    auto it = m_sections.find(::dwarf::elf::section_type_to_name(section));
+    if (it == m_sections.end())
       return nullptr;
-    *size_out = sec->get_size();
-    return sec->get_data();
+    *size_out = it->second.size();
+    return it->second.constData();
   }
 
 private:
-  elfio &reader;
+  std::shared_ptr<const FileMapping> m_mapping;
+  std::map<std::string, QByteArray> m_sections;
 };
 
 /**
- * @brief createDwarfLoader
- * Creates a Dwarf loader for the provided elfio reader.
- * @param reader The elfio reader to create the Dwarf loader for.
- * @return A shared pointer to the newly created Dwarf loader.
+ * @brief loadMappedElf
+ * Loads the segments, sections and function symbols of the ELF file mapped at
+ * @p base. Section and segment data refers to the mapping, which must outlive
+ * the program. Debug sections are added to @p dwarfLoader.
+ * @return False if the file is malformed.
  */
-static std::shared_ptr<ELFIODwarfLoader> createDwarfLoader(elfio &reader) {
-  return std::make_shared<ELFIODwarfLoader>(reader);
+template <typename Ehdr, typename Phdr, typename Shdr, typename Sym>
+static bool loadMappedElf(Program &program, const char *base, uint64_t size,
+                          MappedDwarfLoader &dwarfLoader) {
+  auto inBounds = [&](uint64_t offset, uint64_t length) {
+    return offset <= size && length <= size - offset;
+  };
+  if (!inBounds(0, sizeof(Ehdr)))
+    return false;
+  const auto *ehdr = reinterpret_cast<const Ehdr *>(base);
+
+  // Memory is initialized from the loadable segments.
+  if (ehdr->e_phnum > 0 &&
+      (ehdr->e_phentsize != sizeof(Phdr) ||
+       !inBounds(ehdr->e_phoff, uint64_t(ehdr->e_phnum) * sizeof(Phdr))))
+    return false;
+  const auto *phdrs = reinterpret_cast<const Phdr *>(base + ehdr->e_phoff);
+  for (unsigned i = 0; i < ehdr->e_phnum; ++i) {
+    const Phdr &phdr = phdrs[i];
+    if (phdr.p_type != PT_LOAD)
+      continue;
+    if (phdr.p_filesz > phdr.p_memsz ||
+        !inBounds(phdr.p_offset, phdr.p_filesz))
+      return false;
+    program.segments.push_back(
+        {static_cast<AInt>(phdr.p_vaddr),
+         QByteArray::fromRawData(base + phdr.p_offset,
+                                 static_cast<qsizetype>(phdr.p_filesz)),
+         static_cast<AInt>(phdr.p_memsz)});
+  }
+
+  if (ehdr->e_shnum > 0 &&
+      (ehdr->e_shentsize != sizeof(Shdr) || ehdr->e_shstrndx >= ehdr->e_shnum ||
+       !inBounds(ehdr->e_shoff, uint64_t(ehdr->e_shnum) * sizeof(Shdr))))
+    return false;
+  const auto *shdrs = reinterpret_cast<const Shdr *>(base + ehdr->e_shoff);
+
+  auto hasData = [&](const Shdr &shdr) {
+    return shdr.sh_type != SHT_NOBITS && inBounds(shdr.sh_offset, shdr.sh_size);
+  };
+  auto stringAt = [&](const Shdr &strtab, uint64_t offset) {
+    if (!hasData(strtab) || offset >= strtab.sh_size)
+      return QString();
+    const char *str = base + strtab.sh_offset + offset;
+    const size_t maxLength = strtab.sh_size - offset;
+    const auto *end = static_cast<const char *>(std::memchr(str, 0, maxLength));
+    return QString::fromUtf8(str, end ? end - str : maxLength);
+  };
+
+  for (unsigned i = 0; i < ehdr->e_shnum; ++i) {
+    const Shdr &shdr = shdrs[i];
+    const QString name = stringAt(shdrs[ehdr->e_shstrndx], shdr.sh_name);
+    const char *data = hasData(shdr) ? base + shdr.sh_offset : nullptr;
+    const size_t dataSize = data ? shdr.sh_size : 0;
+
+    // .debug sections are only used for DWARF information
+    if (name.startsWith(".debug")) {
+      if (data)
+        dwarfLoader.addSection(name, data, dataSize);
+    } else {
+      ProgramSection section;
+      section.name = name;
+      section.address = shdr.sh_addr;
+      section.data =
+          QByteArray::fromRawData(data, static_cast<qsizetype>(dataSize));
+      program.sections[section.name] = section;
+    }
+
+    if (shdr.sh_type == SHT_SYMTAB && data && shdr.sh_link < ehdr->e_shnum) {
+      // Collect function symbols
+      const Shdr &strtab = shdrs[shdr.sh_link];
+      const auto *symbols = reinterpret_cast<const Sym *>(data);
+      for (size_t j = 0; j < dataSize / sizeof(Sym); ++j) {
+        if (ELF_ST_TYPE(symbols[j].st_info) != STT_FUNC)
+          continue;
+        program.symbols[symbols[j].st_value] =
+            stringAt(strtab, symbols[j].st_name);
+      }
+    }
+  }
+
+  program.entryPoint = ehdr->e_entry;
+  return true;
 }
 
 /**
@@ -69,90 +213,79 @@ static bool isInternalSourceFile(const QString &filename) {
   return re.match(filename).hasMatch();
 }
 
-bool loadElfFile(Program &program, QFile &file) {
-  ELFIO::elfio reader;
-
-  // No file validity checking is performed - it is expected that Loaddialog has
-  // done all validity checking.
-  if (!reader.load(file.fileName().toStdString())) {
-    assert(false);
-  }
+bool loadElfFile(Program &program, QFile &file, bool loadDebugInfo) {
+  // The file is read in place from a mapping, which is held by the program.
+  // Memory refers to the loadable segments of the mapping, and only copies the
+  // pages which the program writes.
+  auto mapping = std::make_shared<FileMapping>();
+  if (!mapping->map(file.fileName()))
+    return false;
+  const char *base = mapping->data();
+  const qint64 size = mapping->size();
+  program.mapping = mapping;
 
-  for (const auto &elfSection : reader.sections) {
-    // Do not load .debug sections
-    if (!QString::fromStdString(elfSection->get_name()).startsWith(".debug")) {
-      ProgramSection section;
-      section.name = QString::fromStdString(elfSection->get_name());
-      section.address = elfSection->get_address();
-      // QByteArray performs a deep copy of the data when the data array is
-      // initialized at construction
-      section.data = QByteArray(elfSection->get_data(),
-                                static_cast<int>(elfSection->get_size()));
-      program.sections[section.name] = section;
-    }
+  // No further validity checking is performed - it is expected that
+  // Loaddialog has done all validity checking.
+  auto dwarfLoader = std::make_shared<MappedDwarfLoader>(mapping);
+  const bool loaded =
+      size > EI_CLASS && base[EI_CLASS] == ELFCLASS64
+          ? loadMappedElf<Elf64_Ehdr, Elf64_Phdr, Elf64_Shdr, Elf64_Sym>(
+                program, base, size, *dwarfLoader)
+          : loadMappedElf<Elf32_Ehdr, Elf32_Phdr, Elf32_Shdr, Elf32_Sym>(
+                program, base, size, *dwarfLoader);
+  if (!loaded)
+    return false;
 
-    if (elfSection->get_type() == SHT_SYMTAB) {
-      // Collect function symbols
-      const ELFIO::symbol_section_accessor symbols(reader, elfSection);
-      for (unsigned int j = 0; j < symbols.get_symbols_num(); ++j) {
-        std::string name;
-        ELFIO::Elf64_Addr value = 0;
-        ELFIO::Elf_Xword size;
-        unsigned char bind;
-        unsigned char type = STT_NOTYPE;
-        ELFIO::Elf_Half section_index;
-        unsigned char other;
-        symbols.get_symbol(j, name, value, size, bind, type, section_index,
-                           other);
-
-        if (type != STT_FUNC)
-          continue;
-        program.symbols[value] = QString::fromStdString(name);
-      }
-    }
-  }
+  if (!loadDebugInfo || dwarfLoader->empty())
+    return true;
 
-  // Load DWARF information into the source mapping of the program.
+  // Load DWARF information into the source mapping of the program. Parsing the
+  // line tables of large programs is slow, and is deferred to a worker thread,
+  // started once the program is loaded into the processor.
   // We'll only load information from compilation units which originated from a
   // source file that plausibly arrived from within the Ripes editor.
-  QString editorSrcFile;
-  try {
-    ::dwarf::dwarf dw(createDwarfLoader(reader));
-    for (auto &cu : dw.compilation_units()) {
-      for (auto &line : cu.get_line_table()) {
-        if (!line.file)
-          continue;
-        QString filePath = QString::fromStdString(line.file->path);
-        if (editorSrcFile.isEmpty()) {
-          // Try to see if this compilation unit is from the Ripes editor:
-          if (isInternalSourceFile(filePath))
-            editorSrcFile = filePath;
+  program.deferSourceInfo([dwarfLoader] {
+    Program::SourceInfo sourceInfo;
+    QString editorSrcFile;
+    try {
+      ::dwarf::dwarf dw(dwarfLoader);
+      for (auto &cu : dw.compilation_units()) {
+        for (auto &line : cu.get_line_table()) {
+          if (!line.file)
+            continue;
+          QString filePath = QString::fromStdString(line.file->path);
+          if (editorSrcFile.isEmpty()) {
+            // Try to see if this compilation unit is from the Ripes editor:
+            if (isInternalSourceFile(filePath))
+              editorSrcFile = filePath;
+          }
+          if (editorSrcFile != filePath)
+            continue;
+          sourceInfo.mapping[line.address].insert(line.line - 1);
         }
-        if (editorSrcFile != filePath)
-          continue;
-        program.sourceMapping[line.address].insert(line.line - 1);
       }
+      if (!editorSrcFile.isEmpty()) {
+        // Finally, we need to generate a hash of the source file that we've
+        // loaded source mappings from, so the editor knows what editor
+        // contents applies to this program.
+        QFile srcFile(editorSrcFile);
+        if (srcFile.open(QFile::ReadOnly))
+          sourceInfo.hash = Program::calculateHash(srcFile.readAll());
+        else
+          throw ::dwarf::format_error("Could not find source file " +
+                                      editorSrcFile.toStdString());
+      }
+    } catch (::dwarf::format_error &e) {
+      const QString msg =
+          "Could not load debug information: " + QString::fromUtf8(e.what());
+      // Status messages are posted from the GUI thread.
+      postToGUIThread(
+          [msg] { GeneralStatusManager::setStatusTimed(msg, 2500); });
+    } catch (...) {
+      // Something else went wrong.
     }
-    if (!editorSrcFile.isEmpty()) {
-      // Finally, we need to generate a hash of the source file that we've
-      // loaded source mappings from, so the editor knows what editor contents
-      // applies to this program.
-      QFile srcFile(editorSrcFile);
-      if (srcFile.open(QFile::ReadOnly))
-        program.sourceHash = Program::calculateHash(srcFile.readAll());
-      else
-        throw ::dwarf::format_error("Could not find source file " +
-                                    editorSrcFile.toStdString());
-    }
-  } catch (::dwarf::format_error &e) {
-    std::string msg = "Could not load debug information: ";
-    msg += e.what();
-    GeneralStatusManager::setStatusTimed(QString::fromStdString(msg), 2500);
-  } catch (...) {
-    // Something else went wrong.
-  }
-
-  program.entryPoint = reader.get_entry();
+    return sourceInfo;
+  });
 
   return true;
 }
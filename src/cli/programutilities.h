@@ -24,8 +24,11 @@ QString loadFlatBinaryFile(Program &program, const QString &filepath,
  * Loads an ELF file into the program object passed as parameter.
  * @param program The program object to load the ELF file into.
  * @param file The QFile object containing the ELF file.
+ * @param loadDebugInfo Whether to build the source mapping of the program from
+ * the DWARF information of the ELF file. The source mapping is built on a
+ * worker thread upon first being used.
  * @return True if the ELF file was loaded successfully; otherwise, false.
  */
-bool loadElfFile(Program &program, QFile &file);
+bool loadElfFile(Program &program, QFile &file, bool loadDebugInfo = true);
 
 } // namespace Ripes
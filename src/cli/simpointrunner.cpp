@@ -0,0 +1,341 @@
+#include "simpointrunner.h"
+#include "processorhandler.h"
+#include "syscall/systemio.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <cmath>
+#include <limits>
+
+namespace Ripes {
+
+bool parseSimPointOptions(QCommandLineParser &parser, QString &errorMessage,
+                          SimPointOptions &options) {
+  auto parseCount = [&](const QString &name, uint64_t &value) {
+    if (!parser.isSet(name))
+      return true;
+    bool ok;
+    value = parser.value(name).toULongLong(&ok);
+    if (!ok || value == 0) {
+      errorMessage = "Invalid value specified (--" + name + ").";
+      return false;
+    }
+    return true;
+  };
+  if (!parseCount("simpoint-interval", options.intervalLength))
+    return false;
+  options.warmup = options.intervalLength;
+  if (parser.isSet("simpoint-warmup")) {
+    bool ok;
+    options.warmup = parser.value("simpoint-warmup").toULongLong(&ok);
+    if (!ok) {
+      errorMessage = "Invalid warmup specified (--simpoint-warmup).";
+      return false;
+    }
+  }
+  if (parser.isSet("simpoint-maxk")) {
+    bool ok;
+    options.maxK = parser.value("simpoint-maxk").toUInt(&ok);
+    if (!ok || options.maxK == 0) {
+      errorMessage = "Invalid number of clusters specified (--simpoint-maxk).";
+      return false;
+    }
+  }
+  options.validate = parser.isSet("simpoint-validate");
+  return true;
+}
+
+/// Ratio estimate sum(w * num) / sum(w * den) over the simulation points, where
+/// num and den are rates per instruction. The confidence bound treats the
+/// simulation points as independent samples of the program.
+static SimPointRunner::Estimate
+ratioEstimate(const QString &name, const std::vector<double> &w,
+              const std::vector<double> &num, const std::vector<double> &den) {
+  SimPointRunner::Estimate estimate;
+  estimate.name = name;
+  double sumNum = 0.0, sumDen = 0.0;
+  for (size_t i = 0; i < w.size(); ++i) {
+    sumNum += w[i] * num[i];
+    sumDen += w[i] * den[i];
+  }
+  if (sumDen == 0.0)
+    return estimate;
+  estimate.value = sumNum / sumDen;
+
+  const size_t k = w.size();
+  if (k > 1) {
+    double variance = 0.0;
+    for (size_t i = 0; i < k; ++i) {
+      const double residual = (num[i] - estimate.value * den[i]) / sumDen;
+      variance += w[i] * w[i] * residual * residual;
+    }
+    variance *= static_cast<double>(k) / (k - 1);
+    estimate.bound = 1.96 * std::sqrt(variance);
+  }
+  return estimate;
+}
+
+SimPointRunner::SimPointRunner(const CLIModeOptions &options,
+                               const SimPointOptions &spOptions)
+    : CLIRunner(options), m_spOptions(spOptions) {
+  // Caches are only attached to the processor while simulating in detail.
+  for (const auto &shim : m_cacheShims)
+    m_cacheTypes.push_back(shim->type());
+  detachCaches();
+}
+
+int SimPointRunner::run() {
+  if (processInput())
+    return 1;
+
+  if (profileProgram())
+    return 1;
+
+  // Program output is only printed while profiling. The output is buffered and
+  // delivered through the event loop; flush it before disconnecting.
+  SystemIO::flushOutput();
+  QCoreApplication::processEvents();
+  disconnect(&SystemIO::get(), &SystemIO::doPrint, this, nullptr);
+
+  QElapsedTimer timer;
+  timer.start();
+  const auto selection = selectSimPoints(m_profile, m_spOptions.maxK);
+  info("Selected " + QString::number(selection.points.size()) +
+       " simulation points from " +
+       QString::number(m_profile.intervals.size()) + " intervals");
+  const auto checkpoints = takeCheckpoints(selection.points);
+  for (size_t i = 0; i < checkpoints.size(); ++i)
+    m_points.push_back(simulatePoint(selection.points[i], checkpoints[i]));
+  m_sampledTime = timer.elapsed();
+  extrapolate();
+
+  if (m_spOptions.validate) {
+    timer.restart();
+    validate();
+    m_validateTime = timer.elapsed();
+  }
+  return report();
+}
+
+void SimPointRunner::attachCaches() {
+  for (size_t i = 0; i < m_caches.size(); ++i) {
+    m_caches[i].cache->reset();
+    auto shim = std::make_unique<L1CacheShim>(m_cacheTypes[i], nullptr);
+    shim->setNextLevelCache(m_caches[i].cache);
+    m_cacheShims.push_back(std::move(shim));
+  }
+}
+
+void SimPointRunner::detachCaches() { m_cacheShims.clear(); }
+
+int SimPointRunner::profileProgram() {
+  info("Profiling basic block vectors", false, true);
+  QElapsedTimer timer;
+  timer.start();
+  reselectProcessor(functionalProcessor());
+  BBVProfiler profiler(m_spOptions.intervalLength);
+  profiler.setEnabled(true);
+  runUntilRetired(std::numeric_limits<uint64_t>::max());
+  profiler.setEnabled(false);
+  m_profile = profiler.profile();
+  m_profileTime = timer.elapsed();
+
+  if (m_profile.intervals.empty()) {
+    error("No instructions were executed.");
+    return 1;
+  }
+  return 0;
+}
+
+std::vector<ArchCheckpoint>
+SimPointRunner::takeCheckpoints(const std::vector<SimPoint> &points) {
+  info("Taking checkpoints", false, true);
+  reselectProcessor(functionalProcessor());
+  MemoryWriteTracker tracker;
+  std::vector<ArchCheckpoint> checkpoints;
+  for (const auto &point : points) {
+    const uint64_t start = point.interval * m_profile.intervalLength;
+    runUntilRetired(start - std::min(start, m_spOptions.warmup));
+    checkpoints.push_back(ArchCheckpoint::capture(tracker));
+  }
+  return checkpoints;
+}
+
+SimPointRunner::PointResult
+SimPointRunner::simulatePoint(const SimPoint &point,
+                              const ArchCheckpoint &checkpoint) {
+  info("Simulating interval " + QString::number(point.interval));
+  reselectProcessor(m_options.proc);
+  checkpoint.restore();
+  attachCaches();
+
+  // Warm up caches and branch predictors until the start of the interval.
+  const uint64_t warmup =
+      point.interval * m_profile.intervalLength - checkpoint.instructions;
+  runUntilRetired(warmup);
+
+  const auto *proc = ProcessorHandler::getProcessor();
+  const uint64_t startInstructions = proc->getInstructionsRetired();
+  const uint64_t startCycles = proc->getCycleCount();
+  std::vector<std::pair<uint64_t, uint64_t>> startCaches;
+  for (const auto &cache : m_caches)
+    startCaches.push_back({cache.cache->getHits() + cache.cache->getMisses(),
+                           cache.cache->getMisses()});
+
+  runUntilRetired(warmup + m_profile.instructions(point.interval));
+
+  PointResult result;
+  result.point = point;
+  result.instructions = proc->getInstructionsRetired() - startInstructions;
+  result.cycles = proc->getCycleCount() - startCycles;
+  for (size_t i = 0; i < m_caches.size(); ++i) {
+    const auto &cache = m_caches[i].cache;
+    result.cacheAccesses.push_back(
+        {cache->getHits() + cache->getMisses() - startCaches[i].first,
+         cache->getMisses() - startCaches[i].second});
+  }
+  detachCaches();
+  return result;
+}
+
+void SimPointRunner::extrapolate() {
+  std::vector<double> weights, cpi, ones;
+  for (const auto &point : m_points) {
+    const double instructions = std::max<uint64_t>(point.instructions, 1);
+    weights.push_back(point.point.weight);
+    cpi.push_back(point.cycles / instructions);
+    ones.push_back(1.0);
+  }
+  m_estimates.push_back(ratioEstimate("CPI", weights, cpi, ones));
+
+  for (size_t i = 0; i < m_caches.size(); ++i) {
+    std::vector<double> misses, accesses;
+    for (const auto &point : m_points) {
+      const double instructions = std::max<uint64_t>(point.instructions, 1);
+      accesses.push_back(point.cacheAccesses[i].first / instructions);
+      misses.push_back(point.cacheAccesses[i].second / instructions);
+    }
+    m_estimates.push_back(ratioEstimate(m_caches[i].name + " miss rate",
+                                        weights, misses, accesses));
+  }
+}
+
+void SimPointRunner::validate() {
+  info("Simulating the whole program", false, true);
+  reselectProcessor(m_options.proc);
+  attachCaches();
+  runUntilRetired(std::numeric_limits<uint64_t>::max());
+
+  const auto *proc = ProcessorHandler::getProcessor();
+  const double instructions =
+      std::max<long long>(proc->getInstructionsRetired(), 1);
+  m_estimates[0].measured = proc->getCycleCount() / instructions;
+  for (size_t i = 0; i < m_caches.size(); ++i) {
+    const auto &cache = m_caches[i].cache;
+    const double accesses = cache->getHits() + cache->getMisses();
+    m_estimates[i + 1].measured =
+        accesses > 0 ? cache->getMisses() / accesses : 0.0;
+  }
+  detachCaches();
+}
+
+int SimPointRunner::report() {
+  std::unique_ptr<QTextStream> stream;
+  std::unique_ptr<QFile> outputFile;
+  if (m_options.outputFile.isEmpty()) {
+    stream = std::make_unique<QTextStream>(stdout, QIODevice::WriteOnly);
+  } else {
+    outputFile = std::make_unique<QFile>(m_options.outputFile);
+    if (!outputFile->open(QIODevice::Truncate | QIODevice::Text |
+                          QIODevice::WriteOnly)) {
+      error("Failed to open output file");
+      return 1;
+    }
+    stream = std::make_unique<QTextStream>(outputFile.get());
+  }
+
+  uint64_t detailed = 0;
+  for (const auto &point : m_points)
+    detailed += point.instructions;
+  auto relativeError = [](const Estimate &e) {
+    return *e.measured != 0.0 ? 100.0 * (e.value - *e.measured) / *e.measured
+                              : 0.0;
+  };
+
+  if (m_options.jsonOutput) {
+    QJsonArray points;
+    for (const auto &point : m_points) {
+      QJsonObject p;
+      p["interval"] = static_cast<qint64>(point.point.interval);
+      p["cluster"] = static_cast<int>(point.point.cluster);
+      p["weight"] = point.point.weight;
+      p["instructions"] = static_cast<qint64>(point.instructions);
+      p["cycles"] = static_cast<qint64>(point.cycles);
+      points.append(p);
+    }
+    QJsonObject estimates;
+    for (const auto &estimate : m_estimates) {
+      QJsonObject e;
+      e["estimate"] = estimate.value;
+      e["bound"] = estimate.bound;
+      if (estimate.measured) {
+        e["measured"] = *estimate.measured;
+        e["error (%)"] = relativeError(estimate);
+      }
+      estimates[estimate.name] = e;
+    }
+    QJsonObject report;
+    report["instructions"] =
+        static_cast<qint64>(m_profile.totalInstructions());
+    report["interval length"] = static_cast<qint64>(m_profile.intervalLength);
+    report["intervals"] = static_cast<qint64>(m_profile.intervals.size());
+    report["warmup"] = static_cast<qint64>(m_spOptions.warmup);
+    report["simulation points"] = points;
+    report["estimates"] = estimates;
+    report["profiling time (ms)"] = m_profileTime;
+    report["sampled simulation time (ms)"] = m_sampledTime;
+    if (m_spOptions.validate)
+      report["full simulation time (ms)"] = m_validateTime;
+    *stream << QJsonDocument(report).toJson(QJsonDocument::Indented);
+    return 0;
+  }
+
+  *stream << "Instructions:\t" << m_profile.totalInstructions() << "\n";
+  *stream << "Intervals:\t" << m_profile.intervals.size() << " x "
+          << m_profile.intervalLength << "\n";
+  *stream << "Simulation points:\t" << m_points.size() << " ("
+          << detailed << " instructions measured)\n\n";
+  *stream << "interval\tcluster\tweight\tCPI\n";
+  for (const auto &point : m_points) {
+    *stream << point.point.interval << "\t" << point.point.cluster << "\t"
+            << QString::number(point.point.weight, 'f', 4) << "\t"
+            << QString::number(point.cycles /
+                                   std::max<double>(point.instructions, 1),
+                               'f', 3)
+            << "\n";
+  }
+  *stream << "\nmetric\testimate\t95% bound\tmeasured\terror (%)\n";
+  for (const auto &estimate : m_estimates) {
+    *stream << estimate.name << "\t" << QString::number(estimate.value, 'f', 4)
+            << "\t" << QString::number(estimate.bound, 'f', 4) << "\t";
+    if (estimate.measured)
+      *stream << QString::number(*estimate.measured, 'f', 4) << "\t"
+              << QString::number(relativeError(estimate), 'f', 2);
+    else
+      *stream << "-\t-";
+    *stream << "\n";
+  }
+  *stream << "\nProfiling time (ms):\t" << m_profileTime << "\n";
+  *stream << "Sampled simulation time (ms):\t" << m_sampledTime << "\n";
+  if (m_spOptions.validate)
+    *stream << "Full simulation time (ms):\t" << m_validateTime << "\n";
+  return 0;
+}
+
+} // namespace Ripes
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "archcheckpoint.h"
+#include "clirunner.h"
+#include "simpoint.h"
+
+#include <QCommandLineParser>
+#include <optional>
+
+namespace Ripes {
+
+struct SimPointOptions {
+  // Number of instructions per interval.
+  uint64_t intervalLength = 100000;
+  // Number of instructions simulated in detail before each interval to warm up
+  // caches and branch predictors.
+  uint64_t warmup = 100000;
+  // Maximum number of clusters (simulation points).
+  unsigned maxK = 10;
+  // Additionally simulate the whole program in detail, and report the error of
+  // the estimates.
+  bool validate = false;
+};
+
+/// Parses the simpoint mode options. Returns true if options were parsed
+/// successfully.
+bool parseSimPointOptions(QCommandLineParser &parser, QString &errorMessage,
+                          SimPointOptions &options);
+
+/**
+ * Sampled simulation ("--mode simpoint"). The program is first executed on the
+ * single-cycle processor to collect its basic block vector profile, from which
+ * a set of representative intervals (simulation points) is chosen. Each
+ * simulation point is then simulated on the selected processor, resuming from
+ * an architectural checkpoint taken shortly before the interval, such that
+ * caches and branch predictors are warmed up. The CPI and cache miss rates of
+ * the whole program are extrapolated from the simulation points, weighted by
+ * the fraction of the program which they represent.
+ */
+class SimPointRunner : public CLIRunner {
+  Q_OBJECT
+public:
+  /// An extrapolated metric, with the half-width of its 95% confidence
+  /// interval.
+  struct Estimate {
+    QString name;
+    double value = 0.0;
+    double bound = 0.0;
+    std::optional<double> measured;
+  };
+
+  struct PointResult {
+    SimPoint point;
+    uint64_t instructions = 0;
+    uint64_t cycles = 0;
+    // {accesses, misses} of each cache.
+    std::vector<std::pair<uint64_t, uint64_t>> cacheAccesses;
+  };
+
+  SimPointRunner(const CLIModeOptions &options,
+                 const SimPointOptions &spOptions);
+
+  int run();
+
+  const BBVProfile &profile() const { return m_profile; }
+  const std::vector<PointResult> &points() const { return m_points; }
+  /// CPI followed by the miss rate of each cache.
+  const std::vector<Estimate> &estimates() const { return m_estimates; }
+
+private:
+  /// Collects the basic block vector profile on the single-cycle processor.
+  int profileProgram();
+  /// Takes a checkpoint on the single-cycle processor before each of
+  /// @p points, which are sorted in program order.
+  std::vector<ArchCheckpoint>
+  takeCheckpoints(const std::vector<SimPoint> &points);
+  PointResult simulatePoint(const SimPoint &point,
+                            const ArchCheckpoint &checkpoint);
+  /// Simulates the whole program in detail.
+  void validate();
+  void extrapolate();
+  int report();
+
+  void attachCaches();
+  void detachCaches();
+
+  SimPointOptions m_spOptions;
+  std::vector<L1CacheShim::CacheType> m_cacheTypes;
+
+  BBVProfile m_profile;
+  std::vector<PointResult> m_points;
+  std::vector<Estimate> m_estimates;
+  long long m_profileTime = 0;
+  long long m_sampledTime = 0;
+  long long m_validateTime = 0;
+};
+
+} // namespace Ripes
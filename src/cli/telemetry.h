@@ -2,9 +2,14 @@
 
 #include <QTextStream>
 
+#include "executionprofiler.h"
+#include "functionprofiler.h"
+#include "issuemodel.h"
 #include "pipelinediagrammodel.h"
 #include "processorhandler.h"
 #include "radix.h"
+#include "regionofinterest.h"
+#include "selfprofiler.h"
 
 #include <memory>
 
@@ -143,6 +148,206 @@ public:
   }
 };
 
+/// Per-PC execution profile and hot basic blocks. Shares its ExecutionProfiler
+/// with IMixTelemetry, such that the program is only profiled once.
+class ProfileTelemetry : public Telemetry {
+public:
+  ProfileTelemetry(const std::shared_ptr<ExecutionProfiler> &profiler)
+      : m_profiler(profiler) {}
+  void enable() override {
+    m_profiler->setEnabled(true);
+    Telemetry::enable();
+  }
+
+  QString key() const override { return "profile"; }
+  QString description() const override {
+    return "per-instruction execution profile and hot basic blocks";
+  }
+  QVariant report(bool json) override {
+    return m_profiler->profileReport(json);
+  }
+
+private:
+  std::shared_ptr<ExecutionProfiler> m_profiler;
+};
+
+class IMixTelemetry : public Telemetry {
+public:
+  IMixTelemetry(const std::shared_ptr<ExecutionProfiler> &profiler)
+      : m_profiler(profiler) {}
+  void enable() override {
+    m_profiler->setEnabled(true);
+    Telemetry::enable();
+  }
+
+  QString key() const override { return "imix"; }
+  QString prettyKey() const override { return "instruction mix"; }
+  QString description() const override { return "dynamic instruction mix"; }
+  QVariant report(bool json) override { return m_profiler->imixReport(json); }
+
+private:
+  std::shared_ptr<ExecutionProfiler> m_profiler;
+};
+
+class CallGraphTelemetry : public Telemetry {
+public:
+  CallGraphTelemetry(const std::shared_ptr<FunctionProfiler> &profiler)
+      : m_profiler(profiler) {}
+  void enable() override {
+    m_profiler->setEnabled(true);
+    Telemetry::enable();
+  }
+
+  QString key() const override { return "callgraph"; }
+  QString prettyKey() const override { return "call graph"; }
+  QString description() const override {
+    return "function level profile and call graph";
+  }
+  QVariant report(bool json) override { return m_profiler->report(json); }
+
+private:
+  std::shared_ptr<FunctionProfiler> m_profiler;
+};
+
+class SelfProfTelemetry : public Telemetry {
+public:
+  void enable() override {
+    SelfProfiler::reset();
+    SelfProfiler::setEnabled(true);
+    Telemetry::enable();
+  }
+
+  QString key() const override { return "selfprof"; }
+  QString prettyKey() const override { return "simulator profile"; }
+  QString description() const override {
+    return "host-side simulator performance (simulation speed, time spent in "
+           "clock propagation, listeners and syscalls, peak RSS)";
+  }
+  QVariant report(bool json) override { return SelfProfiler::report(json); }
+};
+
+class ROITelemetry : public Telemetry {
+public:
+  QString key() const override { return "roi"; }
+  QString prettyKey() const override { return "region of interest"; }
+  QString description() const override {
+    return "statistics accumulated within the regions of interest marked by "
+           "the program (cycles, instructions, CPI stack, cache statistics)";
+  }
+  QVariant report(bool json) override { return RegionOfInterest::report(json); }
+};
+
+class BranchTelemetry : public Telemetry {
+public:
+  QString key() const override { return "branch"; }
+  QString prettyKey() const override { return "branch prediction"; }
+  QString description() const override {
+    return "branch prediction statistics (accuracy, mispredictions, penalty "
+           "cycles, CPI)";
+  }
+  QVariant report(bool /*json*/) override {
+    const auto *proc = ProcessorHandler::getProcessor();
+    const auto *bp = proc->branchPredictor();
+    if (!bp)
+      return "N/A";
+
+    const auto &stats = bp->stats();
+    const auto &config = bp->config();
+    auto ratio = [](uint64_t n, uint64_t d) {
+      return d > 0 ? static_cast<double>(n) / static_cast<double>(d) : 0.0;
+    };
+    const uint64_t cycles = proc->getCycleCount();
+    const uint64_t retired = proc->getInstructionsRetired();
+
+    QVariantMap m;
+    m["predictor"] = BranchPredictorTypeNames.at(config.type);
+    m["PHT entries"] = config.phtEntries;
+    m["history bits"] = config.historyBits;
+    m["BTB entries"] = config.btbEntries;
+    m["RAS entries"] = config.rasEntries;
+    m["branches"] = QVariant::fromValue(stats.branches);
+    m["branch mispredictions"] =
+        QVariant::fromValue(stats.branchMispredictions);
+    m["jumps"] = QVariant::fromValue(stats.jumps);
+    m["jump mispredictions"] = QVariant::fromValue(stats.jumpMispredictions);
+    m["returns"] = QVariant::fromValue(stats.returns);
+    m["return mispredictions"] =
+        QVariant::fromValue(stats.returnMispredictions);
+    m["other mispredictions"] = QVariant::fromValue(stats.otherMispredictions);
+    m["accuracy"] =
+        100.0 * (1.0 - ratio(stats.mispredictions(), stats.controlFlow()));
+    m["branch accuracy"] =
+        100.0 * (1.0 - ratio(stats.branchMispredictions, stats.branches));
+    m["BTB hit rate"] = 100.0 * ratio(stats.btbHits, stats.btbLookups);
+    m["penalty cycles"] = QVariant::fromValue(stats.penaltyCycles);
+    m["CPI"] = ratio(cycles, retired);
+    // CPI had every control-flow instruction been predicted correctly.
+    m["CPI (perfect prediction)"] =
+        ratio(cycles - stats.penaltyCycles, retired);
+    return m;
+  }
+};
+
+class MulDivTelemetry : public Telemetry {
+public:
+  QString key() const override { return "muldiv"; }
+  QString prettyKey() const override { return "multiply/divide units"; }
+  QString description() const override {
+    return "multiply/divide unit latencies and the cycles stalled on them";
+  }
+  QVariant report(bool /*json*/) override {
+    auto *proc = ProcessorHandler::getProcessor();
+    const auto *latencies = proc->functionalUnitLatencies();
+    if (!latencies)
+      return "N/A";
+
+    QVariantMap m;
+    m["mul latency"] = latencies->mul.latency;
+    m["mul pipelined"] = latencies->mul.pipelined;
+    m["div latency"] = latencies->div.latency;
+    m["div pipelined"] = latencies->div.pipelined;
+    if (const auto *stats = proc->functionalUnitStats()) {
+      const uint64_t cycles = proc->getCycleCount();
+      const uint64_t retired = proc->getInstructionsRetired();
+      const uint64_t stalls = stats->latencyStalls + stats->structuralStalls;
+      m["latency stalls"] = QVariant::fromValue(stats->latencyStalls);
+      m["structural stalls"] = QVariant::fromValue(stats->structuralStalls);
+      if (retired > 0) {
+        m["CPI"] = static_cast<double>(cycles) / retired;
+        // CPI had all multiply and divide instructions been single-cycle.
+        m["CPI (single-cycle mul/div)"] =
+            static_cast<double>(cycles - stalls) / retired;
+      }
+    }
+    return m;
+  }
+};
+
+class IssueTelemetry : public Telemetry {
+public:
+  IssueTelemetry(const std::shared_ptr<IssueModel> &model) : m_model(model) {}
+  void enable() override {
+    m_model->setEnabled(true);
+    Telemetry::enable();
+  }
+
+  QString key() const override { return "issue"; }
+  QString prettyKey() const override { return "issue slots"; }
+  QString description() const override {
+    return "issue slot utilization of the processor (if multiple-issue) and of "
+           "the modelled N-wide in-order issue configurations";
+  }
+  QVariant report(bool json) override {
+    QVariantMap m = m_model->report(json).toMap();
+    if (const auto *stats = ProcessorHandler::getProcessor()->issueStats())
+      m["processor"] = IssueModel::statsReport(*stats);
+    return m;
+  }
+
+private:
+  std::shared_ptr<IssueModel> m_model;
+};
+
 class RunInfoTelemetry : public Telemetry {
 public:
   RunInfoTelemetry(QCommandLineParser *parser) {
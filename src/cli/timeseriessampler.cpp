@@ -0,0 +1,115 @@
+#include "timeseriessampler.h"
+
+#include "cachesim/cachesim.h"
+#include "processorhandler.h"
+#include "regionofinterest.h"
+#include "selfprofiler.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace Ripes {
+
+TimeSeriesSampler::TimeSeriesSampler(unsigned interval, Format format,
+                                     QIODevice *device,
+                                     const std::vector<SampledCache> &caches,
+                                     QObject *parent)
+    : QObject(parent), m_interval(interval), m_format(format), m_out(device),
+      m_caches(caches) {
+  m_fields << "cycle"
+           << "cycles"
+           << "retired"
+           << "ipc";
+  for (const auto &cache : m_caches)
+    m_fields << cache.name + "_hits" << cache.name + "_misses";
+  m_fields << "stalls"
+           << "flushes";
+
+  if (m_format == Format::CSV)
+    m_out << m_fields.join(",") << "\n";
+
+  // Sampling must happen in lockstep with the processor; execute the handler
+  // in the simulation thread (direct connection).
+  connect(ProcessorHandler::get(), &ProcessorHandler::processorClocked, this,
+          &TimeSeriesSampler::processorWasClocked, Qt::DirectConnection);
+  connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this,
+          &TimeSeriesSampler::processorReset);
+  processorReset();
+}
+
+void TimeSeriesSampler::processorReset() {
+  m_stalls = 0;
+  m_flushes = 0;
+  m_last = currentCounters();
+}
+
+TimeSeriesSampler::Counters TimeSeriesSampler::currentCounters() const {
+  const auto *proc = ProcessorHandler::getProcessor();
+  Counters counters;
+  counters.cycle = proc->getCycleCount();
+  counters.retired = proc->getInstructionsRetired();
+  counters.stalls = m_stalls;
+  counters.flushes = m_flushes;
+  for (const auto &cache : m_caches) {
+    counters.hits.push_back(cache.cache->getHits());
+    counters.misses.push_back(cache.cache->getMisses());
+  }
+  return counters;
+}
+
+void TimeSeriesSampler::processorWasClocked() {
+  SelfProfiler::Scope scope(SelfProfiler::TimeSeriesSampler);
+  if (RegionOfInterest::outsideROI())
+    return;
+  const auto *proc = ProcessorHandler::getProcessor();
+  for (auto idx : proc->structure().stageIt()) {
+    switch (proc->stageInfo(idx).state) {
+    case StageInfo::State::Stalled:
+      m_stalls++;
+      break;
+    case StageInfo::State::Flushed:
+      m_flushes++;
+      break;
+    default:
+      break;
+    }
+  }
+
+  if (proc->getCycleCount() - m_last.cycle >= m_interval)
+    flush();
+}
+
+void TimeSeriesSampler::flush() {
+  const Counters now = currentCounters();
+  if (now.cycle == m_last.cycle)
+    return;
+  writeRecord(now);
+  m_last = now;
+}
+
+void TimeSeriesSampler::writeRecord(const Counters &now) {
+  const long long cycles = now.cycle - m_last.cycle;
+  const long long retired = now.retired - m_last.retired;
+  QVariantList values;
+  values << now.cycle << cycles << retired
+         << static_cast<double>(retired) / static_cast<double>(cycles);
+  for (unsigned i = 0; i < m_caches.size(); ++i)
+    values << now.hits.at(i) - m_last.hits.at(i)
+           << now.misses.at(i) - m_last.misses.at(i);
+  values << now.stalls - m_last.stalls << now.flushes - m_last.flushes;
+
+  if (m_format == Format::CSV) {
+    QStringList strValues;
+    for (const auto &v : values)
+      strValues << v.toString();
+    m_out << strValues.join(",") << "\n";
+  } else {
+    QJsonObject record;
+    for (int i = 0; i < m_fields.size(); ++i)
+      record.insert(m_fields.at(i), QJsonValue::fromVariant(values.at(i)));
+    m_out << QJsonDocument(record).toJson(QJsonDocument::Compact) << "\n";
+  }
+  m_out.flush();
+}
+
+} // namespace Ripes
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QIODevice>
+#include <QObject>
+#include <QStringList>
+#include <QTextStream>
+
+#include <memory>
+#include <vector>
+
+namespace Ripes {
+
+class CacheSim;
+
+/**
+ * @brief The TimeSeriesSampler class
+ * Periodically samples execution statistics of the current processor while it
+ * runs. Every N cycles, a record holding the statistics of the interval is
+ * appended to an output stream, as JSON lines or CSV. Only the counters at the
+ * start of the current interval are kept in memory.
+ */
+class TimeSeriesSampler : public QObject {
+  Q_OBJECT
+public:
+  enum class Format { JSONLines, CSV };
+
+  struct SampledCache {
+    QString name;
+    std::shared_ptr<CacheSim> cache;
+  };
+
+  TimeSeriesSampler(unsigned interval, Format format, QIODevice *device,
+                    const std::vector<SampledCache> &caches,
+                    QObject *parent = nullptr);
+
+  /// Writes a record for the (partial) interval since the last sample, if any
+  /// cycles have passed since then.
+  void flush();
+
+private:
+  struct Counters {
+    long long cycle = 0;
+    long long retired = 0;
+    unsigned long long stalls = 0;
+    unsigned long long flushes = 0;
+    std::vector<unsigned> hits;
+    std::vector<unsigned> misses;
+  };
+
+  void processorWasClocked();
+  void processorReset();
+  Counters currentCounters() const;
+  void writeRecord(const Counters &now);
+
+  unsigned m_interval;
+  Format m_format;
+  QTextStream m_out;
+  std::vector<SampledCache> m_caches;
+  QStringList m_fields;
+
+  // Stall/flush counts are accumulated per cycle, since the processor does not
+  // keep these.
+  unsigned long long m_stalls = 0;
+  unsigned long long m_flushes = 0;
+  Counters m_last;
+};
+
+} // namespace Ripes
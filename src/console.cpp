@@ -4,6 +4,7 @@
 #include "ripessettings.h"
 
 #include <QScrollBar>
+#include <QTimer>
 
 #include <QClipboard>
 #include <QGuiApplication>
@@ -49,11 +50,39 @@ Console::Console(QWidget *parent) : QPlainTextEdit(parent) {
 }
 
 void Console::putData(const QByteArray &bytes) {
+  // Output is collected and appended in bulk, once per pass of the event loop.
+  if (m_pending.isEmpty())
+    QTimer::singleShot(0, this, &Console::appendPending);
+  m_pending += QString::fromUtf8(bytes);
+}
+
+void Console::appendPending() {
+  if (m_pending.isEmpty())
+    return;
+
+  // The document only keeps its last maximumBlockCount lines. If the pending
+  // output displaces all of the current contents, only its last lines are
+  // inserted.
+  const int maxBlocks = document()->maximumBlockCount();
+  qsizetype pos = m_pending.size();
+  int newlines = 0;
+  while (maxBlocks > 0 && newlines < maxBlocks && pos > 0) {
+    pos = m_pending.lastIndexOf('\n', pos - 1);
+    if (pos < 0)
+      break;
+    ++newlines;
+  }
+  if (maxBlocks > 0 && newlines == maxBlocks) {
+    clear();
+    m_pending.remove(0, pos + 1);
+  }
+
   // Text can always only be inserted at the end of the console
   auto cursorAtEnd = QTextCursor(document());
   cursorAtEnd.movePosition(QTextCursor::End);
   setTextCursor(cursorAtEnd);
-  insertPlainText(bytes);
+  insertPlainText(m_pending);
+  m_pending.clear();
 
   QScrollBar *bar = verticalScrollBar();
   bar->setValue(bar->maximum());
@@ -62,9 +91,12 @@ void Console::putData(const QByteArray &bytes) {
 void Console::clearConsole() {
   clear();
   m_buffer.clear();
+  m_pending.clear();
 }
 
 void Console::backspace() {
+  appendPending();
+
   // Deletes the last character in the console
   auto cursorAtEnd = QTextCursor(document());
   cursorAtEnd.movePosition(QTextCursor::End);
@@ -23,10 +23,14 @@ protected:
 
 private:
   void backspace();
+  /// Appends the output collected by putData to the console.
+  void appendPending();
 
   bool m_localEchoEnabled = false;
   QFont m_font;
   QString m_buffer;
+  // Output which is not yet appended to the console
+  QString m_pending;
 };
 
 } // namespace Ripes
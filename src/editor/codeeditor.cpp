@@ -37,6 +37,8 @@ CodeEditor::CodeEditor(QWidget *parent) : HighlightableTextEdit(parent) {
 
   connect(ProcessorHandler::get(), &ProcessorHandler::procStateChangedNonRun,
           this, &CodeEditor::updateHighlighting);
+  connect(ProcessorHandler::get(), &ProcessorHandler::sourceInfoChanged, this,
+          &CodeEditor::updateHighlighting);
 
   // Set font for the entire widget. calls to fontMetrics() will get the
   // dimensions of the currently set font
@@ -434,7 +436,7 @@ void CodeEditor::updateHighlighting() {
   if (!program || !program->isSameSource(document()->toPlainText().toUtf8()))
     return;
 
-  auto sourceMapping = program->sourceMapping;
+  const auto &sourceMapping = program->getSourceMapping();
 
   // Do nothing if no soruce mappings are available.
   if (sourceMapping.empty())
@@ -0,0 +1,271 @@
+#include "executionprofiler.h"
+
+#include "processorhandler.h"
+
+#include <QTextStream>
+#include <algorithm>
+
+namespace Ripes {
+
+/// Returns a "symbol+offset" description of @p address, based on the closest
+/// preceding symbol of the current program.
+static QString symbolForAddress(AInt address) {
+  auto program = ProcessorHandler::getProgram();
+  if (!program || program->symbols.empty())
+    return QString();
+  auto it = program->symbols.upper_bound(address);
+  if (it == program->symbols.begin())
+    return QString();
+  --it;
+  QString desc = it->second.v;
+  if (it->first != address)
+    desc += "+0x" + QString::number(address - it->first, 16);
+  return desc;
+}
+
+static QString percentage(uint64_t part, uint64_t total) {
+  if (total == 0)
+    return "0.00%";
+  return QString::number(100.0 * static_cast<double>(part) /
+                             static_cast<double>(total),
+                         'f', 2) +
+         "%";
+}
+
+/// Returns the names of the stages of the current processor, in stage ordinal
+/// order. Stages of multi-lane processors are suffixed with their lane index.
+static QStringList stageNames() {
+  const auto *proc = ProcessorHandler::getProcessor();
+  const auto &structure = proc->structure();
+  QStringList names;
+  for (auto idx : structure.stageIt()) {
+    QString name = proc->stageName(idx);
+    if (structure.size() > 1)
+      name += "(" + QString::number(idx.lane()) + ")";
+    names << name;
+  }
+  return names;
+}
+
+ExecutionProfiler::ExecutionProfiler(QObject *parent)
+    : RetirementObserver(parent) {
+  setObserveStages(true);
+  m_classCounts.fill(0);
+}
+
+void ExecutionProfiler::observerReset() {
+  m_numStages = ProcessorHandler::getProcessor()->structure().numStages();
+  m_execCounts.assign(numSlots(), 0);
+  m_stageCycles.assign(static_cast<size_t>(numSlots()) * m_numStages, 0);
+  m_blockEntries.assign(numSlots(), 0);
+  m_slotInfo.assign(numSlots(), s_unknownClass);
+  m_classCounts.fill(0);
+  m_branchesTaken = 0;
+  m_totalRetired = 0;
+  m_maxExecCount = 0;
+  m_hasPrev = false;
+}
+
+uint8_t ExecutionProfiler::slotInfo(unsigned slot, AInt pc) {
+  uint8_t &info = m_slotInfo[slot];
+  if (info == s_unknownClass) {
+    const uint32_t instr = instructionAt(pc);
+    info = static_cast<uint8_t>(RVISA::classifyInstr(
+        instr, ProcessorHandler::currentISA()->bits()));
+    if (RVISA::instrSize(instr) == 2)
+      info |= s_compressedBit;
+  }
+  return info;
+}
+
+void ExecutionProfiler::stageOccupied(unsigned stage, AInt pc) {
+  m_stageCycles[static_cast<size_t>(slotForPC(pc)) * m_numStages + stage]++;
+}
+
+void ExecutionProfiler::instructionRetired(AInt pc, long long) {
+  const unsigned slot = slotForPC(pc);
+  const uint8_t info = slotInfo(slot, pc);
+
+  m_maxExecCount = std::max(m_maxExecCount, ++m_execCounts[slot]);
+  m_totalRetired++;
+  m_classCounts[static_cast<unsigned>(infoClass(info))]++;
+
+  // An instruction starts a new basic block if it was not reached sequentially
+  // from the previously retired instruction, or if the previous instruction
+  // was a control flow instruction.
+  bool newBlock = true;
+  if (m_hasPrev) {
+    const bool sequential = pc == m_prevPC + infoSize(m_prevInfo);
+    const InstrClass prevClass = infoClass(m_prevInfo);
+    if (prevClass == InstrClass::Branch && !sequential)
+      m_branchesTaken++;
+    newBlock = !sequential || prevClass == InstrClass::Branch ||
+               prevClass == InstrClass::Jump || prevClass == InstrClass::Ecall;
+  }
+  if (newBlock)
+    m_blockEntries[slot]++;
+
+  m_hasPrev = true;
+  m_prevPC = pc;
+  m_prevInfo = info;
+}
+
+uint64_t ExecutionProfiler::executionCount(AInt pc) const {
+  if (!hasSlot(pc) || m_execCounts.empty())
+    return 0;
+  return m_execCounts.at(slotForPC(pc));
+}
+
+uint64_t ExecutionProfiler::stageCycles(AInt pc, unsigned stage) const {
+  if (!hasSlot(pc) || stage >= m_numStages || m_stageCycles.empty())
+    return 0;
+  return m_stageCycles.at(static_cast<size_t>(slotForPC(pc)) * m_numStages +
+                          stage);
+}
+
+std::vector<ExecutionProfiler::BasicBlock>
+ExecutionProfiler::hotBlocks(unsigned n) const {
+  std::vector<BasicBlock> blocks;
+  for (unsigned slot = 0; slot < m_blockEntries.size(); ++slot) {
+    if (m_blockEntries[slot] == 0)
+      continue;
+
+    BasicBlock bb;
+    bb.start = pcForSlot(slot);
+    bb.entries = m_blockEntries[slot];
+
+    // Walk forward until a control flow instruction, an unexecuted instruction
+    // or the start of another block is found.
+    AInt pc = bb.start;
+    unsigned s = slot;
+    while (m_slotInfo[s] != s_unknownClass) {
+      bb.instructions++;
+      const InstrClass cls = infoClass(m_slotInfo[s]);
+      if (cls == InstrClass::Branch || cls == InstrClass::Jump ||
+          cls == InstrClass::Ecall)
+        break;
+      pc += infoSize(m_slotInfo[s]);
+      if (!hasSlot(pc))
+        break;
+      s = slotForPC(pc);
+      if (m_blockEntries[s] != 0)
+        break;
+    }
+    blocks.push_back(bb);
+  }
+
+  std::sort(blocks.begin(), blocks.end(), [](const auto &a, const auto &b) {
+    return a.dynamicInstructions() > b.dynamicInstructions();
+  });
+  if (blocks.size() > n)
+    blocks.resize(n);
+  return blocks;
+}
+
+QVariant ExecutionProfiler::profileReport(bool json, unsigned n) const {
+  const QStringList stages = stageNames();
+  const auto blocks = hotBlocks(n);
+
+  if (json) {
+    QVariantMap report;
+    report["total retired"] = QVariant::fromValue(m_totalRetired);
+
+    QVariantList instructions;
+    for (unsigned slot = 0; slot < m_execCounts.size(); ++slot) {
+      bool occupied = m_execCounts[slot] != 0;
+      for (unsigned s = 0; s < m_numStages && !occupied; ++s)
+        occupied |= m_stageCycles[slot * m_numStages + s] != 0;
+      if (!occupied)
+        continue;
+      const AInt pc = pcForSlot(slot);
+      QVariantMap entry;
+      entry["pc"] = "0x" + QString::number(pc, 16);
+      entry["count"] = QVariant::fromValue(m_execCounts[slot]);
+      QVariantMap stageMap;
+      for (unsigned s = 0; s < m_numStages; ++s)
+        stageMap[stages.at(s)] = QVariant::fromValue(stageCycles(pc, s));
+      entry["stage cycles"] = stageMap;
+      instructions << entry;
+    }
+    report["instructions"] = instructions;
+
+    QVariantList blockList;
+    for (const auto &bb : blocks) {
+      QVariantMap entry;
+      entry["start"] = "0x" + QString::number(bb.start, 16);
+      entry["symbol"] = symbolForAddress(bb.start);
+      entry["instructions"] = bb.instructions;
+      entry["entries"] = QVariant::fromValue(bb.entries);
+      entry["dynamic instructions"] =
+          QVariant::fromValue(bb.dynamicInstructions());
+      blockList << entry;
+    }
+    report["hot blocks"] = blockList;
+    return report;
+  }
+
+  // Textual top-n report
+  std::vector<unsigned> slots;
+  for (unsigned slot = 0; slot < m_execCounts.size(); ++slot)
+    if (m_execCounts[slot] != 0)
+      slots.push_back(slot);
+  std::sort(slots.begin(), slots.end(), [&](unsigned a, unsigned b) {
+    return m_execCounts[a] > m_execCounts[b];
+  });
+  if (slots.size() > n)
+    slots.resize(n);
+
+  QString outStr;
+  QTextStream out(&outStr);
+  out << "Instructions retired: " << m_totalRetired << "\n\n";
+  out << "Top " << slots.size() << " instructions:\n";
+  out << "address\tcount\t%\t" << stages.join("\t") << "\tinstruction\n";
+  for (const unsigned slot : slots) {
+    const AInt pc = pcForSlot(slot);
+    out << "0x" << QString::number(pc, 16) << "\t" << m_execCounts[slot] << "\t"
+        << percentage(m_execCounts[slot], m_totalRetired) << "\t";
+    for (unsigned s = 0; s < m_numStages; ++s)
+      out << stageCycles(pc, s) << "\t";
+    out << ProcessorHandler::disassembleInstr(pc) << "\n";
+  }
+
+  out << "\nTop " << blocks.size() << " basic blocks:\n";
+  out << "start\tinstrs\tentries\tdyn. instrs\t%\tsymbol\n";
+  for (const auto &bb : blocks) {
+    out << "0x" << QString::number(bb.start, 16) << "\t" << bb.instructions
+        << "\t" << bb.entries << "\t" << bb.dynamicInstructions() << "\t"
+        << percentage(bb.dynamicInstructions(), m_totalRetired) << "\t"
+        << symbolForAddress(bb.start) << "\n";
+  }
+  return outStr;
+}
+
+QVariant ExecutionProfiler::imixReport(bool json) const {
+  // Branches are split by their dynamic outcome.
+  std::vector<std::pair<QString, uint64_t>> mix;
+  for (unsigned i = 0; i < static_cast<unsigned>(InstrClass::NClasses); ++i) {
+    const auto cls = static_cast<InstrClass>(i);
+    if (cls == InstrClass::Branch) {
+      mix.push_back({"branch (taken)", branchesTaken()});
+      mix.push_back({"branch (not taken)", branchesNotTaken()});
+    } else {
+      mix.push_back({InstrClassNames.at(cls), classCount(cls)});
+    }
+  }
+
+  if (json) {
+    QVariantMap report;
+    for (const auto &entry : mix)
+      report[entry.first] = QVariant::fromValue(entry.second);
+    return report;
+  }
+
+  QString outStr;
+  QTextStream out(&outStr);
+  for (const auto &entry : mix)
+    out << entry.first << ":\t" << entry.second << "\t("
+        << percentage(entry.second, m_totalRetired) << ")\n";
+  return outStr;
+}
+
+} // namespace Ripes
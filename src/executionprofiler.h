@@ -0,0 +1,98 @@
+#pragma once
+
+#include <QVariant>
+#include <array>
+#include <vector>
+
+#include "isa/rvinstrclass.h"
+#include "retirementobserver.h"
+
+namespace Ripes {
+
+/**
+ * @brief The ExecutionProfiler class
+ * Records a flat, per-PC execution profile of the current program. For each
+ * instruction in the .text section, the profiler counts the number of times it
+ * retired and the number of cycles it spent in each pipeline stage. From this,
+ * the dynamic instruction mix and the hottest basic blocks are derived.
+ *
+ * All state is kept in arrays indexed by RetirementObserver::slotForPC, so the
+ * cost per cycle is a handful of array increments.
+ */
+class ExecutionProfiler : public RetirementObserver {
+  Q_OBJECT
+public:
+  struct BasicBlock {
+    AInt start = 0;
+    unsigned instructions = 0;
+    uint64_t entries = 0;
+    uint64_t dynamicInstructions() const { return entries * instructions; }
+  };
+
+  ExecutionProfiler(QObject *parent = nullptr);
+
+  /// Number of times the instruction at @p pc has retired.
+  uint64_t executionCount(AInt pc) const;
+  uint64_t maxExecutionCount() const { return m_maxExecCount; }
+  uint64_t totalRetired() const { return m_totalRetired; }
+
+  /// Number of cycles the instruction at @p pc has occupied stage @p stage,
+  /// where @p stage is the ordinal of the stage in ProcessorStructure.
+  uint64_t stageCycles(AInt pc, unsigned stage) const;
+
+  /// Dynamic count of retired instructions of class @p cls.
+  uint64_t classCount(InstrClass cls) const {
+    return m_classCounts.at(static_cast<unsigned>(cls));
+  }
+  uint64_t branchesTaken() const { return m_branchesTaken; }
+  uint64_t branchesNotTaken() const {
+    return classCount(InstrClass::Branch) - m_branchesTaken;
+  }
+
+  /// Returns the @p n basic blocks which retired the most instructions.
+  std::vector<BasicBlock> hotBlocks(unsigned n) const;
+
+  /// Reports the per-PC profile. If @p json is set, the full profile is
+  /// returned as a structured QVariant, else a textual top-@p n summary.
+  QVariant profileReport(bool json, unsigned n = 20) const;
+  /// Reports the dynamic instruction mix.
+  QVariant imixReport(bool json) const;
+
+protected:
+  void instructionRetired(AInt pc, long long cycle) override;
+  void stageOccupied(unsigned stage, AInt pc) override;
+  void observerReset() override;
+
+private:
+  static constexpr uint8_t s_unknownClass = 0xFF;
+  static constexpr uint8_t s_compressedBit = 0x80;
+
+  /// Lazily decodes and caches the class of the instruction at @p slot.
+  uint8_t slotInfo(unsigned slot, AInt pc);
+  static InstrClass infoClass(uint8_t info) {
+    return static_cast<InstrClass>(info & ~s_compressedBit);
+  }
+  static unsigned infoSize(uint8_t info) {
+    return info & s_compressedBit ? 2 : 4;
+  }
+
+  unsigned m_numStages = 0;
+  std::vector<uint64_t> m_execCounts;
+  std::vector<uint64_t> m_stageCycles; // [slot * m_numStages + stage]
+  std::vector<uint64_t> m_blockEntries;
+  std::vector<uint8_t> m_slotInfo; // instruction class | compressed bit
+
+  std::array<uint64_t, static_cast<unsigned>(InstrClass::NClasses)>
+      m_classCounts;
+  uint64_t m_branchesTaken = 0;
+  uint64_t m_totalRetired = 0;
+  uint64_t m_maxExecCount = 0;
+
+  // The previously retired instruction, used for determining branch outcomes
+  // and basic block boundaries.
+  bool m_hasPrev = false;
+  AInt m_prevPC = 0;
+  uint8_t m_prevInfo = 0;
+};
+
+} // namespace Ripes
@@ -0,0 +1,233 @@
+#include "functionprofiler.h"
+
+#include "processorhandler.h"
+
+#include <QTextStream>
+#include <algorithm>
+#include <climits>
+
+namespace Ripes {
+
+// Index of the (virtual) root of the call tree.
+static constexpr unsigned s_rootNode = 0;
+// Return address of the bottom frame of the shadow stack; never matches a PC.
+static constexpr AInt s_noReturnAddress = ~static_cast<AInt>(0);
+
+FunctionProfiler::FunctionProfiler(QObject *parent)
+    : RetirementObserver(parent) {}
+
+void FunctionProfiler::observerReset() {
+  m_slotTransfer.assign(numSlots(), s_unknownTransfer);
+  m_functions.clear();
+  m_functionIndex.clear();
+  m_activations.clear();
+  m_edges.clear();
+  m_callTree.clear();
+  m_callTree.push_back({UINT_MAX, s_rootNode});
+  m_stack.clear();
+  m_pending = ControlTransfer::None;
+  m_pendingReturnAddress = 0;
+  m_lastCycle = 0;
+  m_totalCycles = 0;
+  m_totalInstructions = 0;
+}
+
+unsigned FunctionProfiler::functionAt(AInt address) {
+  // Locate the closest preceding, non-local symbol.
+  AInt symbolAddress = address;
+  QString name;
+  if (auto program = ProcessorHandler::getProgram()) {
+    auto it = program->symbols.upper_bound(address);
+    while (it != program->symbols.begin()) {
+      --it;
+      if (!it->second.isLocal()) {
+        symbolAddress = it->first;
+        name = it->second.v;
+        break;
+      }
+    }
+  }
+  if (name.isEmpty())
+    name = "0x" + QString::number(address, 16);
+
+  auto it = m_functionIndex.find(symbolAddress);
+  if (it != m_functionIndex.end())
+    return it->second;
+
+  const unsigned index = m_functions.size();
+  FunctionStats stats;
+  stats.name = name;
+  stats.address = symbolAddress;
+  m_functions.push_back(stats);
+  m_activations.push_back(0);
+  m_functionIndex[symbolAddress] = index;
+  return index;
+}
+
+unsigned FunctionProfiler::childNode(unsigned node, unsigned function) {
+  auto it = m_callTree[node].children.find(function);
+  if (it != m_callTree[node].children.end())
+    return it->second;
+
+  const unsigned child = m_callTree.size();
+  m_callTree.push_back({function, node});
+  m_callTree[node].children[function] = child;
+  return child;
+}
+
+void FunctionProfiler::pushFrame(unsigned function, AInt returnAddress) {
+  const unsigned parent = m_stack.empty() ? s_rootNode : m_stack.back().node;
+  Frame frame;
+  frame.function = function;
+  frame.node = childNode(parent, function);
+  frame.returnAddress = returnAddress;
+  frame.outermost = m_activations[function]++ == 0;
+  frame.entryCycles = m_totalCycles;
+  frame.entryInstructions = m_totalInstructions;
+  m_functions[function].calls++;
+  m_stack.push_back(frame);
+}
+
+void FunctionProfiler::popFrame() {
+  const Frame &frame = m_stack.back();
+  m_activations[frame.function]--;
+  // Recursive activations are only accounted for once, by the outermost frame.
+  if (frame.outermost) {
+    auto &stats = m_functions[frame.function];
+    stats.inclusiveCycles += m_totalCycles - frame.entryCycles;
+    stats.inclusiveInstructions +=
+        m_totalInstructions - frame.entryInstructions;
+  }
+  m_stack.pop_back();
+}
+
+void FunctionProfiler::instructionRetired(AInt pc, long long cycle) {
+  const uint64_t cycles = static_cast<uint64_t>(cycle - m_lastCycle);
+  m_lastCycle = cycle;
+
+  // Resolve the control transfer of the previously retired instruction, now
+  // that its target is known.
+  if (m_pending == ControlTransfer::Call) {
+    const unsigned callee = functionAt(pc);
+    m_edges[{m_stack.back().function, callee}]++;
+    pushFrame(callee, m_pendingReturnAddress);
+  } else if (m_pending == ControlTransfer::Return && m_stack.size() > 1) {
+    // Unwind to the frame returning to this PC. If no such frame exists (ie.
+    // the stack was manipulated directly), assume a single frame was popped.
+    auto match = std::find_if(
+        m_stack.rbegin(), m_stack.rend() - 1,
+        [pc](const Frame &frame) { return frame.returnAddress == pc; });
+    const size_t depth = match == m_stack.rend() - 1
+                             ? 1
+                             : std::distance(m_stack.rbegin(), match) + 1;
+    for (size_t i = 0; i < depth; ++i)
+      popFrame();
+  }
+  m_pending = ControlTransfer::None;
+
+  if (m_stack.empty())
+    pushFrame(functionAt(pc), s_noReturnAddress);
+
+  // Attribute this instruction to the function on top of the shadow stack.
+  m_totalCycles += cycles;
+  m_totalInstructions++;
+  const Frame &top = m_stack.back();
+  auto &stats = m_functions[top.function];
+  stats.selfCycles += cycles;
+  stats.selfInstructions++;
+  m_callTree[top.node].selfCycles += cycles;
+
+  const unsigned slot = slotForPC(pc);
+  uint8_t &transfer = m_slotTransfer[slot];
+  if (transfer == s_unknownTransfer)
+    transfer = static_cast<uint8_t>(RVISA::controlTransfer(
+        instructionAt(pc), ProcessorHandler::currentISA()->bits()));
+  m_pending = static_cast<ControlTransfer>(transfer);
+  if (m_pending == ControlTransfer::Call)
+    m_pendingReturnAddress = pc + RVISA::instrSize(instructionAt(pc));
+}
+
+std::vector<FunctionProfiler::FunctionStats>
+FunctionProfiler::functions() const {
+  auto functions = m_functions;
+  for (const auto &frame : m_stack) {
+    if (!frame.outermost)
+      continue;
+    auto &stats = functions[frame.function];
+    stats.inclusiveCycles += m_totalCycles - frame.entryCycles;
+    stats.inclusiveInstructions +=
+        m_totalInstructions - frame.entryInstructions;
+  }
+  return functions;
+}
+
+QVariant FunctionProfiler::report(bool json) const {
+  auto functions = this->functions();
+  std::sort(functions.begin(), functions.end(),
+            [](const auto &a, const auto &b) {
+              return a.inclusiveCycles > b.inclusiveCycles;
+            });
+
+  if (json) {
+    QVariantMap report;
+    QVariantList functionList;
+    for (const auto &f : functions) {
+      QVariantMap entry;
+      entry["name"] = f.name;
+      entry["address"] = "0x" + QString::number(f.address, 16);
+      entry["calls"] = QVariant::fromValue(f.calls);
+      entry["self cycles"] = QVariant::fromValue(f.selfCycles);
+      entry["self instructions"] = QVariant::fromValue(f.selfInstructions);
+      entry["inclusive cycles"] = QVariant::fromValue(f.inclusiveCycles);
+      entry["inclusive instructions"] =
+          QVariant::fromValue(f.inclusiveInstructions);
+      functionList << entry;
+    }
+    report["functions"] = functionList;
+
+    QVariantList edgeList;
+    for (const auto &edge : m_edges) {
+      QVariantMap entry;
+      entry["caller"] = m_functions.at(edge.first.first).name;
+      entry["callee"] = m_functions.at(edge.first.second).name;
+      entry["calls"] = QVariant::fromValue(edge.second);
+      edgeList << entry;
+    }
+    report["edges"] = edgeList;
+    return report;
+  }
+
+  QString outStr;
+  QTextStream out(&outStr);
+  out << "incl. cycles\tself cycles\tincl. instrs\tself instrs\tcalls\t"
+         "function\n";
+  for (const auto &f : functions) {
+    out << f.inclusiveCycles << "\t" << f.selfCycles << "\t"
+        << f.inclusiveInstructions << "\t" << f.selfInstructions << "\t"
+        << f.calls << "\t" << f.name << "\n";
+  }
+  out << "\nCall graph edges:\n";
+  for (const auto &edge : m_edges) {
+    out << m_functions.at(edge.first.first).name << " -> "
+        << m_functions.at(edge.first.second).name << "\t" << edge.second
+        << "\n";
+  }
+  return outStr;
+}
+
+QString FunctionProfiler::collapsedStacks() const {
+  QString outStr;
+  QTextStream out(&outStr);
+  QStringList stack;
+  for (unsigned node = s_rootNode + 1; node < m_callTree.size(); ++node) {
+    if (m_callTree[node].selfCycles == 0)
+      continue;
+    stack.clear();
+    for (unsigned n = node; n != s_rootNode; n = m_callTree[n].parent)
+      stack.prepend(m_functions.at(m_callTree[n].function).name);
+    out << stack.join(";") << " " << m_callTree[node].selfCycles << "\n";
+  }
+  return outStr;
+}
+
+} // namespace Ripes
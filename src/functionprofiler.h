@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QVariant>
+#include <map>
+#include <vector>
+
+#include "isa/rvinstrclass.h"
+#include "retirementobserver.h"
+
+namespace Ripes {
+
+/**
+ * @brief The FunctionProfiler class
+ * A gprof-style function level profiler. Procedure calls and returns (jal/jalr,
+ * see RVISA::controlTransfer) of the retired instruction stream are tracked
+ * through a shadow stack. The function of a frame is given by the symbol of the
+ * current program which the call targeted. Cycles are attributed to the
+ * instruction retiring after them, and to the function on top of the shadow
+ * stack.
+ *
+ * Alongside the flat profile, the profiler records caller->callee edges and a
+ * call tree, from which a collapsed-stack (flame graph) representation of the
+ * profile can be generated.
+ */
+class FunctionProfiler : public RetirementObserver {
+  Q_OBJECT
+public:
+  struct FunctionStats {
+    QString name;
+    AInt address = 0;
+    uint64_t calls = 0;
+    uint64_t selfCycles = 0;
+    uint64_t selfInstructions = 0;
+    uint64_t inclusiveCycles = 0;
+    uint64_t inclusiveInstructions = 0;
+  };
+  /// caller, callee function indices -> number of calls
+  using CallEdges = std::map<std::pair<unsigned, unsigned>, uint64_t>;
+
+  FunctionProfiler(QObject *parent = nullptr);
+
+  /// Returns the statistics of all functions which have been executed. Frames
+  /// which are still live on the shadow stack are accounted for as if they
+  /// returned at the current cycle.
+  std::vector<FunctionStats> functions() const;
+  const CallEdges &edges() const { return m_edges; }
+
+  QVariant report(bool json) const;
+
+  /// Returns the profile in the collapsed-stack format consumed by flame graph
+  /// tools; one line per unique call stack, "root;caller;callee <cycles>".
+  QString collapsedStacks() const;
+
+protected:
+  void instructionRetired(AInt pc, long long cycle) override;
+  void observerReset() override;
+
+private:
+  static constexpr uint8_t s_unknownTransfer = 0xFF;
+
+  struct Frame {
+    unsigned function;
+    unsigned node;
+    AInt returnAddress;
+    // Totals upon entry, if this is the outermost activation of the function.
+    bool outermost;
+    uint64_t entryCycles;
+    uint64_t entryInstructions;
+  };
+
+  struct CallTreeNode {
+    unsigned function;
+    unsigned parent;
+    uint64_t selfCycles = 0;
+    std::map<unsigned, unsigned> children;
+  };
+
+  /// Returns the index of the function containing @p address, creating it if
+  /// this is the first time the function is seen.
+  unsigned functionAt(AInt address);
+  unsigned childNode(unsigned node, unsigned function);
+  void pushFrame(unsigned function, AInt returnAddress);
+  void popFrame();
+
+  std::vector<uint8_t> m_slotTransfer; // RVISA::ControlTransfer, per slot
+  std::vector<FunctionStats> m_functions;
+  std::map<AInt, unsigned> m_functionIndex; // symbol address -> function
+  std::vector<unsigned> m_activations;      // live frames per function
+  CallEdges m_edges;
+  std::vector<CallTreeNode> m_callTree;
+  std::vector<Frame> m_stack;
+
+  ControlTransfer m_pending = ControlTransfer::None;
+  AInt m_pendingReturnAddress = 0;
+  long long m_lastCycle = 0;
+  uint64_t m_totalCycles = 0;
+  uint64_t m_totalInstructions = 0;
+};
+
+} // namespace Ripes
@@ -2,6 +2,9 @@
 #include <QHeaderView>
 
 #include "processorhandler.h"
+#include "ripessettings.h"
+
+#include <cmath>
 
 namespace Ripes {
 AInt InstructionModel::indexToAddress(const QModelIndex &index) const {
@@ -35,6 +38,11 @@ InstructionModel::InstructionModel(QObject *parent)
           this, &InstructionModel::updateStageInfo);
   connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this,
           &InstructionModel::onProcessorReset);
+
+  m_profiler = new ExecutionProfiler(this);
+  m_profiler->setEnabled(RipesSettings::value(RIPES_SETTING_SHOWHEAT).toBool());
+  connect(ProcessorHandler::get(), &ProcessorHandler::procStateChangedNonRun,
+          this, &InstructionModel::updateHeat);
   onProcessorReset();
 }
 
@@ -48,6 +56,20 @@ void InstructionModel::onProcessorReset() {
   updateStageInfo();
 }
 
+void InstructionModel::setHeatEnabled(bool enabled) {
+  m_profiler->setEnabled(enabled);
+  if (m_rowCount != 0)
+    emit dataChanged(index(0, Heat), index(m_rowCount - 1, Heat),
+                     {Qt::DisplayRole, Qt::BackgroundRole});
+}
+
+void InstructionModel::updateHeat() {
+  if (m_rowCount == 0 || !m_profiler->isEnabled())
+    return;
+  emit dataChanged(index(0, Heat), index(m_rowCount - 1, Heat),
+                   {Qt::DisplayRole, Qt::BackgroundRole});
+}
+
 int InstructionModel::columnCount(const QModelIndex &) const {
   return NColumns;
 }
@@ -118,6 +140,10 @@ QVariant InstructionModel::headerData(int section, Qt::Orientation orientation,
     case Column::Stage:
       return role == Qt::DisplayRole ? "Stage"
                                      : "Stages currently executing instructon";
+    case Column::Heat:
+      return role == Qt::DisplayRole
+                 ? "Heat"
+                 : "Number of times the instruction has been executed";
     case Column::Instruction:
       return "Instruction";
     default:
@@ -147,6 +173,24 @@ QVariant InstructionModel::stageData(AInt addr) const {
   }
 }
 
+QVariant InstructionModel::heatData(AInt addr, int role) const {
+  if (!m_profiler->isEnabled())
+    return QVariant();
+  const uint64_t count = m_profiler->executionCount(addr);
+  if (count == 0)
+    return QVariant();
+
+  if (role == Qt::DisplayRole)
+    return QVariant::fromValue(count);
+
+  // Scale the heat logarithmically; the hottest instructions of a program are
+  // often executed orders of magnitude more than the remainder.
+  const double heat =
+      std::log1p(static_cast<double>(count)) /
+      std::log1p(static_cast<double>(m_profiler->maxExecutionCount()));
+  return QColor(255, 0, 0, 30 + static_cast<int>(heat * 170));
+}
+
 QVariant InstructionModel::instructionData(AInt addr) const {
   if (m_program) {
     auto &disres = m_program->getDisassembled();
@@ -182,6 +226,12 @@ QVariant InstructionModel::data(const QModelIndex &index, int role) const {
     }
     break;
   }
+  case Column::Heat: {
+    if (role == Qt::DisplayRole || role == Qt::BackgroundRole) {
+      return heatData(addr, role);
+    }
+    break;
+  }
   case Column::Instruction: {
     if (role == Qt::DisplayRole) {
       return instructionData(addr);
@@ -6,6 +6,7 @@
 #include <QColor>
 
 #include "assembler/program.h"
+#include "executionprofiler.h"
 #include "processors/interface/ripesprocessor.h"
 
 namespace Ripes {
@@ -16,7 +17,14 @@ class Pipeline;
 class InstructionModel : public QAbstractTableModel {
   Q_OBJECT
 public:
-  enum Column { Breakpoint = 0, PC = 1, Stage = 2, Instruction = 3, NColumns };
+  enum Column {
+    Breakpoint = 0,
+    PC = 1,
+    Stage = 2,
+    Heat = 3,
+    Instruction = 4,
+    NColumns
+  };
   InstructionModel(QObject *parent = nullptr);
 
   int rowCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -33,6 +41,11 @@ public:
   AInt indexToAddress(const QModelIndex &index) const;
   int addressToRow(AInt addr) const;
 
+  /// Enables the execution profiler backing the heat column. The profiler
+  /// observes every retired instruction, and is thus only attached while the
+  /// heat column is shown.
+  void setHeatEnabled(bool enabled);
+
 signals:
   /**
    * @brief firstStageInstrChanged
@@ -47,14 +60,17 @@ private:
   QVariant BPData(AInt addr) const;
   QVariant PCData(AInt addr) const;
   QVariant stageData(AInt addr) const;
+  QVariant heatData(AInt addr, int role) const;
   QVariant instructionData(AInt addr) const;
   void updateRowCount();
   void onProcessorReset();
+  void updateHeat();
 
   std::shared_ptr<const Program> m_program;
   std::map<StageIndex, QString> m_stageNames;
   using StageID = unsigned;
   std::map<StageIndex, StageInfo> m_stageInfos;
   int m_rowCount = 0;
+  ExecutionProfiler *m_profiler = nullptr;
 };
 } // namespace Ripes
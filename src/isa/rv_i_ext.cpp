@@ -12,12 +12,14 @@ static void _enableExtPseudo(const ISAInfoBase *isa,
   enablePseudoInstructions<Lb, Lh, Lw, La, Sb, Sh, Sw, Call, Tail, J, Jr, Jalr,
                            Ret, Jal, Nop, Mv, Not, Neg, Seqz, Snez, Sltz, Sgtz,
                            Beqz, Bnez, Blez, Bgez, Bltz, Bgtz, Bgt, Ble, Bgtu,
-                           Bleu>(pseudoInstructions);
+                           Bleu, Csrr, Rdcycle, Rdtime, Rdinstret>(
+      pseudoInstructions);
 
   if (isa->bits() == 64) {
     enablePseudoInstructions<Li64, Sd, Ld, Negw, SextW>(pseudoInstructions);
   } else {
-    enablePseudoInstructions<Li32>(pseudoInstructions);
+    enablePseudoInstructions<Li32, Rdcycleh, Rdtimeh, Rdinstreth>(
+        pseudoInstructions);
   }
 }
 
@@ -43,6 +45,7 @@ void enableExt(const ISAInfoBase *isa, InstrVec &instructions,
   using namespace TypeIShift;
   using namespace TypeL;
   using namespace TypeSystem;
+  using namespace TypeCSR;
   using namespace TypeU;
   using namespace TypeJ;
   using namespace TypeS;
@@ -54,6 +57,11 @@ void enableExt(const ISAInfoBase *isa, InstrVec &instructions,
                      Slt, Sltu, Xor, Srl, Sra, Or, And, Beq, Bne, Blt, Bge,
                      Bltu, Bgeu>(instructions);
 
+  // Zicsr instructions. Only reads of the (read-only) counter CSRs are
+  // supported by the processor models.
+  enableInstructions<Csrrw, Csrrs, Csrrc, Csrrwi, Csrrsi, Csrrci>(
+      instructions);
+
   if (options.count(Option::shifts64BitVariant)) {
     // 64-bit shift instructions
     enableInstructions<Slliw, Srliw, Sraiw>(instructions);
@@ -269,6 +269,72 @@ struct Ecall : public Instr<Ecall, Funct12::ECALL> {
 
 } // namespace TypeSystem
 
+namespace TypeCSR {
+
+enum class Funct3 : unsigned {
+  CSRRW = 0b001,
+  CSRRS = 0b010,
+  CSRRC = 0b011,
+  CSRRWI = 0b101,
+  CSRRSI = 0b110,
+  CSRRCI = 0b111
+};
+
+/// A RISC-V CSR specifier, being a 12-bit unsigned field in bits 20-31 of the
+/// instruction.
+template <unsigned tokenIndex>
+struct ImmCSR : public Imm<tokenIndex, 12, Repr::Hex, ImmPart<0, 20, 31>> {};
+
+/// A RISC-V 5-bit unsigned immediate, encoded in place of rs1 in bits 15-19 of
+/// the instruction.
+template <unsigned tokenIndex>
+struct ImmUImm5
+    : public Imm<tokenIndex, 5, Repr::Unsigned, ImmPart<0, 15, 19>> {};
+
+/// A Zicsr RISC-V instruction, with a register source operand
+template <typename InstrImpl, Funct3 funct3>
+struct Instr : public RV_Instruction<InstrImpl> {
+  struct Opcode
+      : public OpcodeSet<OpPartOpcode<RVISA::OpcodeID::SYSTEM>,
+                         OpPartFunct3<static_cast<unsigned>(funct3)>> {};
+  struct Fields : public FieldSet<RegRd, ImmCSR, RegRs1> {};
+};
+
+/// A Zicsr RISC-V instruction, with an immediate source operand
+template <typename InstrImpl, Funct3 funct3>
+struct InstrI : public RV_Instruction<InstrImpl> {
+  struct Opcode
+      : public OpcodeSet<OpPartOpcode<RVISA::OpcodeID::SYSTEM>,
+                         OpPartFunct3<static_cast<unsigned>(funct3)>> {};
+  struct Fields : public FieldSet<RegRd, ImmCSR, ImmUImm5> {};
+};
+
+struct Csrrw : public Instr<Csrrw, Funct3::CSRRW> {
+  constexpr static std::string_view NAME = "csrrw";
+};
+
+struct Csrrs : public Instr<Csrrs, Funct3::CSRRS> {
+  constexpr static std::string_view NAME = "csrrs";
+};
+
+struct Csrrc : public Instr<Csrrc, Funct3::CSRRC> {
+  constexpr static std::string_view NAME = "csrrc";
+};
+
+struct Csrrwi : public InstrI<Csrrwi, Funct3::CSRRWI> {
+  constexpr static std::string_view NAME = "csrrwi";
+};
+
+struct Csrrsi : public InstrI<Csrrsi, Funct3::CSRRSI> {
+  constexpr static std::string_view NAME = "csrrsi";
+};
+
+struct Csrrci : public InstrI<Csrrci, Funct3::CSRRCI> {
+  constexpr static std::string_view NAME = "csrrci";
+};
+
+} // namespace TypeCSR
+
 namespace TypeU {
 
 /// A RISC-V immediate field with an input width of 32 bits.
@@ -1112,6 +1178,59 @@ struct SextW : public PseudoInstruction<SextW> {
   constexpr static std::string_view NAME = "sext.w";
 };
 
+/// Reads a CSR, which may be specified by name (ie. "cycle") or number.
+struct Csrr : public PseudoInstruction<Csrr> {
+  struct Fields : public FieldSet<PseudoReg, PseudoImm> {};
+
+  static Result<std::vector<LineTokens>>
+  expander(const PseudoInstruction<Csrr> &, const TokenizedSrcLine &line,
+           const SymbolMap &) {
+    const int csr = csrNumber(line.tokens.at(2));
+    if (csr < 0)
+      return Error(line, "Unknown CSR '" + line.tokens.at(2) + "'");
+    LineTokensVec v;
+    v.push_back(LineTokens{Token("csrrs"), line.tokens.at(1),
+                           Token(QString::number(csr)), Token("x0")});
+    return v;
+  }
+  constexpr static std::string_view NAME = "csrr";
+};
+
+/// Counter read pseudo-instructions (rdcycle, rdtime, rdinstret and their
+/// RV32 high-half variants).
+template <typename PseudoInstrImpl, unsigned csr>
+struct PseudoInstrRdCounter : public PseudoInstruction<PseudoInstrImpl> {
+  struct Fields : public FieldSet<PseudoReg> {};
+
+  static Result<std::vector<LineTokens>>
+  expander(const PseudoInstruction<PseudoInstrImpl> &,
+           const TokenizedSrcLine &line, const SymbolMap &) {
+    LineTokensVec v;
+    v.push_back(LineTokens{Token("csrrs"), line.tokens.at(1),
+                           Token(QString::number(csr)), Token("x0")});
+    return v;
+  }
+};
+
+struct Rdcycle : public PseudoInstrRdCounter<Rdcycle, CYCLE> {
+  constexpr static std::string_view NAME = "rdcycle";
+};
+struct Rdcycleh : public PseudoInstrRdCounter<Rdcycleh, CYCLEH> {
+  constexpr static std::string_view NAME = "rdcycleh";
+};
+struct Rdtime : public PseudoInstrRdCounter<Rdtime, TIME> {
+  constexpr static std::string_view NAME = "rdtime";
+};
+struct Rdtimeh : public PseudoInstrRdCounter<Rdtimeh, TIMEH> {
+  constexpr static std::string_view NAME = "rdtimeh";
+};
+struct Rdinstret : public PseudoInstrRdCounter<Rdinstret, INSTRET> {
+  constexpr static std::string_view NAME = "rdinstret";
+};
+struct Rdinstreth : public PseudoInstrRdCounter<Rdinstreth, INSTRETH> {
+  constexpr static std::string_view NAME = "rdinstreth";
+};
+
 } // namespace TypePseudo
 
 }; // namespace ExtI
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <QString>
+#include <cstdint>
+#include <map>
+
+#include "rvisainfo_common.h"
+
+namespace Ripes {
+
+/// Coarse classes of instructions, used when reporting the dynamic instruction
+/// mix of a program.
+enum class InstrClass : uint8_t {
+  ALU,
+  Load,
+  Store,
+  Branch,
+  Jump,
+  MulDiv,
+  Ecall,
+  Other,
+  NClasses
+};
+
+const static std::map<InstrClass, QString> InstrClassNames = {
+    {InstrClass::ALU, "ALU"},       {InstrClass::Load, "load"},
+    {InstrClass::Store, "store"},   {InstrClass::Branch, "branch"},
+    {InstrClass::Jump, "jump"},     {InstrClass::MulDiv, "mul/div"},
+    {InstrClass::Ecall, "ecall"},   {InstrClass::Other, "other"}};
+
+/// Procedure call/return semantics of a control flow instruction, following
+/// the return address stack hints of the RISC-V unprivileged specification.
+enum class ControlTransfer : uint8_t { None, Call, Return };
+
+namespace RVISA {
+
+/// Returns the size in bytes of the (possibly compressed) instruction @p instr.
+inline unsigned instrSize(uint32_t instr) {
+  return (instr & 0b11) == 0b11 ? 4 : 2;
+}
+
+/**
+ * @brief classifyInstr
+ * Classifies the (possibly compressed) instruction word @p instr. @p xlen is
+ * required to disambiguate compressed encodings which differ between RV32 and
+ * RV64.
+ */
+inline InstrClass classifyInstr(uint32_t instr, unsigned xlen) {
+  if (instrSize(instr) == 2) {
+    const unsigned funct3 = (instr >> 13) & 0b111;
+    switch (instr & 0b11) {
+    case QUADRANT0:
+      switch (funct3) {
+      case 0b000:
+        return InstrClass::ALU; // c.addi4spn
+      case 0b001:
+      case 0b010:
+      case 0b011:
+        return InstrClass::Load; // c.fld, c.lw, c.ld/c.flw
+      case 0b101:
+      case 0b110:
+      case 0b111:
+        return InstrClass::Store; // c.fsd, c.sw, c.sd/c.fsw
+      default:
+        return InstrClass::Other;
+      }
+    case QUADRANT1:
+      switch (funct3) {
+      case 0b001:
+        // c.jal in RV32, c.addiw in RV64
+        return xlen == 32 ? InstrClass::Jump : InstrClass::ALU;
+      case 0b101:
+        return InstrClass::Jump; // c.j
+      case 0b110:
+      case 0b111:
+        return InstrClass::Branch; // c.beqz, c.bnez
+      default:
+        return InstrClass::ALU;
+      }
+    case QUADRANT2: {
+      switch (funct3) {
+      case 0b000:
+        return InstrClass::ALU; // c.slli
+      case 0b001:
+      case 0b010:
+      case 0b011:
+        return InstrClass::Load; // c.fldsp, c.lwsp, c.ldsp/c.flwsp
+      case 0b100: {
+        const unsigned rs1 = (instr >> 7) & 0b11111;
+        const unsigned rs2 = (instr >> 2) & 0b11111;
+        if (rs2 != 0)
+          return InstrClass::ALU; // c.mv, c.add
+        if (rs1 == 0)
+          return InstrClass::Other; // c.ebreak
+        return InstrClass::Jump;    // c.jr, c.jalr
+      }
+      default:
+        return InstrClass::Store; // c.fsdsp, c.swsp, c.sdsp/c.fswsp
+      }
+    }
+    default:
+      return InstrClass::Other;
+    }
+  }
+
+  switch (instr & 0b1111111) {
+  case OpcodeID::LOAD:
+    return InstrClass::Load;
+  case OpcodeID::STORE:
+    return InstrClass::Store;
+  case OpcodeID::BRANCH:
+    return InstrClass::Branch;
+  case OpcodeID::JAL:
+  case OpcodeID::JALR:
+    return InstrClass::Jump;
+  case OpcodeID::SYSTEM:
+    // funct3 = 0 encodes ecall/ebreak; all others are CSR accesses.
+    return ((instr >> 12) & 0b111) == 0 ? InstrClass::Ecall
+                                        : InstrClass::Other;
+  case OpcodeID::OP:
+  case OpcodeID::OP32:
+    return (instr >> 25) == 0b0000001 ? InstrClass::MulDiv : InstrClass::ALU;
+  case OpcodeID::OPIMM:
+  case OpcodeID::OPIMM32:
+  case OpcodeID::LUI:
+  case OpcodeID::AUIPC:
+    return InstrClass::ALU;
+  default:
+    return InstrClass::Other;
+  }
+}
+
+/// Returns true if @p reg is a link register (x1/ra or x5/t0).
+inline bool isLinkReg(unsigned reg) { return reg == 1 || reg == 5; }
+
+/**
+ * @brief controlTransfer
+ * Determines whether the (possibly compressed) instruction @p instr is a
+ * procedure call or return. A jal/jalr which writes a link register is a call;
+ * a jalr which reads a link register without writing one is a return.
+ */
+inline ControlTransfer controlTransfer(uint32_t instr, unsigned xlen) {
+  if (instrSize(instr) == 2) {
+    const unsigned funct3 = (instr >> 13) & 0b111;
+    if ((instr & 0b11) == QUADRANT1 && funct3 == 0b001 && xlen == 32)
+      return ControlTransfer::Call; // c.jal
+    if ((instr & 0b11) == QUADRANT2 && funct3 == 0b100) {
+      const unsigned rs1 = (instr >> 7) & 0b11111;
+      const unsigned rs2 = (instr >> 2) & 0b11111;
+      if (rs2 != 0 || rs1 == 0)
+        return ControlTransfer::None;
+      if ((instr >> 12) & 0b1)
+        return ControlTransfer::Call; // c.jalr
+      return isLinkReg(rs1) ? ControlTransfer::Return
+                            : ControlTransfer::None; // c.jr
+    }
+    return ControlTransfer::None;
+  }
+
+  const unsigned rd = (instr >> 7) & 0b11111;
+  const unsigned rs1 = (instr >> 15) & 0b11111;
+  switch (instr & 0b1111111) {
+  case OpcodeID::JAL:
+    return isLinkReg(rd) ? ControlTransfer::Call : ControlTransfer::None;
+  case OpcodeID::JALR:
+    if (isLinkReg(rd))
+      return ControlTransfer::Call;
+    return isLinkReg(rs1) ? ControlTransfer::Return : ControlTransfer::None;
+  default:
+    return ControlTransfer::None;
+  }
+}
+
+/// Integer register operands of an instruction. Register 0 denotes an absent
+/// operand; as x0 is hardwired to zero, it never carries a dependency.
+struct RegOperands {
+  uint8_t rd = 0;
+  uint8_t rs1 = 0;
+  uint8_t rs2 = 0;
+};
+
+/**
+ * @brief regOperands
+ * Returns the integer register operands of the (possibly compressed)
+ * instruction @p instr. Floating-point register operands are not reported.
+ */
+inline RegOperands regOperands(uint32_t instr, unsigned xlen) {
+  RegOperands ops;
+  auto field = [instr](unsigned lsb, unsigned width) {
+    return static_cast<uint8_t>((instr >> lsb) & ((1u << width) - 1));
+  };
+
+  if (instrSize(instr) == 2) {
+    const unsigned funct3 = (instr >> 13) & 0b111;
+    // Full and compressed (x8-x15) register fields of the compressed formats.
+    const uint8_t r11_7 = field(7, 5), r6_2 = field(2, 5);
+    const uint8_t r9_7 = field(7, 3) + 8, r4_2 = field(2, 3) + 8;
+    switch (instr & 0b11) {
+    case QUADRANT0:
+      switch (funct3) {
+      case 0b000: // c.addi4spn
+        ops = {r4_2, 2, 0};
+        break;
+      case 0b010: // c.lw
+        ops = {r4_2, r9_7, 0};
+        break;
+      case 0b011: // c.ld (RV64), c.flw (RV32)
+        ops = {static_cast<uint8_t>(xlen == 64 ? r4_2 : 0), r9_7, 0};
+        break;
+      case 0b110: // c.sw
+        ops = {0, r9_7, r4_2};
+        break;
+      case 0b111: // c.sd (RV64), c.fsw (RV32)
+        ops = {0, r9_7, static_cast<uint8_t>(xlen == 64 ? r4_2 : 0)};
+        break;
+      default: // c.fld, c.fsd
+        ops = {0, r9_7, 0};
+        break;
+      }
+      break;
+    case QUADRANT1:
+      switch (funct3) {
+      case 0b000: // c.addi
+        ops = {r11_7, r11_7, 0};
+        break;
+      case 0b001: // c.jal (RV32), c.addiw (RV64)
+        ops = xlen == 32 ? RegOperands{1, 0, 0} : RegOperands{r11_7, r11_7, 0};
+        break;
+      case 0b010: // c.li
+        ops = {r11_7, 0, 0};
+        break;
+      case 0b011: // c.addi16sp, c.lui
+        ops = {r11_7, static_cast<uint8_t>(r11_7 == 2 ? 2 : 0), 0};
+        break;
+      case 0b100: // c.srli, c.srai, c.andi, c.sub, c.xor, ...
+        ops = {r9_7, r9_7,
+               static_cast<uint8_t>(field(10, 2) == 0b11 ? r4_2 : 0)};
+        break;
+      case 0b101: // c.j
+        break;
+      default: // c.beqz, c.bnez
+        ops = {0, r9_7, 0};
+        break;
+      }
+      break;
+    case QUADRANT2:
+      switch (funct3) {
+      case 0b000: // c.slli
+        ops = {r11_7, r11_7, 0};
+        break;
+      case 0b010: // c.lwsp
+        ops = {r11_7, 2, 0};
+        break;
+      case 0b011: // c.ldsp (RV64), c.flwsp (RV32)
+        ops = {static_cast<uint8_t>(xlen == 64 ? r11_7 : 0), 2, 0};
+        break;
+      case 0b100:
+        if ((instr >> 12) & 0b1) {
+          if (r6_2 != 0)
+            ops = {r11_7, r11_7, r6_2}; // c.add
+          else if (r11_7 != 0)
+            ops = {1, r11_7, 0}; // c.jalr
+        } else {
+          if (r6_2 != 0)
+            ops = {r11_7, 0, r6_2}; // c.mv
+          else
+            ops = {0, r11_7, 0}; // c.jr
+        }
+        break;
+      case 0b110: // c.swsp
+        ops = {0, 2, r6_2};
+        break;
+      case 0b111: // c.sdsp (RV64), c.fswsp (RV32)
+        ops = {0, 2, static_cast<uint8_t>(xlen == 64 ? r6_2 : 0)};
+        break;
+      default: // c.fldsp, c.fsdsp
+        ops = {0, 2, 0};
+        break;
+      }
+      break;
+    default:
+      break;
+    }
+    return ops;
+  }
+
+  const uint8_t rd = field(7, 5), rs1 = field(15, 5), rs2 = field(20, 5);
+  switch (instr & 0b1111111) {
+  case OpcodeID::LUI:
+  case OpcodeID::AUIPC:
+  case OpcodeID::JAL:
+    return {rd, 0, 0};
+  case OpcodeID::JALR:
+  case OpcodeID::LOAD:
+  case OpcodeID::OPIMM:
+  case OpcodeID::OPIMM32:
+    return {rd, rs1, 0};
+  case OpcodeID::BRANCH:
+  case OpcodeID::STORE:
+    return {0, rs1, rs2};
+  case OpcodeID::OP:
+  case OpcodeID::OP32:
+    return {rd, rs1, rs2};
+  case OpcodeID::SYSTEM:
+    // CSR accesses; the immediate variants (funct3[2] set) read no register.
+    if (((instr >> 12) & 0b111) == 0)
+      return {};
+    return {rd, static_cast<uint8_t>((instr >> 14) & 0b1 ? 0 : rs1), 0};
+  case 0b0000111: // LOAD-FP
+  case 0b0100111: // STORE-FP
+    return {0, rs1, 0};
+  default:
+    return {};
+  }
+}
+
+} // namespace RVISA
+} // namespace Ripes
@@ -50,6 +50,32 @@ const QStringList GPRRegDescs = QStringList() << "Hard-Wired zero"
                                            << "Temporary register\nSaver: Caller";
 // clang-format on
 
+int csrNumber(const QString &name) {
+  static const std::map<QString, int> csrs = [] {
+    std::map<QString, int> m = {
+        {"cycle", CYCLE},       {"time", TIME},         {"instret", INSTRET},
+        {"cycleh", CYCLEH},     {"timeh", TIMEH},       {"instreth", INSTRETH},
+        {"mcycle", MCYCLE},     {"minstret", MINSTRET}, {"mcycleh", MCYCLEH},
+        {"minstreth", MINSTRETH}};
+    for (unsigned i = 0; i < NHPMCounters; ++i) {
+      const QString n = QString::number(i + 3);
+      m["hpmcounter" + n] = HPMCOUNTER3 + i;
+      m["hpmcounter" + n + "h"] = HPMCOUNTER3H + i;
+      m["mhpmcounter" + n] = MHPMCOUNTER3 + i;
+      m["mhpmcounter" + n + "h"] = MHPMCOUNTER3H + i;
+    }
+    return m;
+  }();
+
+  auto it = csrs.find(name.toLower());
+  if (it != csrs.end())
+    return it->second;
+
+  bool ok;
+  const int csr = name.toInt(&ok, 0);
+  return ok && csr >= 0 && csr < (1 << 12) ? csr : -1;
+}
+
 } // namespace RVISA
 
 namespace RVABI {
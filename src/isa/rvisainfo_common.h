@@ -43,8 +43,17 @@ enum SysCall {
   Write = 64,
   FStat = 80,
   Exit2 = 93,
+  ExitGroup = 94,
+  ClockGetTime = 113,
+  GetTimeOfDay = 169,
   brk = 214,
-  Open = 1024
+  munmap = 215,
+  mmap = 222,
+  ClockGetTime64 = 403,
+  Open = 1024,
+  ROIBegin = 1100,
+  ROIEnd = 1101,
+  ROISnapshot = 1102
 };
 
 } // namespace RVABI
@@ -264,6 +273,32 @@ protected:
   RelocationsVec m_relocations;
 };
 
+/// Counter CSRs (Zicntr, Zihpm). The counters are read-only; machine-level
+/// counters alias their user-level shadows.
+enum CSR : unsigned {
+  MCYCLE = 0xB00,
+  MINSTRET = 0xB02,
+  MHPMCOUNTER3 = 0xB03,
+  MCYCLEH = 0xB80,
+  MINSTRETH = 0xB82,
+  MHPMCOUNTER3H = 0xB83,
+  CYCLE = 0xC00,
+  TIME = 0xC01,
+  INSTRET = 0xC02,
+  HPMCOUNTER3 = 0xC03,
+  CYCLEH = 0xC80,
+  TIMEH = 0xC81,
+  INSTRETH = 0xC82,
+  HPMCOUNTER3H = 0xC83
+};
+
+/// Number of hardware performance monitoring counters (hpmcounter3-31).
+constexpr unsigned NHPMCounters = 29;
+
+/// Returns the number of the CSR named @p name, or -1 if the name is unknown.
+/// Numeric CSR specifiers are passed through.
+int csrNumber(const QString &name);
+
 enum OpcodeID {
   LUI = 0b0110111,
   JAL = 0b1101111,
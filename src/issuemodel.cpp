@@ -0,0 +1,217 @@
+#include "issuemodel.h"
+
+#include "processorhandler.h"
+
+#include <algorithm>
+
+namespace Ripes {
+
+IssueModel::Config IssueModel::Config::forWidth(unsigned width) {
+  Config cfg;
+  static_cast<InOrderConfig &>(cfg) = InOrderConfig::forWidth(width);
+  return cfg;
+}
+
+IssueModel::IssueModel(QObject *parent) : RetirementObserver(parent) {}
+
+void IssueModel::setConfigs(const std::vector<Config> &configs) {
+  m_configs = configs;
+  resetMachines();
+}
+
+void IssueModel::resetMachines() {
+  m_machines.clear();
+  for (const auto &cfg : m_configs) {
+    Machine machine;
+    machine.cfg = cfg;
+    machine.stats = IssueStats(cfg.width);
+    m_machines.push_back(machine);
+  }
+}
+
+void IssueModel::observerReset() {
+  resetMachines();
+  m_slotInfo.assign(numSlots(), InstrInfo());
+  m_xlen = ProcessorHandler::currentISA()->bits();
+  m_pendingControl = false;
+  m_pendingNextPC = 0;
+}
+
+const IssueModel::InstrInfo &IssueModel::infoFor(AInt pc) {
+  InstrInfo &info = hasSlot(pc) ? m_slotInfo[slotForPC(pc)] : m_scratchInfo;
+  if (!info.decoded || &info == &m_scratchInfo) {
+    const uint32_t instr = instructionAt(pc);
+    info.decoded = true;
+    info.cls = RVISA::classifyInstr(instr, m_xlen);
+    info.size = RVISA::instrSize(instr);
+    info.regs = RVISA::regOperands(instr, m_xlen);
+  }
+  return info;
+}
+
+void IssueModel::instructionRetired(AInt pc, long long) {
+  // The outcome of the previously retired control-flow instruction is given by
+  // the PC of this instruction.
+  if (m_pendingControl && pc != m_pendingNextPC) {
+    for (auto &machine : m_machines)
+      machine.redirect();
+  }
+
+  const InstrInfo &info = infoFor(pc);
+  for (auto &machine : m_machines)
+    machine.issue(info);
+
+  m_pendingControl =
+      info.cls == InstrClass::Branch || info.cls == InstrClass::Jump;
+  m_pendingNextPC = pc + info.size;
+}
+
+void IssueModel::Machine::closeGroup(IssueStats::Reason reason) {
+  stats.account(count, reason);
+  cycle++;
+  count = alus = memPorts = mulDivUnits = rfReads = rfWrites = 0;
+  closedBy = IssueStats::Reason::None;
+}
+
+void IssueModel::Machine::redirect() {
+  barrier = lastIssueCycle + 1 + cfg.redirectPenalty;
+}
+
+void IssueModel::Machine::issue(const InstrInfo &info) {
+  using Reason = IssueStats::Reason;
+  const RegOperands &regs = info.regs;
+
+  // Cycle at which the source operands become available.
+  uint64_t dataReady = 0;
+  bool fromLoad = false;
+  for (uint8_t reg : {regs.rs1, regs.rs2}) {
+    if (reg != 0 && regReady[reg] > dataReady) {
+      dataReady = regReady[reg];
+      fromLoad = regFromLoad[reg];
+    }
+  }
+  auto stallReason = [&] {
+    if (barrier > cycle && barrier >= dataReady)
+      return Reason::Redirect;
+    return fromLoad ? Reason::LoadUse : Reason::DataDependency;
+  };
+
+  // Functional units and register file ports required by the instruction.
+  const bool isMem =
+      info.cls == InstrClass::Load || info.cls == InstrClass::Store;
+  const bool isMulDiv = info.cls == InstrClass::MulDiv;
+  const bool isALU = !isMem && !isMulDiv;
+  const unsigned reads = (regs.rs1 != 0) + (regs.rs2 != 0);
+  const unsigned writes = regs.rd != 0;
+  const bool isEcall = info.cls == InstrClass::Ecall;
+
+  // Determine whether the instruction can join the group being formed.
+  if (count > 0) {
+    Reason cut = Reason::None;
+    if (closedBy != Reason::None)
+      cut = closedBy;
+    else if (std::max(barrier, dataReady) > cycle)
+      cut = stallReason();
+    else if (isEcall)
+      cut = Reason::Serialization;
+    else if (isALU && alus == cfg.alus)
+      cut = Reason::ALU;
+    else if (isMem && memPorts == cfg.memPorts)
+      cut = Reason::MemPort;
+    else if (isMulDiv && mulDivUnits == cfg.mulDivUnits)
+      cut = Reason::MulDiv;
+    else if (rfReads + reads > cfg.rfReadPorts)
+      cut = Reason::RFReadPorts;
+    else if (rfWrites + writes > cfg.rfWritePorts)
+      cut = Reason::RFWritePorts;
+    if (cut != Reason::None)
+      closeGroup(cut);
+  }
+
+  // Idle cycles until the instruction may issue.
+  const uint64_t earliest = std::max({cycle, barrier, dataReady});
+  if (earliest > cycle) {
+    stats.accountCycles(0, stallReason(), earliest - cycle);
+    cycle = earliest;
+  }
+
+  count++;
+  alus += isALU;
+  memPorts += isMem;
+  mulDivUnits += isMulDiv;
+  rfReads += reads;
+  rfWrites += writes;
+  lastIssueCycle = cycle;
+  if (regs.rd != 0) {
+    unsigned latency = 1;
+    if (info.cls == InstrClass::Load)
+      latency = cfg.loadLatency;
+    else if (isMulDiv)
+      latency = cfg.mulDivLatency;
+    regReady[regs.rd] = cycle + latency;
+    regFromLoad[regs.rd] = info.cls == InstrClass::Load;
+  }
+
+  if (info.cls == InstrClass::Branch || info.cls == InstrClass::Jump)
+    closedBy = Reason::ControlFlow;
+  else if (isEcall)
+    closedBy = Reason::Serialization;
+  if (count == cfg.width)
+    closeGroup(Reason::None);
+}
+
+std::vector<IssueStats> IssueModel::stats() const {
+  std::vector<IssueStats> result;
+  for (const auto &machine : m_machines) {
+    IssueStats stats = machine.stats;
+    if (machine.count > 0)
+      stats.account(machine.count, machine.closedBy != IssueStats::Reason::None
+                                       ? machine.closedBy
+                                       : IssueStats::Reason::Other);
+    result.push_back(stats);
+  }
+  return result;
+}
+
+QVariantMap IssueModel::statsReport(const IssueStats &stats) {
+  QVariantMap m;
+  m["issue width"] = stats.width;
+  m["cycles"] = QVariant::fromValue(stats.cycles);
+  m["instructions"] = QVariant::fromValue(stats.issued);
+  m["IPC"] = stats.cycles > 0 ? static_cast<double>(stats.issued) /
+                                    static_cast<double>(stats.cycles)
+                              : 0.0;
+  m["slot utilization"] = 100.0 * stats.utilization();
+
+  QVariantMap groups;
+  for (unsigned n = 0; n < stats.groupSizes.size(); ++n)
+    groups[QString::number(n)] = QVariant::fromValue(stats.groupSizes[n]);
+  m["issue group sizes"] = groups;
+
+  QVariantMap lost;
+  for (const auto &[reason, name] : IssueReasonNames) {
+    const auto r = static_cast<unsigned>(reason);
+    if (stats.lostSlots[r] != 0)
+      lost[name] = QVariant::fromValue(stats.lostSlots[r]);
+  }
+  m["lost slots"] = lost;
+  return m;
+}
+
+QVariant IssueModel::report(bool) const {
+  QVariantMap report;
+  const auto allStats = stats();
+  for (unsigned i = 0; i < allStats.size(); ++i) {
+    const Config &cfg = m_configs.at(i);
+    QVariantMap m = statsReport(allStats[i]);
+    m["ALUs"] = cfg.alus;
+    m["memory ports"] = cfg.memPorts;
+    m["mul/div units"] = cfg.mulDivUnits;
+    m["register file read ports"] = cfg.rfReadPorts;
+    m["register file write ports"] = cfg.rfWritePorts;
+    report[QString::number(cfg.width) + "-wide"] = m;
+  }
+  return report;
+}
+
+} // namespace Ripes
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <QVariant>
+#include <array>
+#include <vector>
+
+#include "isa/rvinstrclass.h"
+#include "processors/interface/inorderconfig.h"
+#include "processors/interface/issuestats.h"
+#include "retirementobserver.h"
+
+namespace Ripes {
+
+/**
+ * @brief The IssueModel class
+ * A trace-driven model of N-wide, in-order superscalar issue. The retired
+ * instruction stream of the current processor is replayed through one or more
+ * machine configurations, each of which greedily forms issue groups under the
+ * same rules as the dual-issue processor and the N-wide in-order processors
+ * (RVINORDER):
+ *  - an instruction cannot issue before its source operands are available
+ *    (ALU results are forwarded to the next cycle, load results one cycle
+ *    later),
+ *  - a control-flow instruction ends its issue group, and issue resumes
+ *    redirectPenalty cycles after a taken control-flow instruction,
+ *  - environment calls issue alone,
+ *  - each group is limited by the number of functional units (ALUs, memory
+ *    ports, mul/div units) and register file read/write ports.
+ *
+ * Unused issue slots are attributed to the reason which ended their group.
+ * The model is an offline analysis tool, for exploring configurations which
+ * have no processor model; the in-order processors report the issue
+ * statistics of the schedules they simulate.
+ */
+class IssueModel : public RetirementObserver {
+  Q_OBJECT
+public:
+  /// The model shares the resources of the in-order superscalar processors.
+  /// Its mul/div units are pipelined, with a fixed latency.
+  struct Config : InOrderConfig {
+    unsigned mulDivLatency = 1;
+
+    static Config forWidth(unsigned width);
+  };
+
+  IssueModel(QObject *parent = nullptr);
+
+  void setConfigs(const std::vector<Config> &configs);
+  const std::vector<Config> &configs() const { return m_configs; }
+
+  /// Returns the issue statistics of each configuration. The issue group
+  /// currently being formed is accounted for as if it was cut short.
+  std::vector<IssueStats> stats() const;
+
+  QVariant report(bool json) const;
+
+  /// Returns a report of @p stats (IPC, slot utilization, issue group sizes
+  /// and lost issue slots per reason).
+  static QVariantMap statsReport(const IssueStats &stats);
+
+protected:
+  void instructionRetired(AInt pc, long long cycle) override;
+  void observerReset() override;
+
+private:
+  struct InstrInfo {
+    bool decoded = false;
+    InstrClass cls = InstrClass::Other;
+    uint8_t size = 4;
+    RegOperands regs;
+  };
+
+  struct Machine {
+    Config cfg;
+    IssueStats stats;
+
+    // Cycle of the issue group being formed.
+    uint64_t cycle = 0;
+    // Earliest issue cycle after the latest taken control-flow instruction.
+    uint64_t barrier = 0;
+    // Cycle at which the value of each register becomes available, and
+    // whether it is produced by a load.
+    std::array<uint64_t, 32> regReady{};
+    std::array<bool, 32> regFromLoad{};
+
+    // Resources used by the issue group being formed.
+    unsigned count = 0;
+    unsigned alus = 0;
+    unsigned memPorts = 0;
+    unsigned mulDivUnits = 0;
+    unsigned rfReads = 0;
+    unsigned rfWrites = 0;
+    // Set if the group was ended by the latest instruction added to it.
+    IssueStats::Reason closedBy = IssueStats::Reason::None;
+    uint64_t lastIssueCycle = 0;
+
+    void closeGroup(IssueStats::Reason reason);
+    void issue(const InstrInfo &info);
+    void redirect();
+  };
+
+  void resetMachines();
+  const InstrInfo &infoFor(AInt pc);
+
+  std::vector<Config> m_configs;
+  std::vector<Machine> m_machines;
+  std::vector<InstrInfo> m_slotInfo;
+  InstrInfo m_scratchInfo;
+  unsigned m_xlen = 32;
+
+  // The previously retired instruction, if it was a control-flow instruction.
+  bool m_pendingControl = false;
+  AInt m_pendingNextPC = 0;
+};
+
+} // namespace Ripes
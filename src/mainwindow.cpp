@@ -112,10 +112,6 @@ MainWindow::MainWindow(QWidget *parent)
   // Setup status bar
   setupStatusBar();
 
-  // Reset and program reload signals
-  connect(ProcessorHandler::get(), &ProcessorHandler::processorReset,
-          [=] { SystemIO::reset(); });
-
   connect(m_ui->actionSystem_calls, &QAction::triggered, this, [=] {
     SyscallViewer v;
     v.exec();
@@ -246,6 +242,9 @@ void MainWindow::setupMenus() {
   m_ui->menuView->addAction(
       static_cast<ProcessorTab *>(m_tabWidgets.at(ProcessorTabID).tab)
           ->m_displayValuesAction);
+  m_ui->menuView->addAction(
+      static_cast<ProcessorTab *>(m_tabWidgets.at(ProcessorTabID).tab)
+          ->m_showHeatAction);
 
   // File I/O is not yet supported on WASM due to sandboxing.
   disableIfWasm(QList{loadAction, saveAction, saveAsAction, exitAction});
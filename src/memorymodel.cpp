@@ -20,9 +20,29 @@ int MemoryModel::rowCount(const QModelIndex &) const { return m_rowsVisible; }
 void MemoryModel::processorWasClocked() {
   // Reload model
   beginResetModel();
+  const auto bytes = ProcessorHandler::currentISA()->bytes();
+  const AInt top = m_centralAddress + (m_rowsVisible / 2) * bytes;
+  const AInt size = static_cast<AInt>(m_rowsVisible) * bytes;
+  m_visible.clear();
+  if (size > 0 && top + bytes >= size) {
+    m_visibleStart = top + bytes - size;
+    m_visible.resize(size);
+    ProcessorHandler::getMemory().readBlock(m_visibleStart, m_visible.data(),
+                                            size);
+  }
   endResetModel();
 }
 
+VInt MemoryModel::readVisible(AInt address, unsigned bytes) const {
+  if (address < m_visibleStart ||
+      address - m_visibleStart + bytes > m_visible.size())
+    return ProcessorHandler::getMemory().readMemConst(address, bytes);
+  VInt value = 0;
+  for (unsigned i = bytes; i-- > 0;)
+    value = (value << 8) | m_visible[address - m_visibleStart + i];
+  return value;
+}
+
 AInt maxAddress() {
   return vsrtl::generateBitmask(ProcessorHandler::currentISA()->bits());
 }
@@ -187,9 +207,7 @@ QVariant MemoryModel::byteData(AInt address, AInt byteOffset,
     // so). Instead, create a "fake" entry in the memory model, containing X's.
     return "X";
   } else {
-    VInt value =
-        ProcessorHandler::getMemory().readMemConst(address + byteOffset, 1);
-    return encodeRadixValue(value & 0xFF, m_radix, 1);
+    return encodeRadixValue(readVisible(address + byteOffset, 1), m_radix, 1);
   }
 }
 
@@ -202,9 +220,7 @@ QVariant MemoryModel::wordData(AInt address, bool validAddress) const {
     return "X";
   } else {
     unsigned bytes = ProcessorHandler::currentISA()->bytes();
-    return encodeRadixValue(
-        ProcessorHandler::getMemory().readMemConst(address, bytes), m_radix,
-        bytes);
+    return encodeRadixValue(readVisible(address, bytes), m_radix, bytes);
   }
 }
 
@@ -4,6 +4,8 @@
 
 #include "radix.h"
 
+#include <vector>
+
 namespace Ripes {
 
 class MemoryModel : public QAbstractTableModel {
@@ -36,11 +38,19 @@ private:
   QVariant byteData(AInt address, AInt byteOffset, bool validAddress) const;
   QVariant wordData(AInt address, bool validAddress) const;
   QVariant fgColorData(AInt address, AInt byteOffset, bool validAddress) const;
+  /// Reads @p bytes bytes at @p address from the snapshot of the visible
+  /// memory, or from memory if the address is outside the snapshot.
+  VInt readVisible(AInt address, unsigned bytes) const;
 
   Radix m_radix = Radix::Hex;
 
   AInt m_centralAddress = 0; // Memory address at the center of the model
   int m_rowsVisible = 0;     // Number of rows currently visible in the view
                              // associated with the model
+
+  // Snapshot of the visible memory, read in bulk whenever the model is
+  // reloaded rather than once per cell.
+  AInt m_visibleStart = 0;
+  std::vector<uint8_t> m_visible;
 };
 } // namespace Ripes
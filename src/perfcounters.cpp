@@ -0,0 +1,135 @@
+#include "perfcounters.h"
+
+#include "isa/rvisainfo_common.h"
+#include "processorhandler.h"
+#include "selfprofiler.h"
+
+#include "VSRTL/core/vsrtl_register.h"
+
+namespace Ripes {
+
+void PerformanceCounters::setEventSource(Event event,
+                                         std::function<uint64_t()> source) {
+  s_sources[event] = source;
+}
+
+void PerformanceCounters::attach(ProcessorHandler *handler) {
+  s_handler = handler;
+  // Events must be counted in lockstep with the processor; execute the
+  // handlers in the simulation thread (direct connection).
+  QObject::connect(
+      handler, &ProcessorHandler::processorReversed, handler,
+      [] { processorWasReversed(); }, Qt::DirectConnection);
+  QObject::connect(
+      handler, &ProcessorHandler::processorReset, handler,
+      [] { processorReset(); }, Qt::DirectConnection);
+}
+
+void PerformanceCounters::setEnabled(bool enabled) {
+  if (enabled == s_enabled)
+    return;
+  s_enabled = enabled;
+  processorReset();
+  if (!s_enabled) {
+    QObject::disconnect(s_clockedConnection);
+    return;
+  }
+  s_clockedConnection = QObject::connect(
+      s_handler, &ProcessorHandler::processorClocked, s_handler,
+      [] { processorWasClocked(); }, Qt::DirectConnection);
+}
+
+void PerformanceCounters::processorReset() {
+  s_stallCycles = 0;
+  s_flushCycles = 0;
+  s_history.clear();
+}
+
+void PerformanceCounters::processorWasClocked() {
+  SelfProfiler::Scope scope(SelfProfiler::PerformanceCounters);
+  const auto *proc = ProcessorHandler::getProcessor();
+  bool stalled = false, flushed = false;
+  for (auto idx : proc->structure().stageIt()) {
+    const auto state = proc->stageInfo(idx).state;
+    stalled |= state == StageInfo::State::Stalled;
+    flushed |= state == StageInfo::State::Flushed;
+  }
+  if (!stalled && !flushed)
+    return;
+  s_stallCycles += stalled;
+  s_flushCycles += flushed;
+
+  // Events older than the reverse stack of the design can never be undone.
+  const long long cycle = proc->getCycleCount();
+  s_history.push_back({cycle, stalled, flushed});
+  const long long depth = vsrtl::core::ClockedComponent::reverseStackSize();
+  while (s_history.front().cycle + depth < cycle)
+    s_history.pop_front();
+}
+
+void PerformanceCounters::processorWasReversed() {
+  const long long cycle = ProcessorHandler::getProcessor()->getCycleCount();
+  while (!s_history.empty() && s_history.back().cycle > cycle) {
+    s_stallCycles -= s_history.back().stalled;
+    s_flushCycles -= s_history.back().flushed;
+    s_history.pop_back();
+  }
+}
+
+uint64_t PerformanceCounters::counter(unsigned csr) {
+  using namespace RVISA;
+  const auto *proc = ProcessorHandler::getProcessor();
+  switch (csr) {
+  case CYCLE:
+  case MCYCLE:
+  case TIME:
+    return proc->getCycleCount();
+  case INSTRET:
+  case MINSTRET:
+    return proc->getInstructionsRetired();
+  default:
+    break;
+  }
+
+  unsigned hpm;
+  if (csr >= HPMCOUNTER3 && csr < HPMCOUNTER3 + NHPMCounters)
+    hpm = csr - HPMCOUNTER3 + 3;
+  else if (csr >= MHPMCOUNTER3 && csr < MHPMCOUNTER3 + NHPMCounters)
+    hpm = csr - MHPMCOUNTER3 + 3;
+  else
+    return 0;
+
+  switch (hpm - c_firstHPMCounter) {
+  case StallCycles:
+    return s_stallCycles;
+  case FlushCycles:
+    return s_flushCycles;
+  case MulDivLatencyStalls:
+  case MulDivStructuralStalls: {
+    const auto *stats = proc->functionalUnitStats();
+    if (!stats)
+      return 0;
+    return hpm - c_firstHPMCounter == MulDivLatencyStalls
+               ? stats->latencyStalls
+               : stats->structuralStalls;
+  }
+  case ICacheMisses:
+  case DCacheMisses: {
+    const auto &source = s_sources[hpm - c_firstHPMCounter];
+    return source ? source() : 0;
+  }
+  default:
+    return 0;
+  }
+}
+
+VInt PerformanceCounters::read(unsigned csr) {
+  // High halves of the counters (RV32 only) are offset by 0x80 from the low
+  // halves.
+  if ((csr & 0xF80) == (RVISA::CYCLEH & 0xF80) ||
+      (csr & 0xF80) == (RVISA::MCYCLEH & 0xF80))
+    return static_cast<VInt>(counter(csr - 0x80) >> 32);
+  return static_cast<VInt>(counter(csr));
+}
+
+} // namespace Ripes
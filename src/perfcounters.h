@@ -0,0 +1,92 @@
+#pragma once
+
+#include <QObject>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+#include "isa/isa_types.h"
+
+namespace Ripes {
+
+class ProcessorHandler;
+
+/**
+ * @brief The PerformanceCounters class
+ * Backs the counter CSRs (cycle, time, instret and hpmcounter3-31) which the
+ * processor models read through RipesProcessor::csrReadHandler.
+ *
+ * The time CSR ticks once per cycle, such that guest timing is deterministic.
+ * The hardware performance monitoring counters are mapped to fixed events,
+ * starting at hpmcounter3 (see Event). Unmapped counters read as zero.
+ *
+ * Stall and flush events are counted in the simulation thread, in lockstep with
+ * the processor, and are undone when the processor is reversed. Counting them
+ * requires scanning the pipeline every cycle, so they are only counted when
+ * enabled through setEnabled, and read as zero otherwise. Multiply/divide
+ * stalls are read from the processor, and cache miss events from the sources
+ * registered through setEventSource.
+ */
+class PerformanceCounters {
+public:
+  enum Event : unsigned {
+    // Misses in the L1 instruction/data cache.
+    ICacheMisses,
+    DCacheMisses,
+    // Cycles in which a stage of the pipeline was stalled (ie. load-use
+    // hazards).
+    StallCycles,
+    // Cycles in which stages of the pipeline were flushed (ie. taken
+    // branches).
+    FlushCycles,
+    // Cycles in which an instruction waited for the result of a multi-cycle
+    // multiply/divide, or for a non-pipelined multiply/divide unit.
+    MulDivLatencyStalls,
+    MulDivStructuralStalls,
+    NEvents
+  };
+
+  /// hpmcounter which the first event is mapped to.
+  static constexpr unsigned c_firstHPMCounter = 3;
+
+  /// Sets the function from which the value of @p event is read. An empty
+  /// function makes the counter read as zero.
+  static void setEventSource(Event event, std::function<uint64_t()> source);
+
+  /// Returns the value of the counter CSR @p csr. High-half CSRs return the
+  /// upper 32 bits of the counter.
+  static VInt read(unsigned csr);
+
+  /// Connects the internal event counters to @p handler.
+  static void attach(ProcessorHandler *handler);
+  /// Enables counting the stall and flush events. The counts restart from
+  /// zero.
+  static void setEnabled(bool enabled);
+  static bool isEnabled() { return s_enabled; }
+
+private:
+  static uint64_t counter(unsigned csr);
+  static void processorWasClocked();
+  static void processorWasReversed();
+  static void processorReset();
+
+  // Stall and flush events of a cycle, recorded such that they can be undone
+  // when the processor is reversed. Only cycles with events are recorded.
+  struct CycleEvents {
+    long long cycle;
+    bool stalled;
+    bool flushed;
+  };
+
+  static inline ProcessorHandler *s_handler = nullptr;
+  static inline bool s_enabled = false;
+  static inline QMetaObject::Connection s_clockedConnection;
+  static inline std::array<std::function<uint64_t()>, NEvents> s_sources;
+  static inline uint64_t s_stallCycles = 0;
+  static inline uint64_t s_flushCycles = 0;
+  static inline std::deque<CycleEvents> s_history;
+};
+
+} // namespace Ripes
@@ -2,6 +2,7 @@
 
 #include "processorhandler.h"
 #include "ripessettings.h"
+#include "selfprofiler.h"
 
 #include <vector>
 
@@ -48,6 +49,7 @@ int PipelineDiagramModel::columnCount(const QModelIndex &) const {
 }
 
 void PipelineDiagramModel::processorWasClocked() {
+  SelfProfiler::Scope scope(SelfProfiler::PipelineDiagram);
   if (m_atMaxCycles) {
     return;
   }
@@ -1,8 +1,10 @@
 #include "processorhandler.h"
 
 #include "processorregistry.h"
+#include "perfcounters.h"
 #include "processors/ripesvsrtlprocessor.h"
 #include "ripessettings.h"
+#include "selfprofiler.h"
 #include "statusmanager.h"
 
 #include "assembler/assembler.h"
@@ -43,6 +45,10 @@ ProcessorHandler::ProcessorHandler() {
     extensions = RipesSettings::value(RIPES_SETTING_PROCESSOR_EXTENSIONS)
                      .value<QStringList>();
 
+  setBranchPredictorConfigFromSettings();
+  setOoOConfigFromSettings();
+  setFULatenciesFromSettings();
+  setPipelineConfigFromSettings();
   _selectProcessor(
       m_currentID, extensions,
       ProcessorRegistry::getDescription(m_currentID).defaultRegisterVals);
@@ -60,7 +66,10 @@ ProcessorHandler::ProcessorHandler() {
           });
 
   connect(&m_procStateChangeTimer, &QTimer::timeout, this, [=] {
-    emit procStateChangedNonRun();
+    // Views read the processor state, which may not be accessed while another
+    // thread is running the processor. The end of a run triggers an update.
+    if (!_isRunning())
+      emit procStateChangedNonRun();
     m_enqueueStateChangeLock.lock();
     if (m_enqueueStateChangeSignal) {
       m_enqueueStateChangeSignal = false;
@@ -71,12 +80,19 @@ ProcessorHandler::ProcessorHandler() {
 
   // Connect the runwatcher finished signals
   connect(&m_runWatcher, &QFutureWatcher<void>::finished, this, [=] {
+    // Output and files written by the program are made visible while it is
+    // paused.
+    SystemIO::flushOutput();
+    SystemIO::flushFiles();
     emit runFinished();
     _triggerProcStateChangeTimer();
   });
   connect(&m_runWatcher, &QFutureWatcher<void>::finished, this,
           [=] { ProcessorStatusManager::clearStatus(); });
 
+  connect(&m_sourceInfoWatcher, &QFutureWatcher<void>::finished, this,
+          &ProcessorHandler::sourceInfoChanged);
+
   // Connect relevant settings changes to VSRTL
   connect(RipesSettings::getObserver(RIPES_SETTING_REWINDSTACKSIZE),
           &SettingObserver::modified, this, [=](const auto &size) {
@@ -87,22 +103,65 @@ ProcessorHandler::ProcessorHandler() {
   m_currentProcessor->setMaxReverseCycles(
       RipesSettings::value(RIPES_SETTING_REWINDSTACKSIZE).toInt());
 
-  connect(RipesSettings::getObserver(RIPES_SETTING_VCD_TRACE),
+  PerformanceCounters::attach(this);
+  connect(RipesSettings::getObserver(RIPES_SETTING_HPM_EVENTS),
           &SettingObserver::modified, this, [=](const auto &enabled) {
-            m_currentProcessor->vcdTrace(
-                enabled.toBool(),
-                RipesSettings::value(RIPES_SETTING_VCD_TRACE_FILE).toString());
+            PerformanceCounters::setEnabled(enabled.toBool());
           });
+  PerformanceCounters::setEnabled(
+      RipesSettings::value(RIPES_SETTING_HPM_EVENTS).toBool());
+
+  // Drive the VCD tracer (if any) in lockstep with the processor.
+  connect(
+      this, &ProcessorHandler::processorClocked, this,
+      [=] {
+        if (m_vcdTracer)
+          m_vcdTracer->processorWasClocked();
+      },
+      Qt::DirectConnection);
+  connect(this, &ProcessorHandler::processorReset, this, [=] {
+    if (m_vcdTracer)
+      m_vcdTracer->processorReset();
+  });
 
-  connect(RipesSettings::getObserver(RIPES_SETTING_VCD_TRACE_FILE),
-          &SettingObserver::modified, this, [=](const auto &file) {
-            m_currentProcessor->vcdTrace(
-                RipesSettings::value(RIPES_SETTING_VCD_TRACE).toBool(),
-                file.toString());
-          });
+  for (const auto &setting :
+       {RIPES_SETTING_VCD_TRACE, RIPES_SETTING_VCD_TRACE_FILE,
+        RIPES_SETTING_VCD_TRACE_SIGNALS, RIPES_SETTING_VCD_TRACE_START,
+        RIPES_SETTING_VCD_TRACE_STOP, RIPES_SETTING_VCD_TRACE_COMPRESS}) {
+    connect(RipesSettings::getObserver(setting), &SettingObserver::modified,
+            this, &ProcessorHandler::setVCDTraceFromSettings);
+  }
 
   // Reset VCD trace status.
-  RipesSettings::getObserver(RIPES_SETTING_VCD_TRACE_FILE)->trigger();
+  setVCDTraceFromSettings();
+
+  for (const auto &setting :
+       {RIPES_SETTING_BP_TYPE, RIPES_SETTING_BP_PHT_ENTRIES,
+        RIPES_SETTING_BP_HISTORY_BITS, RIPES_SETTING_BP_BTB_ENTRIES,
+        RIPES_SETTING_BP_RAS_ENTRIES}) {
+    connect(RipesSettings::getObserver(setting), &SettingObserver::modified,
+            this, &ProcessorHandler::setBranchPredictorConfigFromSettings);
+  }
+  for (const auto &setting :
+       {RIPES_SETTING_OOO_WIDTH, RIPES_SETTING_OOO_ROB_ENTRIES,
+        RIPES_SETTING_OOO_RS_ENTRIES, RIPES_SETTING_OOO_LSQ_ENTRIES,
+        RIPES_SETTING_OOO_LOAD_LATENCY}) {
+    connect(RipesSettings::getObserver(setting), &SettingObserver::modified,
+            this, &ProcessorHandler::setOoOConfigFromSettings);
+  }
+  for (const auto &setting :
+       {RIPES_SETTING_MUL_LATENCY, RIPES_SETTING_MUL_PIPELINED,
+        RIPES_SETTING_DIV_LATENCY, RIPES_SETTING_DIV_PIPELINED}) {
+    connect(RipesSettings::getObserver(setting), &SettingObserver::modified,
+            this, &ProcessorHandler::setFULatenciesFromSettings);
+  }
+  for (const auto &setting :
+       {RIPES_SETTING_PIPELINE_FORWARDING, RIPES_SETTING_PIPELINE_HAZARD,
+        RIPES_SETTING_PIPELINE_BRANCH_STAGE, RIPES_SETTING_PIPELINE_DB,
+        RIPES_SETTING_PIPELINE_PREDICTION}) {
+    connect(RipesSettings::getObserver(setting), &SettingObserver::modified,
+            this, &ProcessorHandler::setPipelineConfigFromSettings);
+  }
 
   // Reset request handling
   connect(RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET),
@@ -130,9 +189,19 @@ void ProcessorHandler::_loadProgram(const std::shared_ptr<Program> &p) {
   m_program = p;
   // Memory initializations
   mem.clearInitializationMemories();
-  for (const auto &seg : p->sections) {
-    mem.addInitializationMemory(seg.second.address, seg.second.data.data(),
-                                seg.second.data.length());
+  if (!p->segments.empty()) {
+    // Memory beyond the file-backed part of a segment is unallocated, and
+    // thus reads as zero. Memory refers to the mapping of the program, if any,
+    // rather than copying it.
+    for (const auto &seg : p->segments)
+      mem.addInitializationMemory(seg.address, seg.data.constData(),
+                                  seg.data.length(), p->mapping);
+  } else {
+    for (const auto &seg : p->sections) {
+      mem.addInitializationMemory(seg.second.address,
+                                  seg.second.data.constData(),
+                                  seg.second.data.length(), p->mapping);
+    }
   }
 
   m_currentProcessor->setPCInitialValue(p->entryPoint);
@@ -153,13 +222,25 @@ void ProcessorHandler::_loadProgram(const std::shared_ptr<Program> &p) {
 
   RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
   emit programChanged();
+
+  // Source information (i.e. DWARF line tables) may be slow to build, and is
+  // built while the program is already in use.
+  m_sourceInfoWatcher.setFuture(p->loadSourceInfo());
 }
 
 void ProcessorHandler::_writeMem(AInt address, VInt value, int size) {
   m_currentProcessor->getMemory().writeMem(address, value, size);
+  emit memoryWritten(address, static_cast<unsigned>(size));
 }
 
-vsrtl::core::AddressSpaceMM &ProcessorHandler::_getMemory() {
+void ProcessorHandler::_writeBlock(AInt address, const char *data,
+                                   size_t size) {
+  m_currentProcessor->getMemory().writeBlock(
+      address, reinterpret_cast<const uint8_t *>(data), size);
+  emit memoryWritten(address, static_cast<unsigned>(size));
+}
+
+PagedAddressSpace &ProcessorHandler::_getMemory() {
   return m_currentProcessor->getMemory();
 }
 
@@ -213,8 +294,10 @@ void ProcessorHandler::_run() {
       vsrtl_proc->setEnableSignals(false);
     }
 
+    SelfProfiler::Scope runScope(SelfProfiler::Run);
     while (!(_checkBreakpoint() || m_currentProcessor->finished() ||
              m_stopRunningFlag)) {
+      SelfProfiler::Scope clockScope(SelfProfiler::Clock);
       m_currentProcessor->clock();
     }
 
@@ -249,6 +332,7 @@ bool ProcessorHandler::_hasBreakpoint(const AInt address) const {
 }
 
 bool ProcessorHandler::_checkBreakpoint() {
+  SelfProfiler::Scope scope(SelfProfiler::BreakpointChecks);
   for (const auto &stage : m_currentProcessor->breakpointTriggeringStages()) {
     const auto it =
         m_breakpoints.find(m_currentProcessor->getPcForStage(stage));
@@ -278,6 +362,8 @@ void ProcessorHandler::_reset() {
   }
 
   SystemIO::abortSyscall();
+  // Close the files opened by the program, writing any buffered data.
+  SystemIO::reset();
   getProcessorNonConst()->resetProcessor();
 
   // Rewrite register initializations
@@ -296,6 +382,168 @@ void ProcessorHandler::_reset() {
   emit procStateChangedNonRun();
 }
 
+void ProcessorHandler::setVCDTraceFromSettings() {
+  if (!RipesSettings::value(RIPES_SETTING_VCD_TRACE).toBool()) {
+    _setVCDTrace(std::nullopt);
+    return;
+  }
+
+  VCDTracer::Config config;
+  config.file = RipesSettings::value(RIPES_SETTING_VCD_TRACE_FILE).toString();
+  config.signalPatterns =
+      RipesSettings::value(RIPES_SETTING_VCD_TRACE_SIGNALS)
+          .toString()
+          .split(QRegularExpression("[,\\s]+"), Qt::SkipEmptyParts);
+  config.startCycle =
+      RipesSettings::value(RIPES_SETTING_VCD_TRACE_START).toLongLong();
+  config.stopCycle =
+      RipesSettings::value(RIPES_SETTING_VCD_TRACE_STOP).toLongLong();
+  config.compress =
+      RipesSettings::value(RIPES_SETTING_VCD_TRACE_COMPRESS).toBool();
+  _setVCDTrace(config);
+}
+
+void ProcessorHandler::setBranchPredictorConfigFromSettings() {
+  BranchPredictorConfig config;
+  const QString type = RipesSettings::value(RIPES_SETTING_BP_TYPE).toString();
+  for (const auto &it : BranchPredictorTypeNames)
+    if (it.second == type)
+      config.type = it.first;
+  config.phtEntries =
+      RipesSettings::value(RIPES_SETTING_BP_PHT_ENTRIES).toUInt();
+  config.historyBits =
+      RipesSettings::value(RIPES_SETTING_BP_HISTORY_BITS).toUInt();
+  config.btbEntries =
+      RipesSettings::value(RIPES_SETTING_BP_BTB_ENTRIES).toUInt();
+  config.rasEntries =
+      RipesSettings::value(RIPES_SETTING_BP_RAS_ENTRIES).toUInt();
+  _setBranchPredictorConfig(config);
+}
+
+void ProcessorHandler::_setBranchPredictorConfig(
+    const BranchPredictorConfig &config) {
+  m_bpConfig = config;
+  if (m_constructing || !m_currentProcessor)
+    return;
+
+  if (auto *bp = m_currentProcessor->branchPredictor()) {
+    // Predictor state is discarded; restart execution from a consistent
+    // state.
+    _stopRun();
+    bp->configure(m_bpConfig);
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+  }
+}
+
+void ProcessorHandler::setOoOConfigFromSettings() {
+  OoOConfig config = m_oooConfig;
+  config.width = RipesSettings::value(RIPES_SETTING_OOO_WIDTH).toUInt();
+  config.robEntries =
+      RipesSettings::value(RIPES_SETTING_OOO_ROB_ENTRIES).toUInt();
+  config.rsEntries =
+      RipesSettings::value(RIPES_SETTING_OOO_RS_ENTRIES).toUInt();
+  config.lsqEntries =
+      RipesSettings::value(RIPES_SETTING_OOO_LSQ_ENTRIES).toUInt();
+  config.loadLatency =
+      RipesSettings::value(RIPES_SETTING_OOO_LOAD_LATENCY).toUInt();
+  _setOoOConfig(config);
+}
+
+void ProcessorHandler::_setOoOConfig(const OoOConfig &config) {
+  m_oooConfig = config;
+  m_oooConfig.sanitize();
+  if (m_constructing || !m_currentProcessor)
+    return;
+
+  if (auto *ooo = m_currentProcessor->outOfOrderConfig()) {
+    // The instruction window is resized; restart execution.
+    _stopRun();
+    *ooo = m_oooConfig;
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+  }
+}
+
+void ProcessorHandler::setFULatenciesFromSettings() {
+  FULatencies latencies = m_fuLatencies;
+  latencies.mul.latency =
+      RipesSettings::value(RIPES_SETTING_MUL_LATENCY).toUInt();
+  latencies.mul.pipelined =
+      RipesSettings::value(RIPES_SETTING_MUL_PIPELINED).toBool();
+  latencies.div.latency =
+      RipesSettings::value(RIPES_SETTING_DIV_LATENCY).toUInt();
+  latencies.div.pipelined =
+      RipesSettings::value(RIPES_SETTING_DIV_PIPELINED).toBool();
+  _setFULatencies(latencies);
+}
+
+void ProcessorHandler::_setFULatencies(const FULatencies &latencies) {
+  m_fuLatencies = latencies;
+  m_fuLatencies.sanitize();
+  if (m_constructing || !m_currentProcessor)
+    return;
+
+  if (auto *fu = m_currentProcessor->functionalUnitLatencies()) {
+    // Latencies take effect upon reset; restart execution.
+    _stopRun();
+    *fu = m_fuLatencies;
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+  }
+}
+
+void ProcessorHandler::setPipelineConfigFromSettings() {
+  PipelineConfig config;
+  config.forwarding =
+      RipesSettings::value(RIPES_SETTING_PIPELINE_FORWARDING).toBool();
+  config.hazardDetection =
+      RipesSettings::value(RIPES_SETTING_PIPELINE_HAZARD).toBool();
+  const QString stage =
+      RipesSettings::value(RIPES_SETTING_PIPELINE_BRANCH_STAGE).toString();
+  for (const auto &it : BranchStageNames)
+    if (it.second == stage)
+      config.branchStage = it.first;
+  config.delayedBranch =
+      RipesSettings::value(RIPES_SETTING_PIPELINE_DB).toBool();
+  config.prediction =
+      RipesSettings::value(RIPES_SETTING_PIPELINE_PREDICTION).toBool();
+  _setPipelineConfig(config);
+}
+
+void ProcessorHandler::_setPipelineConfig(const PipelineConfig &config) {
+  // The datapath of a parametric processor is fixed upon construction, such
+  // that the configuration is only recorded for the next processor selection.
+  m_pipelineConfig = config;
+  m_pipelineConfig.sanitize();
+}
+
+void ProcessorHandler::_setVCDTrace(
+    const std::optional<VCDTracer::Config> &config) {
+  if (!m_constructing)
+    _stopRun();
+  m_vcdConfig = config;
+  createVCDTracer();
+}
+
+void ProcessorHandler::createVCDTracer() {
+  // Finalize any ongoing trace before a new one is started, in case the same
+  // file is written.
+  m_vcdTracer.reset();
+
+  if (!m_currentProcessor)
+    return;
+
+  auto *design = dynamic_cast<vsrtl::core::Design *>(m_currentProcessor.get());
+  if (!design) {
+    // Fall back to any tracing which the simulator of the processor provides.
+    m_currentProcessor->vcdTrace(m_vcdConfig.has_value(),
+                                 m_vcdConfig ? m_vcdConfig->file : QString());
+    return;
+  }
+
+  if (m_vcdConfig)
+    m_vcdTracer = std::make_unique<VCDTracer>(design, m_currentProcessor.get(),
+                                              *m_vcdConfig);
+}
+
 void ProcessorHandler::_selectProcessor(const ProcessorID &id,
                                         const QStringList &extensions,
                                         const RegisterInitialization &setup) {
@@ -311,9 +559,13 @@ void ProcessorHandler::_selectProcessor(const ProcessorID &id,
           ProcessorRegistry::getDescription(id).isaInfo().isa.get(),
           extensions));
 
+  // The VCD tracer refers to the signals of the current processor.
+  m_vcdTracer.reset();
+
   // Processor initializations
   m_currentProcessor =
-      ProcessorRegistry::constructProcessor(m_currentID, extensions);
+      ProcessorRegistry::constructProcessor(m_currentID, extensions,
+                                            m_pipelineConfig);
   m_currentProcessor->isExecutableAddress = [=](AInt address) {
     return _isExecutableAddress(address);
   };
@@ -321,8 +573,21 @@ void ProcessorHandler::_selectProcessor(const ProcessorID &id,
   // Syscall handling initialization
   m_currentProcessor->trapHandler = [=] { syscallTrap(); };
 
+  // Counter CSR handling
+  m_currentProcessor->csrReadHandler = [](unsigned csr) {
+    return PerformanceCounters::read(csr);
+  };
+
+  if (auto *bp = m_currentProcessor->branchPredictor())
+    bp->configure(m_bpConfig);
+  if (auto *ooo = m_currentProcessor->outOfOrderConfig())
+    *ooo = m_oooConfig;
+  if (auto *fu = m_currentProcessor->functionalUnitLatencies())
+    *fu = m_fuLatencies;
+
   m_currentProcessor->postConstruct();
   createAssemblerForCurrentISA();
+  createVCDTracer();
 
   if (keepProgram && m_program) {
     loadProgram(m_program);
@@ -407,19 +672,18 @@ QString ProcessorHandler::_disassembleInstr(const AInt addr) const {
 }
 
 void ProcessorHandler::syscallTrap() {
-  auto futureWatcher = QFutureWatcher<bool>();
-  futureWatcher.setFuture(QtConcurrent::run([=] {
-    if (auto reg = _currentISA()->syscallReg(); reg.has_value()) {
-      const unsigned int function =
-          m_currentProcessor->getRegister(reg->file->regFileName(), reg->index);
-      return m_syscallManager->execute(function);
-    } else {
-      return false;
-    }
-  }));
+  SelfProfiler::Scope scope(SelfProfiler::Syscalls);
+  // System calls are executed inline in the thread which clocks the
+  // processor. Reads from stdin on the GUI thread request their input through
+  // a modal dialog (see SystemIO::readFromFile).
+  bool handled = false;
+  if (auto reg = _currentISA()->syscallReg(); reg.has_value()) {
+    const unsigned int function =
+        m_currentProcessor->getRegister(reg->file->regFileName(), reg->index);
+    handled = m_syscallManager->execute(function);
+  }
 
-  futureWatcher.waitForFinished();
-  if (!futureWatcher.result()) {
+  if (!handled) {
     // Syscall handling failed, stop running processor
     setStopRunFlag();
   }
@@ -4,6 +4,7 @@
 #include <QFutureWatcher>
 #include <QObject>
 #include <memory>
+#include <optional>
 
 #include "VSRTL/graphics/gallantsignalwrapper.h"
 #include "assembler/assembler.h"
@@ -11,6 +12,7 @@
 #include "processorregistry.h"
 #include "processors/interface/ripesprocessor.h"
 #include "syscall/ripes_syscall.h"
+#include "vcdtracer.h"
 
 #include "VSRTL/graphics/vsrtl_widget.h"
 
@@ -102,6 +104,55 @@ public:
     get()->_selectProcessor(id, extensions, setup);
   }
 
+  /**
+   * @brief setVCDTrace
+   * Enables VCD tracing of the current and any subsequently selected processor
+   * using @param config, or disables tracing if no config is provided. Any
+   * ongoing trace is finalized.
+   */
+  static void setVCDTrace(const std::optional<VCDTracer::Config> &config) {
+    get()->_setVCDTrace(config);
+  }
+
+  /**
+   * @brief setBranchPredictorConfig
+   * Configures the dynamic branch predictor of the current and any
+   * subsequently selected processor which implements dynamic branch
+   * prediction. The processor is reset.
+   */
+  static void setBranchPredictorConfig(const BranchPredictorConfig &config) {
+    get()->_setBranchPredictorConfig(config);
+  }
+
+  /**
+   * @brief setOoOConfig
+   * Configures the current and any subsequently selected out-of-order
+   * processor. The processor is reset.
+   */
+  static void setOoOConfig(const OoOConfig &config) {
+    get()->_setOoOConfig(config);
+  }
+
+  /**
+   * @brief setFULatencies
+   * Configures the multi-cycle functional units of the current and any
+   * subsequently selected processor which models functional unit latencies.
+   * The processor is reset.
+   */
+  static void setFULatencies(const FULatencies &latencies) {
+    get()->_setFULatencies(latencies);
+  }
+
+  /**
+   * @brief setPipelineConfig
+   * Configures the datapath of subsequently selected parametric pipelines.
+   * The datapath is fixed upon construction; the configuration takes effect
+   * the next time a parametric processor is selected.
+   */
+  static void setPipelineConfig(const PipelineConfig &config) {
+    get()->_setPipelineConfig(config);
+  }
+
   /**
    * @brief isExecutableAddress
    * @returns whether @param address is within the executable section of the
@@ -136,7 +187,7 @@ public:
    * @brief getMemory
    * returns const-wrapped references to the current process memory
    */
-  static vsrtl::core::AddressSpaceMM &getMemory() {
+  static PagedAddressSpace &getMemory() {
     return get()->_getMemory();
   }
 
@@ -157,6 +208,15 @@ public:
     get()->_writeMem(address, value, size);
   }
 
+  /**
+   * @brief writeBlock
+   * writes @p size bytes from @p data into the memory of the simulator,
+   * starting at @p address
+   */
+  static void writeBlock(AInt address, const char *data, size_t size) {
+    get()->_writeBlock(address, data, size);
+  }
+
   /**
    * @brief getRegisterValue
    * @returns value of register @param idx
@@ -254,6 +314,9 @@ signals:
    * the VSRTL model whenever the processor changes.
    */
   void programChanged();
+  // Emitted once the source information of the current program, which may be
+  // built on a worker thread after the program is loaded, is available.
+  void sourceInfoChanged();
   void processorReset();
   void processorReversed();
   // Only connect to this if not updating gui!´ i.e., for logging statistics per
@@ -269,12 +332,17 @@ signals:
   // change.
   void memoryFocusAddressChanged(AInt address);
 
+  // Emitted whenever memory is written through ProcessorHandler::writeMem or
+  // writeBlock (ie. by system calls), rather than by the processor itself.
+  // Emitted in the thread writing the memory.
+  void memoryWritten(AInt address, unsigned bytes);
+
 private slots:
   /**
    * @brief syscallTrap
-   * Connects to the processors system call request interface. Will concurrently
-   * run the systemcall manager to handle the requested functionality, and
-   * return once the system call was handled.
+   * Connects to the processors system call request interface. Runs the
+   * systemcall manager in the calling (simulation) thread to handle the
+   * requested functionality, and returns once the system call was handled.
    */
   void syscallTrap();
 
@@ -307,15 +375,21 @@ private:
   void _selectProcessor(
       const ProcessorID &id, const QStringList &extensions = {},
       const RegisterInitialization &setup = RegisterInitialization());
+  void _setVCDTrace(const std::optional<VCDTracer::Config> &config);
+  void _setBranchPredictorConfig(const BranchPredictorConfig &config);
+  void _setOoOConfig(const OoOConfig &config);
+  void _setFULatencies(const FULatencies &latencies);
+  void _setPipelineConfig(const PipelineConfig &config);
   bool _isExecutableAddress(AInt address) const;
   int _getCurrentProgramSize() const;
   AInt _getTextStart() const;
   QString _disassembleInstr(const AInt address) const;
-  vsrtl::core::AddressSpaceMM &_getMemory();
+  PagedAddressSpace &_getMemory();
   const vsrtl::core::AddressSpace &_getRegisters() const;
   void _setRegisterValue(const std::string_view &rfid, const unsigned idx,
                          VInt value);
   void _writeMem(AInt address, VInt value, int size = sizeof(VInt));
+  void _writeBlock(AInt address, const char *data, size_t size);
   VInt _getRegisterValue(const std::string_view &rfid,
                          const unsigned idx) const;
   bool _checkBreakpoint();
@@ -332,6 +406,12 @@ private:
   void _triggerProcStateChangeTimer();
 
   void createAssemblerForCurrentISA();
+  void createVCDTracer();
+  void setVCDTraceFromSettings();
+  void setBranchPredictorConfigFromSettings();
+  void setOoOConfigFromSettings();
+  void setFULatenciesFromSettings();
+  void setPipelineConfigFromSettings();
   void setStopRunFlag();
   ProcessorHandler();
 
@@ -350,10 +430,19 @@ private:
    */
   vsrtl::VSRTLWidget *m_vsrtlWidget = nullptr;
 
+  std::optional<VCDTracer::Config> m_vcdConfig;
+  std::unique_ptr<VCDTracer> m_vcdTracer;
+
+  BranchPredictorConfig m_bpConfig;
+  OoOConfig m_oooConfig;
+  FULatencies m_fuLatencies;
+  PipelineConfig m_pipelineConfig;
+
   std::set<AInt> m_breakpoints;
   std::shared_ptr<Program> m_program;
 
   QFutureWatcher<void> m_runWatcher;
+  QFutureWatcher<void> m_sourceInfoWatcher;
   bool m_stopRunningFlag = false;
   std::mutex m_clockLock;
 
@@ -2,16 +2,10 @@
 
 #include <QPolygonF>
 
-#include "processors/RISC-V/rv5s/rv5s.h"
-#include "processors/RISC-V/rv5s_2s_db/rv5s_2s_db.h"
-#include "processors/RISC-V/rv5s_1s/rv5s_1s.h"
-#include "processors/RISC-V/rv5s_1s_db/rv5s_1s_db.h"
-#include "processors/RISC-V/rv5s_3s/rv5s_3s.h"
-#include "processors/RISC-V/rv5s_3s_db/rv5s_3s_db.h"
-#include "processors/RISC-V/rv5s_no_fw/rv5s_no_fw.h"
-#include "processors/RISC-V/rv5s_no_fw_hz/rv5s_no_fw_hz.h"
-#include "processors/RISC-V/rv5s_no_hz/rv5s_no_hz.h"
+#include "processors/RISC-V/rv5s_param/rv5s_param.h"
 #include "processors/RISC-V/rv6s_dual/rv6s_dual.h"
+#include "processors/RISC-V/rvinorder/rvinorder.h"
+#include "processors/RISC-V/rvooo/rvooo.h"
 #include "processors/RISC-V/rvss/rvss.h"
 
 namespace Ripes {
@@ -66,12 +60,43 @@ constexpr const char rv5s_3s_db_desc[] =
     "forwarding, with delayed branches solved at the WB stage."
     delayed_branch_note;
 
+constexpr const char rv5s_bp_desc[] =
+    "A 5-stage in-order processor with hazard detection/elimination and "
+    "forwarding, with dynamic branch prediction. Branches are predicted at the "
+    "IF stage by a configurable branch predictor (bimodal, gshare or "
+    "tournament, with a branch target buffer and return address stack), and "
+    "solved at the ID stage, such that a misprediction costs a single cycle. "
+    "The predictor is configured in the simulator settings.";
+
+constexpr const char rv5s_param_desc[] =
+    "A 5-stage in-order processor whose microarchitecture is configured in "
+    "the simulator settings: forwarding, hazard detection, the stage in which "
+    "branches are solved (ID, EX or MEM), delayed branches and dynamic branch "
+    "prediction. The configuration takes effect when the processor is "
+    "selected." delayed_branch_note;
+
 constexpr const char rv6s_desc[] =
     "A 6-stage dual-issue in-order processor. Each way may execute "
     "arithmetic instructions, whereas way 1 "
     "is reserved for controlflow and ecall instructions, and way 2 for "
     "memory accessing instructions.";
 
+constexpr const char rvooo_desc[] =
+    "An out-of-order superscalar processor. Instructions are dispatched in "
+    "order into a reorder buffer and reservation stations (or a load/store "
+    "queue), with registers renamed to their in-flight producers. Instructions "
+    "issue to the functional units as soon as their operands are available, "
+    "and commit in order. Branches are predicted by the configurable branch "
+    "predictor. The width, window sizes and load latency are configured in "
+    "the simulator settings.";
+
+constexpr const char rvinorder_desc[] =
+    "An N-wide in-order superscalar processor. Each cycle, up to N "
+    "instructions issue in program order, until an instruction waits for its "
+    "operands, follows a control-flow instruction or exceeds the functional "
+    "units or register file ports of the issue group. Branches are predicted "
+    "not taken, and environment calls issue alone.";
+
 // --- Processor tags --- //
 
 constexpr const ProcessorTags rvss_tags = {
@@ -103,10 +128,57 @@ constexpr const ProcessorTags rv5s_3s_db_tags = {
     DatapathType::P_5S, BranchStrategy::DB, BranchDelaySlots::THREE,
 	true, true};
 
+constexpr const ProcessorTags rv5s_bp_tags = {
+    DatapathType::P_5S, BranchStrategy::DP, BranchDelaySlots::ONE, true, true};
+
+constexpr const ProcessorTags rv5s_param_tags = {
+    DatapathType::P_5S_PARAM, BranchStrategy::N_A, BranchDelaySlots::NONE,
+    true, true};
+
 constexpr const ProcessorTags rv6s_tags = {
     DatapathType::P_6SD, BranchStrategy::PNT, BranchDelaySlots::THREE,
     true, true};
 
+constexpr const ProcessorTags rvooo_tags = {
+    DatapathType::OOO, BranchStrategy::DP, BranchDelaySlots::NONE, true, true};
+
+constexpr const ProcessorTags rvinorder_2_tags = {
+    DatapathType::INORDER_2, BranchStrategy::PNT, BranchDelaySlots::NONE,
+    true, true};
+constexpr const ProcessorTags rvinorder_4_tags = {
+    DatapathType::INORDER_4, BranchStrategy::PNT, BranchDelaySlots::NONE,
+    true, true};
+constexpr const ProcessorTags rvinorder_8_tags = {
+    DatapathType::INORDER_8, BranchStrategy::PNT, BranchDelaySlots::NONE,
+    true, true};
+
+// --- 5-stage presets --- //
+// The 5-stage processors are presets of the parametric 5-stage processor (see
+// RV5S_PARAM): {forwarding, hazard detection, branch stage, delayed branch,
+// dynamic branch prediction}.
+
+using BranchStage = PipelineConfig::BranchStage;
+constexpr const PipelineConfig rv5s_no_fw_hz_preset = {
+    false, false, BranchStage::EX, false, false};
+constexpr const PipelineConfig rv5s_no_fw_preset = {
+    false, true, BranchStage::EX, false, false};
+constexpr const PipelineConfig rv5s_no_hz_preset = {
+    true, false, BranchStage::EX, false, false};
+constexpr const PipelineConfig rv5s_preset = {
+    true, true, BranchStage::EX, false, false};
+constexpr const PipelineConfig rv5s_2s_db_preset = {
+    true, true, BranchStage::EX, true, false};
+constexpr const PipelineConfig rv5s_1s_preset = {
+    true, true, BranchStage::ID, false, false};
+constexpr const PipelineConfig rv5s_1s_db_preset = {
+    true, true, BranchStage::ID, true, false};
+constexpr const PipelineConfig rv5s_3s_preset = {
+    true, true, BranchStage::MEM, false, false};
+constexpr const PipelineConfig rv5s_3s_db_preset = {
+    true, true, BranchStage::MEM, true, false};
+constexpr const PipelineConfig rv5s_bp_preset = {
+    true, true, BranchStage::ID, false, true};
+
 ProcessorRegistry::ProcessorRegistry() {
   // Initialize processors
   std::vector<Layout> layouts;
@@ -144,14 +216,16 @@ ProcessorRegistry::ProcessorRegistry() {
         {{0, 3}, QPointF{0.76, 0.0}},
         {{0, 4}, QPointF{0.9, 0.0}}}}};
   defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
-  addProcessor(ProcInfo<vsrtl::core::RV5S_NO_FW_HZ<uint32_t>>(
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
       ProcessorID::RV32_5S_NO_FW_HZ,
       "5-stage processor w/o forwarding or hazard detection",
-      rv5s_no_fw_hz_desc, rv5s_no_fw_hz_tags, layouts, defRegVals));
-  addProcessor(ProcInfo<vsrtl::core::RV5S_NO_FW_HZ<uint64_t>>(
+      rv5s_no_fw_hz_desc, rv5s_no_fw_hz_tags, layouts, defRegVals,
+      rv5s_no_fw_hz_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
       ProcessorID::RV64_5S_NO_FW_HZ,
       "5-stage processor w/o forwarding or hazard detection",
-      rv5s_no_fw_hz_desc, rv5s_no_fw_hz_tags, layouts, defRegVals));
+      rv5s_no_fw_hz_desc, rv5s_no_fw_hz_tags, layouts, defRegVals,
+      rv5s_no_fw_hz_preset));
 
   // RISC-V 5-stage without hazard detection
   layouts = {{"Standard",
@@ -169,12 +243,14 @@ ProcessorRegistry::ProcessorRegistry() {
                {{0, 3}, QPointF{0.78, 0}},
                {{0, 4}, QPointF{0.9, 0}}}}};
   defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
-  addProcessor(ProcInfo<vsrtl::core::RV5S_NO_HZ<uint32_t>>(
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
       ProcessorID::RV32_5S_NO_HZ, "5-stage processor w/o hazard detection",
-      rv5s_no_hz_desc, rv5s_no_hz_tags, layouts, defRegVals));
-  addProcessor(ProcInfo<vsrtl::core::RV5S_NO_HZ<uint64_t>>(
+      rv5s_no_hz_desc, rv5s_no_hz_tags, layouts, defRegVals,
+      rv5s_no_hz_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
       ProcessorID::RV64_5S_NO_HZ, "5-stage processor w/o hazard detection",
-      rv5s_no_hz_desc, rv5s_no_hz_tags, layouts, defRegVals));
+      rv5s_no_hz_desc, rv5s_no_hz_tags, layouts, defRegVals,
+      rv5s_no_hz_preset));
 
   // RISC-V 5-stage without forwarding unit
   layouts = {{"Standard",
@@ -192,12 +268,14 @@ ProcessorRegistry::ProcessorRegistry() {
                {{0, 3}, QPointF{0.78, 0}},
                {{0, 4}, QPointF{0.9, 0}}}}};
   defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
-  addProcessor(ProcInfo<vsrtl::core::RV5S_NO_FW<uint32_t>>(
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
       ProcessorID::RV32_5S_NO_FW, "5-Stage processor w/o forwarding unit",
-      rv5s_no_fw_desc, rv5s_no_fw_tags, layouts, defRegVals));
-  addProcessor(ProcInfo<vsrtl::core::RV5S_NO_FW<uint64_t>>(
+      rv5s_no_fw_desc, rv5s_no_fw_tags, layouts, defRegVals,
+      rv5s_no_fw_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
       ProcessorID::RV64_5S_NO_FW, "5-Stage processor w/o forwarding unit",
-      rv5s_no_fw_desc, rv5s_no_fw_tags, layouts, defRegVals));
+      rv5s_no_fw_desc, rv5s_no_fw_tags, layouts, defRegVals,
+      rv5s_no_fw_preset));
 
   // RISC-V 5-stage
   layouts = {{"Standard",
@@ -215,12 +293,12 @@ ProcessorRegistry::ProcessorRegistry() {
                {{0, 3}, QPointF{0.78, 0}},
                {{0, 4}, QPointF{0.9, 0}}}}};
   defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
-  addProcessor(ProcInfo<vsrtl::core::RV5S<uint32_t>>(
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
       ProcessorID::RV32_5S, "5-stage processor", rv5s_desc, rv5s_tags, layouts,
-      defRegVals));
-  addProcessor(ProcInfo<vsrtl::core::RV5S<uint64_t>>(
+      defRegVals, rv5s_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
       ProcessorID::RV64_5S, "5-stage processor", rv5s_desc, rv5s_tags, layouts,
-      defRegVals));
+      defRegVals, rv5s_preset));
 
   // RISC-V 5-stage (2-slot delayed branch)
   layouts = {{"Standard",
@@ -238,12 +316,14 @@ ProcessorRegistry::ProcessorRegistry() {
                {{0, 3}, QPointF{0.78, 0}},
                {{0, 4}, QPointF{0.9, 0}}}}};
   defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
-  addProcessor(ProcInfo<vsrtl::core::RV5S_2S_DB<uint32_t>>(
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
       ProcessorID::RV32_5S_2S_DB, "5-stage processor (2-slot delayed branch)",
-      rv5s_2s_db_desc, rv5s_2s_db_tags, layouts, defRegVals));
-  addProcessor(ProcInfo<vsrtl::core::RV5S_2S_DB<uint64_t>>(
+      rv5s_2s_db_desc, rv5s_2s_db_tags, layouts, defRegVals,
+      rv5s_2s_db_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
       ProcessorID::RV64_5S_2S_DB, "5-stage processor (2-slot delayed branch)",
-      rv5s_2s_db_desc, rv5s_2s_db_tags, layouts, defRegVals));
+      rv5s_2s_db_desc, rv5s_2s_db_tags, layouts, defRegVals,
+      rv5s_2s_db_preset));
 
   // RISC-V 5-stage (1-slot predict-not-taken)
   layouts = {{"Standard",
@@ -261,12 +341,12 @@ ProcessorRegistry::ProcessorRegistry() {
                {{0, 3}, QPointF{0.78, 0}},
                {{0, 4}, QPointF{0.9, 0}}}}};
   defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
-  addProcessor(ProcInfo<vsrtl::core::RV5S_1S<uint32_t>>(
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
       ProcessorID::RV32_5S_1S, "5-stage processor (1-slot predict-not-taken)",
-      rv5s_1s_desc, rv5s_1s_tags, layouts, defRegVals));
-  addProcessor(ProcInfo<vsrtl::core::RV5S_1S<uint64_t>>(
+      rv5s_1s_desc, rv5s_1s_tags, layouts, defRegVals, rv5s_1s_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
       ProcessorID::RV64_5S_1S, "5-stage processor (1-slot predict-not-taken)",
-      rv5s_1s_desc, rv5s_1s_tags, layouts, defRegVals));
+      rv5s_1s_desc, rv5s_1s_tags, layouts, defRegVals, rv5s_1s_preset));
 
   // RISC-V 5-stage (1-slot delayed branch)
   layouts = {{"Standard",
@@ -284,12 +364,14 @@ ProcessorRegistry::ProcessorRegistry() {
                {{0, 3}, QPointF{0.78, 0}},
                {{0, 4}, QPointF{0.9, 0}}}}};
   defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
-  addProcessor(ProcInfo<vsrtl::core::RV5S_1S_DB<uint32_t>>(
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
       ProcessorID::RV32_5S_1S_DB, "5-stage processor (1-slot delayed branch)",
-      rv5s_1s_db_desc, rv5s_1s_db_tags, layouts, defRegVals));
-  addProcessor(ProcInfo<vsrtl::core::RV5S_1S_DB<uint64_t>>(
+      rv5s_1s_db_desc, rv5s_1s_db_tags, layouts, defRegVals,
+      rv5s_1s_db_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
       ProcessorID::RV64_5S_1S_DB, "5-stage processor (1-slot delayed branch)",
-      rv5s_1s_db_desc, rv5s_1s_db_tags, layouts, defRegVals));
+      rv5s_1s_db_desc, rv5s_1s_db_tags, layouts, defRegVals,
+      rv5s_1s_db_preset));
 
   // RISC-V 5-stage (3-slot predict-not-taken)
   layouts = {{"Standard",
@@ -307,12 +389,12 @@ ProcessorRegistry::ProcessorRegistry() {
                {{0, 3}, QPointF{0.78, 0}},
                {{0, 4}, QPointF{0.9, 0}}}}};
   defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
-  addProcessor(ProcInfo<vsrtl::core::RV5S_3S<uint32_t>>(
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
       ProcessorID::RV32_5S_3S, "5-stage processor (3-slot predict-not-taken)",
-      rv5s_3s_desc, rv5s_3s_tags, layouts, defRegVals));
-  addProcessor(ProcInfo<vsrtl::core::RV5S_3S<uint64_t>>(
+      rv5s_3s_desc, rv5s_3s_tags, layouts, defRegVals, rv5s_3s_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
       ProcessorID::RV64_5S_3S, "5-stage processor (3-slot predict-not-taken)",
-      rv5s_3s_desc, rv5s_3s_tags, layouts, defRegVals));
+      rv5s_3s_desc, rv5s_3s_tags, layouts, defRegVals, rv5s_3s_preset));
 
   // RISC-V 5-stage (3-slot delayed branch)
   layouts = {{"Standard",
@@ -330,12 +412,63 @@ ProcessorRegistry::ProcessorRegistry() {
                {{0, 3}, QPointF{0.78, 0}},
                {{0, 4}, QPointF{0.9, 0}}}}};
   defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
-  addProcessor(ProcInfo<vsrtl::core::RV5S_3S_DB<uint32_t>>(
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
       ProcessorID::RV32_5S_3S_DB, "5-stage processor (3-slot delayed branch)",
-      rv5s_3s_db_desc, rv5s_3s_db_tags, layouts, defRegVals));
-  addProcessor(ProcInfo<vsrtl::core::RV5S_3S_DB<uint64_t>>(
+      rv5s_3s_db_desc, rv5s_3s_db_tags, layouts, defRegVals,
+      rv5s_3s_db_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
       ProcessorID::RV64_5S_3S_DB, "5-stage processor (3-slot delayed branch)",
-      rv5s_3s_db_desc, rv5s_3s_db_tags, layouts, defRegVals));
+      rv5s_3s_db_desc, rv5s_3s_db_tags, layouts, defRegVals,
+      rv5s_3s_db_preset));
+
+  // RISC-V 5-stage (dynamic branch prediction). Branches are solved in ID as
+  // in the 1-slot processor, whose layouts are reused; the prediction unit is
+  // placed by VSRTL.
+  layouts = {{"Standard",
+              ":/layouts/RISC-V/rv5s_1s/rv5s_1s_standard_layout.json",
+              {{{0, 0}, QPointF{0.08, 0}},
+               {{0, 1}, QPointF{0.29, 0}},
+               {{0, 2}, QPointF{0.55, 0}},
+               {{0, 3}, QPointF{0.75, 0}},
+               {{0, 4}, QPointF{0.87, 0}}}},
+             {"Extended",
+              ":/layouts/RISC-V/rv5s_1s/rv5s_1s_extended_layout.json",
+              {{{0, 0}, QPointF{0.08, 0}},
+               {{0, 1}, QPointF{0.28, 0}},
+               {{0, 2}, QPointF{0.54, 0}},
+               {{0, 3}, QPointF{0.78, 0}},
+               {{0, 4}, QPointF{0.9, 0}}}}};
+  defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
+      ProcessorID::RV32_5S_BP, "5-stage processor (dynamic branch prediction)",
+      rv5s_bp_desc, rv5s_bp_tags, layouts, defRegVals, rv5s_bp_preset));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
+      ProcessorID::RV64_5S_BP, "5-stage processor (dynamic branch prediction)",
+      rv5s_bp_desc, rv5s_bp_tags, layouts, defRegVals, rv5s_bp_preset));
+
+  // RISC-V 5-stage (parametric). The datapath is configured in the settings,
+  // and shown in the layouts of the dynamic branch prediction preset.
+  layouts = {{"Standard",
+              ":/layouts/RISC-V/rv5s_1s/rv5s_1s_standard_layout.json",
+              {{{0, 0}, QPointF{0.08, 0}},
+               {{0, 1}, QPointF{0.29, 0}},
+               {{0, 2}, QPointF{0.55, 0}},
+               {{0, 3}, QPointF{0.75, 0}},
+               {{0, 4}, QPointF{0.87, 0}}}},
+             {"Extended",
+              ":/layouts/RISC-V/rv5s_1s/rv5s_1s_extended_layout.json",
+              {{{0, 0}, QPointF{0.08, 0}},
+               {{0, 1}, QPointF{0.28, 0}},
+               {{0, 2}, QPointF{0.54, 0}},
+               {{0, 3}, QPointF{0.78, 0}},
+               {{0, 4}, QPointF{0.9, 0}}}}};
+  defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint32_t>>(
+      ProcessorID::RV32_5S_PARAM, "5-stage processor (parametric)",
+      rv5s_param_desc, rv5s_param_tags, layouts, defRegVals));
+  addProcessor(ProcInfo<vsrtl::core::RV5S_PARAM<uint64_t>>(
+      ProcessorID::RV64_5S_PARAM, "5-stage processor (parametric)",
+      rv5s_param_desc, rv5s_param_tags, layouts, defRegVals));
 
   // RISC-V 6-stage dual issue
   layouts = {{"Extended",
@@ -359,5 +492,56 @@ ProcessorRegistry::ProcessorRegistry() {
   addProcessor(ProcInfo<vsrtl::core::RV6S_DUAL<uint64_t>>(
       ProcessorID::RV64_6S_DUAL, "6-stage dual-issue processor", rv6s_desc,
       rv6s_tags, layouts, defRegVals));
+
+  // RISC-V out-of-order. The functional core is the single-cycle datapath;
+  // stage labels are stacked per dispatch lane.
+  std::map<StageIndex, QPointF> oooLabels;
+  for (unsigned lane = 0; lane < OoOConfig::s_maxWidth; ++lane)
+    for (unsigned stage = 0; stage < 4; ++stage)
+      oooLabels[{lane, stage}] = QPointF{0.2 + 0.2 * stage, 1.0 * lane};
+  layouts = {{"Standard", ":/layouts/RISC-V/rvss/rv_ss_standard_layout.json",
+              oooLabels},
+             {"Extended", ":/layouts/RISC-V/rvss/rv_ss_extended_layout.json",
+              oooLabels}};
+  defRegVals = {{RVISA::GPR, {{2, 0x7ffffff0}, {3, 0x10000000}}}};
+  addProcessor(ProcInfo<vsrtl::core::RVOOO<uint32_t>>(
+      ProcessorID::RV32_OOO, "Out-of-order processor", rvooo_desc, rvooo_tags,
+      layouts, defRegVals));
+  addProcessor(ProcInfo<vsrtl::core::RVOOO<uint64_t>>(
+      ProcessorID::RV64_OOO, "Out-of-order processor", rvooo_desc, rvooo_tags,
+      layouts, defRegVals));
+
+  // RISC-V N-wide in-order. As for the out-of-order processors, the
+  // functional core is the single-cycle datapath, with stage labels stacked
+  // per issue lane.
+  auto inOrderLayouts = [](unsigned width) {
+    std::map<StageIndex, QPointF> labels;
+    for (unsigned lane = 0; lane < width; ++lane)
+      for (unsigned stage = 0; stage < 4; ++stage)
+        labels[{lane, stage}] = QPointF{0.2 + 0.2 * stage, 1.0 * lane};
+    return std::vector<Layout>{
+        {"Standard", ":/layouts/RISC-V/rvss/rv_ss_standard_layout.json",
+         labels},
+        {"Extended", ":/layouts/RISC-V/rvss/rv_ss_extended_layout.json",
+         labels}};
+  };
+  addProcessor(ProcInfo<vsrtl::core::RVINORDER<uint32_t, 2>>(
+      ProcessorID::RV32_INORDER_2, "2-wide in-order processor",
+      rvinorder_desc, rvinorder_2_tags, inOrderLayouts(2), defRegVals));
+  addProcessor(ProcInfo<vsrtl::core::RVINORDER<uint64_t, 2>>(
+      ProcessorID::RV64_INORDER_2, "2-wide in-order processor",
+      rvinorder_desc, rvinorder_2_tags, inOrderLayouts(2), defRegVals));
+  addProcessor(ProcInfo<vsrtl::core::RVINORDER<uint32_t, 4>>(
+      ProcessorID::RV32_INORDER_4, "4-wide in-order processor",
+      rvinorder_desc, rvinorder_4_tags, inOrderLayouts(4), defRegVals));
+  addProcessor(ProcInfo<vsrtl::core::RVINORDER<uint64_t, 4>>(
+      ProcessorID::RV64_INORDER_4, "4-wide in-order processor",
+      rvinorder_desc, rvinorder_4_tags, inOrderLayouts(4), defRegVals));
+  addProcessor(ProcInfo<vsrtl::core::RVINORDER<uint32_t, 8>>(
+      ProcessorID::RV32_INORDER_8, "8-wide in-order processor",
+      rvinorder_desc, rvinorder_8_tags, inOrderLayouts(8), defRegVals));
+  addProcessor(ProcInfo<vsrtl::core::RVINORDER<uint64_t, 8>>(
+      ProcessorID::RV64_INORDER_8, "8-wide in-order processor",
+      rvinorder_desc, rvinorder_8_tags, inOrderLayouts(8), defRegVals));
 }
 } // namespace Ripes
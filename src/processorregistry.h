@@ -5,6 +5,8 @@
 #include <QPointF>
 #include <map>
 #include <memory>
+#include <optional>
+#include <type_traits>
 
 #include "isa/rv32isainfo.h"
 #include "isa/rv64isainfo.h"
@@ -34,7 +36,13 @@ enum ProcessorID {
   RV32_5S_2S_DB,
   RV32_5S_3S,
   RV32_5S_3S_DB,
+  RV32_5S_BP,
   RV32_6S_DUAL,
+  RV32_OOO,
+  RV32_5S_PARAM,
+  RV32_INORDER_2,
+  RV32_INORDER_4,
+  RV32_INORDER_8,
 
   RV64_SS,
   RV64_5S_NO_FW_HZ,
@@ -46,7 +54,13 @@ enum ProcessorID {
   RV64_5S_2S_DB,
   RV64_5S_3S,
   RV64_5S_3S_DB,
+  RV64_5S_BP,
   RV64_6S_DUAL,
+  RV64_OOO,
+  RV64_5S_PARAM,
+  RV64_INORDER_2,
+  RV64_INORDER_4,
+  RV64_INORDER_8,
 
   NUM_PROCESSORS
 };
@@ -74,17 +88,32 @@ struct Layout {
 };
 
 // Processor tags
-enum DatapathType { SS, P_5S, P_6SD };
+enum DatapathType {
+  SS,
+  P_5S,
+  P_6SD,
+  OOO,
+  P_5S_PARAM,
+  INORDER_2,
+  INORDER_4,
+  INORDER_8
+};
 const static std::map<DatapathType, QString> DatapathNames = {
     {DatapathType::SS, "Single-stage"},
     {DatapathType::P_5S, "Five-stage"},
-    {DatapathType::P_6SD, "Six-stage dual-issue"}};
-
-enum BranchStrategy { N_A, PNT, DB };
+    {DatapathType::P_6SD, "Six-stage dual-issue"},
+    {DatapathType::OOO, "Out-of-order"},
+    {DatapathType::P_5S_PARAM, "Five-stage (parametric)"},
+    {DatapathType::INORDER_2, "2-wide in-order"},
+    {DatapathType::INORDER_4, "4-wide in-order"},
+    {DatapathType::INORDER_8, "8-wide in-order"}};
+
+enum BranchStrategy { N_A, PNT, DB, DP };
 const static std::map<BranchStrategy, QString> BranchNames = {
     {BranchStrategy::N_A, "Not applicable"},
     {BranchStrategy::PNT, "Predict not taken"},
-    {BranchStrategy::DB, "Delayed branch"}};
+    {BranchStrategy::DB, "Delayed branch"},
+    {BranchStrategy::DP, "Dynamic prediction"}};
 
 enum BranchDelaySlots { NONE, ONE, TWO, THREE };
 
@@ -110,9 +139,11 @@ class ProcInfoBase {
 public:
   ProcInfoBase(ProcessorID _id, const QString &_name, const QString &_desc,
                const ProcessorTags &_tags, const std::vector<Layout> &_layouts,
-               const RegisterInitialization &_defaultRegVals = {})
+               const RegisterInitialization &_defaultRegVals = {},
+               const std::optional<PipelineConfig> &_preset = {})
       : id(_id), name(_name), description(_desc), tags(_tags),
-        defaultRegisterVals(_defaultRegVals), layouts(_layouts) {}
+        defaultRegisterVals(_defaultRegVals), layouts(_layouts),
+        preset(_preset) {}
   virtual ~ProcInfoBase() = default;
   ProcessorID id;
   QString name;
@@ -120,17 +151,27 @@ public:
   ProcessorTags tags;
   RegisterInitialization defaultRegisterVals;
   std::vector<Layout> layouts;
+  /// The fixed configuration of a preset of a parametric processor.
+  std::optional<PipelineConfig> preset;
   virtual ProcessorISAInfo isaInfo() const = 0;
+  /// Constructs the processor. @p pipeline configures the datapath of
+  /// parametric processors which are not a preset, and is ignored by all
+  /// others.
   virtual std::unique_ptr<RipesProcessor>
-  construct(const QStringList &extensions) = 0;
+  construct(const QStringList &extensions, const PipelineConfig &pipeline) = 0;
 };
 
 template <typename T>
 class ProcInfo : public ProcInfoBase {
 public:
   using ProcInfoBase::ProcInfoBase;
-  std::unique_ptr<RipesProcessor> construct(const QStringList &extensions) {
-    return std::make_unique<T>(extensions);
+  std::unique_ptr<RipesProcessor> construct(const QStringList &extensions,
+                                            const PipelineConfig &pipeline) {
+    if constexpr (std::is_constructible_v<T, const QStringList &,
+                                          const PipelineConfig &>)
+      return std::make_unique<T>(extensions, preset ? *preset : pipeline);
+    else
+      return std::make_unique<T>(extensions);
   }
   // At this point we force the processor type T to implement a static function
   // identifying its supported ISA.
@@ -151,11 +192,12 @@ public:
     return *desc->second;
   }
   static std::unique_ptr<RipesProcessor>
-  constructProcessor(ProcessorID id, const QStringList &extensions) {
+  constructProcessor(ProcessorID id, const QStringList &extensions,
+                     const PipelineConfig &pipeline = PipelineConfig()) {
     auto &_this = instance();
     auto it = _this.m_descriptions.find(id);
     Q_ASSERT(it != _this.m_descriptions.end());
-    return it->second->construct(extensions);
+    return it->second->construct(extensions, pipeline);
   }
 
   static QList<ProcessorID> getProcessor(ISA isa, ProcessorTags tags) {
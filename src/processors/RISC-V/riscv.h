@@ -75,6 +75,14 @@ enum class RVInstr {
   AND,
   ECALL,
 
+  /* Zicsr Standard Extension (counter CSR reads) */
+  CSRRW,
+  CSRRS,
+  CSRRC,
+  CSRRWI,
+  CSRRSI,
+  CSRRCI,
+
   /* RV32M Standard Extension */
   MUL,
   MULH,
@@ -139,7 +147,8 @@ enum class ALUOp {
   DIVW,
   DIVUW,
   REMW,
-  REMUW
+  REMUW,
+  CSRR
 };
 enum class RegWrSrc { MEMREAD, ALURES, PC4 };
 enum class AluSrc1 { REG1, PC };
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "VSRTL/core/vsrtl_component.h"
+
+#include "processors/RISC-V/riscv.h"
+#include "processors/interface/branchpredictor.h"
+
+namespace vsrtl {
+namespace core {
+using namespace Ripes;
+
+/**
+ * @brief The BranchPredictionUnit class
+ * Drives the program counter of a pipeline with dynamic branch prediction.
+ *
+ * In the fetch stage, the branch predictor is looked up with the PC being
+ * fetched, and the predicted next PC is carried alongside the instruction to
+ * the stage wherein control-flow instructions are resolved. If the resolved
+ * next PC differs from the predicted next PC, a misprediction is signalled, and
+ * the fetch stage is redirected to the resolved next PC.
+ *
+ * The predictor itself is updated with the outcome of the resolved instruction
+ * through resolve(), which the processor must call before clocking the design.
+ */
+template <unsigned XLEN>
+class BranchPredictionUnit : public Component {
+public:
+  BranchPredictionUnit(const std::string &name, SimComponent *parent)
+      : Component(name, parent) {
+    setDescription("Dynamic branch predictor");
+
+    pred_taken << [=] { return m_predictor.predict(if_pc.uValue()).taken; };
+    pred_npc << [=] { return predictedNpc(); };
+    mispredict << [=] { return isMispredicted(); };
+    npc << [=] { return isMispredicted() ? resolvedNpc() : predictedNpc(); };
+  }
+
+  /**
+   * @brief resolve
+   * Updates the predictor with the outcome of the instruction in the resolving
+   * stage, if any. @p cycle is the cycle being clocked.
+   */
+  void resolve(long long cycle) {
+    if (!isResolving())
+      return;
+
+    const RVInstr opcode = id_opcode.eValue<RVInstr>();
+    BranchPredictor::Kind kind = BranchPredictor::Kind::None;
+    if (id_do_branch.uValue()) {
+      kind = BranchPredictor::Kind::Branch;
+    } else if (id_do_jump.uValue()) {
+      // Calls and returns are identified through the register usage hints of
+      // the RISC-V calling convention.
+      const auto isLinkReg = [](unsigned idx) { return idx == 1 || idx == 5; };
+      const unsigned rd = id_wr_reg_idx.uValue();
+      if (isLinkReg(rd))
+        kind = BranchPredictor::Kind::Call;
+      else if (opcode == RVInstr::JALR && rd == 0 &&
+               isLinkReg(id_reg1_idx.uValue()))
+        kind = BranchPredictor::Kind::Return;
+      else
+        kind = BranchPredictor::Kind::Jump;
+    }
+
+    const bool mispredicted = isMispredicted();
+    if (kind == BranchPredictor::Kind::None && !mispredicted)
+      return;
+
+    // Resolving in the decode stage, a misprediction squashes the single
+    // instruction fetched down the wrong path.
+    m_predictor.update(cycle, id_pc.uValue(), id_pc4.uValue(), kind,
+                       id_taken.uValue(), id_target.uValue(), mispredicted, 1);
+  }
+
+  BranchPredictor &predictor() { return m_predictor; }
+
+  // Fetch stage
+  INPUTPORT(if_pc, XLEN);
+  INPUTPORT(if_pc4, XLEN);
+
+  // Resolving stage
+  INPUTPORT(id_valid, 1);
+  INPUTPORT(id_enable, 1);
+  INPUTPORT(id_pc, XLEN);
+  INPUTPORT(id_pc4, XLEN);
+  INPUTPORT(id_pred_npc, XLEN);
+  INPUTPORT_ENUM(id_opcode, RVInstr);
+  INPUTPORT(id_wr_reg_idx, c_RVRegsBits);
+  INPUTPORT(id_reg1_idx, c_RVRegsBits);
+  INPUTPORT(id_do_branch, 1);
+  INPUTPORT(id_do_jump, 1);
+  INPUTPORT(id_taken, 1);
+  INPUTPORT(id_target, XLEN);
+
+  // Predicted direction and next PC of the instruction being fetched.
+  OUTPUTPORT(pred_taken, 1);
+  OUTPUTPORT(pred_npc, XLEN);
+
+  // High when the instruction in the resolving stage was mispredicted; the
+  // instruction in the fetch stage must be squashed.
+  OUTPUTPORT(mispredict, 1);
+
+  // Next PC to be fetched.
+  OUTPUTPORT(npc, XLEN);
+
+private:
+  // An instruction is resolved once it is valid and not stalled in the
+  // resolving stage.
+  bool isResolving() const {
+    return id_valid.uValue() && id_enable.uValue();
+  }
+  bool isMispredicted() const {
+    return isResolving() && resolvedNpc() != id_pred_npc.uValue();
+  }
+  VSRTL_VT_U predictedNpc() const {
+    const auto prediction = m_predictor.predict(if_pc.uValue());
+    return prediction.taken ? VT_U(prediction.target) : if_pc4.uValue();
+  }
+  VSRTL_VT_U resolvedNpc() const {
+    return id_taken.uValue() ? id_target.uValue() : id_pc4.uValue();
+  }
+
+  BranchPredictor m_predictor;
+};
+
+} // namespace core
+} // namespace vsrtl
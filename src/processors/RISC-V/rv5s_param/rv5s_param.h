@@ -17,62 +17,137 @@
 #include "processors/RISC-V/rv_ecallchecker.h"
 #include "processors/RISC-V/rv_immediate.h"
 #include "processors/RISC-V/rv_memory.h"
+#include "processors/RISC-V/rv_muldivunit.h"
 #include "processors/RISC-V/rv_registerfile.h"
 #include "processors/RISC-V/rv_uncompress.h"
 
 // Stage separating registers
-#include "../rv5s_no_fw_hz/rv5s_no_fw_hz_ifid.h"
-#include "../rv5s/rv5s_exmem.h"
 #include "../rv5s/rv5s_idex.h"
 #include "../rv5s/rv5s_memwb.h"
+#include "../rv5s_3s/rv5s_3s_exmem.h"
+#include "../rv5s_bp/rv5s_bp_ifid.h"
 
 // Forwarding & Hazard detection unit
-#include "rv5s_1s_forwardingunit.h"
-#include "rv5s_1s_hazardunit.h"
+#include "../rv5s_1s/rv5s_1s_forwardingunit.h"
+#include "rv5s_param_hazardunit.h"
+
+// Branch prediction
+#include "../rv5s_bp/rv5s_bp_predictionunit.h"
 
 namespace vsrtl {
 namespace core {
 using namespace Ripes;
 
+/**
+ * @brief The RV5S_PARAM class
+ * A 5-stage pipeline whose microarchitecture is given by a PipelineConfig:
+ * forwarding, hazard detection, the stage in which control flow is resolved,
+ * delay slots and dynamic branch prediction. The datapath contains the
+ * components of every configuration; the configuration selects how it is
+ * wired when the processor is constructed.
+ *
+ * Each of the 5-stage processors of the processor registry is a preset
+ * configuration of this processor:
+ *  - 5S:           EX
+ *  - 5S_NO_FW:     EX, no forwarding
+ *  - 5S_NO_HZ:     EX, no hazard detection
+ *  - 5S_NO_FW_HZ:  EX, no forwarding, no hazard detection
+ *  - 5S_1S(_DB):   ID (delayed branch)
+ *  - 5S_2S_DB:     EX, delayed branch
+ *  - 5S_3S(_DB):   MEM (delayed branch)
+ *  - 5S_BP:        ID, dynamic branch prediction
+ * The layouts of each preset only show the components used by its
+ * configuration.
+ */
 template <typename XLEN_T>
-class RV5S_1S : public RipesVSRTLProcessor {
+class RV5S_PARAM : public RipesVSRTLProcessor {
   static_assert(std::is_same<uint32_t, XLEN_T>::value ||
                     std::is_same<uint64_t, XLEN_T>::value,
                 "Only supports 32- and 64-bit variants");
   static constexpr unsigned XLEN = sizeof(XLEN_T) * CHAR_BIT;
+  using BranchStage = PipelineConfig::BranchStage;
 
 public:
   enum Stage { IF = 0, ID = 1, EX = 2, MEM = 3, WB = 4, STAGECOUNT };
-  RV5S_1S(const QStringList &extensions)
-      : RipesVSRTLProcessor(
-            "5-Stage RISC-V Processor (1-slot delayed branch)") {
+  RV5S_PARAM(const QStringList &extensions,
+             const PipelineConfig &config = PipelineConfig())
+      : RipesVSRTLProcessor("5-Stage RISC-V Processor (parametric)"),
+        m_config(config) {
+    m_config.sanitize();
     m_enabledISA = ISAInfoRegistry::getISA<XLenToRVISA<XLEN>()>(extensions);
     decode->setISA(m_enabledISA);
     uncompress->setISA(m_enabledISA);
+    hzunit->configure(m_config);
+
+    const BranchStage stage = m_config.branchStage;
+    const bool delayed = m_config.delayedBranch;
+
+    // High when the front-end is redirected by a resolved control-flow
+    // instruction.
+    auto &redirect = stage == BranchStage::MEM ? exmem_reg->do_branch_out
+                                               : controlflow_or->out;
 
     // -----------------------------------------------------------------------
     // Program counter
     pc_reg->out >> pc_4->op1;
     pc_inc->out >> pc_4->op2;
-    pc_src->out >> pc_reg->in;
+    if (m_config.prediction)
+      bpunit->npc >> pc_reg->in;
+    else
+      pc_src->out >> pc_reg->in;
     0 >> pc_reg->clear;
-    hzunit->hazardFEEnable >> pc_reg->enable;
+    fee_enable_or->out >> pc_reg->enable;
 
     2 >> pc_inc->get(PcInc::INC2);
     4 >> pc_inc->get(PcInc::INC4);
     uncompress->Pc_Inc >> pc_inc->select;
 
     // Note: pc_src works uses the PcSrc enum, but is selected by the boolean
-    // signal from the controlflow OR gate. PcSrc enum values must adhere to the
-    // boolean 0/1 values.
-    controlflow_or->out >> pc_src->select;
+    // redirect signal. PcSrc enum values must adhere to the boolean 0/1 values.
+    redirect >> pc_src->select;
+    pc_4->out >> pc_src->get(PcSrc::PC4);
+    switch (stage) {
+    case BranchStage::ID:
+      branch_adder->out >> pc_src->get(PcSrc::ALU);
+      break;
+    case BranchStage::EX:
+      alu->res >> pc_src->get(PcSrc::ALU);
+      break;
+    case BranchStage::MEM:
+      exmem_reg->alures_out >> pc_src->get(PcSrc::ALU);
+      break;
+    }
 
-    controlflow_or->out >> *efsc_or->in[0];
+    // A control-flow instruction resolved in MEM redirects the front-end even
+    // if it is stalled, given that the stalled instructions are squashed.
+    if (stage == BranchStage::MEM && !delayed)
+      exmem_reg->do_branch_out >> *fee_enable_or->in[0];
+    else
+      0 >> *fee_enable_or->in[0];
+    hzunit->hazardFEEnable >> *fee_enable_or->in[1];
+
+    // Squashing of the instruction in IF
+    if (m_config.prediction)
+      bpunit->mispredict >> *efsc_or->in[0];
+    else if (delayed)
+      0 >> *efsc_or->in[0];
+    else
+      redirect >> *efsc_or->in[0];
     ecallChecker->syscallExit >> *efsc_or->in[1];
 
-    // MODIFIED: disconnect efsc_or from efschz_or
-    // efsc_or->out >> *efschz_or->in[0];
-    ecallChecker->syscallExit >> *efschz_or->in[0];
+    // Squashing of the instruction in ID. A control-flow instruction resolved
+    // in ID itself proceeds to EX. Without hazard detection, ecalls are handled
+    // in ID, and an exit system call only squashes the instruction in IF.
+    if (stage == BranchStage::ID || delayed) {
+      if (m_config.hazardDetection)
+        ecallChecker->syscallExit >> *efschz_or->in[0];
+      else
+        0 >> *efschz_or->in[0];
+    } else if (m_config.hazardDetection) {
+      efsc_or->out >> *efschz_or->in[0];
+    } else {
+      redirect >> *efschz_or->in[0];
+    }
     hzunit->hazardIDEXClear >> *efschz_or->in[1];
 
     // -----------------------------------------------------------------------
@@ -110,9 +185,9 @@ public:
 
     // -----------------------------------------------------------------------
     // Branch
-    // MODIFIED: moved to ID stage, added forwarding multiplexers
 
-    // branch forwarding source selection
+    // Operands of control-flow instructions resolved in ID, forwarded from
+    // the later stages.
     registerFile->r1_out >> branch_op1_src->get(ForwardingSrc_1S::IdStage);
     alu->res >> branch_op1_src->get(ForwardingSrc_1S::ExStage);
     exmem_reg->alures_out >> branch_op1_src->get(ForwardingSrc_1S::MemStage);
@@ -125,41 +200,60 @@ public:
     reg_wr_src->out >> branch_op2_src->get(ForwardingSrc_1S::WbStage);
     funit->branch_op2_fwctrl >> branch_op2_src->select;
 
-    // jump target operand source selection
+    // Jump target of control-flow instructions resolved in ID
     ifid_reg->pc_out >> jump_addr_src->get(AluSrc1::PC);
     branch_op1_src->out >> jump_addr_src->get(AluSrc1::REG1);
     control->alu_op1_ctrl >> jump_addr_src->select;
 
-    // idex_reg->br_op_out >> branch->comp_op;
-    // reg1_fw_src->out >> branch->op1;
-    // reg2_fw_src->out >> branch->op2;
-    control->comp_ctrl >> branch->comp_op; //
-    branch_op1_src->out >> branch->op1;    //
-    branch_op2_src->out >> branch->op2;    // MODIFIED
+    jump_addr_src->out >> branch_adder->op1;
+    immediate->imm >> branch_adder->op2;
 
+    if (stage == BranchStage::ID) {
+      control->comp_ctrl >> branch->comp_op;
+      branch_op1_src->out >> branch->op1;
+      branch_op2_src->out >> branch->op2;
+      control->do_branch >> *br_and->in[1];
+      control->do_jump >> *controlflow_or->in[1];
+    } else {
+      idex_reg->br_op_out >> branch->comp_op;
+      // Without hazard detection, only the ALU operands are forwarded.
+      if (m_config.hazardDetection) {
+        reg1_fw_src->out >> branch->op1;
+        reg2_fw_src->out >> branch->op2;
+      } else {
+        idex_reg->r1_out >> branch->op1;
+        idex_reg->r2_out >> branch->op2;
+      }
+      idex_reg->do_br_out >> *br_and->in[1];
+      idex_reg->do_jmp_out >> *controlflow_or->in[1];
+    }
     branch->res >> *br_and->in[0];
     br_and->out >> *controlflow_or->in[0];
-    // idex_reg->do_br_out >> *br_and->in[1];
-    // idex_reg->do_jmp_out >> *controlflow_or->in[1];
-    control->do_branch >> *br_and->in[1];       //
-    control->do_jump >> *controlflow_or->in[1]; // MODIFIED
 
-    // MODIFIED: get branch target address from dedicated adder
-    // alu->res >> pc_src->get(PcSrc::ALU);
-    jump_addr_src->out >> branch_adder->op1;
-    immediate->imm >> branch_adder->op2;
-    branch_adder->out >> pc_src->get(PcSrc::ALU); // MODIFIED
-    pc_4->out >> pc_src->get(PcSrc::PC4);
+    // -----------------------------------------------------------------------
+    // Branch prediction
+    pc_reg->out >> bpunit->if_pc;
+    pc_4->out >> bpunit->if_pc4;
+
+    ifid_reg->valid_out >> bpunit->id_valid;
+    hzunit->hazardFEEnable >> bpunit->id_enable;
+    ifid_reg->pc_out >> bpunit->id_pc;
+    ifid_reg->pc4_out >> bpunit->id_pc4;
+    ifid_reg->pred_npc_out >> bpunit->id_pred_npc;
+    decode->opcode >> bpunit->id_opcode;
+    decode->wr_reg_idx >> bpunit->id_wr_reg_idx;
+    decode->r1_reg_idx >> bpunit->id_reg1_idx;
+    control->do_branch >> bpunit->id_do_branch;
+    control->do_jump >> bpunit->id_do_jump;
+    controlflow_or->out >> bpunit->id_taken;
+    branch_adder->out >> bpunit->id_target;
 
     // -----------------------------------------------------------------------
     // ALU
 
     // Forwarding multiplexers
     idex_reg->r1_out >> reg1_fw_src->get(ForwardingSrc::IdStage);
-    exmem_reg->alures_out >>
-        reg1_fw_src->get(
-            ForwardingSrc::MemStage); // Todo: Mem stage needs a mux to allow
-                                      // for AUIPC forwarding
+    exmem_reg->alures_out >> reg1_fw_src->get(ForwardingSrc::MemStage);
     reg_wr_src->out >> reg1_fw_src->get(ForwardingSrc::WbStage);
     funit->alu_reg1_forwarding_ctrl >> reg1_fw_src->select;
 
@@ -193,8 +287,14 @@ public:
     // -----------------------------------------------------------------------
     // Ecall checker
 
-    idex_reg->opcode_out >> ecallChecker->opcode;
+    // Ecalls are handled in EX, once all outstanding register writes have been
+    // performed. Without hazard detection, they are handled in ID.
+    if (m_config.hazardDetection)
+      idex_reg->opcode_out >> ecallChecker->opcode;
+    else
+      decode->opcode >> ecallChecker->opcode;
     ecallChecker->setSyscallCallback(&trapHandler);
+    alu->setCSRReadCallback(&csrReadHandler);
     hzunit->stallEcallHandling >> ecallChecker->stallEcallHandling;
 
     // -----------------------------------------------------------------------
@@ -202,7 +302,8 @@ public:
     pc_4->out >> ifid_reg->pc4_in;
     pc_reg->out >> ifid_reg->pc_in;
     uncompress->exp_instr >> ifid_reg->instr_in;
-    hzunit->hazardFEEnable >> ifid_reg->enable;
+    bpunit->pred_npc >> ifid_reg->pred_npc_in;
+    fee_enable_or->out >> ifid_reg->enable;
     efsc_or->out >> ifid_reg->clear;
     1 >> ifid_reg->valid_in; // Always valid unless register is cleared
 
@@ -245,7 +346,12 @@ public:
     // -----------------------------------------------------------------------
     // EX/MEM
     1 >> exmem_reg->enable;
-    hzunit->hazardEXMEMClear >> exmem_reg->clear;
+    if (stage == BranchStage::MEM && !delayed)
+      exmem_reg->do_branch_out >> *mem_clear_or->in[0];
+    else
+      0 >> *mem_clear_or->in[0];
+    hzunit->hazardEXMEMClear >> *mem_clear_or->in[1];
+    mem_clear_or->out >> exmem_reg->clear;
     hzunit->hazardEXMEMClear >> *mem_stalled_or->in[0];
     idex_reg->stalled_out >> *mem_stalled_or->in[1];
     mem_stalled_or->out >> exmem_reg->stalled_in;
@@ -253,8 +359,12 @@ public:
     // Data
     idex_reg->pc_out >> exmem_reg->pc_in;
     idex_reg->pc4_out >> exmem_reg->pc4_in;
-    reg2_fw_src->out >> exmem_reg->r2_in;
+    if (m_config.hazardDetection)
+      reg2_fw_src->out >> exmem_reg->r2_in;
+    else
+      idex_reg->r2_out >> exmem_reg->r2_in;
     alu->res >> exmem_reg->alures_in;
+    controlflow_or->out >> exmem_reg->do_branch_in;
 
     // Control
     idex_reg->reg_wr_src_ctrl_out >> exmem_reg->reg_wr_src_ctrl_in;
@@ -286,38 +396,70 @@ public:
 
     // -----------------------------------------------------------------------
     // Forwarding unit
-    decode->r1_reg_idx >> funit->if_reg1_idx; //
-    decode->r2_reg_idx >> funit->if_reg2_idx; // MODIFIED
+    decode->r1_reg_idx >> funit->if_reg1_idx;
+    decode->r2_reg_idx >> funit->if_reg2_idx;
     idex_reg->rd_reg1_idx_out >> funit->id_reg1_idx;
     idex_reg->rd_reg2_idx_out >> funit->id_reg2_idx;
 
-    idex_reg->wr_reg_idx_out >> funit->ex_reg_wr_idx;  //
-    idex_reg->reg_do_write_out >> funit->ex_reg_wr_en; // MODIFIED
-
+    idex_reg->wr_reg_idx_out >> funit->ex_reg_wr_idx;
     exmem_reg->wr_reg_idx_out >> funit->mem_reg_wr_idx;
-    exmem_reg->reg_do_write_out >> funit->mem_reg_wr_en;
-
     memwb_reg->wr_reg_idx_out >> funit->wb_reg_wr_idx;
-    memwb_reg->reg_do_write_out >> funit->wb_reg_wr_en;
+
+    // Without forwarding, the forwarding unit observes no register writes and
+    // thus always selects the values read in ID.
+    if (m_config.forwarding) {
+      idex_reg->reg_do_write_out >> funit->ex_reg_wr_en;
+      exmem_reg->reg_do_write_out >> funit->mem_reg_wr_en;
+      memwb_reg->reg_do_write_out >> funit->wb_reg_wr_en;
+    } else {
+      0 >> funit->ex_reg_wr_en;
+      0 >> funit->mem_reg_wr_en;
+      0 >> funit->wb_reg_wr_en;
+    }
 
     // -----------------------------------------------------------------------
     // Hazard detection unit
     decode->r1_reg_idx >> hzunit->id_reg1_idx;
     decode->r2_reg_idx >> hzunit->id_reg2_idx;
-
-    // MODIFIED: load-use hazard detection for branch operands
-    exmem_reg->mem_do_read_out >> hzunit->mem_do_mem_read_en;
-    exmem_reg->wr_reg_idx_out >> hzunit->mem_reg_wr_idx;
+    decode->opcode >> hzunit->id_opcode;
+    control->do_branch >> hzunit->id_do_branch;
+    control->mem_do_write_ctrl >> hzunit->id_mem_do_write;
+    control->alu_op2_ctrl >> hzunit->id_alu_op_ctrl_2;
 
     idex_reg->mem_do_read_out >> hzunit->ex_do_mem_read_en;
     idex_reg->wr_reg_idx_out >> hzunit->ex_reg_wr_idx;
+    idex_reg->reg_do_write_out >> hzunit->ex_do_reg_write;
+    idex_reg->opcode_out >> hzunit->opcode;
 
+    exmem_reg->wr_reg_idx_out >> hzunit->mem_reg_wr_idx;
+    exmem_reg->mem_do_read_out >> hzunit->mem_do_mem_read_en;
     exmem_reg->reg_do_write_out >> hzunit->mem_do_reg_write;
 
     memwb_reg->reg_do_write_out >> hzunit->wb_do_reg_write;
 
-    idex_reg->opcode_out >> hzunit->opcode;
-    decode->opcode >> hzunit->id_opcode;
+    mdunit->hazard >> hzunit->mulDivHazard;
+
+    // The instruction in ID is squashed by control-flow instructions resolved
+    // in a later stage, unless it is a delay slot.
+    if (stage == BranchStage::ID || delayed) {
+      0 >> hzunit->id_squashed;
+      0 >> mdunit->redirect;
+    } else {
+      redirect >> hzunit->id_squashed;
+      redirect >> mdunit->redirect;
+    }
+
+    // -----------------------------------------------------------------------
+    // Multiply/divide latency
+    control->alu_ctrl >> mdunit->id_alu_ctrl;
+    decode->r1_reg_idx >> mdunit->id_reg1_idx;
+    decode->r2_reg_idx >> mdunit->id_reg2_idx;
+    ifid_reg->valid_out >> mdunit->id_valid;
+
+    idex_reg->alu_ctrl_out >> mdunit->ex_alu_ctrl;
+    idex_reg->wr_reg_idx_out >> mdunit->ex_reg_wr_idx;
+    idex_reg->valid_out >> mdunit->ex_valid;
+    hzunit->hazardIDEXEnable >> mdunit->ex_enable;
   }
 
   // Design subcomponents
@@ -327,17 +469,17 @@ public:
   SUBCOMPONENT(immediate, TYPE(Immediate<XLEN>));
   SUBCOMPONENT(decode, TYPE(Decode<XLEN>));
   SUBCOMPONENT(branch, TYPE(Branch<XLEN>));
-  SUBCOMPONENT(branch_adder, TYPE(Adder<XLEN>)); // MODIFIED
   SUBCOMPONENT(pc_4, Adder<XLEN>);
+  SUBCOMPONENT(branch_adder, TYPE(Adder<XLEN>));
   SUBCOMPONENT(uncompress, TYPE(Uncompress<XLEN>));
 
   // Registers
   SUBCOMPONENT(pc_reg, RegisterClEn<XLEN>);
 
   // Stage seperating registers
-  SUBCOMPONENT(ifid_reg, TYPE(IFID<XLEN>));
+  SUBCOMPONENT(ifid_reg, TYPE(IFID_BP<XLEN>));
   SUBCOMPONENT(idex_reg, TYPE(RV5S_IDEX<XLEN>));
-  SUBCOMPONENT(exmem_reg, TYPE(RV5S_EXMEM<XLEN>));
+  SUBCOMPONENT(exmem_reg, TYPE(RV5S_3S_EXMEM<XLEN>));
   SUBCOMPONENT(memwb_reg, TYPE(RV5S_MEMWB<XLEN>));
 
   // Multiplexers
@@ -348,34 +490,42 @@ public:
   SUBCOMPONENT(reg1_fw_src, TYPE(EnumMultiplexer<ForwardingSrc, XLEN>));
   SUBCOMPONENT(reg2_fw_src, TYPE(EnumMultiplexer<ForwardingSrc, XLEN>));
   SUBCOMPONENT(pc_inc, TYPE(EnumMultiplexer<PcInc, XLEN>));
-  // MODIFIED: branch operand forwarding multiplexers
+  // Branch operand forwarding multiplexers
   SUBCOMPONENT(branch_op1_src, TYPE(EnumMultiplexer<ForwardingSrc_1S, XLEN>));
   SUBCOMPONENT(branch_op2_src, TYPE(EnumMultiplexer<ForwardingSrc_1S, XLEN>));
-  // MODIFIED: enable jumps relative to address in register
+  // Jump target operand multiplexer
   SUBCOMPONENT(jump_addr_src, TYPE(EnumMultiplexer<AluSrc1, XLEN>));
 
   // Memories
   SUBCOMPONENT(instr_mem, TYPE(ROM<XLEN, c_RVInstrWidth>));
   SUBCOMPONENT(data_mem, TYPE(RVMemory<XLEN, XLEN>));
 
-  // MODIFIED: Forwarding & hazard detection units
+  // Forwarding & hazard detection units
   SUBCOMPONENT(funit, ForwardingUnit_1S);
-  SUBCOMPONENT(hzunit, HazardUnit_1S);
+  SUBCOMPONENT(hzunit, HazardUnit_PARAM);
+  SUBCOMPONENT(mdunit, MulDivUnit);
+
+  // Branch prediction unit
+  SUBCOMPONENT(bpunit, TYPE(BranchPredictionUnit<XLEN>));
 
   // Gates
   // True if branch instruction and branch taken
   SUBCOMPONENT(br_and, TYPE(And<1, 2>));
   // True if branch taken or jump instruction
   SUBCOMPONENT(controlflow_or, TYPE(Or<1, 2>));
-  // True if controlflow action or performing syscall finishing
+  // True if the instruction in IF is squashed or performing syscall finishing
   SUBCOMPONENT(efsc_or, TYPE(Or<1, 2>));
-  // True if performing syscall finishing or stalling due to load-use hazard
+  // True if the instruction in ID is squashed or stalling due to a hazard
   SUBCOMPONENT(efschz_or, TYPE(Or<1, 2>));
+  // True if the instruction in EX is squashed or stalling due to an ecall
+  SUBCOMPONENT(mem_clear_or, TYPE(Or<1, 2>));
+  // True if the front-end is redirected or not stalled
+  SUBCOMPONENT(fee_enable_or, TYPE(Or<1, 2>));
 
   SUBCOMPONENT(mem_stalled_or, TYPE(Or<1, 2>));
 
   // Address spaces
-  ADDRESSSPACEMM(m_memory);
+  PAGEDADDRESSSPACE(m_memory);
   ADDRESSSPACE(m_regMem);
 
   SUBCOMPONENT(ecallChecker, EcallChecker);
@@ -395,7 +545,9 @@ public:
         Q_UNREACHABLE();
     // clang-format on
   }
-  AInt nextFetchedAddress() const override { return pc_src->out.uValue(); }
+  AInt nextFetchedAddress() const override {
+    return m_config.prediction ? bpunit->npc.uValue() : pc_src->out.uValue();
+  }
   QString stageName(StageIndex idx) const override {
     // clang-format off
         switch (idx.index()) {
@@ -434,7 +586,7 @@ public:
         }
 
         // Are we currently clearing the pipeline due to a syscall exit?
-		// if such, all stages before the EX stage are invalid
+        // if such, all stages before the EX stage are invalid
         if(stage.index() < EX){
             stageValid &= !ecallChecker->isSysCallExiting();
         }
@@ -486,7 +638,7 @@ public:
   void setPCInitialValue(AInt address) override {
     pc_reg->setInitValue(address);
   }
-  AddressSpaceMM &getMemory() override { return *m_memory; }
+  PagedAddressSpace &getMemory() override { return *m_memory; }
   VInt getRegister(const std::string_view &, unsigned i) const override {
     return registerFile->getRegister(i);
   }
@@ -537,6 +689,9 @@ public:
       m_instructionsRetired++;
     }
 
+    if (m_config.prediction)
+      bpunit->resolve(m_cycleCount);
+    mdunit->clock();
     Design::clock();
   }
 
@@ -547,6 +702,9 @@ public:
       ecallChecker->setSysCallExiting(false);
       m_syscallExitCycle = -1;
     }
+    if (m_config.prediction)
+      bpunit->predictor().reverse(m_cycleCount - 1);
+    mdunit->reverse();
     Design::reverse();
     if (memwb_reg->valid_out.uValue() != 0 &&
         isExecutableAddress(memwb_reg->pc_out.uValue())) {
@@ -556,10 +714,28 @@ public:
 
   void reset() override {
     ecallChecker->setSysCallExiting(false);
+    bpunit->predictor().reset();
+    mdunit->reset();
     Design::reset();
     m_syscallExitCycle = -1;
   }
 
+  void setMaxReverseCycles(unsigned cycles) override {
+    RipesVSRTLProcessor::setMaxReverseCycles(cycles);
+    mdunit->setReverseStackSize(cycles);
+  }
+  BranchPredictor *branchPredictor() const override {
+    return m_config.prediction ? &bpunit->predictor() : nullptr;
+  }
+  FULatencies *functionalUnitLatencies() override {
+    // Without hazard detection, dependent instructions are never held back.
+    return m_config.hazardDetection ? &mdunit->latencies() : nullptr;
+  }
+  const FUStats *functionalUnitStats() const override {
+    return m_config.hazardDetection ? &mdunit->stats() : nullptr;
+  }
+  const PipelineConfig *pipelineConfig() const override { return &m_config; }
+
   static ProcessorISAInfo supportsISA() { return RVISA::supportsISA<XLEN>(); }
   const ISAInfoBase *implementsISA() const override {
     return m_enabledISA.get();
@@ -588,6 +764,7 @@ private:
   long long m_syscallExitCycle = -1;
   std::shared_ptr<ISAInfoBase> m_enabledISA;
   ProcessorStructure m_structure = {{0, 5}};
+  PipelineConfig m_config;
 };
 
 } // namespace core
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "processors/RISC-V/riscv.h"
+#include "processors/interface/pipelineconfig.h"
+
+#include "VSRTL/core/vsrtl_component.h"
+
+namespace vsrtl {
+namespace core {
+using namespace Ripes;
+
+/**
+ * @brief The HazardUnit_PARAM class
+ * Hazard detection unit of the parametric 5-stage pipeline. Which data hazards
+ * must be detected depends on whether results are forwarded, and on the stage
+ * in which control-flow instructions read their operands; the unit is
+ * configured accordingly when the processor is constructed.
+ */
+class HazardUnit_PARAM : public Component {
+public:
+  HazardUnit_PARAM(const std::string &name, SimComponent *parent)
+      : Component(name, parent) {
+    hazardFEEnable << [=] { return !hasHazard(); };
+    hazardIDEXEnable << [=] { return !hasEcallHazard(); };
+    hazardEXMEMClear << [=] { return hasEcallHazard(); };
+    hazardIDEXClear << [=] { return hasDataHazard() || hasMulDivHazard(); };
+    stallEcallHandling << [=] { return hasEcallHazard(); };
+  }
+
+  void configure(const PipelineConfig &config) { m_config = config; }
+
+  // Instruction in ID
+  INPUTPORT(id_reg1_idx, c_RVRegsBits);
+  INPUTPORT(id_reg2_idx, c_RVRegsBits);
+  INPUTPORT_ENUM(id_opcode, RVInstr);
+  INPUTPORT(id_do_branch, 1);
+  INPUTPORT(id_mem_do_write, 1);
+  INPUTPORT_ENUM(id_alu_op_ctrl_2, AluSrc2);
+
+  // High when the instruction in ID is squashed by a control-flow instruction
+  // in a later stage, in which case it shall not wait for outstanding register
+  // writes.
+  INPUTPORT(id_squashed, 1);
+
+  INPUTPORT(ex_reg_wr_idx, c_RVRegsBits);
+  INPUTPORT(ex_do_mem_read_en, 1);
+  INPUTPORT(ex_do_reg_write, 1);
+  INPUTPORT_ENUM(opcode, RVInstr);
+
+  INPUTPORT(mem_reg_wr_idx, c_RVRegsBits);
+  INPUTPORT(mem_do_mem_read_en, 1);
+  INPUTPORT(mem_do_reg_write, 1);
+
+  INPUTPORT(wb_do_reg_write, 1);
+
+  // High when the instruction in ID must wait for a multi-cycle functional
+  // unit (see MulDivUnit).
+  INPUTPORT(mulDivHazard, 1);
+
+  // Hazard Front End enable: Low when stalling the front end (shall be
+  // connected to a register 'enable' input port).
+  OUTPUTPORT(hazardFEEnable, 1);
+
+  // Hazard IDEX enable: Low when stalling due to an ECALL hazard
+  OUTPUTPORT(hazardIDEXEnable, 1);
+
+  // EXMEM clear: High when an ECALL hazard is detected
+  OUTPUTPORT(hazardEXMEMClear, 1);
+  // IDEX clear: High when a data or mul/div hazard is detected
+  OUTPUTPORT(hazardIDEXClear, 1);
+
+  // Stall Ecall Handling: High whenever we are about to handle an ecall, but
+  // have outstanding writes in the pipeline which must be comitted to the
+  // register file before handling the ecall.
+  OUTPUTPORT(stallEcallHandling, 1);
+
+private:
+  bool hasHazard() const {
+    return hasDataHazard() || hasEcallHazard() || hasMulDivHazard();
+  }
+
+  bool hasMulDivHazard() const {
+    return m_config.hazardDetection && mulDivHazard.uValue();
+  }
+
+  bool hasDataHazard() const {
+    if (!m_config.hazardDetection)
+      return false;
+
+    const unsigned idx1 = id_reg1_idx.uValue();
+    const unsigned idx2 = id_reg2_idx.uValue();
+    const unsigned exIdx = ex_reg_wr_idx.uValue();
+    const unsigned memIdx = mem_reg_wr_idx.uValue();
+
+    // Load-use: a loaded value is available no earlier than the WB stage.
+    const bool loadUse =
+        (exIdx == idx1 || exIdx == idx2) && ex_do_mem_read_en.uValue();
+
+    if (!m_config.forwarding) {
+      // Operands are read from the register file, which forwards the value
+      // being written back; all results in EX and MEM are outstanding, unless
+      // the instruction in ID is squashed.
+      if (id_squashed.uValue())
+        return loadUse;
+      return loadUse || readsRegister(exIdx, ex_do_reg_write.uValue()) ||
+             readsRegister(memIdx, mem_do_reg_write.uValue());
+    }
+
+    // Control-flow instructions resolved in ID require their operands a stage
+    // earlier than the ALU, and must additionally wait for loads in MEM.
+    const bool branchUse =
+        m_config.branchStage == PipelineConfig::BranchStage::ID &&
+        isControlFlow(id_opcode.eValue<RVInstr>()) &&
+        (memIdx == idx1 || memIdx == idx2) && mem_do_mem_read_en.uValue();
+    return loadUse || branchUse;
+  }
+
+  /// Returns true if the instruction in ID reads register @p writeIdx which
+  /// is written by an instruction in a later stage.
+  bool readsRegister(unsigned writeIdx, bool regWrite) const {
+    if (writeIdx == 0 || !regWrite)
+      return false;
+    // The second register index is an immediate field, unless the instruction
+    // is an R-type, branch or store instruction.
+    const bool idx2isReg =
+        id_alu_op_ctrl_2.eValue<AluSrc2>() == AluSrc2::REG2 ||
+        id_do_branch.uValue() || id_mem_do_write.uValue();
+    return writeIdx == id_reg1_idx.uValue() ||
+           (idx2isReg && writeIdx == id_reg2_idx.uValue());
+  }
+
+  static bool isControlFlow(RVInstr opcode) {
+    switch (opcode) {
+    case RVInstr::JAL:
+    case RVInstr::JALR:
+    case RVInstr::BEQ:
+    case RVInstr::BNE:
+    case RVInstr::BLT:
+    case RVInstr::BGE:
+    case RVInstr::BLTU:
+    case RVInstr::BGEU:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  bool hasEcallHazard() const {
+    // Without hazard detection, ecalls are handled in ID (see RV5S_PARAM).
+    if (!m_config.hazardDetection)
+      return false;
+
+    // Check for ECALL hazard. We are implictly dependent on all registers when
+    // performing an ECALL operation. As such, all outstanding writes to the
+    // register file must be performed before handling the ecall. Hence, the
+    // front-end of the pipeline shall be stalled until the remainder of the
+    // pipeline has been cleared and there are no more outstanding writes.
+    const bool isEcall = opcode.eValue<RVInstr>() == RVInstr::ECALL;
+    return isEcall && (mem_do_reg_write.uValue() || wb_do_reg_write.uValue());
+  }
+
+  PipelineConfig m_config;
+};
+} // namespace core
+} // namespace vsrtl
@@ -34,6 +34,7 @@
 // Forwarding & Hazard detection unit
 #include "rv6s_dual_forwardingunit.h"
 #include "rv6s_dual_hazardunit.h"
+#include "rv6s_dual_muldivunit.h"
 
 namespace vsrtl {
 namespace core {
@@ -314,6 +315,8 @@ public:
 
     iiex_reg->opcode_out >> ecallChecker->opcode;
     ecallChecker->setSyscallCallback(&trapHandler);
+    alu->setCSRReadCallback(&csrReadHandler);
+    alu_data->setCSRReadCallback(&csrReadHandler);
     hzunit->stallEcallHandling >> ecallChecker->stallEcallHandling;
 
     // -----------------------------------------------------------------------
@@ -518,6 +521,24 @@ public:
     memwb_reg->reg_do_write_data_out >> hzunit->wb_do_reg_write_data;
 
     iiex_reg->opcode_out >> hzunit->opcode;
+    mdunit->hazard >> hzunit->mulDivHazard;
+
+    // -----------------------------------------------------------------------
+    // Multiply/divide latency
+    control->alu_ctrl_exec >> mdunit->id_alu_ctrl;
+    idii_reg->rd_reg1_idx_exec_out >> mdunit->id_reg1_idx;
+    idii_reg->rd_reg2_idx_exec_out >> mdunit->id_reg2_idx;
+    idii_reg->exec_valid_out >> mdunit->id_valid;
+    idii_reg->rd_reg1_idx_data_out >> mdunit->id_reg1_idx_data;
+    idii_reg->rd_reg2_idx_data_out >> mdunit->id_reg2_idx_data;
+    idii_reg->data_valid_out >> mdunit->id_valid_data;
+
+    iiex_reg->alu_ctrl_out >> mdunit->ex_alu_ctrl;
+    iiex_reg->wr_reg_idx_out >> mdunit->ex_reg_wr_idx;
+    iiex_reg->exec_valid_out >> mdunit->ex_valid;
+    hzunit->hazardIDEXEnable >> mdunit->ex_enable;
+
+    branch->did_controlflow >> mdunit->redirect;
   }
 
   // Design subcomponents
@@ -598,6 +619,7 @@ public:
   // Forwarding & hazard detection units
   SUBCOMPONENT(funit, ForwardingUnit_DUAL);
   SUBCOMPONENT(hzunit, HazardUnit_DUAL);
+  SUBCOMPONENT(mdunit, MulDivUnit_DUAL);
 
   // Gates
   // True if controlflow action or performing syscall finishing
@@ -618,7 +640,7 @@ public:
   SUBCOMPONENT(wayhazard, TYPE(Nand<1, 2>));
 
   // Address spaces
-  ADDRESSSPACEMM(m_memory);
+  PAGEDADDRESSSPACE(m_memory);
   ADDRESSSPACE(m_regMem);
 
   SUBCOMPONENT(ecallChecker, EcallChecker);
@@ -791,7 +813,7 @@ public:
   void setPCInitialValue(AInt address) override {
     pc_reg->setInitValue(address);
   }
-  AddressSpaceMM &getMemory() override { return *m_memory; }
+  PagedAddressSpace &getMemory() override { return *m_memory; }
   VInt getRegister(const std::string_view &, unsigned i) const override {
     return registerFile->getRegister(i);
   }
@@ -854,11 +876,15 @@ public:
     return amount;
   }
 
+  const IssueStats *issueStats() const override { return &m_issueStats; }
+
   void clockProcessor() override {
     // An instruction has been retired if the instruction in the WB stage is
     // valid and the PC is within the executable range of the program
     m_instructionsRetired += instructionsRetired();
+    accountIssue(false);
 
+    mdunit->clock();
     Design::clock();
   }
 
@@ -869,14 +895,29 @@ public:
       ecallChecker->setSysCallExiting(false);
       m_syscallExitCycle = -1;
     }
+    mdunit->reverse();
     Design::reverse();
     m_instructionsRetired -= instructionsRetired();
+    accountIssue(true);
   }
 
   void reset() override {
     ecallChecker->setSysCallExiting(false);
+    mdunit->reset();
     Design::reset();
     m_syscallExitCycle = -1;
+    m_issueStats.reset();
+  }
+
+  void setMaxReverseCycles(unsigned cycles) override {
+    RipesVSRTLProcessor::setMaxReverseCycles(cycles);
+    mdunit->setReverseStackSize(cycles);
+  }
+  FULatencies *functionalUnitLatencies() override {
+    return &mdunit->latencies();
+  }
+  const FUStats *functionalUnitStats() const override {
+    return &mdunit->stats();
   }
 
   static ProcessorISAInfo supportsISA() { return RVISA::supportsISA<XLEN>(); }
@@ -898,6 +939,49 @@ public:
   }
 
 private:
+  /**
+   * @brief accountIssue
+   * Accounts for the instructions issued from the ID stage in the current
+   * cycle, and, if less than two instructions are issued, the reason for the
+   * unused issue slot(s). If @p undo is set, the cycle is removed from the
+   * statistics.
+   */
+  void accountIssue(bool undo) {
+    if (m_cycleCount < ID)
+      return;
+    const bool idValid = ifid_reg->valid_out.uValue() != 0;
+    if (!idValid || branch->did_controlflow.uValue()) {
+      m_issueStats.account(0, IssueStats::Reason::Redirect, undo);
+      return;
+    }
+    if (!isExecutableAddress(ifid_reg->pc_out.uValue()))
+      return;
+    if (!hzunit->hazardFEEnable.uValue()) {
+      IssueStats::Reason reason = IssueStats::Reason::LoadUse;
+      if (!hzunit->hazardIDEXEnable.uValue())
+        reason = IssueStats::Reason::Serialization;
+      else if (mdunit->currentHazard() == MulDivUnit::Hazard::Structural)
+        reason = IssueStats::Reason::MulDiv;
+      else if (mdunit->currentHazard() == MulDivUnit::Hazard::Latency)
+        reason = IssueStats::Reason::DataDependency;
+      m_issueStats.account(0, reason, undo);
+      return;
+    }
+    unsigned issued = 0;
+    if (waycontrol->exec_way_valid.uValue() &&
+        isExecutableAddress(exec_way_pc->out.uValue()))
+      issued++;
+    if (waycontrol->data_way_valid.uValue() &&
+        isExecutableAddress(data_way_pc->out.uValue()))
+      issued++;
+    IssueStats::Reason reason = waycontrol->pairingFailure();
+    if (issued < 2 && reason == IssueStats::Reason::None)
+      reason = IssueStats::Reason::Other;
+    m_issueStats.account(issued, reason, undo);
+  }
+
+  IssueStats m_issueStats = IssueStats(2);
+
   /**
    * @brief m_syscallExitCycle
    * The variable will contain the cycle of which an exit system call was
@@ -15,7 +15,7 @@ public:
     hazardFEEnable << [=] { return !hasHazard(); };
     hazardIDEXEnable << [=] { return !hasEcallHazard(); };
     hazardEXMEMClear << [=] { return hasEcallHazard(); };
-    hazardIDEXClear << [=] { return hasLoadUseHazard(); };
+    hazardIDEXClear << [=] { return hasLoadUseHazard() || hasMulDivHazard(); };
     stallEcallHandling << [=] { return hasEcallHazard(); };
   }
 
@@ -35,6 +35,10 @@ public:
 
   INPUTPORT_ENUM(opcode, RVInstr);
 
+  // High when an instruction in ID must wait for a multi-cycle functional
+  // unit (see MulDivUnit).
+  INPUTPORT(mulDivHazard, 1);
+
   // Hazard Front End enable: Low when stalling the front end (shall be
   // connected to a register 'enable' input port). The
   OUTPUTPORT(hazardFEEnable, 1);
@@ -44,7 +48,7 @@ public:
 
   // EXMEM clear: High when an ECALL hazard is detected
   OUTPUTPORT(hazardEXMEMClear, 1);
-  // IDEX clear: High when a load-use hazard is detected
+  // IDEX clear: High when a load-use or mul/div hazard is detected
   OUTPUTPORT(hazardIDEXClear, 1);
 
   // Stall Ecall Handling: High whenever we are about to handle an ecall, but
@@ -53,7 +57,11 @@ public:
   OUTPUTPORT(stallEcallHandling, 1);
 
 private:
-  bool hasHazard() { return hasLoadUseHazard() || hasEcallHazard(); }
+  bool hasHazard() {
+    return hasLoadUseHazard() || hasEcallHazard() || hasMulDivHazard();
+  }
+
+  bool hasMulDivHazard() const { return mulDivHazard.uValue(); }
 
   bool hasLoadUseHazard() const {
     const unsigned exidx_data = ex_reg_wr_idx_data.uValue();
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "processors/RISC-V/rv_muldivunit.h"
+
+namespace vsrtl {
+namespace core {
+using namespace Ripes;
+
+/**
+ * @brief The MulDivUnit_DUAL class
+ * Multiply/divide latency tracking for the dual-issue processor. Multiply and
+ * divide instructions execute in the exec way, connected to the ports of
+ * MulDivUnit; instructions in the data way may however depend on their
+ * results.
+ */
+class MulDivUnit_DUAL : public MulDivUnit {
+public:
+  MulDivUnit_DUAL(const std::string &name, SimComponent *parent)
+      : MulDivUnit(name, parent) {}
+
+  INPUTPORT(id_reg1_idx_data, c_RVRegsBits);
+  INPUTPORT(id_reg2_idx_data, c_RVRegsBits);
+  INPUTPORT(id_valid_data, 1);
+
+protected:
+  std::vector<Slot> decodeStage() const override {
+    auto slots = MulDivUnit::decodeStage();
+    slots.push_back({id_valid_data.uValue() != 0, NKinds,
+                     static_cast<unsigned>(id_reg1_idx_data.uValue()),
+                     static_cast<unsigned>(id_reg2_idx_data.uValue())});
+    return slots;
+  }
+};
+
+} // namespace core
+} // namespace vsrtl
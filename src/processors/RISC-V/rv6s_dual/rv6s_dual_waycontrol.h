@@ -1,6 +1,7 @@
 #pragma once
 
 #include "VSRTL/core/vsrtl_component.h"
+#include "processors/interface/issuestats.h"
 #include "processors/RISC-V/rv_control.h"
 #include "rv6s_dual_common.h"
 
@@ -48,6 +49,10 @@ private:
             // Jump instructions
             case RVInstr::JALR:
             case RVInstr::JAL:
+
+            // CSR instructions
+            case RVInstr::CSRRW: case RVInstr::CSRRS: case RVInstr::CSRRC:
+            case RVInstr::CSRRWI: case RVInstr::CSRRSI: case RVInstr::CSRRCI:
                 return true;
             default: return false;
         }
@@ -205,6 +210,28 @@ public:
     Q_ASSERT(m_design != nullptr);
   }
 
+  /**
+   * @brief pairingFailure
+   * Returns the reason for which the two currently fetched instructions cannot
+   * be issued together, or IssueStats::Reason::None if they can. Whenever a
+   * pair is split, the instructions are issued over two cycles, so the reason
+   * also applies to the cycle in which the 2nd instruction issues alone.
+   */
+  IssueStats::Reason pairingFailure() const {
+    const WayClass way1Type = instrType(opcode_way1.eValue<RVInstr>());
+    const WayClass way2Type = instrType(opcode_way2.eValue<RVInstr>());
+    if (way1Type == WayClass::Controlflow)
+      return IssueStats::Reason::ControlFlow;
+    if (way1Type == WayClass::Ecall || way2Type == WayClass::Ecall)
+      return IssueStats::Reason::Serialization;
+    if (structuralHazard(way1Type, way2Type))
+      return way1Type == WayClass::Data ? IssueStats::Reason::MemPort
+                                        : IssueStats::Reason::ControlFlow;
+    if (rawHazard())
+      return IssueStats::Reason::DataDependency;
+    return IssueStats::Reason::None;
+  }
+
   INPUTPORT(ifid_valid, 1);
 
   INPUTPORT_ENUM(opcode_way1, RVInstr);
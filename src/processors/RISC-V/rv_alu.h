@@ -1,6 +1,7 @@
 #pragma once
 
 #include "limits.h"
+#include <functional>
 #include <math.h>
 
 #include "riscv.h"
@@ -151,17 +152,30 @@ public:
         return VT_U(signextend<32>(static_cast<uint32_t>(op1.uValue()) >>
                                    (op2.uValue() & generateBitmask(5))));
 
+      case ALUOp::CSRR:
+        // The CSR number is provided through op2.
+        return m_csrRead && *m_csrRead ? VT_U((*m_csrRead)(op2.uValue()))
+                                       : VT_U(0);
+
       default:
         throw std::runtime_error("Invalid ALU opcode");
       }
     };
   }
 
+  /// Sets the callback used to read the value of a CSR.
+  void setCSRReadCallback(std::function<VInt(unsigned)> const *cb) {
+    m_csrRead = cb;
+  }
+
   INPUTPORT_ENUM(ctrl, ALUOp);
   INPUTPORT(op1, XLEN);
   INPUTPORT(op2, XLEN);
 
   OUTPUTPORT(res, XLEN);
+
+private:
+  std::function<VInt(unsigned)> const *m_csrRead = nullptr;
 };
 
 } // namespace core
@@ -25,7 +25,21 @@ public:
             case RVISA::OpcodeID::AUIPC: return RVInstr::AUIPC;
             case RVISA::OpcodeID::JAL: return RVInstr::JAL;
             case RVISA::OpcodeID::JALR: return RVInstr::JALR;
-            case RVISA::OpcodeID::SYSTEM: return RVInstr::ECALL;
+            case RVISA::OpcodeID::SYSTEM: {
+                // Only the read-only counter CSRs are implemented; all CSR
+                // operations are thus reads of the old CSR value into rd.
+                switch((instrValue >> 12) & 0b111) {
+                case 0b000: return RVInstr::ECALL;
+                case 0b001: return RVInstr::CSRRW;
+                case 0b010: return RVInstr::CSRRS;
+                case 0b011: return RVInstr::CSRRC;
+                case 0b101: return RVInstr::CSRRWI;
+                case 0b110: return RVInstr::CSRRSI;
+                case 0b111: return RVInstr::CSRRCI;
+                default: break;
+                }
+                break;
+            }
 
             case RVISA::OpcodeID::OPIMM: {
                 // I-Type
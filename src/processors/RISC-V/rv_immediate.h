@@ -69,6 +69,13 @@ public:
       case RVInstr::SRLIW:
       case RVInstr::SRAIW:
         return VT_U((instr.uValue() >> 20) & 0b11111);
+      case RVInstr::CSRRW:
+      case RVInstr::CSRRS:
+      case RVInstr::CSRRC:
+      case RVInstr::CSRRWI:
+      case RVInstr::CSRRSI:
+      case RVInstr::CSRRCI:
+        return VT_U((instr.uValue() >> 20) & 0xfff);
       case RVInstr::SB:
       case RVInstr::SH:
       case RVInstr::SW:
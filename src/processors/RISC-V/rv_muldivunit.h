@@ -0,0 +1,219 @@
+#pragma once
+
+#include <array>
+#include <deque>
+#include <vector>
+
+#include "VSRTL/core/vsrtl_component.h"
+
+#include "processors/interface/fulatencies.h"
+#include "riscv.h"
+
+namespace vsrtl {
+namespace core {
+using namespace Ripes;
+
+/**
+ * @brief The MulDivUnit class
+ * Enforces the latencies of the multiplier and divider of a pipelined
+ * processor. The ALU computes M-extension results combinationally; this unit
+ * models the latency of the operation by holding back the instruction in the
+ * decode stage until
+ *  - the results it depends on would have been available, given the latency
+ *    of the multi-cycle operations that produce them, and
+ *  - a non-pipelined unit which it requires is no longer occupied by an
+ *    earlier operation.
+ * The hazard output shall be combined with the load-use hazard of the hazard
+ * unit.
+ *
+ * The unit tracks the number of cycles until the result of each register is
+ * available and until each unit is free. This state is not a part of the
+ * circuit: the processor must call clock(), reverse() and reset() _before_
+ * clocking, reversing and resetting the design.
+ */
+class MulDivUnit : public Component {
+public:
+  enum class Hazard { None, Latency, Structural };
+  enum Kind { Mul, Div, NKinds };
+
+  MulDivUnit(const std::string &name, SimComponent *parent)
+      : Component(name, parent) {
+    hazard << [=] { return currentHazard() != Hazard::None; };
+  }
+
+  // Instruction in the decode stage
+  INPUTPORT_ENUM(id_alu_ctrl, ALUOp);
+  INPUTPORT(id_reg1_idx, c_RVRegsBits);
+  INPUTPORT(id_reg2_idx, c_RVRegsBits);
+  INPUTPORT(id_valid, 1);
+
+  // Instruction in the execute stage
+  INPUTPORT_ENUM(ex_alu_ctrl, ALUOp);
+  INPUTPORT(ex_reg_wr_idx, c_RVRegsBits);
+  INPUTPORT(ex_valid, 1);
+  // Enable of the pipeline register in front of the execute stage. While low,
+  // the instruction in the execute stage is held there by another stall.
+  INPUTPORT(ex_enable, 1);
+
+  // High when the front-end is being redirected; the instruction in the
+  // decode stage is squashed, and shall not stall the pipeline. Any multiply or
+  // divide instruction in the execute stage is squashed as well.
+  INPUTPORT(redirect, 1);
+
+  // High when the instruction in the decode stage must be held back.
+  OUTPUTPORT(hazard, 1);
+
+  FULatencies &latencies() { return m_latencies; }
+  const FUStats &stats() const { return m_state.stats; }
+
+  /// Returns the reason for which the instruction in the decode stage is held
+  /// back in the current cycle.
+  Hazard currentHazard() const {
+    if (redirect.uValue())
+      return Hazard::None;
+    const Slot ex = executeStage();
+    const bool exMulDiv = ex.valid && ex.kind != NKinds;
+    Hazard hazard = Hazard::None;
+    for (const Slot &id : decodeStage()) {
+      if (!id.valid)
+        continue;
+      for (unsigned reg : {id.reg1, id.reg2}) {
+        if (reg == 0)
+          continue;
+        if (m_state.pending[reg] > 1 ||
+            (exMulDiv && ex.reg1 == reg && unit(ex.kind).latency > 1))
+          return Hazard::Latency;
+      }
+      if (id.kind == NKinds)
+        continue;
+      if (m_state.busy[id.kind] > 1 ||
+          (exMulDiv && ex.kind == id.kind && !unit(id.kind).pipelined &&
+           unit(id.kind).latency > 1))
+        hazard = Hazard::Structural;
+    }
+    return hazard;
+  }
+
+  void clock() {
+    m_history.push_back(m_state);
+    if (m_history.size() > m_reverseStackSize)
+      m_history.pop_front();
+
+    switch (currentHazard()) {
+    case Hazard::Latency:
+      m_state.stats.latencyStalls++;
+      break;
+    case Hazard::Structural:
+      m_state.stats.structuralStalls++;
+      break;
+    case Hazard::None:
+      break;
+    }
+
+    for (auto &cycles : m_state.pending)
+      cycles = cycles > 0 ? cycles - 1 : 0;
+    for (auto &cycles : m_state.busy)
+      cycles = cycles > 0 ? cycles - 1 : 0;
+
+    // An instruction occupies its unit from the cycle in which it entered the
+    // execute stage. Cycles in which it is held there by another stall (such
+    // as an ecall hazard) shall not restart the operation.
+    const bool entered = !m_state.exHeld;
+    m_state.exHeld = ex_enable.uValue() == 0;
+
+    const Slot ex = executeStage();
+    if (!entered || redirect.uValue() || !ex.valid || ex.kind == NKinds)
+      return;
+    const FULatencies::Unit &u = unit(ex.kind);
+    if (ex.reg1 != 0)
+      m_state.pending[ex.reg1] =
+          std::max(m_state.pending[ex.reg1], u.latency - 1);
+    if (!u.pipelined)
+      m_state.busy[ex.kind] = u.latency - 1;
+  }
+
+  void reverse() {
+    if (m_history.empty())
+      return;
+    m_state = m_history.back();
+    m_history.pop_back();
+  }
+
+  void reset() {
+    m_latencies.sanitize();
+    m_state = State();
+    m_history.clear();
+  }
+
+  void setReverseStackSize(unsigned size) { m_reverseStackSize = size; }
+
+protected:
+  /// An instruction in a stage of the pipeline. For instructions in the
+  /// execute stage, reg1 is the destination register.
+  struct Slot {
+    bool valid;
+    Kind kind;
+    unsigned reg1;
+    unsigned reg2;
+  };
+
+  static Kind kindOf(ALUOp op) {
+    switch (op) {
+    case ALUOp::MUL:
+    case ALUOp::MULH:
+    case ALUOp::MULHU:
+    case ALUOp::MULHSU:
+    case ALUOp::MULW:
+      return Mul;
+    case ALUOp::DIV:
+    case ALUOp::DIVU:
+    case ALUOp::REM:
+    case ALUOp::REMU:
+    case ALUOp::DIVW:
+    case ALUOp::DIVUW:
+    case ALUOp::REMW:
+    case ALUOp::REMUW:
+      return Div;
+    default:
+      return NKinds;
+    }
+  }
+
+  /// Returns the instructions in the decode stage. Only the first may be a
+  /// multiply or divide instruction.
+  virtual std::vector<Slot> decodeStage() const {
+    return {{id_valid.uValue() != 0, kindOf(id_alu_ctrl.eValue<ALUOp>()),
+             static_cast<unsigned>(id_reg1_idx.uValue()),
+             static_cast<unsigned>(id_reg2_idx.uValue())}};
+  }
+
+private:
+  Slot executeStage() const {
+    return {ex_valid.uValue() != 0, kindOf(ex_alu_ctrl.eValue<ALUOp>()),
+            static_cast<unsigned>(ex_reg_wr_idx.uValue()), 0};
+  }
+
+  const FULatencies::Unit &unit(Kind kind) const {
+    return kind == Mul ? m_latencies.mul : m_latencies.div;
+  }
+
+  struct State {
+    // Cycles until the value of each register may be used by an instruction
+    // entering the execute stage.
+    std::array<unsigned, 32> pending{};
+    // Cycles until each non-pipelined unit is free.
+    std::array<unsigned, NKinds> busy{};
+    // The instruction in the execute stage was held there in the previous
+    // cycle, and has already been issued to its unit.
+    bool exHeld = false;
+    FUStats stats;
+  };
+
+  FULatencies m_latencies;
+  State m_state;
+  std::deque<State> m_history;
+  unsigned m_reverseStackSize = 0;
+};
+
+} // namespace core
+} // namespace vsrtl
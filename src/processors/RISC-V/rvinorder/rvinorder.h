@@ -0,0 +1,205 @@
+#pragma once
+
+#include <deque>
+
+#include "../rvss/rvss.h"
+#include "rvinorder_issue.h"
+
+namespace vsrtl {
+namespace core {
+using namespace Ripes;
+
+/**
+ * @brief The RVINORDER class
+ * An N-wide in-order superscalar processor. The processor is modelled as a
+ * functional core - the single-cycle datapath, which executes instructions as
+ * they issue - directing a timing model of the issue stage (see InOrderIssue).
+ * Each cycle, up to WIDTH instructions are fetched, executed by the functional
+ * core and issued, in program order, until an instruction cannot issue.
+ *
+ * The resources of the processor are the defaults of its width (see
+ * InOrderConfig::forWidth); the latencies of its mul/div units are configured
+ * through the functional unit latencies of the processor.
+ */
+template <typename XLEN_T, unsigned WIDTH>
+class RVINORDER : public RVSS<XLEN_T> {
+  static_assert(WIDTH >= 1 && WIDTH <= InOrderConfig::s_maxWidth,
+                "Unsupported issue width");
+  using Base = RVSS<XLEN_T>;
+  static constexpr unsigned XLEN = sizeof(XLEN_T) * CHAR_BIT;
+
+public:
+  enum Stage { IS = 0, EX = 1, MEM = 2, WB = 3, STAGECOUNT };
+  RVINORDER(const QStringList &extensions) : Base(extensions) {
+    // The functional core is clocked once per issued instruction; the
+    // processor signals are emitted once per cycle of the issue model.
+    this->designWasClocked.Disconnect(&this->processorWasClocked,
+                                      &Gallant::Signal0<>::Emit);
+    this->designWasReversed.Disconnect(&this->processorWasReversed,
+                                       &Gallant::Signal0<>::Emit);
+
+    // Environment calls are handled as they issue (see issue()), not when the
+    // functional core propagates them.
+    this->ecallChecker->setSyscallCallback(&m_deferredTrap);
+
+    this->m_structure.clear();
+    for (unsigned lane = 0; lane < WIDTH; ++lane)
+      this->m_structure[lane] = STAGECOUNT;
+    m_issue.configure(InOrderConfig::forWidth(WIDTH), m_fuLatencies);
+  }
+
+  // Ripes interface compliance
+  unsigned int getPcForStage(StageIndex idx) const override {
+    return m_issue.slot(idx.index(), idx.lane()).pc;
+  }
+  AInt nextFetchedAddress() const override {
+    return this->pc_reg->out.uValue();
+  }
+  QString stageName(StageIndex idx) const override {
+    switch (idx.index()) {
+    case IS:
+      return "IS";
+    case EX:
+      return "EX";
+    case MEM:
+      return "MEM";
+    case WB:
+      return "WB";
+    default:
+      assert(false && "Processor does not contain stage");
+    }
+    Q_UNREACHABLE();
+  }
+  StageInfo stageInfo(StageIndex idx) const override {
+    const auto &slot = m_issue.slot(idx.index(), idx.lane());
+    return StageInfo({slot.pc, slot.valid, StageInfo::State::None});
+  }
+  const std::vector<StageIndex> breakpointTriggeringStages() const override {
+    std::vector<StageIndex> stages;
+    for (unsigned lane = 0; lane < WIDTH; ++lane)
+      stages.push_back({lane, IS});
+    return stages;
+  }
+  bool finished() const override {
+    return (this->m_finished ||
+            !this->isExecutableAddress(this->pc_reg->out.uValue())) &&
+           m_issue.empty();
+  }
+
+  MemoryAccess dataMemAccess() const override {
+    return m_issue.state().dataAccess;
+  }
+  MemoryAccess instrMemAccess() const override {
+    return m_issue.state().instrAccess;
+  }
+
+  long long getInstructionsRetired() const override {
+    return m_issue.state().retired;
+  }
+  long long getCycleCount() const override { return m_issue.cycle() + 1; }
+
+  const IssueStats *issueStats() const override {
+    return &m_issue.state().issueStats;
+  }
+  FULatencies *functionalUnitLatencies() override { return &m_fuLatencies; }
+
+  void setMaxReverseCycles(unsigned cycles) override {
+    m_maxReverseCycles = cycles;
+    // Each cycle clocks the functional core up to once per issue lane.
+    Base::setMaxReverseCycles(cycles * WIDTH);
+  }
+
+  void clockProcessor() override {
+    if (m_maxReverseCycles > 0) {
+      m_history.push_back({m_issue.state(), 0, this->m_finishInNextCycle,
+                           this->m_finished});
+      while (m_history.size() > m_maxReverseCycles)
+        m_history.pop_front();
+    }
+
+    m_issue.beginCycle();
+    unsigned steps = 0;
+    while (issue())
+      steps++;
+    m_issue.endCycle();
+
+    if (m_maxReverseCycles > 0)
+      m_history.back().steps = steps;
+    this->processorWasClocked.Emit();
+  }
+
+  void reverse() override {
+    if (m_history.empty())
+      return;
+    Snapshot &snapshot = m_history.back();
+    for (unsigned i = 0; i < snapshot.steps; ++i)
+      Base::reverse();
+    m_issue.setState(std::move(snapshot.issue));
+    this->m_finishInNextCycle = snapshot.finishInNextCycle;
+    this->m_finished = snapshot.finished;
+    m_history.pop_back();
+    this->processorWasReversed.Emit();
+  }
+
+  void reset() override {
+    Base::reset();
+    m_issue.configure(InOrderConfig::forWidth(WIDTH), m_fuLatencies);
+    m_fuLatencies = m_issue.latencies();
+    m_history.clear();
+  }
+
+private:
+  struct Snapshot {
+    InOrderIssue::State issue;
+    unsigned steps;
+    bool finishInNextCycle;
+    bool finished;
+  };
+
+  /// Fetches the next instruction and, if it may issue in this cycle,
+  /// executes it in the functional core. Returns false if no instruction could
+  /// be issued.
+  bool issue() {
+    if (m_issue.issueClosed())
+      return false;
+    const AInt pc = this->pc_reg->out.uValue();
+    if (this->m_finished || !this->isExecutableAddress(pc)) {
+      m_issue.stopIssue(IssueStats::Reason::Other);
+      return false;
+    }
+
+    const uint32_t word = this->instr_mem->data_out.uValue();
+    InOrderIssue::Instr instr;
+    instr.pc = pc;
+    instr.size = RVISA::instrSize(word);
+    instr.cls = RVISA::classifyInstr(word, XLEN);
+    instr.regs = RVISA::regOperands(word, XLEN);
+    // Division and remainder instructions have bit 2 of funct3 set.
+    instr.isDiv = instr.cls == InstrClass::MulDiv && ((word >> 14) & 0b1);
+    if (const auto reason = m_issue.canIssue(instr);
+        reason != IssueStats::Reason::None) {
+      m_issue.stopIssue(reason);
+      return false;
+    }
+    instr.mem = this->memToAccessInfo(this->data_mem);
+
+    // Environment calls issue alone, after all older instructions have been
+    // executed by the functional core.
+    if (instr.cls == InstrClass::Ecall)
+      this->trapHandler();
+    Base::clockProcessor();
+
+    instr.taken = this->pc_reg->out.uValue() != pc + instr.size;
+    m_issue.issue(instr);
+    return true;
+  }
+
+  FULatencies m_fuLatencies;
+  InOrderIssue m_issue;
+  std::function<void(void)> m_deferredTrap = [] {};
+  std::deque<Snapshot> m_history;
+  unsigned m_maxReverseCycles = 0;
+};
+
+} // namespace core
+} // namespace vsrtl
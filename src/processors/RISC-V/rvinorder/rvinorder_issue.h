@@ -0,0 +1,255 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "isa/rvinstrclass.h"
+#include "processors/interface/fulatencies.h"
+#include "processors/interface/inorderconfig.h"
+#include "processors/interface/issuestats.h"
+#include "processors/interface/ripesprocessor.h"
+
+namespace Ripes {
+
+/**
+ * @brief The InOrderIssue class
+ * Timing model of the issue stage of an N-wide in-order superscalar processor
+ * with a four-stage backend (IS, EX, MEM, WB). Each cycle, instructions issue
+ * in program order until one cannot:
+ *  - an instruction cannot issue before its source operands are available
+ *    (ALU results are forwarded to the next cycle, load results after
+ *    loadLatency cycles, mul/div results after the latency of their unit),
+ *  - a control-flow instruction ends its issue group, and issue resumes
+ *    redirectPenalty cycles after a taken control-flow instruction (branches
+ *    are predicted not taken),
+ *  - environment calls issue alone,
+ *  - each group is limited by the number of functional units (ALUs, memory
+ *    ports, mul/div units) and register file read/write ports.
+ *
+ * Issued instructions flow through the backend without stalling. Unused issue
+ * slots are attributed to the reason which ended their group.
+ */
+class InOrderIssue {
+public:
+  enum Stage { Issue, Execute, Memory, Writeback, NStages };
+
+  /// An instruction to be issued, as executed by the functional model.
+  struct Instr {
+    AInt pc = 0;
+    uint8_t size = 4;
+    InstrClass cls = InstrClass::Other;
+    RegOperands regs;
+    bool isDiv = false;
+    MemoryAccess mem;
+    /// Set if the next instruction is not at pc + size.
+    bool taken = false;
+  };
+
+  struct Slot {
+    AInt pc = 0;
+    bool valid = false;
+  };
+
+  /// The complete state of the model, such that it may be saved and restored
+  /// while reversing.
+  struct State {
+    uint64_t cycle = 0;
+    uint64_t retired = 0;
+    // Earliest issue cycle after the latest taken control-flow instruction.
+    uint64_t barrier = 0;
+    // Cycle at which the value of each register becomes available, and
+    // whether it is produced by a load.
+    std::array<uint64_t, 32> regReady{};
+    std::array<bool, 32> regFromLoad{};
+    // Cycle at which each mul/div unit may accept a new operation.
+    std::vector<uint64_t> mulDivFree;
+    IssueStats issueStats;
+
+    // State of the current cycle. Instructions advance one stage per cycle.
+    std::array<std::array<Slot, InOrderConfig::s_maxWidth>, NStages> stages{};
+    unsigned count = 0;
+    unsigned alus = 0;
+    unsigned memPorts = 0;
+    unsigned rfReads = 0;
+    unsigned rfWrites = 0;
+    // Set if the group was ended by the latest instruction added to it.
+    IssueStats::Reason closedBy = IssueStats::Reason::None;
+    IssueStats::Reason issueLimit = IssueStats::Reason::None;
+    MemoryAccess dataAccess;
+    MemoryAccess instrAccess;
+  };
+
+  void configure(const InOrderConfig &config, const FULatencies &latencies) {
+    m_config = config;
+    m_config.sanitize();
+    m_latencies = latencies;
+    m_latencies.sanitize();
+    reset();
+  }
+  const InOrderConfig &config() const { return m_config; }
+  const FULatencies &latencies() const { return m_latencies; }
+
+  void reset() {
+    m_state = State();
+    m_state.mulDivFree.assign(m_config.mulDivUnits, 0);
+    m_state.issueStats = IssueStats(m_config.width);
+  }
+
+  const State &state() const { return m_state; }
+  void setState(State &&state) { m_state = std::move(state); }
+
+  uint64_t cycle() const { return m_state.cycle; }
+  const Slot &slot(unsigned stage, unsigned lane) const {
+    return m_state.stages.at(stage).at(lane);
+  }
+  /// Returns true if no instruction is in flight.
+  bool empty() const {
+    for (const auto &stage : m_state.stages)
+      for (const auto &slot : stage)
+        if (slot.valid)
+          return false;
+    return true;
+  }
+
+  /// Starts a new cycle: instructions advance a stage, and those reaching WB
+  /// retire. Instructions may then be issued until endCycle() is called.
+  void beginCycle() {
+    State &s = m_state;
+    for (unsigned stage = NStages - 1; stage > Issue; --stage)
+      s.stages[stage] = s.stages[stage - 1];
+    s.stages[Issue].fill(Slot());
+    for (const auto &slot : s.stages[Writeback])
+      s.retired += slot.valid;
+
+    s.count = s.alus = s.memPorts = s.rfReads = s.rfWrites = 0;
+    s.closedBy = IssueStats::Reason::None;
+    s.issueLimit = IssueStats::Reason::None;
+    s.dataAccess = MemoryAccess();
+    s.instrAccess = MemoryAccess();
+  }
+
+  /// Returns true if no further instruction may issue in this cycle,
+  /// regardless of the instruction.
+  bool issueClosed() const {
+    return m_state.count == m_config.width ||
+           m_state.closedBy != IssueStats::Reason::None;
+  }
+
+  /// Returns the reason for which @p instr cannot issue in this cycle, or
+  /// IssueStats::Reason::None if it can.
+  IssueStats::Reason canIssue(const Instr &instr) const {
+    using Reason = IssueStats::Reason;
+    const State &s = m_state;
+    const RegOperands &regs = instr.regs;
+
+    uint64_t dataReady = 0;
+    bool fromLoad = false;
+    for (uint8_t reg : {regs.rs1, regs.rs2}) {
+      if (reg != 0 && s.regReady[reg] > dataReady) {
+        dataReady = s.regReady[reg];
+        fromLoad = s.regFromLoad[reg];
+      }
+    }
+    if (s.barrier > s.cycle && s.barrier >= dataReady)
+      return Reason::Redirect;
+    if (dataReady > s.cycle)
+      return fromLoad ? Reason::LoadUse : Reason::DataDependency;
+    if (instr.cls == InstrClass::Ecall && s.count > 0)
+      return Reason::Serialization;
+    if (isALU(instr.cls) && s.alus == m_config.alus)
+      return Reason::ALU;
+    if (isMem(instr.cls) && s.memPorts == m_config.memPorts)
+      return Reason::MemPort;
+    if (instr.cls == InstrClass::MulDiv && freeMulDiv() == ~0u)
+      return Reason::MulDiv;
+    if (s.rfReads + reads(regs) > m_config.rfReadPorts)
+      return Reason::RFReadPorts;
+    if (s.rfWrites + (regs.rd != 0) > m_config.rfWritePorts)
+      return Reason::RFWritePorts;
+    return Reason::None;
+  }
+
+  void issue(const Instr &instr) {
+    State &s = m_state;
+    const RegOperands &regs = instr.regs;
+    unsigned latency = 1;
+    if (isALU(instr.cls))
+      s.alus++;
+    if (isMem(instr.cls)) {
+      s.memPorts++;
+      if (s.dataAccess.type == MemoryAccess::None)
+        s.dataAccess = instr.mem;
+      if (instr.cls == InstrClass::Load)
+        latency = m_config.loadLatency;
+    }
+    if (instr.cls == InstrClass::MulDiv) {
+      const FULatencies::Unit &unit =
+          instr.isDiv ? m_latencies.div : m_latencies.mul;
+      s.mulDivFree[freeMulDiv()] =
+          s.cycle + (unit.pipelined ? 1 : unit.latency);
+      latency = unit.latency;
+    }
+    s.rfReads += reads(regs);
+    s.rfWrites += regs.rd != 0;
+    if (regs.rd != 0) {
+      s.regReady[regs.rd] = s.cycle + latency;
+      s.regFromLoad[regs.rd] = instr.cls == InstrClass::Load;
+    }
+
+    if (instr.cls == InstrClass::Branch || instr.cls == InstrClass::Jump)
+      s.closedBy = IssueStats::Reason::ControlFlow;
+    else if (instr.cls == InstrClass::Ecall)
+      s.closedBy = IssueStats::Reason::Serialization;
+    if (instr.taken)
+      s.barrier = s.cycle + 1 + m_config.redirectPenalty;
+
+    if (s.count == 0)
+      s.instrAccess = {MemoryAccess::Read, instr.pc, instr.size};
+    s.stages[Issue][s.count++] = {instr.pc, true};
+  }
+
+  /// Records that issue stopped in this cycle for the reason @p reason.
+  void stopIssue(IssueStats::Reason reason) {
+    if (m_state.issueLimit == IssueStats::Reason::None)
+      m_state.issueLimit = reason;
+  }
+
+  void endCycle() {
+    State &s = m_state;
+    IssueStats::Reason reason = s.closedBy != IssueStats::Reason::None
+                                    ? s.closedBy
+                                    : s.issueLimit;
+    if (s.count < m_config.width && reason == IssueStats::Reason::None)
+      reason = IssueStats::Reason::Other;
+    s.issueStats.account(s.count, reason);
+    s.cycle++;
+  }
+
+private:
+  static bool isMem(InstrClass cls) {
+    return cls == InstrClass::Load || cls == InstrClass::Store;
+  }
+  static bool isALU(InstrClass cls) {
+    return !isMem(cls) && cls != InstrClass::MulDiv;
+  }
+  static unsigned reads(const RegOperands &regs) {
+    return (regs.rs1 != 0) + (regs.rs2 != 0);
+  }
+
+  /// Returns the index of a mul/div unit accepting operations in this cycle,
+  /// or ~0u if none does.
+  unsigned freeMulDiv() const {
+    const auto &units = m_state.mulDivFree;
+    const auto it = std::find_if(units.begin(), units.end(), [&](uint64_t at) {
+      return at <= m_state.cycle;
+    });
+    return it == units.end() ? ~0u : static_cast<unsigned>(it - units.begin());
+  }
+
+  InOrderConfig m_config;
+  FULatencies m_latencies;
+  State m_state;
+};
+
+} // namespace Ripes
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <deque>
+
+#include "../rvss/rvss.h"
+#include "rvooo_window.h"
+
+namespace vsrtl {
+namespace core {
+using namespace Ripes;
+
+/**
+ * @brief The RVOOO class
+ * An out-of-order superscalar processor. The processor is modelled as a
+ * functional core - the single-cycle datapath, which executes instructions as
+ * they are dispatched - directing a timing model of the instruction window
+ * (see OoOWindow). Each cycle, the window commits and issues instructions,
+ * after which up to 'width' instructions are fetched, executed by the
+ * functional core and dispatched into the window.
+ *
+ * The architectural register file is updated as instructions commit, whereas
+ * memory is updated by the functional core at dispatch. Environment calls are
+ * dispatched into an empty window, and thus observe the architectural state.
+ */
+template <typename XLEN_T>
+class RVOOO : public RVSS<XLEN_T> {
+  using Base = RVSS<XLEN_T>;
+  static constexpr unsigned XLEN = sizeof(XLEN_T) * CHAR_BIT;
+
+public:
+  enum Stage { DP = 0, IS = 1, WB = 2, CM = 3, STAGECOUNT };
+  RVOOO(const QStringList &extensions) : Base(extensions) {
+    // The functional core is clocked once per dispatched instruction; the
+    // processor signals are emitted once per cycle of the window.
+    this->designWasClocked.Disconnect(&this->processorWasClocked,
+                                      &Gallant::Signal0<>::Emit);
+    this->designWasReversed.Disconnect(&this->processorWasReversed,
+                                       &Gallant::Signal0<>::Emit);
+
+    // Environment calls are handled as they are dispatched (see dispatch()),
+    // not when the functional core propagates them.
+    this->ecallChecker->setSyscallCallback(&m_deferredTrap);
+
+    this->m_structure.clear();
+    for (unsigned lane = 0; lane < OoOConfig::s_maxWidth; ++lane)
+      this->m_structure[lane] = STAGECOUNT;
+    m_window.configure(m_config, m_fuLatencies);
+  }
+
+  // Ripes interface compliance
+  unsigned int getPcForStage(StageIndex idx) const override {
+    return m_window.slot(idx.index(), idx.lane()).pc;
+  }
+  AInt nextFetchedAddress() const override {
+    return this->pc_reg->out.uValue();
+  }
+  QString stageName(StageIndex idx) const override {
+    switch (idx.index()) {
+    case DP:
+      return "DP";
+    case IS:
+      return "IS";
+    case WB:
+      return "WB";
+    case CM:
+      return "CM";
+    default:
+      assert(false && "Processor does not contain stage");
+    }
+    Q_UNREACHABLE();
+  }
+  StageInfo stageInfo(StageIndex idx) const override {
+    if (idx.lane() >= m_window.config().width)
+      return StageInfo({0, false, StageInfo::State::Unused});
+    const auto &slot = m_window.slot(idx.index(), idx.lane());
+    return StageInfo({slot.pc, slot.valid, StageInfo::State::None});
+  }
+  const std::vector<StageIndex> breakpointTriggeringStages() const override {
+    std::vector<StageIndex> stages;
+    for (unsigned lane = 0; lane < m_window.config().width; ++lane)
+      stages.push_back({lane, DP});
+    return stages;
+  }
+  bool finished() const override {
+    return (this->m_finished ||
+            !this->isExecutableAddress(this->pc_reg->out.uValue())) &&
+           m_window.empty();
+  }
+
+  MemoryAccess dataMemAccess() const override {
+    return m_window.state().dataAccess;
+  }
+  MemoryAccess instrMemAccess() const override {
+    return m_window.state().instrAccess;
+  }
+
+  VInt getRegister(const std::string_view &, unsigned i) const override {
+    return m_window.reg(i);
+  }
+  void setRegister(const std::string_view &rfid, unsigned i,
+                   VInt v) override {
+    Base::setRegister(rfid, i, v);
+    m_window.setReg(i, v);
+  }
+
+  long long getInstructionsRetired() const override {
+    return m_window.state().retired;
+  }
+  long long getCycleCount() const override { return m_window.cycle() + 1; }
+
+  BranchPredictor *branchPredictor() const override { return &m_bp; }
+  const IssueStats *issueStats() const override {
+    return &m_window.state().dispatchStats;
+  }
+  OoOConfig *outOfOrderConfig() override { return &m_config; }
+  FULatencies *functionalUnitLatencies() override { return &m_fuLatencies; }
+
+  void setMaxReverseCycles(unsigned cycles) override {
+    m_maxReverseCycles = cycles;
+    // Each cycle clocks the functional core up to once per dispatch lane.
+    Base::setMaxReverseCycles(cycles * OoOConfig::s_maxWidth);
+  }
+
+  void clockProcessor() override {
+    if (m_maxReverseCycles > 0) {
+      m_history.push_back({m_window.state(), 0, this->m_finishInNextCycle,
+                           this->m_finished});
+      while (m_history.size() > m_maxReverseCycles)
+        m_history.pop_front();
+    }
+
+    m_window.beginCycle();
+    resolveControlFlow();
+    unsigned steps = 0;
+    while (dispatch())
+      steps++;
+    m_window.endCycle();
+
+    if (m_maxReverseCycles > 0)
+      m_history.back().steps = steps;
+    this->processorWasClocked.Emit();
+  }
+
+  void reverse() override {
+    if (m_history.empty())
+      return;
+    Snapshot &snapshot = m_history.back();
+    for (unsigned i = 0; i < snapshot.steps; ++i)
+      Base::reverse();
+    m_window.setState(std::move(snapshot.window));
+    m_bp.reverse(m_window.cycle());
+    this->m_finishInNextCycle = snapshot.finishInNextCycle;
+    this->m_finished = snapshot.finished;
+    m_history.pop_back();
+    this->processorWasReversed.Emit();
+  }
+
+  void reset() override {
+    Base::reset();
+    m_window.configure(m_config, m_fuLatencies);
+    m_config = m_window.config();
+    m_fuLatencies = m_window.latencies();
+    m_bp.reset();
+    for (unsigned i = 0; i < 32; ++i)
+      m_window.setReg(i, this->registerFile->getRegister(i));
+    m_history.clear();
+  }
+
+private:
+  struct Snapshot {
+    OoOWindow::State window;
+    unsigned steps;
+    bool finishInNextCycle;
+    bool finished;
+  };
+
+  /// Updates the branch predictor with the control-flow instructions resolved
+  /// in this cycle.
+  void resolveControlFlow() {
+    for (const auto &r : m_window.resolved()) {
+      m_bp.update(m_window.cycle(), r.pc, r.control.returnAddress,
+                  r.control.kind, r.control.taken, r.control.target,
+                  r.mispredicted, m_window.config().redirectPenalty + 1);
+    }
+  }
+
+  /// Fetches the next instruction, executes it in the functional core and
+  /// dispatches it into the window. Returns false if no instruction could be
+  /// dispatched.
+  bool dispatch() {
+    if (m_window.dispatchFull())
+      return false;
+    const AInt pc = this->pc_reg->out.uValue();
+    if (this->m_finished || !this->isExecutableAddress(pc)) {
+      m_window.stopDispatch(IssueStats::Reason::Other);
+      return false;
+    }
+
+    const uint32_t word = this->instr_mem->data_out.uValue();
+    OoOWindow::Instr instr;
+    instr.pc = pc;
+    instr.size = RVISA::instrSize(word);
+    instr.cls = RVISA::classifyInstr(word, XLEN);
+    if (const auto reason = m_window.canDispatch(instr.cls);
+        reason != IssueStats::Reason::None) {
+      m_window.stopDispatch(reason);
+      return false;
+    }
+    instr.regs = RVISA::regOperands(word, XLEN);
+    // Division and remainder instructions have bit 2 of funct3 set.
+    instr.isDiv = instr.cls == InstrClass::MulDiv && ((word >> 14) & 0b1);
+    instr.mem = this->memToAccessInfo(this->data_mem);
+    instr.control.kind = controlKind(instr);
+    instr.control.returnAddress = pc + instr.size;
+    const auto prediction = m_bp.predict(pc);
+
+    // The window is empty when an environment call dispatches, so the
+    // environment observes the architectural state.
+    if (instr.cls == InstrClass::Ecall)
+      this->trapHandler();
+    Base::clockProcessor();
+
+    const AInt nextPC = this->pc_reg->out.uValue();
+    if (instr.regs.rd != 0)
+      instr.result = this->registerFile->getRegister(instr.regs.rd);
+    instr.control.taken = nextPC != pc + instr.size;
+    instr.control.target = nextPC;
+    const AInt predictedPC =
+        prediction.taken ? prediction.target : pc + instr.size;
+    instr.mispredicted = predictedPC != nextPC;
+    m_window.dispatch(instr);
+    return true;
+  }
+
+  static BranchPredictor::Kind controlKind(const OoOWindow::Instr &instr) {
+    if (instr.cls == InstrClass::Branch)
+      return BranchPredictor::Kind::Branch;
+    if (instr.cls != InstrClass::Jump)
+      return BranchPredictor::Kind::None;
+    // Calls and returns are identified through the register usage hints of the
+    // RISC-V calling convention.
+    const auto isLinkReg = [](unsigned idx) { return idx == 1 || idx == 5; };
+    if (isLinkReg(instr.regs.rd))
+      return BranchPredictor::Kind::Call;
+    if (instr.regs.rd == 0 && isLinkReg(instr.regs.rs1))
+      return BranchPredictor::Kind::Return;
+    return BranchPredictor::Kind::Jump;
+  }
+
+  OoOConfig m_config;
+  FULatencies m_fuLatencies;
+  OoOWindow m_window;
+  mutable BranchPredictor m_bp;
+  std::function<void(void)> m_deferredTrap = [] {};
+  std::deque<Snapshot> m_history;
+  unsigned m_maxReverseCycles = 0;
+};
+
+} // namespace core
+} // namespace vsrtl
@@ -0,0 +1,387 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <vector>
+
+#include "isa/rvinstrclass.h"
+#include "processors/interface/branchpredictor.h"
+#include "processors/interface/fulatencies.h"
+#include "processors/interface/issuestats.h"
+#include "processors/interface/oooconfig.h"
+#include "processors/interface/ripesprocessor.h"
+
+namespace Ripes {
+
+/**
+ * @brief The OoOWindow class
+ * Timing model of the instruction window of an out-of-order processor, in the
+ * style of Tomasulo's algorithm extended with a reorder buffer:
+ *  - Dispatch: instructions enter the reorder buffer (ROB) in program order,
+ *    and occupy a reservation station (RS) or, for loads and stores, a
+ *    load/store queue (LSQ) entry. Source registers are renamed to the ROB
+ *    entries of their in-flight producers.
+ *  - Issue: any dispatched instruction whose operands are available issues to
+ *    a free functional unit, oldest first. Its reservation station is freed.
+ *  - Writeback: results are broadcast once the functional unit latency has
+ *    elapsed, waking up dependent instructions.
+ *  - Commit: completed instructions leave the ROB in program order, updating
+ *    the architectural register file. Stores write memory at commit.
+ *
+ * Instructions are executed by a functional model as they are dispatched; the
+ * window thus knows the result, memory address and control-flow outcome of
+ * every instruction it holds. This gives perfect memory disambiguation: a load
+ * waits only for older stores to overlapping addresses, whose data is then
+ * forwarded. A mispredicted control-flow instruction blocks dispatch until it
+ * has been resolved and the front-end has been refilled; wrong-path
+ * instructions are not modelled. Environment calls are serialized.
+ */
+class OoOWindow {
+public:
+  enum Stage { Dispatch, Issue, Writeback, Commit, NStages };
+  static constexpr uint64_t s_noProducer = ULLONG_MAX;
+
+  /// Resolved outcome of a control-flow instruction.
+  struct ControlInfo {
+    BranchPredictor::Kind kind = BranchPredictor::Kind::None;
+    bool taken = false;
+    AInt target = 0;
+    AInt returnAddress = 0;
+  };
+
+  /// An instruction entering the window, as executed by the functional model.
+  struct Instr {
+    AInt pc = 0;
+    uint8_t size = 4;
+    InstrClass cls = InstrClass::Other;
+    RegOperands regs;
+    bool isDiv = false;
+    /// Value written to regs.rd.
+    VInt result = 0;
+    MemoryAccess mem;
+    ControlInfo control;
+    bool mispredicted = false;
+  };
+
+  struct Entry {
+    Instr instr;
+    uint64_t seq = 0;
+    std::array<uint64_t, 2> producers{};
+    bool issued = false;
+    uint64_t doneCycle = 0;
+  };
+
+  struct Resolved {
+    AInt pc;
+    ControlInfo control;
+    bool mispredicted;
+  };
+
+  struct Slot {
+    AInt pc = 0;
+    bool valid = false;
+  };
+
+  /// The complete state of the window, such that it may be saved and restored
+  /// while reversing.
+  struct State {
+    // Circular reorder buffer.
+    std::vector<Entry> rob;
+    unsigned head = 0;
+    unsigned count = 0;
+    // Sequence number of the entry at the head of the ROB.
+    uint64_t headSeq = 0;
+    // Sequence number of the in-flight producer of each register.
+    std::array<uint64_t, 32> rename{};
+    std::array<VInt, 32> archRegs{};
+    unsigned rsUsed = 0;
+    unsigned lsqUsed = 0;
+    // Cycle at which each mul/div unit may accept a new operation.
+    std::vector<uint64_t> mulDivFree;
+
+    uint64_t cycle = 0;
+    uint64_t retired = 0;
+    // Earliest cycle at which the front-end may resume dispatching, after a
+    // misprediction.
+    uint64_t frontendResume = 0;
+    bool awaitingRedirect = false;
+    bool serializing = false;
+    IssueStats dispatchStats;
+
+    // State of the current cycle.
+    std::array<std::array<Slot, OoOConfig::s_maxWidth>, NStages> stages{};
+    unsigned dispatched = 0;
+    bool fetchGroupEnded = false;
+    IssueStats::Reason dispatchLimit = IssueStats::Reason::None;
+    unsigned alusUsed = 0;
+    unsigned memPortsUsed = 0;
+    MemoryAccess dataAccess;
+    MemoryAccess instrAccess;
+    std::vector<Resolved> resolved;
+  };
+
+  void configure(const OoOConfig &config, const FULatencies &latencies) {
+    m_config = config;
+    m_config.sanitize();
+    m_latencies = latencies;
+    m_latencies.sanitize();
+    reset();
+  }
+  const OoOConfig &config() const { return m_config; }
+  const FULatencies &latencies() const { return m_latencies; }
+
+  void reset() {
+    m_state = State();
+    m_state.rob.resize(m_config.robEntries);
+    m_state.rename.fill(s_noProducer);
+    m_state.mulDivFree.assign(m_config.mulDivUnits, 0);
+    m_state.dispatchStats = IssueStats(m_config.width);
+  }
+
+  const State &state() const { return m_state; }
+  void setState(State &&state) { m_state = std::move(state); }
+
+  uint64_t cycle() const { return m_state.cycle; }
+  bool empty() const { return m_state.count == 0; }
+  const Slot &slot(unsigned stage, unsigned lane) const {
+    return m_state.stages.at(stage).at(lane);
+  }
+  /// Control-flow instructions resolved in the current cycle.
+  const std::vector<Resolved> &resolved() const { return m_state.resolved; }
+
+  VInt reg(unsigned i) const { return m_state.archRegs.at(i); }
+  void setReg(unsigned i, VInt value) { m_state.archRegs.at(i) = value; }
+
+  /// Starts a new cycle: commits and issues instructions. Instructions may
+  /// then be dispatched until endCycle() is called.
+  void beginCycle() {
+    State &s = m_state;
+    for (auto &stage : s.stages)
+      stage.fill(Slot());
+    s.dispatched = 0;
+    s.fetchGroupEnded = false;
+    s.dispatchLimit = IssueStats::Reason::None;
+    s.alusUsed = s.memPortsUsed = 0;
+    s.dataAccess = MemoryAccess();
+    s.instrAccess = MemoryAccess();
+    s.resolved.clear();
+
+    commit();
+    writeback();
+    issue();
+  }
+
+  /// Returns true if 'width' instructions have been dispatched in this cycle.
+  bool dispatchFull() const { return m_state.dispatched == m_config.width; }
+
+  /// Returns the reason for which an instruction of class @p cls cannot be
+  /// dispatched in this cycle, or IssueStats::Reason::None if it can.
+  IssueStats::Reason canDispatch(InstrClass cls) const {
+    using Reason = IssueStats::Reason;
+    const State &s = m_state;
+    if (s.awaitingRedirect || s.cycle < s.frontendResume)
+      return Reason::Redirect;
+    if (s.fetchGroupEnded)
+      return Reason::ControlFlow;
+    if (s.serializing || (cls == InstrClass::Ecall && s.count > 0))
+      return Reason::Serialization;
+    if (s.count == s.rob.size())
+      return Reason::ROB;
+    if (isMem(cls) && s.lsqUsed == m_config.lsqEntries)
+      return Reason::LSQ;
+    if (!isMem(cls) && s.rsUsed == m_config.rsEntries)
+      return Reason::RS;
+    return Reason::None;
+  }
+
+  void dispatch(const Instr &instr) {
+    State &s = m_state;
+    Entry &e = s.rob[(s.head + s.count) % s.rob.size()];
+    e = Entry();
+    e.instr = instr;
+    e.seq = s.headSeq + s.count;
+    const std::array<uint8_t, 2> sources = {instr.regs.rs1, instr.regs.rs2};
+    for (unsigned i = 0; i < sources.size(); ++i)
+      e.producers[i] = sources[i] != 0 ? s.rename[sources[i]] : s_noProducer;
+    if (instr.regs.rd != 0)
+      s.rename[instr.regs.rd] = e.seq;
+
+    s.count++;
+    if (isMem(instr.cls))
+      s.lsqUsed++;
+    else
+      s.rsUsed++;
+    if (instr.cls == InstrClass::Ecall)
+      s.serializing = true;
+    if (instr.mispredicted)
+      s.awaitingRedirect = true;
+    else if (instr.control.taken)
+      // Fetch does not continue past a taken control-flow instruction within
+      // a cycle.
+      s.fetchGroupEnded = true;
+
+    if (s.dispatched == 0)
+      s.instrAccess = {MemoryAccess::Read, instr.pc, instr.size};
+    s.stages[Dispatch][s.dispatched++] = {instr.pc, true};
+  }
+
+  /// Records that dispatch stopped in this cycle for the reason @p reason.
+  void stopDispatch(IssueStats::Reason reason) {
+    if (m_state.dispatchLimit == IssueStats::Reason::None)
+      m_state.dispatchLimit = reason;
+  }
+
+  void endCycle() {
+    State &s = m_state;
+    IssueStats::Reason reason = s.dispatchLimit;
+    if (s.dispatched < m_config.width && reason == IssueStats::Reason::None)
+      reason = IssueStats::Reason::Other;
+    s.dispatchStats.account(s.dispatched, reason);
+    s.cycle++;
+  }
+
+private:
+  static bool isMem(InstrClass cls) {
+    return cls == InstrClass::Load || cls == InstrClass::Store;
+  }
+  static bool overlaps(const MemoryAccess &a, const MemoryAccess &b) {
+    return a.address < b.address + b.bytes && b.address < a.address + a.bytes;
+  }
+
+  Entry &at(unsigned i) {
+    return m_state.rob[(m_state.head + i) % m_state.rob.size()];
+  }
+
+  /// Returns the cycle at which the result of ROB entry @p seq is available.
+  uint64_t availableAt(uint64_t seq) const {
+    if (seq == s_noProducer || seq < m_state.headSeq)
+      return 0; // Committed
+    const Entry &e = m_state.rob[(m_state.head + (seq - m_state.headSeq)) %
+                                 m_state.rob.size()];
+    return e.issued ? e.doneCycle : ULLONG_MAX;
+  }
+
+  void commit() {
+    State &s = m_state;
+    unsigned committed = 0;
+    while (s.count > 0 && committed < m_config.width) {
+      Entry &e = s.rob[s.head];
+      if (!e.issued || e.doneCycle > s.cycle)
+        break;
+      if (e.instr.cls == InstrClass::Store) {
+        if (s.memPortsUsed == m_config.memPorts)
+          break;
+        s.memPortsUsed++;
+        if (s.dataAccess.type == MemoryAccess::None)
+          s.dataAccess = e.instr.mem;
+      }
+
+      const uint8_t rd = e.instr.regs.rd;
+      if (rd != 0) {
+        s.archRegs[rd] = e.instr.result;
+        if (s.rename[rd] == e.seq)
+          s.rename[rd] = s_noProducer;
+      }
+      if (isMem(e.instr.cls))
+        s.lsqUsed--;
+      if (e.instr.cls == InstrClass::Ecall)
+        s.serializing = false;
+      s.stages[Commit][committed++] = {e.instr.pc, true};
+
+      s.head = (s.head + 1) % s.rob.size();
+      s.count--;
+      s.headSeq++;
+      s.retired++;
+    }
+  }
+
+  void writeback() {
+    State &s = m_state;
+    unsigned lane = 0;
+    for (unsigned i = 0; i < s.count && lane < m_config.width; ++i) {
+      const Entry &e = at(i);
+      if (e.issued && e.doneCycle == s.cycle)
+        s.stages[Writeback][lane++] = {e.instr.pc, true};
+    }
+  }
+
+  void issue() {
+    State &s = m_state;
+    unsigned issued = 0;
+    for (unsigned i = 0; i < s.count && issued < m_config.width; ++i) {
+      Entry &e = at(i);
+      if (e.issued || availableAt(e.producers[0]) > s.cycle ||
+          availableAt(e.producers[1]) > s.cycle)
+        continue;
+
+      unsigned latency = 1;
+      switch (e.instr.cls) {
+      case InstrClass::Load: {
+        // The youngest older store to an overlapping address forwards its
+        // data once it has executed; otherwise, memory is accessed.
+        const Entry *store = nullptr;
+        for (unsigned j = 0; j < i; ++j) {
+          const Entry &older = at(j);
+          if (older.instr.cls == InstrClass::Store &&
+              overlaps(older.instr.mem, e.instr.mem))
+            store = &older;
+        }
+        if (store) {
+          if (!store->issued || store->doneCycle > s.cycle)
+            continue;
+        } else {
+          if (s.memPortsUsed == m_config.memPorts)
+            continue;
+          s.memPortsUsed++;
+          latency = m_config.loadLatency;
+          if (s.dataAccess.type == MemoryAccess::None)
+            s.dataAccess = e.instr.mem;
+        }
+        break;
+      }
+      case InstrClass::Store:
+        // Address and data are computed; memory is written at commit.
+        break;
+      case InstrClass::MulDiv: {
+        const FULatencies::Unit &unit =
+            e.instr.isDiv ? m_latencies.div : m_latencies.mul;
+        auto freeUnit =
+            std::find_if(s.mulDivFree.begin(), s.mulDivFree.end(),
+                         [&](uint64_t freeAt) { return freeAt <= s.cycle; });
+        if (freeUnit == s.mulDivFree.end())
+          continue;
+        *freeUnit = s.cycle + (unit.pipelined ? 1 : unit.latency);
+        latency = unit.latency;
+        break;
+      }
+      default:
+        if (s.alusUsed == m_config.aluUnits)
+          continue;
+        s.alusUsed++;
+        break;
+      }
+
+      e.issued = true;
+      e.doneCycle = s.cycle + latency;
+      if (!isMem(e.instr.cls))
+        s.rsUsed--;
+      s.stages[Issue][issued++] = {e.instr.pc, true};
+
+      if (e.instr.mispredicted) {
+        s.awaitingRedirect = false;
+        s.frontendResume = e.doneCycle + m_config.redirectPenalty;
+      }
+      if (e.instr.control.kind != BranchPredictor::Kind::None ||
+          e.instr.mispredicted)
+        s.resolved.push_back({e.instr.pc, e.instr.control,
+                              e.instr.mispredicted});
+    }
+  }
+
+  OoOConfig m_config;
+  FULatencies m_latencies;
+  State m_state;
+};
+
+} // namespace Ripes
@@ -123,6 +123,7 @@ public:
     // Ecall checker
     decode->opcode >> ecallChecker->opcode;
     ecallChecker->setSyscallCallback(&trapHandler);
+    alu->setCSRReadCallback(&csrReadHandler);
     0 >> ecallChecker->stallEcallHandling;
   }
 
@@ -154,7 +155,7 @@ public:
   SUBCOMPONENT(controlflow_or, TYPE(Or<1, 2>));
 
   // Address spaces
-  ADDRESSSPACEMM(m_memory);
+  PAGEDADDRESSSPACE(m_memory);
   ADDRESSSPACE(m_regMem);
 
   SUBCOMPONENT(ecallChecker, EcallChecker);
@@ -178,7 +179,7 @@ public:
   void setPCInitialValue(AInt address) override {
     pc_reg->setInitValue(address);
   }
-  AddressSpaceMM &getMemory() override { return *m_memory; }
+  PagedAddressSpace &getMemory() override { return *m_memory; }
   VInt getRegister(const std::string_view &, unsigned i) const override {
     return registerFile->getRegister(i);
   }
@@ -255,7 +256,7 @@ public:
     return rfs;
   }
 
-private:
+protected:
   bool m_finishInNextCycle = false;
   bool m_finished = false;
   std::shared_ptr<ISAInfoBase> m_enabledISA;
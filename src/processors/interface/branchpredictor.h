@@ -0,0 +1,361 @@
+#pragma once
+
+#include <QString>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "VSRTL/core/vsrtl_register.h"
+
+#include "../isa/isa_types.h"
+
+namespace Ripes {
+
+/// Configuration of a dynamic branch predictor. Table sizes are rounded down
+/// to the nearest power of two.
+struct BranchPredictorConfig {
+  enum class Type { Bimodal, GShare, Tournament };
+  Type type = Type::Bimodal;
+  /// Number of 2-bit counters in each pattern history table.
+  unsigned phtEntries = 256;
+  /// Length of the global branch history (gshare and tournament).
+  unsigned historyBits = 8;
+  /// Number of entries in the (direct-mapped) branch target buffer.
+  unsigned btbEntries = 64;
+  /// Depth of the return address stack. 0 disables the return address stack.
+  unsigned rasEntries = 8;
+};
+
+const static std::map<BranchPredictorConfig::Type, QString>
+    BranchPredictorTypeNames = {
+        {BranchPredictorConfig::Type::Bimodal, "bimodal"},
+        {BranchPredictorConfig::Type::GShare, "gshare"},
+        {BranchPredictorConfig::Type::Tournament, "tournament"}};
+
+/**
+ * @brief The BranchPredictor class
+ * A model of a dynamic branch predictor, consisting of a direction predictor
+ * (bimodal, gshare or tournament), a branch target buffer and a return address
+ * stack.
+ *
+ * The predictor is looked up in the fetch stage through predict(), and updated
+ * with the outcome of each control-flow instruction once it has been resolved
+ * through update(). The predictor is not a part of the VSRTL design; updates
+ * are recorded in an undo log, such that the owning processor may reverse the
+ * predictor in lockstep with the design.
+ */
+class BranchPredictor {
+public:
+  enum class Kind : uint8_t { None, Branch, Jump, Call, Return };
+
+  struct Prediction {
+    bool taken = false;
+    AInt target = 0;
+  };
+
+  struct Stats {
+    uint64_t branches = 0;
+    uint64_t branchMispredictions = 0;
+    uint64_t jumps = 0;
+    uint64_t jumpMispredictions = 0;
+    uint64_t returns = 0;
+    uint64_t returnMispredictions = 0;
+    uint64_t btbLookups = 0;
+    uint64_t btbHits = 0;
+    // Mispredictions of instructions which are not control-flow instructions
+    // (ie. stale branch target buffer entries).
+    uint64_t otherMispredictions = 0;
+    uint64_t penaltyCycles = 0;
+
+    uint64_t controlFlow() const { return branches + jumps + returns; }
+    uint64_t mispredictions() const {
+      return branchMispredictions + jumpMispredictions +
+             returnMispredictions + otherMispredictions;
+    }
+  };
+
+  BranchPredictor(const BranchPredictorConfig &config = {}) {
+    configure(config);
+  }
+
+  /// Reconfigures the predictor. All predictor state is cleared.
+  void configure(const BranchPredictorConfig &config) {
+    m_config = config;
+    m_config.phtEntries = floorPow2(config.phtEntries);
+    m_config.btbEntries = floorPow2(config.btbEntries);
+    m_config.historyBits = std::min(config.historyBits, 32u);
+    reset();
+  }
+  const BranchPredictorConfig &config() const { return m_config; }
+  const Stats &stats() const { return m_stats; }
+
+  void reset() {
+    // Counters are initialized to weakly not-taken; the chooser to weakly
+    // prefer the bimodal predictor.
+    m_bimodal.assign(m_config.phtEntries, 1);
+    m_gshare.assign(m_config.phtEntries, 1);
+    m_chooser.assign(m_config.phtEntries, 1);
+    m_btb.assign(m_config.btbEntries, BTBEntry());
+    m_ras.assign(m_config.rasEntries, 0);
+    m_rasTop = 0;
+    m_rasCount = 0;
+    m_history = 0;
+    m_stats = Stats();
+    m_undo.clear();
+  }
+
+  /**
+   * @brief predict
+   * Returns the predicted direction and target of the instruction at @p pc.
+   * An instruction is only predicted taken if its target is known; ie. it hits
+   * in the branch target buffer.
+   */
+  Prediction predict(AInt pc) const {
+    Prediction p;
+    const BTBEntry &entry = m_btb[btbIndex(pc)];
+    if (!entry.valid || entry.tag != pc)
+      return p;
+
+    switch (entry.kind) {
+    case Kind::Branch:
+      p.taken = predictDirection(pc);
+      p.target = entry.target;
+      break;
+    case Kind::Return:
+      p.taken = true;
+      p.target = m_rasCount > 0 ? m_ras[rasPrev(m_rasTop)] : entry.target;
+      break;
+    case Kind::Jump:
+    case Kind::Call:
+      p.taken = true;
+      p.target = entry.target;
+      break;
+    case Kind::None:
+      break;
+    }
+    return p;
+  }
+
+  /**
+   * @brief update
+   * Updates the predictor with the resolved outcome of the instruction at
+   * @p pc, which was resolved during @p cycle. @p mispredicted indicates
+   * whether the fetch stage fetched down the wrong path, costing
+   * @p penaltyCycles cycles.
+   */
+  void update(long long cycle, AInt pc, AInt returnAddress, Kind kind,
+              bool taken, AInt target, bool mispredicted,
+              unsigned penaltyCycles) {
+    UndoRecord &undo = pushUndo(cycle, pc);
+    const BTBEntry &entry = m_btb[btbIndex(pc)];
+    const bool btbHit = entry.valid && entry.tag == pc;
+
+    switch (kind) {
+    case Kind::None:
+      m_stats.otherMispredictions += mispredicted;
+      // Evict the stale entry which caused the misprediction.
+      if (btbHit)
+        setBTB(undo, pc, BTBEntry());
+      break;
+    case Kind::Branch:
+      m_stats.branches++;
+      m_stats.branchMispredictions += mispredicted;
+      updateDirection(undo, pc, taken);
+      if (taken)
+        setBTB(undo, pc, {true, kind, pc, target});
+      break;
+    case Kind::Jump:
+    case Kind::Call:
+    case Kind::Return:
+      if (kind == Kind::Return) {
+        m_stats.returns++;
+        m_stats.returnMispredictions += mispredicted;
+      } else {
+        m_stats.jumps++;
+        m_stats.jumpMispredictions += mispredicted;
+      }
+      setBTB(undo, pc, {true, kind, pc, target});
+      if (kind == Kind::Call)
+        pushRAS(undo, returnAddress);
+      else if (kind == Kind::Return)
+        popRAS();
+      break;
+    }
+
+    if (kind != Kind::None) {
+      m_stats.btbLookups++;
+      m_stats.btbHits += btbHit;
+    }
+    if (mispredicted)
+      m_stats.penaltyCycles += penaltyCycles;
+  }
+
+  /// Undoes all updates performed during or after @p cycle.
+  void reverse(long long cycle) {
+    while (!m_undo.empty() && m_undo.back().cycle >= cycle) {
+      const UndoRecord &undo = m_undo.back();
+      for (unsigned i = 0; i < undo.nCounters; ++i)
+        *undo.counters[i].first = undo.counters[i].second;
+      if (undo.btbModified)
+        m_btb[btbIndex(undo.pc)] = undo.btb;
+      if (undo.rasModified)
+        m_ras[undo.rasTop] = undo.rasEntry;
+      m_rasTop = undo.rasTop;
+      m_rasCount = undo.rasCount;
+      m_history = undo.history;
+      m_stats = undo.stats;
+      m_undo.pop_back();
+    }
+  }
+
+private:
+  struct BTBEntry {
+    bool valid = false;
+    Kind kind = Kind::None;
+    AInt tag = 0;
+    AInt target = 0;
+  };
+
+  /// Predictor state prior to an update.
+  struct UndoRecord {
+    long long cycle;
+    AInt pc;
+    // Bimodal, gshare and chooser counters.
+    std::array<std::pair<uint8_t *, uint8_t>, 3> counters;
+    unsigned nCounters = 0;
+    bool btbModified = false;
+    BTBEntry btb;
+    bool rasModified = false;
+    AInt rasEntry = 0;
+    unsigned rasTop;
+    unsigned rasCount;
+    uint32_t history;
+    Stats stats;
+  };
+
+  static unsigned floorPow2(unsigned v) {
+    unsigned p = 1;
+    while (p * 2 != 0 && p * 2 <= v)
+      p *= 2;
+    return v == 0 ? 1 : p;
+  }
+
+  // Instructions are (at least) 2-byte aligned; the lowest bit of the PC
+  // carries no information.
+  unsigned bimodalIndex(AInt pc) const {
+    return (pc >> 1) & (m_config.phtEntries - 1);
+  }
+  unsigned gshareIndex(AInt pc) const {
+    return ((pc >> 1) ^ m_history) & (m_config.phtEntries - 1);
+  }
+  unsigned btbIndex(AInt pc) const {
+    return (pc >> 1) & (m_config.btbEntries - 1);
+  }
+  unsigned rasPrev(unsigned idx) const {
+    return (idx + m_config.rasEntries - 1) % m_config.rasEntries;
+  }
+
+  bool predictDirection(AInt pc) const {
+    const bool bimodal = m_bimodal[bimodalIndex(pc)] >= 2;
+    switch (m_config.type) {
+    case BranchPredictorConfig::Type::Bimodal:
+      return bimodal;
+    case BranchPredictorConfig::Type::GShare:
+      return m_gshare[gshareIndex(pc)] >= 2;
+    case BranchPredictorConfig::Type::Tournament:
+      return m_chooser[bimodalIndex(pc)] >= 2 ? m_gshare[gshareIndex(pc)] >= 2
+                                               : bimodal;
+    }
+    return false;
+  }
+
+  UndoRecord &pushUndo(long long cycle, AInt pc) {
+    UndoRecord undo;
+    undo.cycle = cycle;
+    undo.pc = pc;
+    undo.rasTop = m_rasTop;
+    undo.rasCount = m_rasCount;
+    undo.history = m_history;
+    undo.stats = m_stats;
+    m_undo.push_back(undo);
+    // Updates older than the reverse stack of the design can never be undone.
+    while (m_undo.size() > 1 &&
+           m_undo.size() > vsrtl::core::ClockedComponent::reverseStackSize())
+      m_undo.pop_front();
+    return m_undo.back();
+  }
+
+  void setCounter(UndoRecord &undo, uint8_t &counter, bool taken) {
+    undo.counters[undo.nCounters++] = {&counter, counter};
+    if (taken && counter < 3)
+      counter++;
+    else if (!taken && counter > 0)
+      counter--;
+  }
+
+  void updateDirection(UndoRecord &undo, AInt pc, bool taken) {
+    uint8_t &bimodal = m_bimodal[bimodalIndex(pc)];
+    uint8_t &gshare = m_gshare[gshareIndex(pc)];
+    if (m_config.type == BranchPredictorConfig::Type::Tournament) {
+      // Train the chooser towards whichever predictor was correct, if they
+      // disagreed.
+      const bool bimodalCorrect = (bimodal >= 2) == taken;
+      const bool gshareCorrect = (gshare >= 2) == taken;
+      if (bimodalCorrect != gshareCorrect)
+        setCounter(undo, m_chooser[bimodalIndex(pc)], gshareCorrect);
+    }
+    if (m_config.type != BranchPredictorConfig::Type::GShare)
+      setCounter(undo, bimodal, taken);
+    if (m_config.type != BranchPredictorConfig::Type::Bimodal)
+      setCounter(undo, gshare, taken);
+
+    const uint32_t mask = m_config.historyBits == 32
+                              ? ~uint32_t(0)
+                              : (uint32_t(1) << m_config.historyBits) - 1;
+    m_history = ((m_history << 1) | taken) & mask;
+  }
+
+  void setBTB(UndoRecord &undo, AInt pc, const BTBEntry &entry) {
+    BTBEntry &current = m_btb[btbIndex(pc)];
+    undo.btbModified = true;
+    undo.btb = current;
+    current = entry;
+  }
+
+  void pushRAS(UndoRecord &undo, AInt returnAddress) {
+    if (m_config.rasEntries == 0)
+      return;
+    // A full stack overwrites its oldest entry.
+    undo.rasModified = true;
+    undo.rasEntry = m_ras[m_rasTop];
+    m_ras[m_rasTop] = returnAddress;
+    m_rasTop = (m_rasTop + 1) % m_config.rasEntries;
+    m_rasCount = std::min(m_rasCount + 1, m_config.rasEntries);
+  }
+
+  void popRAS() {
+    if (m_rasCount == 0)
+      return;
+    m_rasTop = rasPrev(m_rasTop);
+    m_rasCount--;
+  }
+
+  BranchPredictorConfig m_config;
+  Stats m_stats;
+
+  std::vector<uint8_t> m_bimodal;
+  std::vector<uint8_t> m_gshare;
+  std::vector<uint8_t> m_chooser;
+  uint32_t m_history = 0;
+  std::vector<BTBEntry> m_btb;
+  std::vector<AInt> m_ras;
+  unsigned m_rasTop = 0;
+  unsigned m_rasCount = 0;
+
+  std::deque<UndoRecord> m_undo;
+};
+
+} // namespace Ripes
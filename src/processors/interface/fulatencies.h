@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Ripes {
+
+/// Latencies of the multi-cycle functional units of a processor. A latency is
+/// given as the number of cycles from an operation entering the unit until its
+/// result may be used by a dependent instruction; a latency of 1 corresponds to
+/// a combinational unit.
+struct FULatencies {
+  /// The latencies of multi-cycle functional units are bounded, to bound the
+  /// state required to track them.
+  static constexpr unsigned s_maxLatency = 64;
+
+  struct Unit {
+    unsigned latency;
+    /// A pipelined unit accepts a new operation every cycle. Otherwise, the
+    /// unit is occupied until the result of the current operation is ready.
+    bool pipelined;
+  };
+
+  /// All units are single-cycle by default, matching the combinational ALU of
+  /// the processor models. Multi-cycle latencies must be opted into.
+  Unit mul = {1, true};
+  Unit div = {1, false};
+
+  /// Clamps all latencies to their valid range.
+  void sanitize() {
+    for (Unit *unit : {&mul, &div})
+      unit->latency = std::clamp(unit->latency, 1u, s_maxLatency);
+  }
+};
+
+/// Cycles in which an instruction was held back by a multi-cycle functional
+/// unit.
+struct FUStats {
+  /// Waiting for the result of a multi-cycle operation.
+  uint64_t latencyStalls = 0;
+  /// Waiting for a non-pipelined unit to become free.
+  uint64_t structuralStalls = 0;
+};
+
+} // namespace Ripes
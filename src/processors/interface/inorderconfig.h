@@ -0,0 +1,51 @@
+#pragma once
+
+#include <algorithm>
+
+namespace Ripes {
+
+/// Resources of an N-wide in-order superscalar processor. Shared by the
+/// in-order superscalar processors and the trace-driven issue model (see
+/// IssueModel), such that the model replays the issue rules of the processors.
+struct InOrderConfig {
+  /// Maximum number of instructions issued per cycle.
+  static constexpr unsigned s_maxWidth = 8;
+  unsigned width = 2;
+  unsigned alus = 2;
+  unsigned memPorts = 1;
+  unsigned mulDivUnits = 1;
+  unsigned rfReadPorts = 4;
+  unsigned rfWritePorts = 2;
+  /// Cycles lost after a taken control-flow instruction.
+  unsigned redirectPenalty = 3;
+  /// Cycles from issuing a load until its result may be used.
+  unsigned loadLatency = 2;
+
+  /// Returns the default configuration of an issue width: one ALU per slot,
+  /// a memory port per two slots, a mul/div unit per four slots and enough
+  /// register file ports to never limit issue.
+  static InOrderConfig forWidth(unsigned width) {
+    InOrderConfig cfg;
+    cfg.width = std::max(width, 1u);
+    cfg.alus = cfg.width;
+    cfg.memPorts = std::max(cfg.width / 2, 1u);
+    cfg.mulDivUnits = std::max(cfg.width / 4, 1u);
+    cfg.rfReadPorts = 2 * cfg.width;
+    cfg.rfWritePorts = cfg.width;
+    return cfg;
+  }
+
+  /// Clamps all parameters to their valid ranges. A single instruction must
+  /// always be able to issue.
+  void sanitize() {
+    width = std::clamp(width, 1u, s_maxWidth);
+    alus = std::max(alus, 1u);
+    memPorts = std::max(memPorts, 1u);
+    mulDivUnits = std::max(mulDivUnits, 1u);
+    rfReadPorts = std::max(rfReadPorts, 2u);
+    rfWritePorts = std::max(rfWritePorts, 1u);
+    loadLatency = std::max(loadLatency, 1u);
+  }
+};
+
+} // namespace Ripes
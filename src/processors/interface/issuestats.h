@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QString>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace Ripes {
+
+/**
+ * @brief The IssueStats struct
+ * Issue slot accounting of a multiple-issue processor. Every cycle, the
+ * processor may issue up to 'width' instructions. Slots which are left unused
+ * are attributed to the reason which prevented the issue group from growing
+ * further (or, for cycles in which nothing issued, the reason for the bubble).
+ */
+struct IssueStats {
+  enum class Reason {
+    None,
+    DataDependency, // RAW hazard within the issue group, or on the result of
+                    // a multi-cycle operation
+    LoadUse,        // Stalled on the result of a load
+    ControlFlow,    // Control-flow instructions end the issue group
+    Redirect,       // Pipeline flushed by a taken control-flow instruction
+    Serialization,  // Environment calls issue alone
+    ALU,            // Out of ALUs
+    MemPort,        // Out of memory ports
+    MulDiv,         // Out of multiply/divide units
+    RFReadPorts,    // Out of register file read ports
+    RFWritePorts,   // Out of register file write ports
+    ROB,            // Reorder buffer full
+    RS,             // Reservation stations full
+    LSQ,            // Load/store queue full
+    Other,
+    NReasons
+  };
+  static constexpr unsigned s_nReasons =
+      static_cast<unsigned>(Reason::NReasons);
+
+  IssueStats(unsigned width = 1) : width(width), groupSizes(width + 1, 0) {}
+
+  unsigned width;
+  uint64_t cycles = 0;
+  uint64_t issued = 0;
+  /// Number of cycles in which n instructions were issued, indexed by n.
+  std::vector<uint64_t> groupSizes;
+  /// Number of unused issue slots, per reason.
+  std::array<uint64_t, s_nReasons> lostSlots{};
+  /// Number of issue groups cut short, per reason.
+  std::array<uint64_t, s_nReasons> limitedGroups{};
+
+  /// Accounts for a cycle in which @p n instructions issued. If @p undo is
+  /// set, a previously accounted cycle is removed (ie. upon reversing).
+  void account(unsigned n, Reason reason, bool undo = false) {
+    accountCycles(n, reason, 1, undo);
+  }
+  void accountCycles(unsigned n, Reason reason, uint64_t count,
+                     bool undo = false) {
+    auto add = [=](uint64_t &counter, uint64_t value) {
+      counter = undo ? counter - value : counter + value;
+    };
+    add(cycles, count);
+    add(issued, n * count);
+    add(groupSizes.at(n), count);
+    if (n < width) {
+      const auto r = static_cast<unsigned>(reason);
+      add(lostSlots[r], (width - n) * count);
+      add(limitedGroups[r], count);
+    }
+  }
+  void reset() { *this = IssueStats(width); }
+
+  /// Fraction of issue slots used.
+  double utilization() const {
+    return cycles > 0 ? static_cast<double>(issued) /
+                            static_cast<double>(cycles * width)
+                      : 0.0;
+  }
+};
+
+const static std::map<IssueStats::Reason, QString> IssueReasonNames = {
+    {IssueStats::Reason::None, "none"},
+    {IssueStats::Reason::DataDependency, "data dependency"},
+    {IssueStats::Reason::LoadUse, "load-use stall"},
+    {IssueStats::Reason::ControlFlow, "control flow"},
+    {IssueStats::Reason::Redirect, "control-flow redirect"},
+    {IssueStats::Reason::Serialization, "ecall serialization"},
+    {IssueStats::Reason::ALU, "ALUs"},
+    {IssueStats::Reason::MemPort, "memory ports"},
+    {IssueStats::Reason::MulDiv, "mul/div units"},
+    {IssueStats::Reason::RFReadPorts, "register file read ports"},
+    {IssueStats::Reason::RFWritePorts, "register file write ports"},
+    {IssueStats::Reason::ROB, "reorder buffer full"},
+    {IssueStats::Reason::RS, "reservation stations full"},
+    {IssueStats::Reason::LSQ, "load/store queue full"},
+    {IssueStats::Reason::Other, "other"}};
+
+} // namespace Ripes
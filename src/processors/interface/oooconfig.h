@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+
+namespace Ripes {
+
+/// Configuration of an out-of-order processor. Window sizes are given in
+/// instructions.
+struct OoOConfig {
+  /// Maximum number of instructions dispatched, issued and committed per
+  /// cycle.
+  static constexpr unsigned s_maxWidth = 4;
+  unsigned width = 2;
+  /// Number of reorder buffer entries.
+  unsigned robEntries = 32;
+  /// Number of reservation station entries, shared by all non-memory
+  /// instructions.
+  unsigned rsEntries = 16;
+  /// Number of load/store queue entries.
+  unsigned lsqEntries = 16;
+
+  unsigned aluUnits = 2;
+  /// The latency and pipelining of mul/div units are given by the processor's
+  /// functional unit latencies (see FULatencies).
+  unsigned mulDivUnits = 1;
+  unsigned memPorts = 1;
+
+  /// Cycles from issuing a load until its result may be used.
+  unsigned loadLatency = 2;
+  /// Cycles for the front-end to refill after a mispredicted control-flow
+  /// instruction has been resolved.
+  unsigned redirectPenalty = 3;
+
+  /// Clamps all parameters to their valid ranges.
+  void sanitize() {
+    width = std::clamp(width, 1u, s_maxWidth);
+    robEntries = std::max(robEntries, 1u);
+    rsEntries = std::max(rsEntries, 1u);
+    lsqEntries = std::max(lsqEntries, 1u);
+    aluUnits = std::max(aluUnits, 1u);
+    mulDivUnits = std::max(mulDivUnits, 1u);
+    memPorts = std::max(memPorts, 1u);
+    loadLatency = std::max(loadLatency, 1u);
+  }
+};
+
+} // namespace Ripes
@@ -0,0 +1,436 @@
+#pragma once
+
+#include "VSRTL/core/vsrtl_addressspace.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Ripes {
+
+/**
+ * @brief The PagedAddressSpace class
+ * Memory backend of the processor models. Memory is stored in 4 KiB pages,
+ * which are allocated upon first being written and located through a
+ * two-level page table. The first level maps the upper address bits to a table
+ * of 1024 pages (4 MiB of address space), such that large, sparse 64-bit
+ * address spaces only allocate the tables which are in use.
+ *
+ * The page most recently accessed by the processor is cached; an access within
+ * the same page as the previous access reduces to an offset into the page.
+ * Pages overlapping an IO region are never cached, and accesses to IO regions
+ * are dispatched through vsrtl::core::AddressSpaceMM. The const accessors
+ * (readMemConst(), readBlock(), readCString(), contains()) neither use nor
+ * update the caches, such that inspecting the memory does not disturb the
+ * caching of the processor's accesses.
+ *
+ * The address space is not thread-safe: writes may add page tables and replace
+ * pages. The const accessors must therefore not be called while another thread
+ * is clocking the processor.
+ *
+ * Reads of unallocated memory return 0 without allocating a page. contains()
+ * reports whether the page of an address has been allocated.
+ *
+ * The program image (the initialization memories) is kept in a separate set of
+ * pages, which are mapped read-only into the address space upon reset and
+ * copied upon being written (copy-on-write). Reset thus only remaps the pages
+ * which were written since the previous reset, rather than rebuilding the
+ * memory from the program image. Pages of the image may refer to memory which
+ * is not owned by the address space, such as a memory-mapped executable, in
+ * which case the executable is only copied a page at a time, as it is written.
+ */
+class PagedAddressSpace : public vsrtl::core::AddressSpaceMM {
+public:
+  static constexpr unsigned s_pageBits = 12;
+  static constexpr unsigned s_tableBits = 10;
+  static constexpr VSRTL_VT_U s_pageSize = VSRTL_VT_U(1) << s_pageBits;
+
+  void writeMem(VSRTL_VT_U address, VSRTL_VT_U value,
+                int size = sizeof(VSRTL_VT_U)) override {
+    const VSRTL_VT_U offset = address & (s_pageSize - 1);
+    if ((address >> s_pageBits) != m_lastPageNumber || !m_lastWritable ||
+        offset + size > s_pageSize) {
+      writeSlow(address, value, size);
+      return;
+    }
+    // The cached page is only writable if it is private to the address space.
+    store(const_cast<uint8_t *>(m_lastPage) + offset, value, size);
+  }
+
+  VSRTL_VT_U readMem(VSRTL_VT_U address,
+                     unsigned width = sizeof(VSRTL_VT_U)) override {
+    const VSRTL_VT_U offset = address & (s_pageSize - 1);
+    if ((address >> s_pageBits) != m_lastPageNumber ||
+        offset + width > s_pageSize) {
+      // Reads of IO regions may have side effects.
+      if (isIO(address, width))
+        return AddressSpaceMM::readMem(address, width);
+      return readSlow(address, width);
+    }
+    return load(m_lastPage + offset, width);
+  }
+
+  VSRTL_VT_U readMemConst(VSRTL_VT_U address,
+                          unsigned width = sizeof(VSRTL_VT_U)) const override {
+    if (isIO(address, width))
+      return AddressSpaceMM::readMemConst(address, width);
+    const VSRTL_VT_U offset = address & (s_pageSize - 1);
+    if (offset + width > s_pageSize) {
+      // Page-crossing access.
+      VSRTL_VT_U value = 0;
+      for (unsigned i = width; i-- > 0;)
+        value = (value << 8) | readMemConst(address + i, 1);
+      return value;
+    }
+    const uint8_t *page = lookupPage(address >> s_pageBits);
+    return page ? load(page + offset, width) : 0;
+  }
+
+  bool contains(VSRTL_VT_U address) const override {
+    if (isIO(address, 1))
+      return AddressSpaceMM::contains(address);
+    return lookupPage(address >> s_pageBits) != nullptr;
+  }
+
+  void reset() override {
+    AddressSpaceMM::reset();
+    if (m_imageChanged) {
+      m_tables.clear();
+      for (const auto &[pageNumber, page] : m_image)
+        entry(pageNumber) = {page, /*shared=*/true};
+      m_imageChanged = false;
+    } else {
+      for (const VSRTL_VT_U pageNumber : m_dirty) {
+        auto it = m_image.find(pageNumber);
+        entry(pageNumber) = it != m_image.end()
+                                ? PageEntry{it->second, /*shared=*/true}
+                                : PageEntry{};
+      }
+    }
+    m_dirty.clear();
+    invalidateCache();
+  }
+
+  /// Reads @p size bytes starting at @p address into @p data.
+  void readBlock(VSRTL_VT_U address, uint8_t *data, size_t size) const {
+    while (size > 0) {
+      const VSRTL_VT_U offset = address & (s_pageSize - 1);
+      const size_t n = std::min<size_t>(size, s_pageSize - offset);
+      if (isIO(address, n)) {
+        for (size_t i = 0; i < n; ++i)
+          data[i] = readMemConst(address + i, 1) & 0xFF;
+      } else if (const uint8_t *page = lookupPage(address >> s_pageBits)) {
+        std::memcpy(data, page + offset, n);
+      } else {
+        std::memset(data, 0, n);
+      }
+      address += n;
+      data += n;
+      size -= n;
+    }
+  }
+
+  /// Writes @p size bytes from @p data to memory starting at @p address.
+  void writeBlock(VSRTL_VT_U address, const uint8_t *data, size_t size) {
+    while (size > 0) {
+      const VSRTL_VT_U offset = address & (s_pageSize - 1);
+      const size_t n = std::min<size_t>(size, s_pageSize - offset);
+      if (isIO(address, n)) {
+        for (size_t i = 0; i < n; ++i)
+          writeMem(address + i, data[i], 1);
+      } else {
+        std::memcpy(writablePage(address >> s_pageBits) + offset, data, n);
+      }
+      address += n;
+      data += n;
+      size -= n;
+    }
+  }
+
+  /// Sets @p size bytes starting at @p address to zero. Pages which lie
+  /// entirely within the range are released.
+  void clearBlock(VSRTL_VT_U address, VSRTL_VT_U size) {
+    while (size > 0) {
+      const VSRTL_VT_U offset = address & (s_pageSize - 1);
+      const VSRTL_VT_U n = std::min<VSRTL_VT_U>(size, s_pageSize - offset);
+      const VSRTL_VT_U pageNumber = address >> s_pageBits;
+      if (isIO(address, n)) {
+        for (VSRTL_VT_U i = 0; i < n; ++i)
+          writeMem(address + i, 0, 1);
+      } else if (n == s_pageSize) {
+        releasePage(pageNumber);
+      } else if (findPage(pageNumber)) {
+        std::memset(writablePage(pageNumber) + offset, 0, n);
+      }
+      address += n;
+      size -= n;
+    }
+  }
+
+  /// Reads the null-terminated string starting at @p address, excluding the
+  /// terminator. At most @p maxLength bytes are read.
+  std::string
+  readCString(VSRTL_VT_U address,
+              size_t maxLength = std::numeric_limits<size_t>::max()) const {
+    std::string str;
+    while (str.size() < maxLength) {
+      const VSRTL_VT_U offset = address & (s_pageSize - 1);
+      const size_t n =
+          std::min<size_t>(maxLength - str.size(), s_pageSize - offset);
+      if (isIO(address, n)) {
+        for (size_t i = 0; i < n; ++i) {
+          const char c = readMemConst(address + i, 1) & 0xFF;
+          if (c == '\0')
+            return str;
+          str.push_back(c);
+        }
+      } else {
+        // Unallocated memory reads as a terminator.
+        const uint8_t *page = lookupPage(address >> s_pageBits);
+        if (!page)
+          return str;
+        const char *begin = reinterpret_cast<const char *>(page) + offset;
+        const char *end = static_cast<const char *>(std::memchr(begin, 0, n));
+        str.append(begin, end ? end : begin + n);
+        if (end)
+          return str;
+      }
+      address += n;
+    }
+    return str;
+  }
+
+  /// Adds @p size bytes from @p data to the program image at @p address. The
+  /// program image is mapped into the address space upon reset.
+  /// If @p owner is set, it keeps @p data alive, and the pages which lie
+  /// entirely within @p data refer to it rather than to a copy of it.
+  void addInitializationMemory(VSRTL_VT_U address, const char *data,
+                               size_t size,
+                               const std::shared_ptr<const void> &owner = {}) {
+    while (size > 0) {
+      const VSRTL_VT_U offset = address & (s_pageSize - 1);
+      const size_t n = std::min<size_t>(size, s_pageSize - offset);
+      auto &page = m_image[address >> s_pageBits];
+      if (owner && n == s_pageSize) {
+        page = PageData(owner, reinterpret_cast<const uint8_t *>(data));
+      } else {
+        // Pages of the image are never modified in place: they may be mapped
+        // into the address space, or refer to the memory of an owner.
+        auto copy = copyPage(page);
+        std::memcpy(copy->data() + offset, data, n);
+        page = PageData(copy, copy->data());
+      }
+      address += n;
+      data += n;
+      size -= n;
+    }
+    m_imageChanged = true;
+  }
+  void clearInitializationMemories() {
+    m_image.clear();
+    m_imageChanged = true;
+  }
+
+  void addIORegion(VSRTL_VT_U startAddr, unsigned size,
+                   vsrtl::core::IOFunctors io) {
+    AddressSpaceMM::addIORegion(startAddr, size, io);
+    m_ioRegions.push_back({startAddr, startAddr + size});
+    invalidateCache();
+  }
+
+  void removeIORegion(VSRTL_VT_U startAddr, unsigned size) {
+    AddressSpaceMM::removeIORegion(startAddr, size);
+    for (auto it = m_ioRegions.begin(); it != m_ioRegions.end(); ++it) {
+      if (it->first == startAddr && it->second == startAddr + size) {
+        m_ioRegions.erase(it);
+        break;
+      }
+    }
+    invalidateCache();
+  }
+
+private:
+  using Page = std::array<uint8_t, s_pageSize>;
+  /// The bytes of a page. Pages of the program image may refer to memory
+  /// which the pointer keeps alive; all other pages are Pages.
+  using PageData = std::shared_ptr<const uint8_t>;
+  struct PageEntry {
+    PageData page;
+    // The page is a page of the program image, and must be copied before
+    // being written.
+    bool shared = false;
+  };
+  using PageTable = std::array<PageEntry, 1 << s_tableBits>;
+  static constexpr VSRTL_VT_U s_noPage = ~VSRTL_VT_U(0);
+
+  static VSRTL_VT_U load(const uint8_t *bytes, unsigned width) {
+    VSRTL_VT_U value = 0;
+    for (unsigned i = width; i-- > 0;)
+      value = (value << 8) | bytes[i];
+    return value;
+  }
+
+  static void store(uint8_t *bytes, VSRTL_VT_U value, int size) {
+    for (int i = 0; i < size; ++i) {
+      bytes[i] = value & 0xFF;
+      value >>= 8;
+    }
+  }
+
+  /// Returns a new page holding a copy of @p page, or zeros if @p page is null.
+  static std::shared_ptr<Page> copyPage(const PageData &page) {
+    auto copy = std::make_shared<Page>();
+    if (page)
+      std::memcpy(copy->data(), page.get(), s_pageSize);
+    return copy;
+  }
+
+  /// Returns true if [address : address + size[ overlaps an IO region.
+  bool isIO(VSRTL_VT_U address, VSRTL_VT_U size) const {
+    for (const auto &region : m_ioRegions)
+      if (address < region.second && region.first < address + size)
+        return true;
+    return false;
+  }
+
+  /// Returns the page at @p pageNumber, or nullptr if it is not allocated.
+  /// Does not use the caches.
+  const uint8_t *lookupPage(VSRTL_VT_U pageNumber) const {
+    auto it = m_tables.find(pageNumber >> s_tableBits);
+    if (it == m_tables.end())
+      return nullptr;
+    return (*it->second)[pageNumber & ((1 << s_tableBits) - 1)].page.get();
+  }
+
+  /// As lookupPage(), through the last-table cache.
+  const uint8_t *findPage(VSRTL_VT_U pageNumber) {
+    const VSRTL_VT_U tableNumber = pageNumber >> s_tableBits;
+    if (tableNumber != m_lastTableNumber) {
+      auto it = m_tables.find(tableNumber);
+      if (it == m_tables.end())
+        return nullptr;
+      m_lastTableNumber = tableNumber;
+      m_lastTable = it->second.get();
+    }
+    return (*m_lastTable)[pageNumber & ((1 << s_tableBits) - 1)].page.get();
+  }
+
+  PageEntry &entry(VSRTL_VT_U pageNumber) {
+    auto &table = m_tables[pageNumber >> s_tableBits];
+    if (!table)
+      table = std::make_unique<PageTable>();
+    return (*table)[pageNumber & ((1 << s_tableBits) - 1)];
+  }
+
+  /// Returns the page at @p pageNumber, allocating it or copying the page of
+  /// the program image if it is not yet private to the address space.
+  uint8_t *writablePage(VSRTL_VT_U pageNumber) {
+    PageEntry &e = entry(pageNumber);
+    if (!e.page || e.shared) {
+      auto copy = copyPage(e.page);
+      e.page = PageData(copy, copy->data());
+      e.shared = false;
+      m_dirty.push_back(pageNumber);
+      if (pageNumber == m_lastPageNumber)
+        m_lastPageNumber = s_noPage;
+    }
+    // Private pages are allocated by the address space.
+    return const_cast<uint8_t *>(e.page.get());
+  }
+
+  /// Unmaps the page at @p pageNumber, such that it reads as zero until reset.
+  void releasePage(VSRTL_VT_U pageNumber) {
+    if (!findPage(pageNumber))
+      return;
+    PageEntry &e = entry(pageNumber);
+    // Private pages are already restored upon reset.
+    if (e.shared)
+      m_dirty.push_back(pageNumber);
+    e = PageEntry{};
+    if (pageNumber == m_lastPageNumber)
+      m_lastPageNumber = s_noPage;
+  }
+
+  /// Caches @p page unless it overlaps an IO region.
+  void cachePage(VSRTL_VT_U pageNumber, const uint8_t *page, bool writable) {
+    if (isIO(pageNumber << s_pageBits, s_pageSize))
+      return;
+    m_lastPageNumber = pageNumber;
+    m_lastPage = page;
+    m_lastWritable = writable;
+  }
+
+  void invalidateCache() {
+    m_lastPageNumber = s_noPage;
+    m_lastPage = nullptr;
+    m_lastWritable = false;
+    m_lastTableNumber = s_noPage;
+    m_lastTable = nullptr;
+  }
+
+  void writeSlow(VSRTL_VT_U address, VSRTL_VT_U value, int size) {
+    if (isIO(address, size)) {
+      AddressSpaceMM::writeMem(address, value, size);
+      return;
+    }
+    const VSRTL_VT_U offset = address & (s_pageSize - 1);
+    if (offset + size > s_pageSize) {
+      // Page-crossing access.
+      for (int i = 0; i < size; ++i) {
+        writeMem(address + i, value & 0xFF, 1);
+        value >>= 8;
+      }
+      return;
+    }
+    const VSRTL_VT_U pageNumber = address >> s_pageBits;
+    uint8_t *page = writablePage(pageNumber);
+    cachePage(pageNumber, page, /*writable=*/true);
+    store(page + offset, value, size);
+  }
+
+  /// Reads memory outside of any IO region, and caches the page being read.
+  VSRTL_VT_U readSlow(VSRTL_VT_U address, unsigned width) {
+    const VSRTL_VT_U offset = address & (s_pageSize - 1);
+    if (offset + width > s_pageSize) {
+      // Page-crossing access.
+      return readMemConst(address, width);
+    }
+    const VSRTL_VT_U pageNumber = address >> s_pageBits;
+    const uint8_t *page = findPage(pageNumber);
+    if (!page)
+      return 0;
+    // Whether the page may be written is unknown; a write to the page
+    // determines it through writeSlow.
+    cachePage(pageNumber, page, /*writable=*/false);
+    return load(page + offset, width);
+  }
+
+  std::unordered_map<VSRTL_VT_U, std::unique_ptr<PageTable>> m_tables;
+  std::vector<std::pair<VSRTL_VT_U, VSRTL_VT_U>> m_ioRegions;
+
+  // Pages of the program image, and whether the image changed since the last
+  // reset.
+  std::unordered_map<VSRTL_VT_U, PageData> m_image;
+  bool m_imageChanged = false;
+  // Pages made private to the address space since the last reset.
+  std::vector<VSRTL_VT_U> m_dirty;
+
+  // Last-page and last-table caches, used by the non-const accessors only.
+  VSRTL_VT_U m_lastPageNumber = s_noPage;
+  const uint8_t *m_lastPage = nullptr;
+  bool m_lastWritable = false;
+  VSRTL_VT_U m_lastTableNumber = s_noPage;
+  PageTable *m_lastTable = nullptr;
+};
+
+} // namespace Ripes
+
+/// Declares a paged address space owned by the enclosing VSRTL design.
+#define PAGEDADDRESSSPACE(name)                                                \
+  Ripes::PagedAddressSpace *name =                                             \
+      this->template create_memory<Ripes::PagedAddressSpace>()
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QString>
+#include <map>
+
+namespace Ripes {
+
+/// Microarchitecture of a parametric 5-stage pipeline. The configuration
+/// determines how the datapath is wired, and is thus fixed once the processor
+/// has been constructed.
+struct PipelineConfig {
+  /// Stage in which control-flow instructions are resolved. A control-flow
+  /// instruction resolved in ID, EX or MEM is followed by respectively 1, 2 or
+  /// 3 instructions fetched before the front-end is redirected.
+  enum class BranchStage { ID = 1, EX = 2, MEM = 3 };
+
+  /// Forward results from the EX, MEM and WB stages to their consumers. If
+  /// disabled, consumers read the register file, and a hazard detection unit
+  /// must stall until their operands have been written back.
+  bool forwarding = true;
+  /// Stall the pipeline on data hazards. If disabled, programs must resolve
+  /// data hazards themselves by inserting nops.
+  bool hazardDetection = true;
+  BranchStage branchStage = BranchStage::EX;
+  /// Execute, rather than squash, the instructions fetched after a taken
+  /// control-flow instruction (delay slots).
+  bool delayedBranch = false;
+  /// Predict the next PC in the fetch stage with the dynamic branch predictor.
+  /// Requires control flow to be resolved in ID, and excludes delay slots.
+  bool prediction = false;
+
+  /// Number of instructions fetched after a control-flow instruction before it
+  /// is resolved.
+  unsigned branchSlots() const { return static_cast<unsigned>(branchStage); }
+
+  /// Resolves conflicting parameters; dynamic prediction takes precedence.
+  void sanitize() {
+    if (prediction) {
+      branchStage = BranchStage::ID;
+      delayedBranch = false;
+    }
+  }
+
+  bool operator==(const PipelineConfig &rhs) const {
+    return forwarding == rhs.forwarding &&
+           hazardDetection == rhs.hazardDetection &&
+           branchStage == rhs.branchStage &&
+           delayedBranch == rhs.delayedBranch && prediction == rhs.prediction;
+  }
+  bool operator!=(const PipelineConfig &rhs) const { return !(*this == rhs); }
+};
+
+const static std::map<PipelineConfig::BranchStage, QString> BranchStageNames =
+    {{PipelineConfig::BranchStage::ID, "ID"},
+     {PipelineConfig::BranchStage::EX, "EX"},
+     {PipelineConfig::BranchStage::MEM, "MEM"}};
+
+} // namespace Ripes
@@ -8,6 +8,12 @@
 
 #include "../isa/isa_types.h"
 #include "../isa/isainfo.h"
+#include "branchpredictor.h"
+#include "fulatencies.h"
+#include "issuestats.h"
+#include "oooconfig.h"
+#include "pagedaddressspace.h"
+#include "pipelineconfig.h"
 
 namespace Ripes {
 
@@ -223,7 +229,7 @@ public:
    * @return reference to the address space utilized by the implementing
    * processor
    */
-  virtual vsrtl::core::AddressSpaceMM &getMemory() = 0;
+  virtual PagedAddressSpace &getMemory() = 0;
 
   /**
    * @brief dataMemAccess/instrMemAccess
@@ -275,6 +281,51 @@ public:
    */
   virtual void vcdTrace(bool, const QString &){};
 
+  /**
+   * @brief branchPredictor
+   * @returns the dynamic branch predictor of the processor, or nullptr if the
+   * processor does not implement dynamic branch prediction.
+   */
+  virtual BranchPredictor *branchPredictor() const { return nullptr; }
+
+  /**
+   * @brief issueStats
+   * @returns the issue slot statistics of a multiple-issue processor, or
+   * nullptr if the processor does not issue multiple instructions per cycle.
+   */
+  virtual const IssueStats *issueStats() const { return nullptr; }
+
+  /**
+   * @brief outOfOrderConfig
+   * @returns the configuration of an out-of-order processor, or nullptr if the
+   * processor does not execute instructions out of order. Changes take effect
+   * upon the next reset of the processor.
+   */
+  virtual OoOConfig *outOfOrderConfig() { return nullptr; }
+
+  /**
+   * @brief functionalUnitLatencies
+   * @returns the latencies of the multi-cycle functional units of the
+   * processor, or nullptr if all functional units of the processor are
+   * combinational. Changes take effect when the processor is reset.
+   */
+  virtual FULatencies *functionalUnitLatencies() { return nullptr; }
+
+  /**
+   * @brief functionalUnitStats
+   * @returns the number of cycles which the processor has stalled on its
+   * multi-cycle functional units, or nullptr if these are not accounted.
+   */
+  virtual const FUStats *functionalUnitStats() const { return nullptr; }
+
+  /**
+   * @brief pipelineConfig
+   * @returns the microarchitecture of a parametric pipeline, or nullptr if the
+   * datapath of the processor is fixed. The configuration is given when the
+   * processor is constructed.
+   */
+  virtual const PipelineConfig *pipelineConfig() const { return nullptr; }
+
   /**
    * @brief clock
    * Clocks the processor.
@@ -343,6 +394,14 @@ public:
    */
   std::function<void(void)> trapHandler;
 
+  /**
+   * @brief csrReadHandler
+   * Callback for the processor to read the value of the CSR with the provided
+   * number from the Ripes environment (ie. the cycle, instret and hardware
+   * performance monitoring counters).
+   */
+  std::function<VInt(unsigned)> csrReadHandler;
+
   /** ======================== FEATURE: Reversible ======================== */
   // Enabled by setting m_features.isReversible = true
 
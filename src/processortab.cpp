@@ -279,6 +279,20 @@ void ProcessorTab::setupSimulatorActions(QToolBar *controlToolbar) {
   m_displayValuesAction->setChecked(
       RipesSettings::value(RIPES_SETTING_SHOWSIGNALS).toBool());
 
+  m_showHeatAction = new QAction("Show execution heat", this);
+  m_showHeatAction->setCheckable(true);
+  m_showHeatAction->setToolTip(
+      "Count the number of times each instruction is executed and show it in "
+      "the instruction view. Profiling slows down simulation.");
+  connect(m_showHeatAction, &QAction::toggled, this, [=](bool checked) {
+    RipesSettings::setValue(RIPES_SETTING_SHOWHEAT,
+                            QVariant::fromValue(checked));
+    m_instrModel->setHeatEnabled(checked);
+    m_ui->instructionView->setColumnHidden(InstructionModel::Heat, !checked);
+  });
+  m_showHeatAction->setChecked(
+      RipesSettings::value(RIPES_SETTING_SHOWHEAT).toBool());
+
   const QIcon tableIcon = QIcon(":/icons/spreadsheet.svg");
   m_pipelineDiagramAction =
       new QAction(tableIcon, "Show pipeline diagram", this);
@@ -430,6 +444,14 @@ void ProcessorTab::updateInstructionModel() {
                                               Qt::Horizontal, Qt::DisplayRole)
                                  .toString()) *
           1.25);
+  // The heat column is, like the stage column, updated frequently.
+  m_ui->instructionView->horizontalHeader()->setSectionResizeMode(
+      InstructionModel::Heat, QHeaderView::Interactive);
+  m_ui->instructionView->horizontalHeader()->resizeSection(
+      InstructionModel::Heat, ivfm.horizontalAdvance("0000000") * 1.25);
+  m_ui->instructionView->setColumnHidden(
+      InstructionModel::Heat,
+      !RipesSettings::value(RIPES_SETTING_SHOWHEAT).toBool());
   m_ui->instructionView->horizontalHeader()->setSectionResizeMode(
       InstructionModel::Instruction, QHeaderView::Stretch);
   // Make the instruction view follow the instruction which is currently present
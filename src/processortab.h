@@ -82,6 +82,7 @@ private:
   QAction *m_autoClockAction = nullptr;
   QAction *m_runAction = nullptr;
   QAction *m_displayValuesAction = nullptr;
+  QAction *m_showHeatAction = nullptr;
   QAction *m_pipelineDiagramAction = nullptr;
   QAction *m_reverseAction = nullptr;
   QAction *m_resetAction = nullptr;
@@ -0,0 +1,175 @@
+#include "regionofinterest.h"
+
+#include "processorhandler.h"
+
+#include <QTextStream>
+
+namespace Ripes {
+
+static const std::array<QString, RegionOfInterest::NCycleClasses>
+    s_cycleClassNames = {"retiring", "stalled", "flushed", "other"};
+
+void RegionOfInterest::attach() {
+  if (s_attached)
+    return;
+  s_attached = true;
+
+  // The CPI stack must be gathered in lockstep with the processor; execute the
+  // handlers in the simulation thread (direct connection).
+  auto *handler = ProcessorHandler::get();
+  QObject::connect(
+      handler, &ProcessorHandler::processorClocked, handler,
+      [] { processorWasClocked(); }, Qt::DirectConnection);
+  QObject::connect(
+      handler, &ProcessorHandler::processorReset, handler, [] { reset(); },
+      Qt::DirectConnection);
+}
+
+void RegionOfInterest::addCounter(const QString &name,
+                                  std::function<uint64_t()> read) {
+  s_counters.push_back({name, read});
+}
+
+void RegionOfInterest::reset() {
+  s_active = false;
+  s_regions = 0;
+  s_cycles = 0;
+  s_retired = 0;
+  s_cpiStack.fill(0);
+  for (auto &counter : s_counters) {
+    counter.start = 0;
+    counter.total = 0;
+  }
+  s_snapshots.clear();
+}
+
+void RegionOfInterest::begin() {
+  attach();
+  if (s_active)
+    return;
+  const auto *proc = ProcessorHandler::getProcessor();
+  s_active = true;
+  s_regions++;
+  s_startCycle = proc->getCycleCount();
+  s_startRetired = proc->getInstructionsRetired();
+  for (auto &counter : s_counters)
+    counter.start = counter.read();
+}
+
+void RegionOfInterest::end() {
+  if (!s_active)
+    return;
+  const auto *proc = ProcessorHandler::getProcessor();
+  s_active = false;
+  s_cycles += proc->getCycleCount() - s_startCycle;
+  s_retired += proc->getInstructionsRetired() - s_startRetired;
+  for (auto &counter : s_counters)
+    counter.total += counter.read() - counter.start;
+}
+
+void RegionOfInterest::processorWasClocked() {
+  if (!s_active)
+    return;
+
+  const auto *proc = ProcessorHandler::getProcessor();
+  const auto &structure = proc->structure();
+  bool retiring = false, stalled = false, flushed = false;
+  for (auto idx : structure.stageIt()) {
+    const auto info = proc->stageInfo(idx);
+    if (idx.index() == structure.at(idx.lane()) - 1 && info.stage_valid)
+      retiring = true;
+    stalled |= info.state == StageInfo::State::Stalled;
+    flushed |= info.state == StageInfo::State::Flushed;
+  }
+
+  CycleClass cls = Other;
+  if (retiring)
+    cls = Retiring;
+  else if (stalled)
+    cls = Stalled;
+  else if (flushed)
+    cls = Flushed;
+  s_cpiStack[cls]++;
+}
+
+QVariantMap RegionOfInterest::currentTotals() {
+  const auto *proc = ProcessorHandler::getProcessor();
+  long long cycles = s_cycles;
+  long long retired = s_retired;
+  if (s_active) {
+    cycles += proc->getCycleCount() - s_startCycle;
+    retired += proc->getInstructionsRetired() - s_startRetired;
+  }
+
+  QVariantMap totals;
+  totals["cycles"] = cycles;
+  totals["instructions"] = retired;
+  totals["CPI"] =
+      retired > 0 ? static_cast<double>(cycles) / static_cast<double>(retired)
+                  : 0.0;
+  totals["IPC"] =
+      cycles > 0 ? static_cast<double>(retired) / static_cast<double>(cycles)
+                 : 0.0;
+  QVariantMap cpiStack;
+  for (unsigned c = 0; c < NCycleClasses; ++c)
+    cpiStack[s_cycleClassNames[c]] = s_cpiStack[c];
+  totals["CPI stack"] = cpiStack;
+  for (const auto &counter : s_counters) {
+    uint64_t total = counter.total;
+    if (s_active)
+      total += counter.read() - counter.start;
+    totals[counter.name] = QVariant::fromValue(total);
+  }
+  return totals;
+}
+
+void RegionOfInterest::snapshot(long long id) {
+  attach();
+  QVariantMap snapshot = currentTotals();
+  snapshot["id"] = id;
+  snapshot["cycle"] = ProcessorHandler::getProcessor()->getCycleCount();
+  s_snapshots << snapshot;
+}
+
+QVariant RegionOfInterest::report(bool json) {
+  QVariantMap totals = currentTotals();
+  if (json) {
+    totals["regions"] = s_regions;
+    totals["snapshots"] = s_snapshots;
+    return totals;
+  }
+
+  QString outStr;
+  QTextStream out(&outStr);
+  if (s_regions == 0) {
+    out << "No region of interest was entered.\n";
+    return outStr;
+  }
+
+  const long long cycles = totals["cycles"].toLongLong();
+  out << "Regions:\t" << s_regions << "\n";
+  out << "Cycles:\t" << cycles << "\n";
+  out << "Instructions:\t" << totals["instructions"].toLongLong() << "\n";
+  out << "CPI:\t" << totals["CPI"].toDouble() << "\n";
+  out << "IPC:\t" << totals["IPC"].toDouble() << "\n";
+  out << "CPI stack:\n";
+  for (unsigned c = 0; c < NCycleClasses; ++c) {
+    out << "  " << s_cycleClassNames[c] << "\t" << s_cpiStack[c] << "\t"
+        << QString::number(cycles > 0 ? 100.0 * s_cpiStack[c] / cycles : 0,
+                           'f', 2)
+        << "%\n";
+  }
+  for (const auto &counter : s_counters)
+    out << counter.name << ":\t" << totals[counter.name].toULongLong() << "\n";
+  for (const auto &s : s_snapshots) {
+    const auto snapshot = s.toMap();
+    out << "Snapshot " << snapshot["id"].toLongLong() << " @ cycle "
+        << snapshot["cycle"].toLongLong()
+        << ":\tcycles: " << snapshot["cycles"].toLongLong()
+        << "\tinstructions: " << snapshot["instructions"].toLongLong()
+        << "\n";
+  }
+  return outStr;
+}
+
+} // namespace Ripes
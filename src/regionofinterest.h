@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QString>
+#include <QVariant>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Ripes {
+
+/**
+ * @brief The RegionOfInterest class
+ * Guest-controlled measurement regions. The program being simulated marks the
+ * beginning and end of its region(s) of interest through dedicated environment
+ * calls, and the statistics accumulated over all regions are reported
+ * alongside the whole-program totals.
+ *
+ * Within a region, cycles, retired instructions and a CPI stack (the primary
+ * cause of each cycle) are accumulated, as well as the deltas of any counters
+ * registered through addCounter (ie. cache hits/misses).
+ *
+ * In ROI-only mode, detailed modelling (cache simulation, profilers, sampling
+ * and tracing) is skipped outside of a region; listeners to
+ * ProcessorHandler::processorClocked should check outsideROI() before doing any
+ * work.
+ *
+ * All state is modified in the simulation thread, and only read once
+ * simulation has finished; no synchronization is performed.
+ */
+class RegionOfInterest {
+public:
+  /// Primary cause of a cycle within a region.
+  enum CycleClass : unsigned {
+    // One or more instructions retired.
+    Retiring,
+    // No instruction retired, and one or more stages were stalled.
+    Stalled,
+    // No instruction retired, and one or more stages were flushed.
+    Flushed,
+    // No instruction retired for other reasons (pipeline fill, ...).
+    Other,
+    NCycleClasses
+  };
+
+  static void setROIOnly(bool enabled) { s_roiOnly = enabled; }
+  static bool isROIOnly() { return s_roiOnly; }
+
+  /// Returns true if currently within a region of interest.
+  static bool isActive() { return s_active; }
+
+  /// Returns true if detailed modelling should be skipped for the current
+  /// cycle; ie. ROI-only mode is enabled and the program is outside a region.
+  static bool outsideROI() { return s_roiOnly && !s_active; }
+
+  /// Registers a counter for which the delta over all regions is reported.
+  static void addCounter(const QString &name, std::function<uint64_t()> read);
+
+  static void begin();
+  static void end();
+
+  /// Records a snapshot of the statistics accumulated so far, tagged with
+  /// @p id.
+  static void snapshot(long long id);
+
+  /// Reports the statistics accumulated over all regions of interest.
+  static QVariant report(bool json);
+
+private:
+  struct Counter {
+    QString name;
+    std::function<uint64_t()> read;
+    uint64_t start = 0;
+    uint64_t total = 0;
+  };
+
+  static void attach();
+  static void reset();
+  static void processorWasClocked();
+
+  /// Returns the values accumulated over all regions so far, including the
+  /// currently active region.
+  static QVariantMap currentTotals();
+
+  static inline bool s_attached = false;
+  static inline bool s_roiOnly = false;
+  static inline bool s_active = false;
+  static inline unsigned s_regions = 0;
+
+  static inline long long s_startCycle = 0;
+  static inline long long s_startRetired = 0;
+  static inline long long s_cycles = 0;
+  static inline long long s_retired = 0;
+  static inline std::array<long long, NCycleClasses> s_cpiStack{};
+  static inline std::vector<Counter> s_counters;
+  static inline QVariantList s_snapshots;
+};
+
+} // namespace Ripes
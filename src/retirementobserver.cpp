@@ -0,0 +1,82 @@
+#include "retirementobserver.h"
+
+#include "processorhandler.h"
+#include "regionofinterest.h"
+#include "selfprofiler.h"
+
+#include <algorithm>
+
+namespace Ripes {
+
+RetirementObserver::RetirementObserver(QObject *parent) : QObject(parent) {}
+
+void RetirementObserver::setEnabled(bool enabled) {
+  if (enabled == m_enabled)
+    return;
+  m_enabled = enabled;
+
+  if (m_enabled) {
+    // Statistics must be gathered in lockstep with the processor; execute the
+    // handler in the simulation thread (direct connection).
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorClocked, this,
+            &RetirementObserver::processorWasClocked, Qt::DirectConnection);
+    connect(ProcessorHandler::get(), &ProcessorHandler::processorReset, this,
+            &RetirementObserver::processorReset);
+    processorReset();
+  } else {
+    disconnect(ProcessorHandler::get(), nullptr, this, nullptr);
+  }
+}
+
+uint32_t RetirementObserver::instructionAt(AInt pc) {
+  return static_cast<uint32_t>(
+      ProcessorHandler::getMemory().readMemConst(pc, 4));
+}
+
+void RetirementObserver::processorReset() {
+  m_textStart = ProcessorHandler::getTextStart();
+  const auto *isa = ProcessorHandler::currentISA();
+  const unsigned minInstrBytes = isa->extensionEnabled("C") ? 2 : 4;
+  m_slotShift = minInstrBytes == 2 ? 1 : 2;
+  m_numSlots = ProcessorHandler::getCurrentProgramSize() >> m_slotShift;
+  m_retiring.clear();
+  observerReset();
+
+  // The initial (cycle 0) state of the processor may already hold valid
+  // instructions, ie. for single-cycle processors.
+  processorWasClocked();
+}
+
+void RetirementObserver::processorWasClocked() {
+  SelfProfiler::Scope scope(SelfProfiler::RetirementObservers);
+  if (RegionOfInterest::outsideROI())
+    return;
+  const auto *proc = ProcessorHandler::getProcessor();
+  const auto &structure = proc->structure();
+  const long long cycle = proc->getCycleCount();
+
+  m_retiring.clear();
+  unsigned stageOrdinal = 0;
+  for (auto idx : structure.stageIt()) {
+    const bool lastInLane = idx.index() == structure.at(idx.lane()) - 1;
+    if (m_observeStages || lastInLane) {
+      const auto info = proc->stageInfo(idx);
+      if (info.stage_valid && hasSlot(info.pc)) {
+        if (m_observeStages)
+          stageOccupied(stageOrdinal, info.pc);
+        if (lastInLane)
+          m_retiring.push_back(info.pc);
+      }
+    }
+    ++stageOrdinal;
+  }
+
+  // Instructions retiring in the same cycle (multi-lane processors) are
+  // sequential; report them in program order.
+  if (m_retiring.size() > 1)
+    std::sort(m_retiring.begin(), m_retiring.end());
+  for (const AInt pc : m_retiring)
+    instructionRetired(pc, cycle);
+}
+
+} // namespace Ripes
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <QObject>
+#include <vector>
+
+#include "isa/isa_types.h"
+
+namespace Ripes {
+
+/**
+ * @brief The RetirementObserver class
+ * Base class for statistics gatherers which must observe every instruction that
+ * leaves the pipeline of the current processor. The observer connects to
+ * ProcessorHandler::processorClocked (in the simulation thread) and, for each
+ * cycle, inspects the final stage of each lane of the processor. Instructions
+ * which are valid in the final stage of a lane are reported as retired, in
+ * program order.
+ *
+ * State which is indexed by program counter should be kept in flat arrays
+ * indexed by slotForPC(), which maps an address within the .text section of the
+ * current program to a dense index.
+ */
+class RetirementObserver : public QObject {
+  Q_OBJECT
+public:
+  RetirementObserver(QObject *parent = nullptr);
+  virtual ~RetirementObserver() {}
+
+  /// Starts/stops observing the processor. The observer is reset upon being
+  /// enabled.
+  void setEnabled(bool enabled);
+  bool isEnabled() const { return m_enabled; }
+
+  /// Number of PC slots in the .text section of the current program.
+  unsigned numSlots() const { return m_numSlots; }
+
+  /// Returns true if @p pc maps to a slot within the current .text section.
+  bool hasSlot(AInt pc) const {
+    return pc >= m_textStart &&
+           ((pc - m_textStart) >> m_slotShift) < m_numSlots;
+  }
+  unsigned slotForPC(AInt pc) const {
+    return static_cast<unsigned>((pc - m_textStart) >> m_slotShift);
+  }
+  AInt pcForSlot(unsigned slot) const {
+    return m_textStart + (static_cast<AInt>(slot) << m_slotShift);
+  }
+
+protected:
+  /// Called for every instruction leaving the final stage of a lane.
+  virtual void instructionRetired(AInt pc, long long cycle) = 0;
+
+  /// Called for every valid stage of the processor each cycle, if stage
+  /// observation has been enabled through setObserveStages. @p stage is the
+  /// ordinal of the stage when iterating ProcessorStructure::stageIt().
+  virtual void stageOccupied(unsigned /*stage*/, AInt /*pc*/) {}
+
+  /// Called whenever the processor is reset or a new program is loaded.
+  /// Implementations should (re)size their slot-indexed state to numSlots().
+  virtual void observerReset() = 0;
+
+  void setObserveStages(bool enabled) { m_observeStages = enabled; }
+
+  /// Reads the (up to 32-bit) instruction word located at @p pc.
+  static uint32_t instructionAt(AInt pc);
+
+private:
+  void processorWasClocked();
+  void processorReset();
+
+  bool m_enabled = false;
+  bool m_observeStages = false;
+
+  AInt m_textStart = 0;
+  unsigned m_numSlots = 0;
+  // log2 of the smallest instruction size of the current ISA.
+  unsigned m_slotShift = 2;
+
+  // Scratch buffer of PCs retired in the current cycle.
+  std::vector<AInt> m_retiring;
+};
+
+} // namespace Ripes
@@ -37,6 +37,30 @@ const std::map<QString, QVariant> s_defaultSettings = {
     {RIPES_SETTING_EDITORSTAGEHIGHLIGHTING, true},
     {RIPES_SETTING_VCD_TRACE_FILE, "ripes.vcd"},
     {RIPES_SETTING_VCD_TRACE, false},
+    {RIPES_SETTING_VCD_TRACE_SIGNALS, "*"},
+    {RIPES_SETTING_VCD_TRACE_START, 0},
+    {RIPES_SETTING_VCD_TRACE_STOP, -1},
+    {RIPES_SETTING_VCD_TRACE_COMPRESS, false},
+    {RIPES_SETTING_BP_TYPE, "bimodal"},
+    {RIPES_SETTING_BP_PHT_ENTRIES, 256},
+    {RIPES_SETTING_BP_HISTORY_BITS, 8},
+    {RIPES_SETTING_BP_BTB_ENTRIES, 64},
+    {RIPES_SETTING_BP_RAS_ENTRIES, 8},
+    {RIPES_SETTING_OOO_WIDTH, 2},
+    {RIPES_SETTING_OOO_ROB_ENTRIES, 32},
+    {RIPES_SETTING_OOO_RS_ENTRIES, 16},
+    {RIPES_SETTING_OOO_LSQ_ENTRIES, 16},
+    {RIPES_SETTING_OOO_LOAD_LATENCY, 2},
+    {RIPES_SETTING_MUL_LATENCY, 1},
+    {RIPES_SETTING_MUL_PIPELINED, true},
+    {RIPES_SETTING_DIV_LATENCY, 1},
+    {RIPES_SETTING_DIV_PIPELINED, false},
+    {RIPES_SETTING_HPM_EVENTS, false},
+    {RIPES_SETTING_PIPELINE_FORWARDING, true},
+    {RIPES_SETTING_PIPELINE_HAZARD, true},
+    {RIPES_SETTING_PIPELINE_BRANCH_STAGE, "EX"},
+    {RIPES_SETTING_PIPELINE_DB, false},
+    {RIPES_SETTING_PIPELINE_PREDICTION, false},
 
     {RIPES_SETTING_PIPEDIAGRAM_MAXCYCLES, 100},
     {RIPES_SETTING_CACHE_MAXCYCLES, 10000},
@@ -69,6 +93,7 @@ const std::map<QString, QVariant> s_defaultSettings = {
     {RIPES_SETTING_SOURCECODE, ""},
     {RIPES_SETTING_DARKMODE, true},
     {RIPES_SETTING_SHOWSIGNALS, false},
+    {RIPES_SETTING_SHOWHEAT, false},
     {RIPES_SETTING_INPUT_TYPE, static_cast<unsigned>(SourceType::Assembly)},
     {RIPES_SETTING_AUTOCLOCK_INTERVAL, 100},
 
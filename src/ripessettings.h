@@ -34,6 +34,30 @@ namespace Ripes {
 #define RIPES_SETTING_PERIPHERAL_SETTINGS ("peripheral_settings")
 #define RIPES_SETTING_VCD_TRACE ("enable_vcd_trace")
 #define RIPES_SETTING_VCD_TRACE_FILE ("vcd_trace_file")
+#define RIPES_SETTING_VCD_TRACE_SIGNALS ("vcd_trace_signals")
+#define RIPES_SETTING_VCD_TRACE_START ("vcd_trace_start")
+#define RIPES_SETTING_VCD_TRACE_STOP ("vcd_trace_stop")
+#define RIPES_SETTING_VCD_TRACE_COMPRESS ("vcd_trace_compress")
+#define RIPES_SETTING_BP_TYPE ("bp_type")
+#define RIPES_SETTING_BP_PHT_ENTRIES ("bp_pht_entries")
+#define RIPES_SETTING_BP_HISTORY_BITS ("bp_history_bits")
+#define RIPES_SETTING_BP_BTB_ENTRIES ("bp_btb_entries")
+#define RIPES_SETTING_BP_RAS_ENTRIES ("bp_ras_entries")
+#define RIPES_SETTING_OOO_WIDTH ("ooo_width")
+#define RIPES_SETTING_OOO_ROB_ENTRIES ("ooo_rob_entries")
+#define RIPES_SETTING_OOO_RS_ENTRIES ("ooo_rs_entries")
+#define RIPES_SETTING_OOO_LSQ_ENTRIES ("ooo_lsq_entries")
+#define RIPES_SETTING_OOO_LOAD_LATENCY ("ooo_load_latency")
+#define RIPES_SETTING_MUL_LATENCY ("mul_latency")
+#define RIPES_SETTING_MUL_PIPELINED ("mul_pipelined")
+#define RIPES_SETTING_DIV_LATENCY ("div_latency")
+#define RIPES_SETTING_DIV_PIPELINED ("div_pipelined")
+#define RIPES_SETTING_HPM_EVENTS ("hpm_events")
+#define RIPES_SETTING_PIPELINE_FORWARDING ("pipeline_forwarding")
+#define RIPES_SETTING_PIPELINE_HAZARD ("pipeline_hazard_detection")
+#define RIPES_SETTING_PIPELINE_BRANCH_STAGE ("pipeline_branch_stage")
+#define RIPES_SETTING_PIPELINE_DB ("pipeline_delayed_branch")
+#define RIPES_SETTING_PIPELINE_PREDICTION ("pipeline_prediction")
 
 // This is not really a setting, but instead a method to leverage the static
 // observer objects that are generated for a setting. Used for other objects to
@@ -52,6 +76,7 @@ namespace Ripes {
 #define RIPES_SETTING_SOURCECODE ("sourcecode")
 #define RIPES_SETTING_DARKMODE ("darkmode")
 #define RIPES_SETTING_SHOWSIGNALS ("show_signals")
+#define RIPES_SETTING_SHOWHEAT ("show_execution_heat")
 #define RIPES_SETTING_AUTOCLOCK_INTERVAL ("autoclock_interval")
 #define RIPES_SETTING_EDITORREGS ("editor_regs")
 #define RIPES_SETTING_EDITORCONSOLE ("editor_console")
@@ -0,0 +1,93 @@
+#include "selfprofiler.h"
+
+#include "processorhandler.h"
+#include "utilities/systemutils.h"
+
+#include <QTextStream>
+
+namespace Ripes {
+
+static const std::array<QString, SelfProfiler::NRegions> s_regionNames = {
+    "run",
+    "clock",
+    "syscalls",
+    "breakpoint checks",
+    "L1CacheShim",
+    "PipelineDiagramModel",
+    "RetirementObserver",
+    "TimeSeriesSampler",
+    "VCDTracer",
+    "PerformanceCounters"};
+
+static double toMs(SelfProfiler::Clock_t::duration d) {
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+void SelfProfiler::reset() {
+  s_time.fill(Clock_t::duration::zero());
+  s_count.fill(0);
+}
+
+QVariant SelfProfiler::report(bool json) {
+  const auto *proc = ProcessorHandler::getProcessor();
+  const long long cycles = proc->getCycleCount();
+  const long long retired = proc->getInstructionsRetired();
+  const double runSeconds = toMs(s_time[Run]) / 1000.0;
+
+  // Time spent in Design::clock() which is not accounted for by any nested
+  // region is the cost of propagating the circuit itself.
+  Clock_t::duration listeners = Clock_t::duration::zero();
+  for (unsigned r = 0; r < NRegions; ++r)
+    if (isListener(static_cast<Region>(r)))
+      listeners += s_time[r];
+  const auto propagation = s_time[Clock] - listeners - s_time[Syscalls];
+
+  const double kHz =
+      runSeconds > 0 ? static_cast<double>(cycles) / runSeconds / 1e3 : 0;
+  const double mips =
+      runSeconds > 0 ? static_cast<double>(retired) / runSeconds / 1e6 : 0;
+  const qulonglong peakRSS = peakResidentSetSize();
+
+  if (json) {
+    QVariantMap report;
+    report["simulated kHz"] = kHz;
+    report["MIPS"] = mips;
+    report["peak RSS (bytes)"] = peakRSS;
+    report["propagation (ms)"] = toMs(propagation);
+    QVariantMap regions;
+    for (unsigned r = 0; r < NRegions; ++r) {
+      QVariantMap region;
+      region["time (ms)"] = toMs(s_time[r]);
+      region["count"] = QVariant::fromValue(s_count[r]);
+      regions[s_regionNames[r]] = region;
+    }
+    report["regions"] = regions;
+    return report;
+  }
+
+  QString outStr;
+  QTextStream out(&outStr);
+  out << "Simulation speed:\t" << QString::number(kHz, 'f', 2) << " kHz\t"
+      << QString::number(mips, 'f', 3) << " MIPS\n";
+  out << "Peak RSS:\t" << peakRSS / 1024 << " KiB\n\n";
+  out << "region\ttime (ms)\tcount\t% of run\n";
+  auto printRegion = [&](const QString &name, Clock_t::duration d,
+                         uint64_t count) {
+    const double ms = toMs(d);
+    out << name << "\t" << QString::number(ms, 'f', 3) << "\t" << count << "\t"
+        << QString::number(runSeconds > 0 ? ms / (runSeconds * 10.0) : 0, 'f',
+                           2)
+        << "%\n";
+  };
+  for (unsigned r = 0; r < NRegions; ++r) {
+    if (s_count[r] == 0)
+      continue;
+    printRegion((isListener(static_cast<Region>(r)) ? "  listener: " : "") +
+                    s_regionNames[r],
+                s_time[r], s_count[r]);
+  }
+  printRegion("propagation", propagation, s_count[Clock]);
+  return outStr;
+}
+
+} // namespace Ripes
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QString>
+#include <QVariant>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace Ripes {
+
+/**
+ * @brief The SelfProfiler class
+ * Host-side instrumentation of the simulator itself. Regions of interest (clock
+ * propagation, processorClocked listeners, syscalls, ...) are timed through
+ * SelfProfiler::Scope objects. When profiling is disabled, a scope costs a
+ * single branch.
+ *
+ * All regions are executed in the simulation thread, and the accumulated
+ * statistics are only read once simulation has finished; no synchronization
+ * is performed.
+ */
+class SelfProfiler {
+public:
+  enum Region : unsigned {
+    // The complete simulation loop.
+    Run,
+    // Design::clock(), including all of the processorClocked listeners.
+    Clock,
+    Syscalls,
+    BreakpointChecks,
+    // processorClocked listeners
+    L1CacheShim,
+    PipelineDiagram,
+    RetirementObservers,
+    TimeSeriesSampler,
+    VCDTracer,
+    PerformanceCounters,
+    NRegions
+  };
+
+  using Clock_t = std::chrono::steady_clock;
+
+  /// RAII timer, adding its lifetime to a region.
+  class Scope {
+  public:
+    explicit Scope(Region region) : m_region(region), m_active(s_enabled) {
+      if (m_active)
+        m_start = Clock_t::now();
+    }
+    ~Scope() {
+      if (m_active)
+        add(m_region, Clock_t::now() - m_start);
+    }
+
+  private:
+    Region m_region;
+    bool m_active;
+    Clock_t::time_point m_start;
+  };
+
+  static void setEnabled(bool enabled) { s_enabled = enabled; }
+  static bool isEnabled() { return s_enabled; }
+  static void reset();
+
+  static void add(Region region, Clock_t::duration duration) {
+    s_time[region] += duration;
+    s_count[region]++;
+  }
+
+  /// Reports simulation speed, per-region host time and the peak resident set
+  /// size of the process.
+  static QVariant report(bool json);
+
+private:
+  static bool isListener(Region region) {
+    return region >= L1CacheShim && region < NRegions;
+  }
+
+  static inline bool s_enabled = false;
+  static inline std::array<Clock_t::duration, NRegions> s_time{};
+  static inline std::array<uint64_t, NRegions> s_count{};
+};
+
+} // namespace Ripes
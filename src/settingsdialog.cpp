@@ -3,10 +3,15 @@
 
 #include "ccmanager.h"
 #include "formattermanager.h"
+#include "processors/interface/branchpredictor.h"
+#include "processors/interface/fulatencies.h"
+#include "processors/interface/oooconfig.h"
+#include "processors/interface/pipelineconfig.h"
 #include "ripessettings.h"
 
 #include <QCheckBox>
 #include <QColorDialog>
+#include <QComboBox>
 #include <QFileDialog>
 #include <QFontDialog>
 #include <QGroupBox>
@@ -70,6 +75,11 @@ createSettingsWidgets(const QString &settingName, const QString &labelText) {
     widget->connect(widget, &QLineEdit::textChanged, settingObserver,
                     &SettingObserver::setValue);
     widget->setText(settingObserver->value().toString());
+  } else if constexpr (std::is_same<T_EditWidget, QComboBox>()) {
+    // The combobox is populated by the caller, which must also select the item
+    // matching the current setting. Only user selections modify the setting.
+    widget->connect(widget, &QComboBox::textActivated, settingObserver,
+                    &SettingObserver::setValue);
   } else if constexpr (std::is_same<T_EditWidget, QCheckBox>()) {
     widget->connect(widget, &QCheckBox::toggled, settingObserver,
                     &SettingObserver::setValue);
@@ -327,6 +337,145 @@ QWidget *SettingsDialog::createSimulatorPage() {
   appendToLayout({vcdEnableLabel, vcdEnable}, pageLayout);
   appendToLayout({vcdTraceFileLabel, vcdTraceFile}, pageLayout);
 
+  // Setting: RIPES_SETTING_VCD_TRACE_SIGNALS
+  appendToLayout(createSettingsWidgets<QLineEdit>(
+                     RIPES_SETTING_VCD_TRACE_SIGNALS, "VCD trace signals:"),
+                 pageLayout,
+                 "Comma-separated wildcard patterns of the hierarchical signal "
+                 "names to trace, e.g. \"*.alu.*,*.pc_reg.*\"");
+
+  // Setting: RIPES_SETTING_VCD_TRACE_START/STOP
+  auto [vcdStartLabel, vcdStart] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_VCD_TRACE_START, "VCD trace start cycle:");
+  vcdStart->setRange(0, INT_MAX);
+  appendToLayout({vcdStartLabel, vcdStart}, pageLayout);
+  auto [vcdStopLabel, vcdStop] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_VCD_TRACE_STOP, "VCD trace stop cycle:");
+  vcdStop->setRange(-1, INT_MAX);
+  appendToLayout({vcdStopLabel, vcdStop}, pageLayout,
+                 "Last cycle to trace. -1 traces until the end of simulation.");
+
+  // Setting: RIPES_SETTING_VCD_TRACE_COMPRESS
+  appendToLayout(
+      createSettingsWidgets<QCheckBox>(RIPES_SETTING_VCD_TRACE_COMPRESS,
+                                       "Compress VCD trace (gzip):"),
+      pageLayout);
+
+  // Setting: RIPES_SETTING_BP_*
+  auto [bpTypeLabel, bpType] = createSettingsWidgets<QComboBox>(
+      RIPES_SETTING_BP_TYPE, "Branch predictor:");
+  for (const auto &it : BranchPredictorTypeNames)
+    bpType->addItem(it.second);
+  bpType->setCurrentText(
+      RipesSettings::value(RIPES_SETTING_BP_TYPE).toString());
+  appendToLayout({bpTypeLabel, bpType}, pageLayout,
+                 "Direction predictor of processors with dynamic branch "
+                 "prediction. Changing the predictor resets the processor.");
+  auto [phtLabel, phtEntries] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_BP_PHT_ENTRIES, "Pattern history table entries:");
+  phtEntries->setRange(1, 1 << 20);
+  appendToLayout({phtLabel, phtEntries}, pageLayout,
+                 "Number of 2-bit counters in each pattern history table. "
+                 "Rounded down to a power of two.");
+  auto [historyLabel, historyBits] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_BP_HISTORY_BITS, "Global history bits:");
+  historyBits->setRange(0, 32);
+  appendToLayout({historyLabel, historyBits}, pageLayout);
+  auto [btbLabel, btbEntries] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_BP_BTB_ENTRIES, "Branch target buffer entries:");
+  btbEntries->setRange(1, 1 << 20);
+  appendToLayout({btbLabel, btbEntries}, pageLayout,
+                 "Rounded down to a power of two.");
+  auto [rasLabel, rasEntries] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_BP_RAS_ENTRIES, "Return address stack entries:");
+  rasEntries->setRange(0, 1024);
+  appendToLayout({rasLabel, rasEntries}, pageLayout,
+                 "0 disables the return address stack.");
+
+  // Setting: RIPES_SETTING_OOO_*
+  auto [oooWidthLabel, oooWidth] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_OOO_WIDTH, "Out-of-order width:");
+  oooWidth->setRange(1, OoOConfig::s_maxWidth);
+  appendToLayout({oooWidthLabel, oooWidth}, pageLayout,
+                 "Instructions dispatched, issued and committed per cycle by "
+                 "the out-of-order processor. Changing the configuration "
+                 "resets the processor.");
+  auto [robLabel, robEntries] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_OOO_ROB_ENTRIES, "Reorder buffer entries:");
+  robEntries->setRange(1, 1024);
+  appendToLayout({robLabel, robEntries}, pageLayout);
+  auto [rsLabel, rsEntries] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_OOO_RS_ENTRIES, "Reservation station entries:");
+  rsEntries->setRange(1, 1024);
+  appendToLayout({rsLabel, rsEntries}, pageLayout);
+  auto [lsqLabel, lsqEntries] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_OOO_LSQ_ENTRIES, "Load/store queue entries:");
+  lsqEntries->setRange(1, 1024);
+  appendToLayout({lsqLabel, lsqEntries}, pageLayout);
+  auto [loadLatencyLabel, loadLatency] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_OOO_LOAD_LATENCY, "Load latency:");
+  loadLatency->setRange(1, 1000);
+  appendToLayout({loadLatencyLabel, loadLatency}, pageLayout,
+                 "Cycles from issuing a load until its result may be used.");
+
+  // Setting: RIPES_SETTING_MUL_*, RIPES_SETTING_DIV_*
+  auto [mulLatencyLabel, mulLatency] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_MUL_LATENCY, "Multiply latency:");
+  mulLatency->setRange(1, FULatencies::s_maxLatency);
+  appendToLayout({mulLatencyLabel, mulLatency}, pageLayout,
+                 "Cycles from a multiply instruction entering the execute "
+                 "stage until its result may be used, for the processors with "
+                 "hazard detection. Processors without hazard detection "
+                 "ignore the latencies. Changing the latencies resets the "
+                 "processor.");
+  auto [mulPipelinedLabel, mulPipelined] = createSettingsWidgets<QCheckBox>(
+      RIPES_SETTING_MUL_PIPELINED, "Pipelined multiplier:");
+  appendToLayout({mulPipelinedLabel, mulPipelined}, pageLayout);
+  auto [divLatencyLabel, divLatency] = createSettingsWidgets<QSpinBox>(
+      RIPES_SETTING_DIV_LATENCY, "Divide latency:");
+  divLatency->setRange(1, FULatencies::s_maxLatency);
+  appendToLayout({divLatencyLabel, divLatency}, pageLayout);
+  auto [divPipelinedLabel, divPipelined] = createSettingsWidgets<QCheckBox>(
+      RIPES_SETTING_DIV_PIPELINED, "Pipelined divider:");
+  appendToLayout({divPipelinedLabel, divPipelined}, pageLayout,
+                 "A non-pipelined unit accepts a new operation once the "
+                 "result of the previous operation is ready.");
+
+  // Setting: RIPES_SETTING_HPM_EVENTS
+  auto [hpmLabel, hpmEvents] = createSettingsWidgets<QCheckBox>(
+      RIPES_SETTING_HPM_EVENTS, "Count pipeline events:");
+  appendToLayout({hpmLabel, hpmEvents}, pageLayout,
+                 "Count stalled and flushed cycles in the hpmcounter5 and "
+                 "hpmcounter6 CSRs. Counting slows down simulation; when "
+                 "disabled, the counters read as zero.");
+
+  // Setting: RIPES_SETTING_PIPELINE_*
+  auto [fwLabel, forwarding] = createSettingsWidgets<QCheckBox>(
+      RIPES_SETTING_PIPELINE_FORWARDING, "Parametric pipeline forwarding:");
+  appendToLayout({fwLabel, forwarding}, pageLayout,
+                 "Microarchitecture of the parametric 5-stage processor. "
+                 "Changes take effect when the processor is next selected.");
+  appendToLayout(
+      createSettingsWidgets<QCheckBox>(RIPES_SETTING_PIPELINE_HAZARD,
+                                       "Parametric pipeline hazard detection:"),
+      pageLayout);
+  auto [stageLabel, branchStage] = createSettingsWidgets<QComboBox>(
+      RIPES_SETTING_PIPELINE_BRANCH_STAGE, "Branches solved in stage:");
+  for (const auto &it : BranchStageNames)
+    branchStage->addItem(it.second);
+  branchStage->setCurrentText(
+      RipesSettings::value(RIPES_SETTING_PIPELINE_BRANCH_STAGE).toString());
+  appendToLayout({stageLabel, branchStage}, pageLayout);
+  appendToLayout(createSettingsWidgets<QCheckBox>(RIPES_SETTING_PIPELINE_DB,
+                                                  "Delayed branches:"),
+                 pageLayout);
+  appendToLayout(
+      createSettingsWidgets<QCheckBox>(RIPES_SETTING_PIPELINE_PREDICTION,
+                                       "Dynamic branch prediction:"),
+      pageLayout,
+      "Branches are solved in ID when predicted, and delayed branches are "
+      "disabled.");
+
   return pageWidget;
 }
 
@@ -0,0 +1,280 @@
+#include "simpoint.h"
+
+#include "isa/rvinstrclass.h"
+#include "processorhandler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace Ripes {
+
+uint64_t BBVProfile::instructions(size_t i) const {
+  uint64_t count = 0;
+  for (const auto &block : intervals.at(i))
+    count += block.second;
+  return count;
+}
+
+uint64_t BBVProfile::totalInstructions() const {
+  if (intervals.empty())
+    return 0;
+  return (intervals.size() - 1) * intervalLength +
+         instructions(intervals.size() - 1);
+}
+
+BBVProfiler::BBVProfiler(uint64_t intervalLength, QObject *parent)
+    : RetirementObserver(parent) {
+  m_profile.intervalLength = std::max<uint64_t>(intervalLength, 1);
+}
+
+void BBVProfiler::observerReset() {
+  const uint64_t intervalLength = m_profile.intervalLength;
+  m_profile = BBVProfile();
+  m_profile.intervalLength = intervalLength;
+  m_slotBlock.assign(numSlots(), -1);
+  m_slotInfo.assign(numSlots(), s_unknown);
+  m_counts.clear();
+  m_touched.clear();
+  m_inInterval = 0;
+  m_block = -1;
+  m_blockEnded = true;
+}
+
+void BBVProfiler::instructionRetired(AInt pc, long long) {
+  const unsigned slot = slotForPC(pc);
+  if (m_blockEnded || pc != m_nextPC) {
+    int &block = m_slotBlock[slot];
+    if (block < 0) {
+      block = m_profile.numBlocks++;
+      m_counts.push_back(0);
+    }
+    m_block = block;
+  }
+
+  uint8_t &info = m_slotInfo[slot];
+  if (info == s_unknown) {
+    const uint32_t instr = instructionAt(pc);
+    const auto cls =
+        RVISA::classifyInstr(instr, ProcessorHandler::currentISA()->bits());
+    info = RVISA::instrSize(instr) == 2 ? s_compressedBit : 0;
+    if (cls == InstrClass::Branch || cls == InstrClass::Jump)
+      info |= s_controlFlowBit;
+  }
+  m_blockEnded = info & s_controlFlowBit;
+  m_nextPC = pc + ((info & s_compressedBit) ? 2 : 4);
+
+  if (m_counts[m_block]++ == 0)
+    m_touched.push_back(m_block);
+  if (++m_inInterval == m_profile.intervalLength)
+    closeInterval();
+}
+
+BBVProfile::Vector BBVProfiler::currentVector() const {
+  BBVProfile::Vector vector;
+  vector.reserve(m_touched.size());
+  for (const unsigned block : m_touched)
+    vector.push_back({block, m_counts[block]});
+  std::sort(vector.begin(), vector.end());
+  return vector;
+}
+
+void BBVProfiler::closeInterval() {
+  m_profile.intervals.push_back(currentVector());
+  for (const unsigned block : m_touched)
+    m_counts[block] = 0;
+  m_touched.clear();
+  m_inInterval = 0;
+}
+
+BBVProfile BBVProfiler::profile() const {
+  BBVProfile profile = m_profile;
+  if (m_inInterval > 0)
+    profile.intervals.push_back(currentVector());
+  return profile;
+}
+
+namespace {
+
+using Point = std::vector<double>;
+
+constexpr double s_pi = 3.14159265358979323846;
+
+double distance2(const Point &a, const Point &b) {
+  double d = 0.0;
+  for (size_t i = 0; i < a.size(); ++i)
+    d += (a[i] - b[i]) * (a[i] - b[i]);
+  return d;
+}
+
+struct Clustering {
+  std::vector<Point> centroids;
+  std::vector<unsigned> assignment;
+  double bic = 0.0;
+};
+
+/// k-means with k-means++ seeding.
+Clustering kmeans(const std::vector<Point> &points, unsigned k,
+                  std::mt19937 &rng) {
+  const size_t n = points.size();
+  Clustering c;
+  std::vector<double> minDist(n, std::numeric_limits<double>::max());
+  c.centroids.push_back(points[rng() % n]);
+  while (c.centroids.size() < k) {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      minDist[i] =
+          std::min(minDist[i], distance2(points[i], c.centroids.back()));
+      sum += minDist[i];
+    }
+    size_t next = rng() % n;
+    if (sum > 0.0) {
+      double r = std::uniform_real_distribution<double>(0.0, sum)(rng);
+      for (next = 0; next < n - 1 && r > minDist[next]; ++next)
+        r -= minDist[next];
+    }
+    c.centroids.push_back(points[next]);
+  }
+
+  c.assignment.assign(n, 0);
+  const unsigned dims = points[0].size();
+  for (unsigned iter = 0; iter < 100; ++iter) {
+    bool changed = iter == 0;
+    for (size_t i = 0; i < n; ++i) {
+      unsigned best = 0;
+      double bestDist = std::numeric_limits<double>::max();
+      for (unsigned j = 0; j < k; ++j) {
+        const double d = distance2(points[i], c.centroids[j]);
+        if (d < bestDist) {
+          bestDist = d;
+          best = j;
+        }
+      }
+      changed |= c.assignment[i] != best;
+      c.assignment[i] = best;
+    }
+    if (!changed)
+      break;
+
+    std::vector<Point> sums(k, Point(dims, 0.0));
+    std::vector<unsigned> sizes(k, 0);
+    for (size_t i = 0; i < n; ++i) {
+      sizes[c.assignment[i]]++;
+      for (unsigned d = 0; d < dims; ++d)
+        sums[c.assignment[i]][d] += points[i][d];
+    }
+    // Empty clusters retain their centroid.
+    for (unsigned j = 0; j < k; ++j)
+      if (sizes[j] > 0)
+        for (unsigned d = 0; d < dims; ++d)
+          c.centroids[j][d] = sums[j][d] / sizes[j];
+  }
+  return c;
+}
+
+/// BIC score of a clustering under an identical spherical Gaussian model for
+/// each cluster (Pelleg & Moore, X-means).
+double bicScore(const std::vector<Point> &points, const Clustering &c) {
+  const double n = points.size();
+  const double k = c.centroids.size();
+  const double dims = points[0].size();
+  if (n <= k)
+    return 0.0;
+
+  double sse = 0.0;
+  std::vector<double> sizes(c.centroids.size(), 0.0);
+  for (size_t i = 0; i < points.size(); ++i) {
+    sse += distance2(points[i], c.centroids[c.assignment[i]]);
+    sizes[c.assignment[i]]++;
+  }
+  const double variance = std::max(sse / (n - k), 1e-12) / dims;
+
+  double logLikelihood = 0.0;
+  for (const double size : sizes) {
+    if (size == 0.0)
+      continue;
+    logLikelihood += size * std::log(size / n) -
+                     size * dims / 2.0 * std::log(2.0 * s_pi * variance) -
+                     (size - k) / 2.0;
+  }
+  const double params = (k - 1) + dims * k + 1;
+  return logLikelihood - params / 2.0 * std::log(n);
+}
+
+} // namespace
+
+SimPointSelection selectSimPoints(const BBVProfile &profile, unsigned maxK,
+                                  unsigned dims, unsigned seed) {
+  SimPointSelection selection;
+  const size_t n = profile.intervals.size();
+  if (n == 0)
+    return selection;
+
+  // Random projection of the normalized basic block vectors.
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::vector<double> projection(static_cast<size_t>(profile.numBlocks) * dims);
+  for (auto &v : projection)
+    v = uniform(rng);
+
+  std::vector<Point> points(n, Point(dims, 0.0));
+  for (size_t i = 0; i < n; ++i) {
+    const double total = profile.instructions(i);
+    for (const auto &[block, count] : profile.intervals[i])
+      for (unsigned d = 0; d < dims; ++d)
+        points[i][d] += count / total * projection[block * dims + d];
+  }
+
+  // The BIC is undefined when every interval forms a cluster of its own.
+  const size_t kLimit =
+      std::min<size_t>(std::max(maxK, 1u), std::max<size_t>(n - 1, 1));
+  std::vector<Clustering> clusterings;
+  for (unsigned k = 1; k <= kLimit; ++k) {
+    clusterings.push_back(kmeans(points, k, rng));
+    clusterings.back().bic = bicScore(points, clusterings.back());
+  }
+  const auto [minIt, maxIt] = std::minmax_element(
+      clusterings.begin(), clusterings.end(),
+      [](const auto &a, const auto &b) { return a.bic < b.bic; });
+  const double threshold = minIt->bic + 0.9 * (maxIt->bic - minIt->bic);
+  const auto &chosen = *std::find_if(
+      clusterings.begin(), clusterings.end(),
+      [&](const auto &c) { return c.bic >= threshold; });
+
+  // Pick the interval closest to each centroid; clusters are weighted by the
+  // instructions executed within their intervals.
+  const double total = profile.totalInstructions();
+  std::vector<double> weights(chosen.centroids.size(), 0.0);
+  std::vector<size_t> closest(chosen.centroids.size(), n);
+  std::vector<double> closestDist(chosen.centroids.size(),
+                                  std::numeric_limits<double>::max());
+  for (size_t i = 0; i < n; ++i) {
+    const unsigned j = chosen.assignment[i];
+    weights[j] += profile.instructions(i) / total;
+    const double d = distance2(points[i], chosen.centroids[j]);
+    if (d < closestDist[j]) {
+      closestDist[j] = d;
+      closest[j] = i;
+    }
+  }
+
+  // Number the non-empty clusters in program order of their simulation
+  // points.
+  std::vector<unsigned> order;
+  for (unsigned j = 0; j < closest.size(); ++j)
+    if (closest[j] < n)
+      order.push_back(j);
+  std::sort(order.begin(), order.end(),
+            [&](unsigned a, unsigned b) { return closest[a] < closest[b]; });
+  std::vector<unsigned> renumber(chosen.centroids.size(), 0);
+  for (unsigned i = 0; i < order.size(); ++i) {
+    renumber[order[i]] = i;
+    selection.points.push_back({closest[order[i]], i, weights[order[i]]});
+  }
+  for (const unsigned j : chosen.assignment)
+    selection.clusterOf.push_back(renumber[j]);
+  return selection;
+}
+
+} // namespace Ripes
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "retirementobserver.h"
+
+namespace Ripes {
+
+/**
+ * A basic block vector (BBV) profile of a program. The retired instruction
+ * stream is divided into fixed-length intervals, and for each interval the
+ * number of instructions executed within each basic block is recorded. Basic
+ * blocks are identified by their entry address; a block ends at a control-flow
+ * instruction, and a new block starts at any non-sequential PC.
+ */
+struct BBVProfile {
+  /// Sparse basic block vector; pairs of {block, instructions}, sorted by
+  /// block.
+  using Vector = std::vector<std::pair<unsigned, uint32_t>>;
+
+  uint64_t intervalLength = 0;
+  unsigned numBlocks = 0;
+  std::vector<Vector> intervals;
+
+  /// Number of instructions executed within interval @p i. All intervals but
+  /// the last have intervalLength instructions.
+  uint64_t instructions(size_t i) const;
+  uint64_t totalInstructions() const;
+};
+
+/**
+ * @brief The BBVProfiler class
+ * Collects the basic block vector profile of the retired instruction stream of
+ * the current processor. The profile is restarted whenever the processor is
+ * reset.
+ */
+class BBVProfiler : public RetirementObserver {
+  Q_OBJECT
+public:
+  BBVProfiler(uint64_t intervalLength, QObject *parent = nullptr);
+
+  /// Returns the profile, including the final, partial interval.
+  BBVProfile profile() const;
+
+protected:
+  void instructionRetired(AInt pc, long long cycle) override;
+  void observerReset() override;
+
+private:
+  static constexpr uint8_t s_unknown = 0xFF;
+  static constexpr uint8_t s_compressedBit = 0b01;
+  static constexpr uint8_t s_controlFlowBit = 0b10;
+
+  BBVProfile::Vector currentVector() const;
+  void closeInterval();
+
+  BBVProfile m_profile;
+
+  /// Per-slot block index of blocks entered at the slot, or -1.
+  std::vector<int> m_slotBlock;
+  /// Per-slot cache of the size and control-flow bits of the instruction.
+  std::vector<uint8_t> m_slotInfo;
+
+  /// Instructions per block within the current interval, and the blocks
+  /// touched in it.
+  std::vector<uint32_t> m_counts;
+  std::vector<unsigned> m_touched;
+  uint64_t m_inInterval = 0;
+
+  int m_block = -1;
+  bool m_blockEnded = true;
+  AInt m_nextPC = 0;
+};
+
+/// A simulation point: an interval which represents a cluster of intervals
+/// with similar basic block vectors.
+struct SimPoint {
+  size_t interval = 0;
+  unsigned cluster = 0;
+  /// Fraction of the instructions of the program executed within the
+  /// intervals of the cluster.
+  double weight = 0.0;
+};
+
+struct SimPointSelection {
+  std::vector<SimPoint> points;
+  /// Cluster of each interval.
+  std::vector<unsigned> clusterOf;
+};
+
+/**
+ * @brief selectSimPoints
+ * Clusters the intervals of @p profile by their basic block vectors and picks
+ * the interval closest to the centroid of each cluster (SimPoint). The vectors
+ * are normalized and randomly projected onto @p dims dimensions, and clustered
+ * with k-means for k = 1 ... @p maxK. The smallest k whose Bayesian
+ * information criterion (BIC) score reaches 90% of the range of scores is
+ * chosen. Clustering is deterministic for a given @p seed.
+ */
+SimPointSelection selectSimPoints(const BBVProfile &profile, unsigned maxK,
+                                  unsigned dims = 15, unsigned seed = 1);
+
+} // namespace Ripes
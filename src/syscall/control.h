@@ -3,6 +3,7 @@
 #include <type_traits>
 
 #include "processorhandler.h"
+#include "processstate.h"
 #include "ripes_syscall.h"
 #include "systemio.h"
 
@@ -16,6 +17,8 @@ public:
   ExitSyscall() : BaseSyscall("Exit", "Exits the program with code 0") {}
   void execute() {
     SystemIO::printString("\nProgram exited with code: 0\n");
+    SystemIO::flushFiles();
+    SystemIO::flushOutput();
     ProcessorHandler::getProcessorNonConst()->finalize(
         RipesProcessor::FinalizeReason::exitSyscall);
   }
@@ -33,6 +36,8 @@ public:
     SystemIO::printString(
         "\nProgram exited with code: " +
         QString::number(BaseSyscall::getArg(BaseSyscall::REG_FILE, 0)) + "\n");
+    SystemIO::flushFiles();
+    SystemIO::flushOutput();
     ProcessorHandler::getProcessorNonConst()->finalize(
         RipesProcessor::FinalizeReason::exitSyscall);
   }
@@ -49,27 +54,81 @@ public:
             "Change the location of the program break, which defines the end "
             "of the process's data segment (i.e., "
             "the program break is the first location after the end of the "
-            "uninitialized data segment).",
-            {{0, "sets the end of the data segment to the specified address"}},
-            {{0, "On success, brk() returns zero.  On error, -1 is returned, "
-                 "and errno is set to ENOMEM"}}) {}
+            "uninitialized data segment). The heap starts at the end of the "
+            "loaded program.",
+            {{0, "the new program break, or 0 to query the current program "
+                 "break"}},
+            {{0, "the new program break on success. On error, the current "
+                 "program break is returned"}}) {}
 
   void execute() {
-    // Nothing to do - at the moment we allow infinite growth of the heap.
-
-    // Retrieves the argument of the brk syscall, the new program break
-    uint64_t newBreak = BaseSyscall::getArg(BaseSyscall::REG_FILE, 0);
-    // Retrieve the current stack pointer from the processor handler
-    uint64_t stackPointer =
-        ProcessorHandler::getProcessor()->getRegister(BaseSyscall::REG_FILE, 2);
-    if (newBreak >= stackPointer) {
-      SystemIO::printString(
-          "Error: Attempted to allocate memory overlapping stack segment\n");
-      BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, -1); // Syscall error code
-      return;
+    const AInt newBreak = BaseSyscall::getArg(BaseSyscall::REG_FILE, 0);
+    if (newBreak != 0 && !ProcessState::setProgramBreak(newBreak))
+      SystemIO::printString("Error: Could not move the program break to 0x" +
+                            QString::number(newBreak, 16) + "\n");
+    BaseSyscall::setRet(BaseSyscall::REG_FILE, 0,
+                        ProcessState::programBreak());
+  }
+};
+
+template <typename BaseSyscall>
+class MmapSyscall : public BaseSyscall {
+  static_assert(std::is_base_of<Syscall, BaseSyscall>::value);
+
+public:
+  MmapSyscall()
+      : BaseSyscall(
+            "mmap",
+            "Map zero-initialized memory into the address space of the "
+            "program. Only anonymous mappings (MAP_ANONYMOUS) are supported.",
+            {{0, "the address of the mapping if MAP_FIXED is set, else "
+                 "ignored"},
+             {1, "the length of the mapping"},
+             {2, "memory protection (ignored)"},
+             {3, "flags"},
+             {4, "file descriptor (ignored)"},
+             {5, "file offset (ignored)"}},
+            {{0, "the address of the mapping on success. On error, -errno is "
+                 "returned"}}) {}
+
+  void execute() {
+    constexpr VInt MapFixed = 0x10;
+    constexpr VInt MapAnonymous = 0x20;
+    const AInt address = BaseSyscall::getArg(BaseSyscall::REG_FILE, 0);
+    const AInt length = BaseSyscall::getArg(BaseSyscall::REG_FILE, 1);
+    const VInt flags = BaseSyscall::getArg(BaseSyscall::REG_FILE, 3);
+
+    VInt ret;
+    if (!(flags & MapAnonymous)) {
+      ret = -ProcessState::NoDevice;
+    } else if (length == 0) {
+      ret = -ProcessState::InvalidArgument;
+    } else {
+      const auto mapped = ProcessState::map(address, length, flags & MapFixed);
+      ret = mapped ? *mapped : -ProcessState::NoMemory;
     }
+    BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, ret);
+  }
+};
 
-    BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, 0);
+template <typename BaseSyscall>
+class MunmapSyscall : public BaseSyscall {
+  static_assert(std::is_base_of<Syscall, BaseSyscall>::value);
+
+public:
+  MunmapSyscall()
+      : BaseSyscall("munmap",
+                    "Unmap the pages of a memory range mapped by mmap.",
+                    {{0, "the (page-aligned) start address of the range"},
+                     {1, "the length of the range"}},
+                    {{0, "0 on success. On error, -errno is returned"}}) {}
+
+  void execute() {
+    const AInt address = BaseSyscall::getArg(BaseSyscall::REG_FILE, 0);
+    const AInt length = BaseSyscall::getArg(BaseSyscall::REG_FILE, 1);
+    const bool ok = ProcessState::unmap(address, length);
+    BaseSyscall::setRet(BaseSyscall::REG_FILE, 0,
+                        ok ? 0 : -ProcessState::InvalidArgument);
   }
 };
 
@@ -3,9 +3,12 @@
 #include <type_traits>
 
 #include "processorhandler.h"
+#include "processstate.h"
 #include "ripes_syscall.h"
 #include "systemio.h"
 
+#include <QDateTime>
+
 namespace Ripes {
 
 template <typename BaseSyscall>
@@ -22,18 +25,9 @@ public:
   void execute() {
     const AInt arg0 = BaseSyscall::getArg(BaseSyscall::REG_FILE, 0);
     const AInt arg1 = BaseSyscall::getArg(BaseSyscall::REG_FILE, 1);
-    QByteArray string;
-    char byte;
-    unsigned int address = arg0;
-    do {
-      byte = static_cast<char>(
-          ProcessorHandler::getMemory().readMemConst(address++, 1) & 0xFF);
-      string.append(byte);
-    } while (byte != '\0');
-    if (string.endsWith('\0'))
-      string.removeLast(); // Remove null-byte
-
-    int ret = SystemIO::openFile(QString::fromUtf8(string), arg1);
+    const std::string path = ProcessorHandler::getMemory().readCString(arg0);
+
+    int ret = SystemIO::openFile(QString::fromStdString(path), arg1);
 
     BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, ret);
   }
@@ -95,15 +89,9 @@ public:
     int retLength = SystemIO::readFromFile(fd, buffer, length);
     BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, retLength);
 
-    if (retLength != -1) {
+    if (retLength > 0) {
       // copy bytes from returned buffer into memory
-      const char *dataptr =
-          buffer.constData(); // QString::data contains a possible null
-                              // termination '\0' character (present if reading
-                              // from stdin and not from a file)
-      while (retLength-- > 0) {
-        ProcessorHandler::writeMem(byteAddress++, *dataptr++, sizeof(char));
-      }
+      ProcessorHandler::writeBlock(byteAddress, buffer.constData(), retLength);
     }
   }
 };
@@ -128,17 +116,12 @@ public:
       BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, -1);
       return;
     }
-    int index = 0;
-    QString myBuffer;
-
-    do {
-      myBuffer.append(static_cast<char>(
-          ProcessorHandler::getMemory().readMemConst(byteAddress + index++, 1) &
-          0xFF));
-    } while (index < reqLength);
+    QByteArray myBuffer(reqLength, Qt::Uninitialized);
+    ProcessorHandler::getMemory().readBlock(
+        byteAddress, reinterpret_cast<uint8_t *>(myBuffer.data()), reqLength);
 
     const int retValue = SystemIO::writeToFile(
-        BaseSyscall::getArg(BaseSyscall::REG_FILE, 0), myBuffer, reqLength);
+        BaseSyscall::getArg(BaseSyscall::REG_FILE, 0), myBuffer);
     BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, retValue);
   }
 };
@@ -154,16 +137,17 @@ public:
             "Writes the path of the current working directory into a buffer",
             {{0, "address of the buffer to write into"},
              {1, "the length of the buffer"}},
-            {{0, "-1 if the path is longer than the buffer"}}) {}
+            {{0, "the length of the path, or -1 if the path and its null "
+                 "terminator do not fit in the buffer"}}) {}
   void execute() {
     const long byteAddress = BaseSyscall::getArg(
         BaseSyscall::REG_FILE, 0); // destination of characters read from file
-    int index = 0;
     const int bufferSize = BaseSyscall::getArg(BaseSyscall::REG_FILE, 1);
 
     const QString pwd = QDir::currentPath();
 
-    if (pwd.length() > bufferSize) {
+    // The path is written with its null terminator.
+    if (pwd.length() + 1 > bufferSize) {
       BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, -1);
       return;
     } else {
@@ -171,10 +155,9 @@ public:
     }
 
     // copy bytes from returned buffer into memory
-    while (index < pwd.length()) {
-      ProcessorHandler::writeMem(byteAddress, pwd.at(index++).toLatin1(),
-                                 sizeof(char));
-    }
+    const QByteArray path = pwd.toLatin1();
+    ProcessorHandler::writeBlock(byteAddress, path.constData(),
+                                 path.size() + 1);
   }
 };
 
@@ -187,14 +170,49 @@ public:
       : BaseSyscall(
             "FStat",
             "fstat is a system call that is used to determine information "
-            "about a file based on its file descriptor.",
+            "about a file based on its file descriptor. The standard streams "
+            "are reported as character devices.",
             {{0, " the file descriptor "}, {1, " pointer to a struct stat "}},
-            {{0, "returns -1 if an error occurred"}}) {}
+            {{0, "0 on success. On error, -errno is returned"}}) {}
   void execute() {
-    /// @todo: Figure out whether we want to handle fstat. For now, most
-    /// syscall's seems to execute fine with just null-values in the fstat
-    /// return struct - this is ofcourse not a valid mode of execution, but for
-    /// the current state of development, it'll have to do.
+    // File types and permissions (st_mode)
+    constexpr uint32_t CharDevice = 0020000;
+    constexpr uint32_t RegularFile = 0100000;
+    constexpr uint32_t BlockSize = 4096;
+
+    const int fd = BaseSyscall::getArg(BaseSyscall::REG_FILE, 0);
+    const AInt statAddress = BaseSyscall::getArg(BaseSyscall::REG_FILE, 1);
+
+    // struct stat of the RISC-V Linux ABI (asm-generic), as used by newlib
+    // and glibc on both RV32 and RV64.
+    char stat[128] = {};
+    auto put = [&](unsigned offset, int64_t value, unsigned size) {
+      for (unsigned i = 0; i < size; ++i)
+        stat[offset + i] = static_cast<char>(value >> (8 * i));
+    };
+    auto putTime = [&](unsigned offset, const QDateTime &time) {
+      const qint64 ms = time.isValid() ? time.toMSecsSinceEpoch() : 0;
+      put(offset, ms / 1000, 8);
+      put(offset + 8, ms % 1000 * 1000000, 8);
+    };
+
+    put(20, 1, 4); // st_nlink
+    put(56, BlockSize, 4);
+    if (fd >= 0 && fd < SystemIO::STDIO_END) {
+      put(16, CharDevice | 0620, 4);
+    } else if (const auto info = SystemIO::fileInfo(fd)) {
+      put(16, RegularFile | 0644, 4);
+      put(48, info->size(), 8);
+      put(64, (info->size() + 511) / 512, 8); // 512-byte blocks
+      putTime(72, info->lastRead());
+      putTime(88, info->lastModified());
+      putTime(104, info->metadataChangeTime());
+    } else {
+      BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, -ProcessState::BadFile);
+      return;
+    }
+
+    ProcessorHandler::writeBlock(statAddress, stat, sizeof(stat));
     BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, 0);
   }
 };
@@ -0,0 +1,158 @@
+#include "processstate.h"
+
+#include "processorhandler.h"
+
+#include <QDateTime>
+
+#include <algorithm>
+#include <limits>
+
+namespace Ripes {
+
+void ProcessState::attach() {
+  if (s_attached)
+    return;
+  s_attached = true;
+
+  // Reset in lockstep with the processor, such that a restarted program never
+  // observes the state of a previous run (direct connection).
+  auto *handler = ProcessorHandler::get();
+  QObject::connect(
+      handler, &ProcessorHandler::processorReset, handler, [] { reset(); },
+      Qt::DirectConnection);
+}
+
+void ProcessState::reset() {
+  s_heapStart.reset();
+  s_break = 0;
+  s_mapTop.reset();
+  s_mappings.clear();
+  s_realtimeBase.reset();
+}
+
+AInt ProcessState::stackPointer() {
+  const auto sp = ProcessorHandler::currentISA()->spReg();
+  if (!sp)
+    return std::numeric_limits<AInt>::max();
+  return ProcessorHandler::getRegisterValue(sp->file->regFileName(),
+                                            sp->index);
+}
+
+AInt ProcessState::programBreak() {
+  attach();
+  if (!s_heapStart) {
+    AInt end = 0;
+    if (const auto program = ProcessorHandler::getProgram()) {
+      for (const auto &segment : program->segments)
+        end = std::max(end, segment.address + segment.memSize);
+      if (program->segments.empty()) {
+        for (const auto &[name, section] : program->sections)
+          end = std::max<AInt>(end, section.address + section.data.size());
+      }
+    }
+    s_heapStart = pageAlign(end);
+    s_break = *s_heapStart;
+  }
+  return s_break;
+}
+
+bool ProcessState::setProgramBreak(AInt address) {
+  const AInt current = programBreak();
+  if (address < *s_heapStart || address >= stackPointer())
+    return false;
+  if (!s_mappings.empty() && address > s_mappings.begin()->first)
+    return false;
+
+  if (address > current)
+    ProcessorHandler::getMemory().clearBlock(current, address - current);
+  s_break = address;
+  return true;
+}
+
+std::optional<AInt> ProcessState::map(AInt address, AInt length, bool fixed) {
+  attach();
+  length = pageAlign(length);
+  if (length == 0)
+    return {};
+
+  if (fixed) {
+    if (address & (s_pageSize - 1))
+      return {};
+    unmap(address, length);
+  } else {
+    if (!s_mapTop) {
+      const AInt sp = stackPointer() & ~(s_pageSize - 1);
+      s_mapTop = sp > s_stackReserve ? sp - s_stackReserve : 0;
+    }
+    // First fit, top-down: find the highest gap below the top of the mapping
+    // area which fits the mapping.
+    AInt end = *s_mapTop;
+    for (auto it = s_mappings.rbegin(); it != s_mappings.rend(); ++it) {
+      const AInt regionEnd = it->first + it->second;
+      if (regionEnd <= end && end - regionEnd >= length)
+        break;
+      end = std::min(end, it->first);
+    }
+    if (end < length || end - length < programBreak())
+      return {};
+    address = end - length;
+  }
+
+  s_mappings[address] = length;
+  ProcessorHandler::getMemory().clearBlock(address, length);
+  return address;
+}
+
+bool ProcessState::unmap(AInt address, AInt length) {
+  attach();
+  if (address & (s_pageSize - 1))
+    return false;
+  length = pageAlign(length);
+  const AInt end = address + length;
+
+  for (auto it = s_mappings.begin(); it != s_mappings.end();) {
+    const AInt start = it->first;
+    const AInt regionEnd = start + it->second;
+    if (regionEnd <= address || start >= end) {
+      ++it;
+      continue;
+    }
+    // Keep the parts of the region outside of the unmapped range.
+    it = s_mappings.erase(it);
+    if (start < address)
+      s_mappings[start] = address - start;
+    if (regionEnd > end)
+      s_mappings[end] = regionEnd - end;
+  }
+  ProcessorHandler::getMemory().clearBlock(address, length);
+  return true;
+}
+
+ProcessState::Snapshot ProcessState::snapshot() {
+  return {s_heapStart, s_break, s_mapTop, s_mappings};
+}
+
+void ProcessState::restore(const Snapshot &snapshot) {
+  attach();
+  s_heapStart = snapshot.heapStart;
+  s_break = snapshot.programBreak;
+  s_mapTop = snapshot.mapTop;
+  s_mappings = snapshot.mappings;
+}
+
+uint64_t ProcessState::monotonicNs() {
+  const uint64_t cycles = ProcessorHandler::getProcessor()->getCycleCount();
+  constexpr uint64_t nsPerSecond = 1000000000;
+  return cycles / s_clockHz * nsPerSecond +
+         cycles % s_clockHz * nsPerSecond / s_clockHz;
+}
+
+int64_t ProcessState::realtimeNs() {
+  attach();
+  const int64_t monotonic = monotonicNs();
+  if (!s_realtimeBase)
+    s_realtimeBase = QDateTime::currentMSecsSinceEpoch() * 1000000 - monotonic;
+  return *s_realtimeBase + monotonic;
+}
+
+} // namespace Ripes
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+#include "isa/isa_types.h"
+
+namespace Ripes {
+
+/**
+ * @brief The ProcessState class
+ * Process state of the simulated program which is managed by Linux-style
+ * system calls: the program break (brk), anonymous memory mappings (mmap,
+ * munmap) and the clocks (clock_gettime, gettimeofday).
+ *
+ * The heap starts at the page-aligned end of the loaded program, and grows
+ * upwards. Mappings are allocated top-down, starting 8 MiB (the default Linux
+ * stack limit) below the stack pointer at the time of the first mmap call.
+ * Memory is zeroed when handed to the program.
+ *
+ * Time elapses with the simulated cycle count at a nominal clock frequency of
+ * 1 GHz, such that time measurements of the program are deterministic and
+ * comparable across processor models. The realtime clock is offset by the host
+ * time at which the program first queries a clock.
+ *
+ * State is reset along with the processor.
+ */
+class ProcessState {
+public:
+  static constexpr AInt s_pageSize = 4096;
+  static constexpr uint64_t s_clockHz = 1000000000;
+  static constexpr AInt s_stackReserve = 8 * 1024 * 1024;
+
+  /// Linux error numbers, returned negated by the system calls.
+  enum Errno : int {
+    BadFile = 9,
+    NoMemory = 12,
+    BadAddress = 14,
+    NoDevice = 19,
+    InvalidArgument = 22
+  };
+
+  /// Returns the current program break.
+  static AInt programBreak();
+  /// Moves the program break to @p address. Returns false if the heap would
+  /// shrink below its start, or overlap a mapping or the stack.
+  static bool setProgramBreak(AInt address);
+
+  /// Maps @p length bytes of zeroed memory. If @p fixed, the memory is mapped
+  /// at @p address, replacing any existing mapping. Returns the address of the
+  /// mapping, or std::nullopt if no space is available.
+  static std::optional<AInt> map(AInt address, AInt length, bool fixed);
+  /// Unmaps the pages within [address; address + length[. Returns false if
+  /// @p address is not page-aligned.
+  static bool unmap(AInt address, AInt length);
+
+  /// Memory management state of the process, as stored in checkpoints.
+  struct Snapshot {
+    std::optional<AInt> heapStart;
+    AInt programBreak = 0;
+    std::optional<AInt> mapTop;
+    std::map<AInt, AInt> mappings;
+  };
+  /// Returns the current memory management state.
+  static Snapshot snapshot();
+  /// Replaces the memory management state with @p snapshot. Memory contents
+  /// are not affected.
+  static void restore(const Snapshot &snapshot);
+
+  /// Simulated time since the processor was reset, in nanoseconds.
+  static uint64_t monotonicNs();
+  /// Simulated wall-clock time, in nanoseconds since the epoch.
+  static int64_t realtimeNs();
+
+private:
+  static void attach();
+  static void reset();
+  static AInt stackPointer();
+  static AInt pageAlign(AInt value) {
+    return (value + s_pageSize - 1) & ~(s_pageSize - 1);
+  }
+
+  static inline bool s_attached = false;
+  // Start and current end of the heap; determined upon first use.
+  static inline std::optional<AInt> s_heapStart;
+  static inline AInt s_break = 0;
+  // Top of the mapping area; determined upon first use.
+  static inline std::optional<AInt> s_mapTop;
+  // Mapped regions, as {start address: length}.
+  static inline std::map<AInt, AInt> s_mappings;
+  // Host time (in ns since the epoch) corresponding to a cycle count of 0.
+  static inline std::optional<int64_t> s_realtimeBase;
+};
+
+} // namespace Ripes
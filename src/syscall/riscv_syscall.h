@@ -8,6 +8,7 @@
 #include "control.h"
 #include "file.h"
 #include "print.h"
+#include "roi.h"
 #include "syscall_time.h"
 
 namespace Ripes {
@@ -55,7 +56,10 @@ public:
     // Control syscalls
     emplace<ExitSyscall<RISCVSyscall>>(RVABI::Exit);
     emplace<Exit2Syscall<RISCVSyscall>>(RVABI::Exit2);
+    emplace<Exit2Syscall<RISCVSyscall>>(RVABI::ExitGroup);
     emplace<BrkSyscall<RISCVSyscall>>(RVABI::brk);
+    emplace<MmapSyscall<RISCVSyscall>>(RVABI::mmap);
+    emplace<MunmapSyscall<RISCVSyscall>>(RVABI::munmap);
 
     // File syscalls
     emplace<CloseSyscall<RISCVSyscall>>(RVABI::Close);
@@ -69,6 +73,14 @@ public:
     // Time syscalls
     emplace<CyclesSyscall<RISCVSyscall>>(RVABI::Cycles);
     emplace<TimeMsSyscall<RISCVSyscall>>(RVABI::TimeMs);
+    emplace<ClockGetTimeSyscall<RISCVSyscall>>(RVABI::ClockGetTime);
+    emplace<ClockGetTimeSyscall<RISCVSyscall>>(RVABI::ClockGetTime64);
+    emplace<GetTimeOfDaySyscall<RISCVSyscall>>(RVABI::GetTimeOfDay);
+
+    // Measurement syscalls
+    emplace<ROIBeginSyscall<RISCVSyscall>>(RVABI::ROIBegin);
+    emplace<ROIEndSyscall<RISCVSyscall>>(RVABI::ROIEnd);
+    emplace<ROISnapshotSyscall<RISCVSyscall>>(RVABI::ROISnapshot);
   }
 };
 
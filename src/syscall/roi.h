@@ -0,0 +1,48 @@
+#pragma once
+
+#include <type_traits>
+
+#include "regionofinterest.h"
+#include "ripes_syscall.h"
+
+namespace Ripes {
+
+template <typename BaseSyscall>
+class ROIBeginSyscall : public BaseSyscall {
+  static_assert(std::is_base_of<Syscall, BaseSyscall>::value);
+
+public:
+  ROIBeginSyscall()
+      : BaseSyscall("ROI_begin",
+                    "Marks the beginning of a region of interest. Statistics "
+                    "are accumulated over all regions of interest.") {}
+  void execute() { RegionOfInterest::begin(); }
+};
+
+template <typename BaseSyscall>
+class ROIEndSyscall : public BaseSyscall {
+  static_assert(std::is_base_of<Syscall, BaseSyscall>::value);
+
+public:
+  ROIEndSyscall()
+      : BaseSyscall("ROI_end", "Marks the end of a region of interest.") {}
+  void execute() { RegionOfInterest::end(); }
+};
+
+template <typename BaseSyscall>
+class ROISnapshotSyscall : public BaseSyscall {
+  static_assert(std::is_base_of<Syscall, BaseSyscall>::value);
+
+public:
+  ROISnapshotSyscall()
+      : BaseSyscall("ROI_snapshot",
+                    "Records a snapshot of the statistics accumulated over the "
+                    "regions of interest so far.",
+                    {{0, "snapshot identifier"}}) {}
+  void execute() {
+    RegionOfInterest::snapshot(
+        static_cast<long long>(BaseSyscall::getArg(BaseSyscall::REG_FILE, 0)));
+  }
+};
+
+} // namespace Ripes
@@ -3,12 +3,25 @@
 #include <type_traits>
 
 #include "processorhandler.h"
+#include "processstate.h"
 #include "ripes_syscall.h"
 #include "systemio.h"
 
 #include <QDateTime>
 
 namespace Ripes {
+
+/// Writes a pair of 64-bit little-endian integers to @p address; the layout of
+/// struct timespec and struct timeval in the RISC-V Linux ABI.
+inline void writeTimePair(AInt address, int64_t seconds, int64_t fraction) {
+  char data[16];
+  for (unsigned i = 0; i < 8; ++i) {
+    data[i] = static_cast<char>(seconds >> (8 * i));
+    data[8 + i] = static_cast<char>(fraction >> (8 * i));
+  }
+  ProcessorHandler::writeBlock(address, data, sizeof(data));
+}
+
 template <typename BaseSyscall>
 class CyclesSyscall : public BaseSyscall {
   static_assert(std::is_base_of<Syscall, BaseSyscall>::value);
@@ -46,4 +59,64 @@ public:
   }
 };
 
+template <typename BaseSyscall>
+class ClockGetTimeSyscall : public BaseSyscall {
+  static_assert(std::is_base_of<Syscall, BaseSyscall>::value);
+
+public:
+  ClockGetTimeSyscall()
+      : BaseSyscall("clock_gettime",
+                    "Get the time of a clock. Time elapses with the simulated "
+                    "cycle count, at a nominal frequency of 1 GHz.",
+                    {{0, "the clock; CLOCK_REALTIME (0) is the time since "
+                         "epoch, all other clocks the time since program "
+                         "start"},
+                     {1, "pointer to a struct timespec"}},
+                    {{0, "0 on success. On error, -errno is returned"}}) {}
+  void execute() {
+    // Highest clock ID of Linux (CLOCK_TAI)
+    constexpr VInt MaxClock = 11;
+    const VInt clock = BaseSyscall::getArg(BaseSyscall::REG_FILE, 0);
+    const AInt tp = BaseSyscall::getArg(BaseSyscall::REG_FILE, 1);
+    if (clock > MaxClock) {
+      BaseSyscall::setRet(BaseSyscall::REG_FILE, 0,
+                          -ProcessState::InvalidArgument);
+      return;
+    }
+    if (tp == 0) {
+      BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, -ProcessState::BadAddress);
+      return;
+    }
+    const int64_t ns = clock == 0 ? ProcessState::realtimeNs()
+                                  : ProcessState::monotonicNs();
+    writeTimePair(tp, ns / 1000000000, ns % 1000000000);
+    BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, 0);
+  }
+};
+
+template <typename BaseSyscall>
+class GetTimeOfDaySyscall : public BaseSyscall {
+  static_assert(std::is_base_of<Syscall, BaseSyscall>::value);
+
+public:
+  GetTimeOfDaySyscall()
+      : BaseSyscall("gettimeofday",
+                    "Get the time since epoch. Time elapses with the simulated "
+                    "cycle count, at a nominal frequency of 1 GHz.",
+                    {{0, "pointer to a struct timeval, or 0"},
+                     {1, "pointer to a struct timezone, or 0"}},
+                    {{0, "0"}}) {}
+  void execute() {
+    const int64_t ns = ProcessState::realtimeNs();
+    if (const AInt tv = BaseSyscall::getArg(BaseSyscall::REG_FILE, 0))
+      writeTimePair(tv, ns / 1000000000, ns % 1000000000 / 1000);
+    // The simulated time zone is UTC, without daylight saving time.
+    if (const AInt tz = BaseSyscall::getArg(BaseSyscall::REG_FILE, 1)) {
+      const char zero[8] = {};
+      ProcessorHandler::writeBlock(tz, zero, sizeof(zero));
+    }
+    BaseSyscall::setRet(BaseSyscall::REG_FILE, 0, 0);
+  }
+};
+
 } // namespace Ripes
@@ -3,12 +3,17 @@
 namespace Ripes {
 QString SystemIO::s_fileErrorString;
 
-std::map<int, QString> SystemIO::FileIOData::fileNames;
-std::map<int, unsigned> SystemIO::FileIOData::fileFlags;
-std::map<int, QTextStream> SystemIO::FileIOData::streams;
-std::map<int, QFile> SystemIO::FileIOData::files;
+std::vector<std::unique_ptr<SystemIO::FileIOData::OpenFile>>
+    SystemIO::FileIOData::files;
 QByteArray SystemIO::FileIOData::s_stdinBuffer;
+std::unique_ptr<QTextStream> SystemIO::FileIOData::s_stdinStream;
 QMutex SystemIO::FileIOData::s_stdioMutex;
 QWaitCondition SystemIO::FileIOData::s_stdinBufferEmpty;
 bool SystemIO::s_abortSyscall = false;
+bool SystemIO::s_cliInput = false;
+QMutex SystemIO::s_outputMutex;
+QRecursiveMutex SystemIO::s_deliveryMutex;
+QString SystemIO::s_output;
+int SystemIO::s_outputLines = 0;
+bool SystemIO::s_outputFlushScheduled = false;
 } // namespace Ripes
@@ -3,15 +3,25 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QInputDialog>
 #include <QMutex>
+#include <QRecursiveMutex>
 #include <QObject>
 #include <QTemporaryFile>
 #include <QTextStream>
+#include <QThread>
+#include <QTimer>
 #include <QWaitCondition>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <optional>
 #include <set>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 #include <sys/stat.h>
 
 #include "STLExtras.h"
@@ -62,6 +72,9 @@ public:
     return sio;
   }
 
+  // Standard I/O Channels
+  enum STDIO { STDIN = 0, STDOUT = 1, STDERR = 2, STDIO_END };
+
 private:
   // String used for description of file error
   static QString s_fileErrorString; // = ("File operation OK");
@@ -69,13 +82,67 @@ private:
   // Flag used for aborting waiting for I/O
   static bool s_abortSyscall;
 
-  // Standard I/O Channels
-  enum STDIO { STDIN = 0, STDOUT = 1, STDERR = 2, STDIO_END };
+  // Set when stdin is read from the standard input of the CLI
+  static bool s_cliInput;
+
+  /**
+   * Requests a line of input from the user through a modal dialog, and pushes
+   * it onto the stdin buffer. The input is echoed to the program output.
+   *
+   * @return false if the dialog was cancelled
+   */
+  static bool requestInput() {
+    bool ok = false;
+    const QString text =
+        QInputDialog::getText(nullptr, "Program input", "Input to stdin:",
+                              QLineEdit::Normal, QString(), &ok);
+    if (!ok)
+      return false;
+    printString(text + '\n');
+    flushOutput();
+    get().putStdInData((text + '\n').toUtf8());
+    return true;
+  }
 
-  // Buffer size for syscalls for file I/O
-  static constexpr int SYSCALL_BUFSIZE = 128;
-  // Maximum number of files that can be open
-  static constexpr int SYSCALL_MAXFILES = 32;
+  // Thresholds at which buffered output is delivered: number of lines,
+  // number of characters, and milliseconds since the output was buffered
+  static constexpr int OUTPUT_FLUSH_LINES = 64;
+  static constexpr int OUTPUT_FLUSH_SIZE = 16 * 1024;
+  static constexpr int OUTPUT_FLUSH_INTERVAL = 50;
+
+  // Output not yet delivered through doPrint
+  static QMutex s_outputMutex;
+  static QString s_output;
+  static int s_outputLines;
+  static bool s_outputFlushScheduled;
+
+  // Held while output is taken out of the buffer and delivered, such that
+  // output is delivered in the order in which it was printed. Recursive, such
+  // that receivers of doPrint may print or flush.
+  static QRecursiveMutex s_deliveryMutex;
+
+  // Takes the buffered output out of the buffer. s_outputMutex must be held.
+  static QString takeOutput() {
+    s_outputLines = 0;
+    return std::exchange(s_output, QString());
+  }
+
+  // Delivers the buffered output through doPrint. s_outputMutex is released
+  // before emitting, such that other threads may keep printing.
+  static void deliverOutput() {
+    QMutexLocker delivery(&s_deliveryMutex);
+    QMutexLocker locker(&s_outputMutex);
+    const QString output = takeOutput();
+    locker.unlock();
+    if (!output.isEmpty())
+      emit get().doPrint(output);
+  }
+
+  // Size of the user-space buffers of files opened by the program
+  static constexpr int SYSCALL_BUFSIZE = 64 * 1024;
+  // Maximum number of files that can be open. Buffers are only held while
+  // they contain data, so idle files do not hold any buffer memory.
+  static constexpr int SYSCALL_MAXFILES = 1024;
 
   /// Flags used in the open syscall
   enum Flags : unsigned {
@@ -90,20 +157,133 @@ private:
   };
 
   // //////////////////////////////////////////////////////////////////////////////
-  // Maintain information on files in use. The index to the arrays is the "file
-  // descriptor."
+  // Maintain information on files in use. The index to the file table is the
+  // "file descriptor."
 
   struct FileIOData {
-    // The filenames in use. Null if file descriptor i is not in use.
-    static std::map<int, QString> fileNames;
-    // The flags of this file. Invalid if this file descriptor is not in use.
-    static std::map<int, unsigned> fileFlags;
-    // The streams in use, associated with the filenames
-    static std::map<int, QTextStream> streams;
-    // The file pointers in use
-    static std::map<int, QFile> files;
+    /**
+     * @brief The OpenFile struct
+     * A file opened by the program. The file is accessed through an unbuffered
+     * QFile, with explicit buffering in user space: reads are served from a
+     * read-ahead buffer of SYSCALL_BUFSIZE bytes, and writes are collected
+     * until the buffer is full, or the file is read, seeked or closed. Data is
+     * transferred as raw bytes. The buffers are released once they have been
+     * consumed or flushed.
+     */
+    struct OpenFile {
+      OpenFile(const QString &name, unsigned flags)
+          : name(name), flags(flags), file(name) {}
+      ~OpenFile() { flush(); }
+
+      /// Writes any buffered bytes to the file. Returns false on error.
+      bool flush() {
+        if (writeBuffer.isEmpty())
+          return true;
+        const bool success = file.write(writeBuffer) == writeBuffer.size();
+        writeBuffer.clear();
+        return success;
+      }
+
+      /// Reads up to @p size bytes into @p data. Returns the number of bytes
+      /// read, 0 on EOF, or -1 on error.
+      qint64 read(char *data, qint64 size) {
+        if (!flush())
+          return -1;
+        const qint64 buffered =
+            std::min<qint64>(size, readBuffer.size() - readPos);
+        std::memcpy(data, readBuffer.constData() + readPos, buffered);
+        readPos += buffered;
+        if (buffered == size) {
+          releaseConsumedReadBuffer();
+          return size;
+        }
+
+        readBuffer.clear();
+        readPos = 0;
+        const qint64 remaining = size - buffered;
+        if (remaining >= SYSCALL_BUFSIZE) {
+          // Large reads bypass the buffer.
+          const qint64 n = file.read(data + buffered, remaining);
+          return n < 0 ? (buffered > 0 ? buffered : -1) : buffered + n;
+        }
+        readBuffer.resize(SYSCALL_BUFSIZE);
+        const qint64 n = file.read(readBuffer.data(), SYSCALL_BUFSIZE);
+        readBuffer.resize(std::max<qint64>(n, 0));
+        // Read-ahead of a short file only holds the bytes read.
+        readBuffer.squeeze();
+        if (n < 0 && buffered == 0)
+          return -1;
+        readPos = std::min<qint64>(remaining, readBuffer.size());
+        std::memcpy(data + buffered, readBuffer.constData(), readPos);
+        const qint64 total = buffered + readPos;
+        releaseConsumedReadBuffer();
+        return total;
+      }
+
+      /// Writes @p size bytes from @p data. Returns the number of bytes
+      /// written, or -1 on error.
+      qint64 write(const char *data, qint64 size) {
+        discardReadBuffer();
+        if (writeBuffer.size() + size > SYSCALL_BUFSIZE) {
+          if (!flush())
+            return -1;
+          // Large writes bypass the buffer.
+          if (size >= SYSCALL_BUFSIZE)
+            return file.write(data, size);
+        }
+        writeBuffer.append(data, size);
+        return size;
+      }
+
+      bool seek(qint64 position) {
+        readBuffer.clear();
+        readPos = 0;
+        return flush() && file.seek(position);
+      }
+
+      /// Position within the file, as seen by the program.
+      qint64 pos() const {
+        return file.pos() + writeBuffer.size() - (readBuffer.size() - readPos);
+      }
+
+      qint64 size() {
+        flush();
+        return file.size();
+      }
+
+      QString name;
+      unsigned flags;
+      QFile file;
+
+    private:
+      void releaseConsumedReadBuffer() {
+        if (readPos < readBuffer.size())
+          return;
+        readBuffer.clear();
+        readPos = 0;
+      }
+
+      /// Moves the file position back to the first byte not yet read by the
+      /// program, and discards the read-ahead bytes.
+      void discardReadBuffer() {
+        if (readPos < readBuffer.size())
+          file.seek(file.pos() - (readBuffer.size() - readPos));
+        readBuffer.clear();
+        readPos = 0;
+      }
+
+      QByteArray readBuffer;
+      qsizetype readPos = 0;
+      QByteArray writeBuffer;
+    };
+
+    // The files in use. Null if file descriptor i is not in use. The standard
+    // I/O channels are entries without an open file.
+    static std::vector<std::unique_ptr<OpenFile>> files;
     // QByteArray to use as a stdin buffer
     static QByteArray s_stdinBuffer;
+    // The stream which stdin is read from
+    static std::unique_ptr<QTextStream> s_stdinStream;
 
     /**
      * @brief s_stdioMutex
@@ -114,48 +294,47 @@ private:
     static QMutex s_stdioMutex;
     static QWaitCondition s_stdinBufferEmpty;
 
-    // Reset all file information. Closes any open files and resets the arrays
+    // Reset all file information. Closes any open files and resets the file
+    // table
     static void resetFiles() {
-      for (int i = 0; i < SYSCALL_MAXFILES; ++i) {
-        close(i);
-      }
+      files.clear();
       setupStdio();
     }
 
     static void setupStdio() {
-      fileNames[STDIN] = "STDIN";
-      fileNames[STDOUT] = "STDOUT";
-      fileNames[STDERR] = "STDERR";
-      fileFlags[STDIN] = SystemIO::O_RDONLY;
-      fileFlags[STDOUT] = SystemIO::O_WRONLY;
-      fileFlags[STDERR] = SystemIO::O_WRONLY;
-
-      if (streams.count(STDIN) == 0) {
+      files.resize(STDIO_END);
+      files[STDIN] = std::make_unique<OpenFile>("STDIN", SystemIO::O_RDONLY);
+      files[STDOUT] = std::make_unique<OpenFile>("STDOUT", SystemIO::O_WRONLY);
+      files[STDERR] = std::make_unique<OpenFile>("STDERR", SystemIO::O_WRONLY);
+
+      if (!s_stdinStream) {
         // stdin stream has not yet been created
-        streams.emplace(STDIN, &s_stdinBuffer);
-      } else {
-        // Clear stdin stream and reset stream
+        s_stdinStream = std::make_unique<QTextStream>(&s_stdinBuffer);
+      } else if (!s_cliInput) {
+        // Clear stdin stream and reset stream. The standard input of the CLI
+        // cannot be rewound.
         s_stdinBuffer.clear();
-        auto success = streams[STDIN].seek(0);
+        auto success = s_stdinStream->seek(0);
         Q_ASSERT(success);
       }
 
       // stdout/stderr will be handled via. signal/slots internally in the
-      // application streams.emplace(STDOUT, stdout); streams.emplace(STDERR,
-      // stderr);
+      // application
     }
 
-    // Open a file stream assigned to the given file descriptor
-    static void openFilestream(int fd, const QString &filename) {
+    // Open the file assigned to the given file descriptor
+    static void openFilestream(int fd) {
       // Ensure flags are valid
-      const auto flags = fileFlags[fd];
+      const auto flags = files[fd]->flags;
       if ((flags & O_ACCMODE) == O_ACCMODE) {
         throw std::runtime_error(
             "Tried to open file with incompatible read/write mode flags");
       }
 
-      // Translate from stdlib file flags to Qt flags
+      // Translate from stdlib file flags to Qt flags. Buffering is performed
+      // by OpenFile.
       auto qtOpenFlags =
+          QIODevice::Unbuffered |
           ((flags & O_RDONLY) == O_RDONLY ? QIODevice::ReadOnly
                                           : QIODevice::NotOpen) |
           (flags & O_WRONLY ? QIODevice::WriteOnly : QIODevice::NotOpen) |
@@ -165,8 +344,7 @@ private:
           (flags & O_APPEND ? QIODevice::Append : QIODevice::NotOpen);
 
       // Try to open file with the given flags
-      files.emplace(fd, filename);
-      auto &file = files[fd];
+      auto &file = files[fd]->file;
       file.open(qtOpenFlags);
 
       if (!file.exists() && !(flags & O_CREAT)) {
@@ -180,45 +358,40 @@ private:
       if (!file.isOpen()) {
         throw std::runtime_error("File could not be opened");
       }
-
-      streams.emplace(fd, &files[fd]);
     }
 
-    // Retrieve a stream for use
-    static QTextStream &getStreamInUse(int fd) { return streams[fd]; }
+    // Retrieve an open file, or nullptr if fd is not in use.
+    static OpenFile *getFile(int fd) {
+      if (fd < 0 || fd >= static_cast<int>(files.size()))
+        return nullptr;
+      return files[fd].get();
+    }
 
     // Determine whether a given filename is already in use.
     static bool filenameInUse(const QString &requestedFilename) {
-      return llvm::any_of(fileNames, [&](auto fn) {
-        return !fn.second.isEmpty() && fn.second == requestedFilename;
+      return llvm::any_of(files, [&](const auto &file) {
+        return file && file->name == requestedFilename;
       });
     }
 
     // Determine whether a given fd is already in use with the given flag.
     static bool fdInUse(int fd, unsigned flag) {
-      if (fd < 0 || fd >= SYSCALL_MAXFILES) {
-        return false;
-      } else if (fileNames[fd].isEmpty()) {
+      const auto *file = getFile(fd);
+      if (!file)
         return false;
-      } else if ((flag == O_RDONLY) ? (fileFlags[fd] & O_ACCMODE) == flag
-                                    : (fileFlags[fd] & flag) == flag) {
-        return true;
-      }
-      return false;
+      return (flag == O_RDONLY) ? (file->flags & O_ACCMODE) == flag
+                                : (file->flags & flag) == flag;
     }
 
     // Close the file with file descriptor fd. No errors are recoverable -- if
     // the user's made an error in the call, it will come back to him.
     static void close(int fd) {
       // Can't close STDIN, STDOUT, STDERR, or invalid fd
-      if (fd < STDIO_END || fd >= SYSCALL_MAXFILES)
+      if (fd < STDIO_END || fd >= static_cast<int>(files.size()))
         return;
 
-      fileFlags[fd] = O_ACCMODE; // set flag to invalid read/write mode
-      files[fd].close();
-      streams.erase(fd);
-      files.erase(fd);
-      fileNames.erase(fd);
+      // Buffered data is written upon destruction
+      files[fd].reset();
     }
 
     // Attempt to open a new file with the given flag, using the lowest
@@ -226,16 +399,14 @@ private:
     // reasonable, and there is an available file descriptor. Return: file
     // descriptor in 0...(SYSCALL_MAXFILES-1), or -1 if error
     static int nowOpening(const QString &filename, unsigned flag) {
-      int i = 0;
       if (filenameInUse(filename)) {
         s_fileErrorString = "File name " + filename + " is already open.";
         return -1;
       }
 
-      while (!fileNames[i].isEmpty() && i < SYSCALL_MAXFILES) {
-        i++;
-      } // Attempt to find available file descriptor
-
+      // Attempt to find available file descriptor
+      const int i = std::find(files.begin(), files.end(), nullptr) -
+                    files.begin();
       if (i >= SYSCALL_MAXFILES) // no available file descriptors
       {
         s_fileErrorString = "File name " + filename +
@@ -244,9 +415,10 @@ private:
         return -1;
       }
 
-      // Must be OK -- put filename in table
-      fileNames[i] = filename; // our table has its own copy of filename
-      fileFlags[i] = flag;
+      // Must be OK -- put file in table
+      if (i == static_cast<int>(files.size()))
+        files.emplace_back();
+      files[i] = std::make_unique<OpenFile>(filename, flag);
       s_fileErrorString = "File operation OK";
       return i;
     }
@@ -278,9 +450,9 @@ public:
     } // fileErrorString would have been set
 
     try {
-      FileIOData::openFilestream(fdToUse, filename);
+      FileIOData::openFilestream(fdToUse);
     } catch (const std::runtime_error &error) {
-      FileIOData::files.erase(fdToUse);
+      FileIOData::files[fdToUse].reset();
       s_fileErrorString =
           "File " + filename + " could not be opened: " + error.what();
       retValue = -1;
@@ -289,6 +461,22 @@ public:
     return retValue; // return the "file descriptor"
   }
 
+  /**
+   * Retrieve information on an open file. Buffered writes are flushed first,
+   * such that the reported size is up to date.
+   *
+   * @param fd file descriptor
+   * @return std::nullopt if fd is a standard stream or not in use
+   */
+  static std::optional<QFileInfo> fileInfo(int fd) {
+    SystemIO::get(); // Ensure that SystemIO is constructed
+    auto *file = FileIOData::getFile(fd);
+    if (!file || fd < STDIO_END)
+      return {};
+    file->flush();
+    return QFileInfo(file->file);
+  }
+
   /**
    * Read bytes from file.
    *
@@ -300,32 +488,27 @@ public:
    */
   static int seek(int fd, int offset, int base) {
     SystemIO::get(); // Ensure that SystemIO is constructed
-    if (!(FileIOData::fdInUse(fd, O_RDONLY) ||
-          FileIOData::fdInUse(fd,
-                              O_RDWR))) // Check the existence of the "read" fd
-    {
+    auto *file = FileIOData::getFile(fd);
+    if (!file || fd < STDIO_END) {
       s_fileErrorString =
-          "File descriptor " + QString::number(fd) + " is not open for reading";
+          "File descriptor " + QString::number(fd) + " is not open for seeking";
       return -1;
     }
-    if (fd < 0 || fd >= SYSCALL_MAXFILES)
-      return -1;
-    auto &stream = FileIOData::getStreamInUse(fd);
 
+    qint64 position = offset;
     if (base == SEEK_SET) {
-      offset += 0;
+      position += 0;
     } else if (base == SEEK_CUR) {
-      offset += stream.pos();
+      position += file->pos();
     } else if (base == SEEK_END) {
-      offset += FileIOData::files[fd].size();
+      position += file->size();
     } else {
       return -1;
     }
-    if (offset < 0) {
+    if (position < 0 || !file->seek(position)) {
       return -1;
     }
-    stream.seek(offset);
-    return offset;
+    return position;
   }
 
   /**
@@ -351,10 +534,10 @@ public:
           "File descriptor " + QString::number(fd) + " is not open for reading";
       return -1;
     }
-    // retrieve FileInputStream from storage
-    auto &InputStream = FileIOData::getStreamInUse(fd);
-
     if (fd == STDIN) {
+      auto &InputStream = *FileIOData::s_stdinStream;
+      // Any prompt must be visible while waiting for input.
+      flushOutput();
       // systemIO might be called from non-gui thread, so be threadsafe in
       // interacting with the ui.
       postToGUIThread([=] {
@@ -374,31 +557,55 @@ public:
         auto readData = InputStream.read(1).toUtf8();
         myBuffer.append(readData);
         lengthRequested -= readData.length();
-
-        /** We spin on a wait condition with a timeout. The timeout is required
-         * to ensure that we may observe any abort flags (ie. if execution is
-         * stopped while waiting for IO */
-        FileIOData::s_stdinBufferEmpty.wait(&FileIOData::s_stdioMutex, 100);
-        FileIOData::s_stdioMutex.unlock();
+        if (!readData.isEmpty()) {
+          FileIOData::s_stdioMutex.unlock();
+        } else if (s_cliInput) {
+          // End of the standard input of the CLI
+          FileIOData::s_stdioMutex.unlock();
+          break;
+        } else if (QCoreApplication::instance() &&
+                   QThread::currentThread() ==
+                       QCoreApplication::instance()->thread()) {
+          /** System calls are executed inline by the thread clocking the
+           * processor. If that is the GUI thread, the console cannot deliver
+           * input while we wait, so the input is requested through a modal
+           * dialog. The dialog keeps the user from resetting, reversing or
+           * switching the processor while the system call is in progress. */
+          FileIOData::s_stdioMutex.unlock();
+          if (!requestInput()) {
+            postToGUIThread([=] { SystemIOStatusManager::clearStatus(); });
+            return -1;
+          }
+        } else {
+          /** We spin on a wait condition with a timeout. The timeout is
+           * required to ensure that we may observe any abort flags (ie. if
+           * execution is stopped while waiting for IO */
+          FileIOData::s_stdinBufferEmpty.wait(&FileIOData::s_stdioMutex, 100);
+          FileIOData::s_stdioMutex.unlock();
+        }
         if (myBuffer.endsWith('\n'))
           break;
       }
+      // EOF is only possible for the standard input of the CLI
+      Q_ASSERT(s_cliInput || myBuffer.size() > 0);
+      postToGUIThread([=] { SystemIOStatusManager::clearStatus(); });
     } else {
-      // Reads up to lengthRequested bytes of data from this Input stream into
-      // an array of bytes.
-      myBuffer = InputStream.read(lengthRequested).toUtf8();
-    }
-
-    if (myBuffer.size() == 0) {
-      if (fd == STDIN) {
-        Q_ASSERT(false); // EOF should never be possible for STDIN
-      } else {
-        // End of file - write EOF file character into buffer
-        myBuffer.append(sizeof(int), EOF);
+      // Reads up to lengthRequested bytes of data from the file into an array
+      // of bytes.
+      if (lengthRequested < 0)
+        return -1;
+      myBuffer.resize(lengthRequested);
+      const qint64 n =
+          FileIOData::files[fd]->read(myBuffer.data(), lengthRequested);
+      if (n < 0) {
+        s_fileErrorString = "Could not read from file descriptor " +
+                            QString::number(fd) + ": " +
+                            FileIOData::files[fd]->file.errorString();
+        return -1;
       }
+      myBuffer.resize(n);
     }
 
-    postToGUIThread([=] { SystemIOStatusManager::clearStatus(); });
     return myBuffer.size();
 
   } // end readFromFile
@@ -407,15 +614,14 @@ public:
    * Write bytes to file.
    *
    * @param fd              file descriptor
-   * @param myBuffer        byte array containing characters to write
-   * @param lengthRequested number of bytes to write
+   * @param myBuffer        byte array containing the bytes to write
    * @return number of bytes written, or -1 on error
    */
 
-  static int writeToFile(int fd, const QString &myBuffer, int lengthRequested) {
+  static int writeToFile(int fd, const QByteArray &myBuffer) {
     SystemIO::get(); // Ensure that SystemIO is constructed
     if (fd == STDOUT || fd == STDERR) {
-      emit get().doPrint(myBuffer);
+      printString(QString::fromLatin1(myBuffer));
       return myBuffer.size();
     }
 
@@ -427,12 +633,15 @@ public:
           "File descriptor " + QString::number(fd) + " is not open for writing";
       return -1;
     }
-    // retrieve FileOutputStream from storage
-    auto &outputStream = FileIOData::getStreamInUse(fd);
-
-    outputStream << myBuffer;
-    outputStream.flush();
-    return lengthRequested;
+    const qint64 n =
+        FileIOData::files[fd]->write(myBuffer.constData(), myBuffer.size());
+    if (n < 0) {
+      s_fileErrorString = "Could not write to file descriptor " +
+                          QString::number(fd) + ": " +
+                          FileIOData::files[fd]->file.errorString();
+      return -1;
+    }
+    return n;
 
   } // end writeToFile
 
@@ -442,8 +651,8 @@ public:
    * mapping) and explicitly maps it to the standard input stream (stdin).
    */
   static void setCLIInput() {
-    FileIOData::streams.erase(STDIN);
-    FileIOData::streams.emplace(STDIN, stdin);
+    FileIOData::s_stdinStream = std::make_unique<QTextStream>(stdin);
+    s_cliInput = true;
   }
 
   /**
@@ -453,8 +662,52 @@ public:
    */
   static void closeFile(int fd) { FileIOData::close(fd); }
 
-  static void printString(const QString &string) { emit get().doPrint(string); }
-  static void reset() { FileIOData::resetFiles(); }
+  /// Writes the buffered data of all open files to disk.
+  static void flushFiles() {
+    for (const auto &file : FileIOData::files)
+      if (file)
+        file->flush();
+  }
+
+  /**
+   * Appends @p string to the program output. Output is buffered, and delivered
+   * through doPrint once OUTPUT_FLUSH_LINES lines or OUTPUT_FLUSH_SIZE
+   * characters have been buffered, OUTPUT_FLUSH_INTERVAL ms after being
+   * buffered, or when flushOutput is called (program exit, input requests and
+   * the end of a run).
+   */
+  static void printString(const QString &string) {
+    SystemIO::get(); // Ensure that SystemIO is constructed
+    QMutexLocker locker(&s_outputMutex);
+    s_output += string;
+    s_outputLines += string.count('\n');
+    if (s_outputLines >= OUTPUT_FLUSH_LINES ||
+        s_output.size() >= OUTPUT_FLUSH_SIZE) {
+      locker.unlock();
+      deliverOutput();
+    } else if (!s_outputFlushScheduled) {
+      s_outputFlushScheduled = true;
+      postToGUIThread([] {
+        QTimer::singleShot(OUTPUT_FLUSH_INTERVAL, [] {
+          QMutexLocker locker(&s_outputMutex);
+          s_outputFlushScheduled = false;
+          locker.unlock();
+          deliverOutput();
+        });
+      });
+    }
+  }
+
+  /// Delivers any buffered output through doPrint.
+  static void flushOutput() { deliverOutput(); }
+
+  /// Closes all open files, and discards any output which has not yet been
+  /// delivered.
+  static void reset() {
+    FileIOData::resetFiles();
+    QMutexLocker locker(&s_outputMutex);
+    takeOutput();
+  }
   static void abortSyscall() { s_abortSyscall = true; }
 
 signals:
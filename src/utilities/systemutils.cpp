@@ -1,6 +1,15 @@
 #include "systemutils.h"
 
 #include <QProcess>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+// windows.h must be included before psapi.h
+#include <psapi.h>
+#elif defined(Q_OS_UNIX) && !defined(Q_OS_WASM)
+#include <sys/resource.h>
+#endif
+
 namespace Ripes {
 bool isExecutable(const QString &path, const QStringList &dummyArgs) {
 #ifdef RIPES_WITH_QPROCESS
@@ -13,4 +22,24 @@ bool isExecutable(const QString &path, const QStringList &dummyArgs) {
 #endif
 }
 
+unsigned long long peakResidentSetSize() {
+#if defined(Q_OS_WIN)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return counters.PeakWorkingSetSize;
+  return 0;
+#elif defined(Q_OS_UNIX) && !defined(Q_OS_WASM)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(Q_OS_MAC)
+  return usage.ru_maxrss; // bytes
+#else
+  return static_cast<unsigned long long>(usage.ru_maxrss) * 1024; // KiB
+#endif
+#else
+  return 0;
+#endif
+}
+
 } // namespace Ripes
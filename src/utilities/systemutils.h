@@ -6,4 +6,8 @@ namespace Ripes {
 
 bool isExecutable(const QString &path, const QStringList &dummyArgs = {});
 
+/// Returns the peak resident set size of this process in bytes, or 0 if this
+/// cannot be determined on the host platform.
+unsigned long long peakResidentSetSize();
+
 } // namespace Ripes
@@ -0,0 +1,302 @@
+#include "vcdtracer.h"
+
+#include "regionofinterest.h"
+#include "selfprofiler.h"
+
+#include <QDebug>
+
+#include <cstdio>
+
+#ifdef RIPES_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace Ripes {
+
+// Number of value changes buffered before a chunk is handed off to the writer.
+static constexpr size_t s_chunkSize = 1 << 16;
+// Maximum number of chunks queued for the writer. If the writer falls behind,
+// the simulation thread blocks rather than buffering unbounded amounts of
+// trace data.
+static constexpr size_t s_maxQueuedChunks = 8;
+
+/// VCD identifier codes are strings over the printable ASCII characters.
+static std::string vcdIdentifier(uint32_t index) {
+  std::string id;
+  do {
+    id += static_cast<char>('!' + index % 94);
+    index /= 94;
+  } while (index != 0);
+  return id;
+}
+
+// VSRTL stores subcomponents and ports as owning pointers.
+template <typename T>
+static T *ptr(T *p) {
+  return p;
+}
+template <typename T>
+static T *ptr(const std::unique_ptr<T> &p) {
+  return p.get();
+}
+
+/**
+ * @brief The VCDTracer::Writer class
+ * Background thread which formats and writes chunks of value changes.
+ */
+class VCDTracer::Writer {
+public:
+  Writer(const QString &fileName, bool compress,
+         const std::vector<unsigned> &widths)
+      : m_widths(widths) {
+#ifdef RIPES_WITH_ZLIB
+    if (compress) {
+      m_gzFile = gzopen(fileName.toLocal8Bit().constData(), "wb6");
+      if (m_gzFile)
+        gzbuffer(m_gzFile, 1 << 20);
+    } else
+#else
+    (void)compress;
+#endif
+    {
+      m_file = std::fopen(fileName.toLocal8Bit().constData(), "wb");
+      if (m_file)
+        std::setvbuf(m_file, nullptr, _IOFBF, 1 << 20);
+    }
+    m_thread = std::thread([this] { run(); });
+  }
+
+  ~Writer() {
+    {
+      std::unique_lock lock(m_mutex);
+      m_done = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+#ifdef RIPES_WITH_ZLIB
+    if (m_gzFile)
+      gzclose(m_gzFile);
+#endif
+    if (m_file)
+      std::fclose(m_file);
+  }
+
+  bool isOpen() const {
+#ifdef RIPES_WITH_ZLIB
+    if (m_gzFile)
+      return true;
+#endif
+    return m_file != nullptr;
+  }
+
+  /// Enqueues raw text (ie. the VCD header).
+  void write(const std::string &text) {
+    auto chunk = std::make_unique<Chunk>();
+    enqueue(std::move(chunk), text);
+  }
+
+  void enqueue(std::unique_ptr<Chunk> chunk, const std::string &text = {}) {
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_queue.size() < s_maxQueuedChunks; });
+    m_queue.push_back({std::move(chunk), text});
+    lock.unlock();
+    m_cv.notify_all();
+  }
+
+private:
+  void run() {
+    std::string buffer;
+    while (true) {
+      std::pair<std::unique_ptr<Chunk>, std::string> item;
+      {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_done || !m_queue.empty(); });
+        if (m_queue.empty())
+          return;
+        item = std::move(m_queue.front());
+        m_queue.pop_front();
+      }
+      m_cv.notify_all();
+
+      buffer = item.second;
+      format(*item.first, buffer);
+      output(buffer);
+    }
+  }
+
+  void format(const Chunk &chunk, std::string &out) const {
+    for (size_t t = 0; t < chunk.times.size(); ++t) {
+      out += '#';
+      out += std::to_string(chunk.times[t].first);
+      out += '\n';
+      const size_t end = t + 1 < chunk.times.size() ? chunk.times[t + 1].second
+                                                     : chunk.changes.size();
+      for (size_t i = chunk.times[t].second; i < end; ++i) {
+        const auto &change = chunk.changes[i];
+        const unsigned width = m_widths[change.signal];
+        if (width == 1) {
+          out += change.value ? '1' : '0';
+        } else {
+          out += 'b';
+          int msb = width - 1;
+          // Leading zeros may be omitted.
+          while (msb > 0 && ((change.value >> msb) & 1) == 0)
+            --msb;
+          for (int bit = msb; bit >= 0; --bit)
+            out += ((change.value >> bit) & 1) ? '1' : '0';
+          out += ' ';
+        }
+        out += vcdIdentifier(change.signal);
+        out += '\n';
+      }
+    }
+  }
+
+  void output(const std::string &text) {
+#ifdef RIPES_WITH_ZLIB
+    if (m_gzFile) {
+      gzwrite(m_gzFile, text.data(), static_cast<unsigned>(text.size()));
+      return;
+    }
+#endif
+    if (m_file)
+      std::fwrite(text.data(), 1, text.size(), m_file);
+  }
+
+  std::vector<unsigned> m_widths;
+  std::FILE *m_file = nullptr;
+#ifdef RIPES_WITH_ZLIB
+  gzFile m_gzFile = nullptr;
+#endif
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::pair<std::unique_ptr<Chunk>, std::string>> m_queue;
+  bool m_done = false;
+};
+
+VCDTracer::VCDTracer(vsrtl::core::Design *design,
+                     const RipesProcessor *processor, const Config &config,
+                     QObject *parent)
+    : QObject(parent), m_processor(processor), m_config(config),
+      m_fileName(config.file) {
+  for (const auto &pattern : m_config.signalPatterns)
+    m_patterns.emplace_back(QRegularExpression::wildcardToRegularExpression(
+        pattern, QRegularExpression::NonPathWildcardConversion));
+
+#ifdef RIPES_WITH_ZLIB
+  if (m_config.compress && !m_fileName.endsWith(".gz"))
+    m_fileName += ".gz";
+#else
+  if (m_config.compress) {
+    qWarning() << "Ripes was built without zlib; writing an uncompressed VCD "
+                  "trace.";
+    m_config.compress = false;
+  }
+#endif
+
+  const QString header =
+      "$timescale 1ns $end\n" +
+      buildHeader(design, QString::fromStdString(design->getName())) +
+      "$enddefinitions $end\n";
+
+  m_writer = std::make_unique<Writer>(m_fileName, m_config.compress, m_widths);
+  if (!m_writer->isOpen())
+    qWarning() << "Could not open VCD trace file" << m_fileName;
+  m_writer->write(header.toStdString());
+  m_chunk = std::make_unique<Chunk>();
+  processorReset();
+}
+
+VCDTracer::~VCDTracer() {
+  // Flush any pending changes; the writer drains its queue and is joined upon
+  // destruction.
+  submitChunk();
+}
+
+QString VCDTracer::buildHeader(vsrtl::SimComponent *component,
+                               const QString &path) {
+  QString vars;
+  for (const auto &p : component->getPorts<vsrtl::SimPort::PortType::out>()) {
+    auto *port = ptr(p);
+    const QString name = QString::fromStdString(port->getName());
+    const QString hierName = path + "." + name;
+    bool selected = m_patterns.empty();
+    for (const auto &re : m_patterns)
+      selected |= re.match(hierName).hasMatch();
+    if (!selected)
+      continue;
+
+    const unsigned width = port->getWidth();
+    const uint32_t index = m_signals.size();
+    m_signals.push_back(
+        {port, width >= 64 ? ~VSRTL_VT_U(0) : (VSRTL_VT_U(1) << width) - 1, 0});
+    m_widths.push_back(width);
+    vars += "$var wire " + QString::number(width) + " " +
+            QString::fromStdString(vcdIdentifier(index)) + " " + name +
+            " $end\n";
+  }
+
+  for (const auto &c : component->getSubComponents()) {
+    auto *sub = ptr(c);
+    vars += buildHeader(
+        sub, path + "." + QString::fromStdString(sub->getName()));
+  }
+
+  // Components without any traced signals in their subtree are omitted.
+  if (vars.isEmpty())
+    return vars;
+  return "$scope module " + QString::fromStdString(component->getName()) +
+         " $end\n" + vars + "$upscope $end\n";
+}
+
+bool VCDTracer::inWindow(long long cycle) const {
+  return cycle >= m_config.startCycle &&
+         (m_config.stopCycle < 0 || cycle <= m_config.stopCycle);
+}
+
+void VCDTracer::processorReset() {
+  // The design state is discontinuous across resets; dump all values again.
+  m_dumpAll = true;
+  processorWasClocked();
+}
+
+void VCDTracer::processorWasClocked() {
+  SelfProfiler::Scope scope(SelfProfiler::VCDTracer);
+  if (RegionOfInterest::outsideROI() ||
+      !inWindow(m_processor->getCycleCount())) {
+    // Values must be dumped in full upon (re)entering the window.
+    m_dumpAll = true;
+    return;
+  }
+  sample(m_dumpAll);
+  m_dumpAll = false;
+  ++m_time;
+}
+
+void VCDTracer::sample(bool all) {
+  const size_t firstChange = m_chunk->changes.size();
+  for (uint32_t i = 0; i < m_signals.size(); ++i) {
+    auto &signal = m_signals[i];
+    const VSRTL_VT_U value = signal.port->uValue() & signal.mask;
+    if (all || value != signal.last) {
+      signal.last = value;
+      m_chunk->changes.push_back({i, value});
+    }
+  }
+  if (m_chunk->changes.size() != firstChange)
+    m_chunk->times.push_back({m_time, firstChange});
+
+  if (m_chunk->changes.size() >= s_chunkSize)
+    submitChunk();
+}
+
+void VCDTracer::submitChunk() {
+  if (m_chunk->times.empty())
+    return;
+  m_writer->enqueue(std::move(m_chunk));
+  m_chunk = std::make_unique<Chunk>();
+}
+
+} // namespace Ripes
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QObject>
+#include <QRegularExpression>
+#include <QStringList>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "VSRTL/core/vsrtl_design.h"
+#include "processors/interface/ripesprocessor.h"
+
+namespace Ripes {
+
+/**
+ * @brief The VCDTracer class
+ * Writes a Value Change Dump of a subset of the signals of a VSRTL design.
+ *
+ * Signals are selected by matching their hierarchical name
+ * (design.component.port) against a set of wildcard patterns, and are only
+ * traced within a window of cycles. Value changes are detected in the
+ * simulation thread and handed off in chunks to a background writer thread,
+ * which formats the VCD text and writes it to disk, optionally gzip
+ * compressed.
+ *
+ * VCD time is the number of clock events observed by the tracer, such that the
+ * trace remains valid across processor resets and reversals. The owner is
+ * responsible for calling processorWasClocked() in lockstep with the processor,
+ * and processorReset() whenever the processor is reset.
+ */
+class VCDTracer : public QObject {
+  Q_OBJECT
+public:
+  struct Config {
+    QString file;
+    /// Wildcard patterns of signals to trace. Empty traces all signals.
+    QStringList signalPatterns;
+    /// Cycle window [startCycle, stopCycle] to trace. A negative stopCycle
+    /// traces until the end of simulation.
+    long long startCycle = 0;
+    long long stopCycle = -1;
+    /// Write a gzip-compressed trace. Requires Ripes to be built with zlib.
+    bool compress = false;
+  };
+
+  VCDTracer(vsrtl::core::Design *design, const RipesProcessor *processor,
+            const Config &config, QObject *parent = nullptr);
+  ~VCDTracer();
+
+  void processorWasClocked();
+  void processorReset();
+
+  /// Returns the name of the file which is written to. Differs from the
+  /// configured file if compression appended a .gz suffix.
+  const QString &fileName() const { return m_fileName; }
+
+private:
+  struct Signal {
+    vsrtl::SimPort *port;
+    VSRTL_VT_U mask;
+    VSRTL_VT_U last;
+  };
+
+  struct Change {
+    uint32_t signal;
+    VSRTL_VT_U value;
+  };
+
+  /// A batch of value changes, handed off to the writer thread.
+  struct Chunk {
+    // (time, index of the first change at this time)
+    std::vector<std::pair<uint64_t, size_t>> times;
+    std::vector<Change> changes;
+  };
+
+  class Writer;
+
+  bool inWindow(long long cycle) const;
+  void sample(bool all);
+  void submitChunk();
+  QString buildHeader(vsrtl::SimComponent *component, const QString &path);
+
+  const RipesProcessor *m_processor;
+  Config m_config;
+  QString m_fileName;
+  std::vector<QRegularExpression> m_patterns;
+  std::vector<Signal> m_signals;
+  std::vector<unsigned> m_widths;
+
+  uint64_t m_time = 0;
+  bool m_dumpAll = true;
+  std::unique_ptr<Chunk> m_chunk;
+  std::unique_ptr<Writer> m_writer;
+};
+
+} // namespace Ripes
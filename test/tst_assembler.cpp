@@ -45,6 +45,7 @@ private slots:
   void tst_stringDirectives();
   void tst_riscv();
   void tst_relativeLabels();
+  void tst_zicsr();
 
 private:
   QString createProgram(int entries) {
@@ -416,5 +417,56 @@ void tst_Assembler::tst_matcher() {
   }
 }
 
+void tst_Assembler::tst_zicsr() {
+  auto isa = std::make_shared<ISAInfo<ISA::RV32I>>(QStringList());
+  auto assembler = ISA_Assembler<ISA::RV32I>(isa);
+
+  // Zicsr instructions and the counter read pseudo-instructions, and their
+  // expected encodings.
+  std::vector<std::pair<QString, uint32_t>> toAssemble = {
+      {"csrrw a0, 0xC00, a1", 0xC0059573},
+      {"csrrs a0, 0xC00, x0", 0xC0002573},
+      {"csrrc a0, 0xC00, x0", 0xC0003573},
+      {"csrrwi a0, 0xC00, 5", 0xC002D573},
+      {"csrrsi a0, 0xC00, 0", 0xC0006573},
+      {"csrrci a0, 0xC02, 0", 0xC0207573},
+      {"csrr t0, cycle", 0xC00022F3},
+      {"csrr t0, 0xB02", 0xB02022F3},
+      {"rdcycle a0", 0xC0002573},
+      {"rdcycleh a0", 0xC8002573},
+      {"rdtime a0", 0xC0102573},
+      {"rdinstret a1", 0xC02025F3},
+      {"rdinstreth a1", 0xC82025F3}};
+
+  for (const auto &iter : toAssemble) {
+    auto res = assembler.assemble(QStringList() << iter.first);
+    if (res.errors.size() != 0) {
+      QFAIL(("Could not assemble '" + iter.first + "':\n" +
+             res.errors.toString())
+                .toStdString()
+                .c_str());
+    }
+    const auto &text = res.program.getSection(".text")->data;
+    QCOMPARE(text.size(), 4);
+    uint32_t encoding = 0;
+    for (int i = 3; i >= 0; i--)
+      encoding = (encoding << 8) | static_cast<uint8_t>(text.at(i));
+    QCOMPARE(encoding, iter.second);
+
+    // The encodings must decode back to the Zicsr instruction which the
+    // assembler emitted.
+    auto match = assembler.getMatcher().matchInstruction(encoding);
+    if (auto *error = std::get_if<Error>(&match)) {
+      QFAIL(error->toString().toStdString().c_str());
+    }
+    const QString name = std::get<const InstructionBase *>(match)->name();
+    QVERIFY(name.startsWith("csrr"));
+  }
+
+  testAssemble(QStringList() << "csrr a0, notacsr", Expect::Fail);
+  testAssemble(QStringList() << "csrrs a0, 0x1000, x0", Expect::Fail);
+  testAssemble(QStringList() << "csrrwi a0, 0xC00, 32", Expect::Fail);
+}
+
 QTEST_APPLESS_MAIN(tst_Assembler)
 #include "tst_assembler.moc"
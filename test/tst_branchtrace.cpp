@@ -0,0 +1,228 @@
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+#include <map>
+
+#include "branchtrace.h"
+#include "cli/bpeval.h"
+#include "processorhandler.h"
+#include "ripessettings.h"
+
+/**
+ * Branch traces
+ * Records the branch trace of a small program and reads it back, and replays
+ * a hand-built trace through the direction predictors of the offline branch
+ * predictor evaluation (bpeval), comparing the number of mispredictions to
+ * those derived by hand.
+ */
+
+using namespace Ripes;
+
+using Kind = BranchTrace::Kind;
+
+// Maximum cycle count
+static constexpr unsigned s_maxCycles = 1000;
+
+// A loop branch which is taken twice, followed by a call, a return and a jump.
+// The program is placed at address 0.
+static const char s_program[] = "li t0, 3\n"         // 0x00
+                                "loop:\n"            //
+                                "addi t0, t0, -1\n"  // 0x04
+                                "bnez t0, loop\n"    // 0x08
+                                "jal ra, func\n"     // 0x0c
+                                "j end\n"            // 0x10
+                                "func:\n"            //
+                                "ret\n"              // 0x14
+                                "end:\n"             //
+                                "li a7, 10\n"        // 0x18
+                                "ecall\n";           // 0x1c
+
+/// Builds a branch trace file by hand, following the format described in
+/// branchtrace.h.
+class TraceBuilder {
+public:
+  void add(AInt pc, AInt nextPC, Kind kind, bool taken) {
+    m_records.push_back(static_cast<uint8_t>(kind) | (taken ? 1 << 2 : 0));
+    putVarint(static_cast<int64_t>(pc - m_lastNextPC));
+    putVarint(static_cast<int64_t>(nextPC - pc));
+    m_lastNextPC = nextPC;
+    m_nRecords++;
+  }
+
+  QByteArray data(uint64_t instructions) const {
+    QByteArray data("RBTR", 4);
+    putLE(data, BranchTrace::s_version, 4);
+    putLE(data, 32, 4);
+    putLE(data, 0, 4);
+    putLE(data, instructions, 8);
+    putLE(data, m_nRecords, 8);
+    return data + m_records;
+  }
+
+private:
+  static void putLE(QByteArray &out, uint64_t value, unsigned bytes) {
+    for (unsigned i = 0; i < bytes; ++i)
+      out.append(static_cast<char>(value >> (8 * i)));
+  }
+
+  void putVarint(int64_t value) {
+    uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^
+                      static_cast<uint64_t>(value >> 63);
+    while (zigzag >= 0x80) {
+      m_records.append(static_cast<char>((zigzag & 0x7F) | 0x80));
+      zigzag >>= 7;
+    }
+    m_records.append(static_cast<char>(zigzag));
+  }
+
+  QByteArray m_records;
+  uint64_t m_nRecords = 0;
+  AInt m_lastNextPC = 0;
+};
+
+class tst_BranchTrace : public QObject {
+  Q_OBJECT
+
+private:
+  static bool writeFile(const QString &path, const QByteArray &data) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+      return false;
+    return file.write(data) == data.size();
+  }
+
+private slots:
+  void testRoundTrip();
+  void testTruncated();
+  void testPredictors();
+};
+
+void tst_BranchTrace::testRoundTrip() {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  const QString path = dir.filePath("trace.rbtr");
+
+  ProcessorHandler::selectProcessor(ProcessorID::RV32_SS, {"M"});
+  auto res = ProcessorHandler::getAssembler()->assembleRaw(s_program);
+  QVERIFY(res.errors.size() == 0);
+  ProcessorHandler::get()->loadProgram(
+      std::make_shared<Program>(res.program));
+  RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+
+  {
+    // The header is finalized when the recorder is destroyed.
+    BranchTraceRecorder recorder(path);
+    recorder.setEnabled(true);
+    QVERIFY(recorder.isOpen());
+    auto *proc = ProcessorHandler::getProcessorNonConst();
+    for (unsigned i = 0; i < s_maxCycles && !proc->finished(); ++i)
+      proc->clock();
+    QVERIFY(proc->finished());
+    QCOMPARE(recorder.records(), uint64_t(6));
+  }
+
+  BranchTrace trace;
+  QCOMPARE(BranchTrace::read(path, trace), QString());
+  QCOMPARE(trace.xlen, 32u);
+  QVERIFY(trace.instructions >= 11);
+
+  const std::vector<BranchTrace::Record> expected = {
+      {0x08, 0x04, Kind::Branch, true, false},
+      {0x08, 0x04, Kind::Branch, true, false},
+      {0x08, 0x0c, Kind::Branch, false, false},
+      {0x0c, 0x14, Kind::Call, true, false},
+      {0x14, 0x10, Kind::Return, true, false},
+      {0x10, 0x18, Kind::Jump, true, false}};
+  QCOMPARE(trace.records.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    const auto &record = trace.records.at(i);
+    QCOMPARE(record.pc, expected.at(i).pc);
+    QCOMPARE(record.nextPC, expected.at(i).nextPC);
+    QVERIFY(record.kind == expected.at(i).kind);
+    QCOMPARE(record.taken, expected.at(i).taken);
+    QCOMPARE(record.compressed, expected.at(i).compressed);
+  }
+}
+
+void tst_BranchTrace::testTruncated() {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  const QString path = dir.filePath("trace.rbtr");
+
+  // A record with multi-byte varints.
+  TraceBuilder builder;
+  builder.add(0x10000, 0x400, Kind::Jump, true);
+  const QByteArray data = builder.data(1);
+
+  BranchTrace trace;
+  QVERIFY(writeFile(path, data));
+  QCOMPARE(BranchTrace::read(path, trace), QString());
+  QCOMPARE(trace.records.size(), size_t(1));
+  QCOMPARE(trace.records.at(0).pc, AInt(0x10000));
+  QCOMPARE(trace.records.at(0).nextPC, AInt(0x400));
+
+  // Truncation within the records, and within the header.
+  for (const qsizetype size : {data.size() - 1, qsizetype(33), qsizetype(32)}) {
+    QVERIFY(writeFile(path, data.left(size)));
+    QVERIFY(BranchTrace::read(path, trace).startsWith("Truncated"));
+  }
+  QVERIFY(writeFile(path, data.left(16)));
+  QVERIFY(BranchTrace::read(path, trace).endsWith("is not a branch trace"));
+}
+
+void tst_BranchTrace::testPredictors() {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+
+  // A single conditional branch alternating between taken and not taken, 64
+  // times. Unconditional control flow is not seen by the predictors.
+  TraceBuilder builder;
+  builder.add(0x0fc, 0x100, Kind::Call, true);
+  for (unsigned i = 0; i < 64; ++i) {
+    const bool taken = i % 2 == 0;
+    builder.add(0x100, taken ? 0x80 : 0x104, Kind::Branch, taken);
+  }
+  BPEvalOptions options;
+  options.traceFile = dir.filePath("trace.rbtr");
+  QVERIFY(writeFile(options.traceFile, builder.data(1000)));
+
+  // Mispredictions of the 2-bit counters, which start out as weakly not taken:
+  // - bimodal: the counter of the branch flips between weakly taken and weakly
+  //   not taken, so every branch is mispredicted.
+  // - gshare (4 history bits): mispredicts until the history settles on its
+  //   two alternating values and their counters have been trained; 3.
+  // - tournament: the chooser starts out selecting the bimodal predictor and
+  //   switches to gshare once they disagree twice; 4.
+  const std::map<QString, qint64> expected = {
+      {"bimodal:4", 64}, {"gshare:4:4", 3}, {"tournament:4:4", 4}};
+  for (const auto &[spec, _] : expected) {
+    BPEvalConfig config;
+    QVERIFY(BPEvalConfig::parse(spec, config));
+    options.configs.push_back(config);
+  }
+  options.outputFile = dir.filePath("bpeval.json");
+  options.jsonOutput = true;
+  QCOMPARE(runBPEval(options), 0);
+
+  QFile output(options.outputFile);
+  QVERIFY(output.open(QIODevice::ReadOnly));
+  const QJsonObject report = QJsonDocument::fromJson(output.readAll()).object();
+  QCOMPARE(report["instructions"].toInteger(), qint64(1000));
+  QCOMPARE(report["conditional branches"].toInteger(), qint64(64));
+
+  const QJsonArray configs = report["configurations"].toArray();
+  QCOMPARE(configs.size(), qsizetype(expected.size()));
+  for (const auto &c : configs) {
+    const QJsonObject config = c.toObject();
+    const QString name = config["predictor"].toString();
+    QVERIFY2(expected.count(name), qPrintable(name));
+    QCOMPARE(config["mispredictions"].toInteger(), expected.at(name));
+  }
+}
+
+QTEST_APPLESS_MAIN(tst_BranchTrace)
+#include "tst_branchtrace.moc"
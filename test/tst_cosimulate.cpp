@@ -2,6 +2,7 @@
 #include <QProcess>
 #include <QResource>
 #include <QStringList>
+#include <QTemporaryDir>
 #include <QtTest/QTest>
 
 #include <optional>
@@ -62,6 +63,78 @@ const std::vector<LoadFileParams> s_testFiles = {
                            "../../examples/ELF/RanPi-RV32"),
                    SourceType::ExternalELF, 0, 0}};
 
+// A multiply/divide kernel with results used right after the producing
+// instruction (latency stalls) and back-to-back divides (structural stalls on a
+// non-pipelined divider).
+static const char s_mulDivKernel[] = R"(
+.text
+main:
+    li s0, 64
+    li s1, 1
+    li s2, 7
+    li s3, 0
+loop:
+    mul t0, s0, s2
+    mul t1, s1, s2
+    add s3, s3, t0
+    div t2, t0, s2
+    div t3, t1, s2
+    add s3, s3, t2
+    add s3, s3, t3
+    rem t4, s0, s2
+    mulh t5, s3, s0
+    add s3, s3, t4
+    add s3, s3, t5
+    addi s1, s1, 3
+    addi s0, s0, -1
+    bnez s0, loop
+    mv a0, s3
+    li a7, 10
+    ecall
+)";
+
+// A kernel with every source of bubbles in the 5-stage pipelines: a load-use
+// hazard, an ALU result used by the next instruction, a jump, a branch which is
+// not taken and an ecall with outstanding register writes. The operands of the
+// branch and the ecall are written well ahead, such that the kernel executes
+// the same instructions without hazard detection.
+static const char s_presetKernel[] = R"(
+.text
+main:
+    addi t0, x0, 1
+    addi a0, x0, 5
+    addi a7, x0, 1
+    lw t1, 0(sp)
+    add t2, t1, t1
+    add t3, t2, t2
+    j skip
+    addi t4, x0, 1
+    addi t5, x0, 1
+    addi t6, x0, 1
+skip:
+    beq t0, x0, main
+    addi t4, x0, 2
+    addi t5, x0, 2
+    ecall
+    nop
+    nop
+    nop
+    nop
+)";
+
+// A kernel without bubbles in any of the 5-stage pipelines.
+static const char s_straightKernel[] = R"(
+.text
+    nop
+    nop
+    nop
+    nop
+    nop
+    nop
+    nop
+    nop
+)";
+
 class tst_Cosimulate : public QObject {
   Q_OBJECT
 
@@ -69,7 +142,8 @@ public:
   explicit tst_Cosimulate() {}
 
 private:
-  void cosimulate(const ProcessorID &id, const QStringList &extensions);
+  void cosimulate(const ProcessorID &id, const QStringList &extensions,
+                  const std::vector<LoadFileParams> &tests = s_testFiles);
   const Trace &generateReferenceTrace(const QStringList &extensions);
   void trapHandler();
   void executeSimulator(Trace &outTrace, const Trace *refTrace = nullptr);
@@ -78,6 +152,8 @@ private:
                               const TraceEntry &lhs,
                               const TraceEntry &rhs) const;
   void loadCurrentTest();
+  bool runKernel(ProcessorID id, const char *source, long long &cycles,
+                 long long &retired);
 
   bool m_stop = false;
   QString m_err;
@@ -93,13 +169,174 @@ private slots:
    * co-simulate.
    */
   void testRV6SDual() { cosimulate(ProcessorID::RV32_6S_DUAL, {"M"}); }
+  void testRVOOO() { cosimulate(ProcessorID::RV32_OOO, {"M"}); }
+  void testRVInOrder2() { cosimulate(ProcessorID::RV32_INORDER_2, {"M"}); }
+  void testRVInOrder4() { cosimulate(ProcessorID::RV32_INORDER_4, {"M"}); }
+  void testRVInOrder8() { cosimulate(ProcessorID::RV32_INORDER_8, {"M"}); }
   void testRV5S() { cosimulate(ProcessorID::RV32_5S, {"M"}); }
   void testRV5SNoFW() { cosimulate(ProcessorID::RV32_5S_NO_FW, {"M"}); }
 
   void testRV5S1S() { cosimulate(ProcessorID::RV32_5S_1S, {"M"}); }
   void testRV5S3S() { cosimulate(ProcessorID::RV32_5S_3S, {"M"}); }
+  void testRV5SParam();
+  void testRV5SPresets();
+  void testFULatencies();
 };
 
+void tst_Cosimulate::testFULatencies() {
+  QTemporaryDir dir;
+  QVERIFY(dir.isValid());
+  const QString kernel = dir.filePath("muldiv.s");
+  QFile file(kernel);
+  QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+  file.write(s_mulDivKernel);
+  file.close();
+
+  // Multi-cycle units must only delay execution. The multiply/divide kernel
+  // runs last, such that the functional unit statistics of the processor
+  // refer to it.
+  auto tests = s_testFiles;
+  tests.push_back(LoadFileParams{kernel, SourceType::Assembly, 0, 0});
+
+  FULatencies latencies;
+  latencies.mul = {3, true};
+  latencies.div = {32, false};
+  ProcessorHandler::setFULatencies(latencies);
+  for (const auto id : {ProcessorID::RV32_5S, ProcessorID::RV32_5S_NO_FW}) {
+    cosimulate(id, {"M"}, tests);
+    if (QTest::currentTestFailed())
+      break;
+
+    const auto *stats = ProcessorHandler::getProcessor()->functionalUnitStats();
+    QVERIFY(stats != nullptr);
+    QVERIFY(stats->latencyStalls > 0);
+    QVERIFY(stats->structuralStalls > 0);
+  }
+  ProcessorHandler::setFULatencies(FULatencies());
+}
+
+void tst_Cosimulate::testRV5SParam() {
+  // Configurations which execute programs with data and control hazards
+  // unmodified, and which are not a preset (see testRV5SPresets()); delay
+  // slots and missing hazard detection change the semantics of the test
+  // programs.
+  using BranchStage = PipelineConfig::BranchStage;
+  const auto config = [](bool forwarding, BranchStage stage, bool prediction) {
+    PipelineConfig config;
+    config.forwarding = forwarding;
+    config.branchStage = stage;
+    config.prediction = prediction;
+    return config;
+  };
+  const std::vector<PipelineConfig> configs = {
+      config(false, BranchStage::ID, false),
+      config(false, BranchStage::MEM, false),
+      config(false, BranchStage::ID, true),
+  };
+
+  for (const auto &cfg : configs) {
+    ProcessorHandler::setPipelineConfig(cfg);
+    cosimulate(ProcessorID::RV32_5S_PARAM, {"M"});
+  }
+  ProcessorHandler::setPipelineConfig(PipelineConfig());
+}
+
+bool tst_Cosimulate::runKernel(ProcessorID id, const char *source,
+                               long long &cycles, long long &retired) {
+  ProcessorHandler::selectProcessor(id, {"M"});
+  const auto program = ProcessorHandler::getAssembler()->assembleRaw(source);
+  if (program.errors.size() != 0)
+    return false;
+  ProcessorHandler::get()->loadProgram(
+      std::make_shared<Program>(program.program));
+  RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+
+  auto *proc = ProcessorHandler::getProcessorNonConst();
+  while (!proc->finished() && proc->getCycleCount() < s_maxCycles)
+    proc->clock();
+  cycles = proc->getCycleCount();
+  retired = proc->getInstructionsRetired();
+  return proc->finished();
+}
+
+void tst_Cosimulate::testRV5SPresets() {
+  // Each 5-stage processor is a preset of the parametric processor, and must
+  // execute the kernel in the cycles of the processor it replaced. The bubbles
+  // of the replaced processors, in the order of the kernel:
+  //  - load-use: 1 with forwarding, 2 without, 0 without hazard detection,
+  //  - ALU result: 2 without forwarding, 0 otherwise,
+  //  - jump: squashes the 1, 2 or 3 instructions fetched behind it when
+  //    resolved in ID, EX or MEM, which rather execute as delay slots,
+  //  - ecall: 2 while the preceding writes complete. Without hazard
+  //    detection, ecalls are handled in ID without stalling.
+  using BranchStage = PipelineConfig::BranchStage;
+  struct Preset {
+    ProcessorID id;
+    PipelineConfig config;
+    long long bubbles;
+    long long delaySlots;
+  };
+  const std::vector<Preset> presets = {
+      {ProcessorID::RV32_5S, {true, true, BranchStage::EX, false, false}, 5, 0},
+      {ProcessorID::RV32_5S_NO_FW,
+       {false, true, BranchStage::EX, false, false},
+       8,
+       0},
+      {ProcessorID::RV32_5S_NO_HZ,
+       {true, false, BranchStage::EX, false, false},
+       2,
+       0},
+      {ProcessorID::RV32_5S_NO_FW_HZ,
+       {false, false, BranchStage::EX, false, false},
+       2,
+       0},
+      {ProcessorID::RV32_5S_1S,
+       {true, true, BranchStage::ID, false, false},
+       4,
+       0},
+      {ProcessorID::RV32_5S_1S_DB,
+       {true, true, BranchStage::ID, true, false},
+       3,
+       1},
+      {ProcessorID::RV32_5S_2S_DB,
+       {true, true, BranchStage::EX, true, false},
+       3,
+       2},
+      {ProcessorID::RV32_5S_3S,
+       {true, true, BranchStage::MEM, false, false},
+       6,
+       0},
+      {ProcessorID::RV32_5S_3S_DB,
+       {true, true, BranchStage::MEM, true, false},
+       3,
+       3},
+      {ProcessorID::RV32_5S_BP,
+       {true, true, BranchStage::ID, false, true},
+       4,
+       0},
+  };
+
+  // Cycles to fill and drain the pipeline, common to all presets.
+  long long cycles = 0, retired = 0;
+  QVERIFY(runKernel(ProcessorID::RV32_5S, s_straightKernel, cycles, retired));
+  QCOMPARE(retired, 8LL);
+  const long long fill = cycles - retired;
+
+  for (const auto &preset : presets) {
+    const QString name = enumToString(preset.id);
+    QVERIFY2(runKernel(preset.id, s_straightKernel, cycles, retired),
+             qPrintable(name));
+    QCOMPARE(cycles - retired, fill);
+
+    QVERIFY2(runKernel(preset.id, s_presetKernel, cycles, retired),
+             qPrintable(name));
+    const auto *config = ProcessorHandler::getProcessor()->pipelineConfig();
+    QVERIFY2(config && *config == preset.config, qPrintable(name));
+    QCOMPARE(retired, 15LL + preset.delaySlots);
+    QCOMPARE(cycles - retired - fill, preset.bubbles);
+  }
+}
+
 void tst_Cosimulate::trapHandler() {
   auto reg =
       ProcessorHandler::get()->getProcessor()->implementsISA()->syscallReg();
@@ -302,9 +539,10 @@ tst_Cosimulate::generateReferenceTrace(const QStringList &extensions) {
  * nature of the ProcessorHandler.
  */
 void tst_Cosimulate::cosimulate(const ProcessorID &id,
-                                const QStringList &extensions) {
+                                const QStringList &extensions,
+                                const std::vector<LoadFileParams> &tests) {
   m_loader = new ProgramLoader();
-  for (const auto &test : s_testFiles) {
+  for (const auto &test : tests) {
     m_currentTest = test;
     std::cout << test.filepath.toStdString() << std::endl;
     auto referenceTrace = generateReferenceTrace(extensions);
@@ -314,6 +552,8 @@ void tst_Cosimulate::cosimulate(const ProcessorID &id,
     Trace trace;
     std::cout << "Cosimulating... " << std::flush;
     executeSimulator(trace, &referenceTrace);
+    if (QTest::currentTestFailed())
+      return;
     std::cout << "PASS!\n" << std::endl;
   }
 }
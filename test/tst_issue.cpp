@@ -0,0 +1,157 @@
+#include <QtTest/QTest>
+
+#include "issuemodel.h"
+#include "processorhandler.h"
+#include "processorregistry.h"
+#include "ripessettings.h"
+
+/**
+ * Issue model
+ * Replays a short straight-line program through the trace-driven issue model
+ * at issue widths 1, 2 and 4, and checks the issue group size histogram and
+ * the attribution of lost issue slots against a hand-derived schedule. The
+ * N-wide in-order processors must issue the program on the same schedule.
+ */
+
+using namespace Ripes;
+using Reason = IssueStats::Reason;
+
+// Two independent results feeding an add, followed by the exit ecall. The add
+// must wait a cycle for its operands, and the ecall issues alone.
+static const QString s_program = "li a7, 10\n"
+                                 "addi t0, x0, 1\n"
+                                 "addi t1, x0, 2\n"
+                                 "add t2, t0, t1\n"
+                                 "ecall\n";
+
+static constexpr unsigned s_maxCycles = 100;
+
+class tst_Issue : public QObject {
+  Q_OBJECT
+
+private:
+  bool runOn(ProcessorID id);
+  std::vector<IssueStats> runProgram(const std::vector<unsigned> &widths);
+  static uint64_t lost(const IssueStats &stats, Reason reason) {
+    return stats.lostSlots.at(static_cast<unsigned>(reason));
+  }
+
+private slots:
+  void testGroupSizes();
+  void testLostSlots();
+  void testProcessors();
+};
+
+bool tst_Issue::runOn(ProcessorID id) {
+  ProcessorHandler::selectProcessor(id, {"M"});
+  const auto program =
+      ProcessorHandler::getAssembler()->assembleRaw(s_program);
+  if (program.errors.size() != 0)
+    return false;
+  ProcessorHandler::get()->loadProgram(
+      std::make_shared<Program>(program.program));
+  RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+  return true;
+}
+
+std::vector<IssueStats>
+tst_Issue::runProgram(const std::vector<unsigned> &widths) {
+  if (!runOn(ProcessorID::RV32_SS))
+    return {};
+
+  IssueModel model;
+  std::vector<IssueModel::Config> configs;
+  for (const unsigned width : widths)
+    configs.push_back(IssueModel::Config::forWidth(width));
+  model.setConfigs(configs);
+  model.setEnabled(true);
+
+  auto *proc = ProcessorHandler::getProcessorNonConst();
+  while (!proc->finished() && proc->getCycleCount() < s_maxCycles)
+    proc->clock();
+  if (!proc->finished())
+    return {};
+  return model.stats();
+}
+
+void tst_Issue::testGroupSizes() {
+  const auto stats = runProgram({1, 2, 4});
+  QCOMPARE(stats.size(), size_t{3});
+
+  // 1-wide: every instruction issues alone.
+  QCOMPARE(stats[0].issued, uint64_t{5});
+  QCOMPARE(stats[0].cycles, uint64_t{5});
+  QVERIFY(stats[0].groupSizes == std::vector<uint64_t>({0, 5}));
+
+  // 2-wide: {li, addi} {addi} {add} {ecall}
+  QCOMPARE(stats[1].issued, uint64_t{5});
+  QCOMPARE(stats[1].cycles, uint64_t{4});
+  QVERIFY(stats[1].groupSizes == std::vector<uint64_t>({0, 3, 1}));
+
+  // 4-wide: {li, addi, addi} {add} {ecall}
+  QCOMPARE(stats[2].issued, uint64_t{5});
+  QCOMPARE(stats[2].cycles, uint64_t{3});
+  QVERIFY(stats[2].groupSizes == std::vector<uint64_t>({0, 2, 0, 1, 0}));
+}
+
+void tst_Issue::testLostSlots() {
+  const auto stats = runProgram({1, 2, 4});
+  QCOMPARE(stats.size(), size_t{3});
+
+  // A 1-wide machine never leaves a slot unused in this program.
+  for (unsigned r = 0; r < IssueStats::s_nReasons; ++r)
+    QCOMPARE(stats[0].lostSlots[r], uint64_t{0});
+
+  // The add ends the group of the second addi, whose result it depends on.
+  // The ecall ends the group of the add, and issues alone.
+  QCOMPARE(lost(stats[1], Reason::DataDependency), uint64_t{1});
+  QCOMPARE(lost(stats[1], Reason::Serialization), uint64_t{2});
+  QCOMPARE(lost(stats[2], Reason::DataDependency), uint64_t{1});
+  QCOMPARE(lost(stats[2], Reason::Serialization), uint64_t{6});
+
+  // Lost slots and issued instructions add up to the available slots.
+  for (const auto &s : stats) {
+    uint64_t lostSlots = 0;
+    for (const uint64_t n : s.lostSlots)
+      lostSlots += n;
+    QCOMPARE(lostSlots + s.issued, s.cycles * s.width);
+  }
+}
+
+void tst_Issue::testProcessors() {
+  const std::vector<std::pair<ProcessorID, unsigned>> processors = {
+      {ProcessorID::RV32_INORDER_2, 2},
+      {ProcessorID::RV32_INORDER_4, 4},
+      {ProcessorID::RV32_INORDER_8, 8}};
+  std::vector<unsigned> widths;
+  for (const auto &[id, width] : processors)
+    widths.push_back(width);
+  const auto expected = runProgram(widths);
+  QCOMPARE(expected.size(), processors.size());
+
+  for (unsigned i = 0; i < processors.size(); ++i) {
+    const auto &[id, width] = processors[i];
+    QVERIFY(runOn(id));
+    auto *proc = ProcessorHandler::getProcessorNonConst();
+    while (!proc->finished() && proc->getCycleCount() < s_maxCycles)
+      proc->clock();
+    QVERIFY(proc->finished());
+    QCOMPARE(proc->getInstructionsRetired(), 5LL);
+
+    const IssueStats *stats = proc->issueStats();
+    QVERIFY(stats != nullptr);
+    QCOMPARE(stats->width, width);
+    QCOMPARE(stats->issued, expected[i].issued);
+    // Cycles in which nothing issues while the pipeline drains are attributed
+    // to 'other'; the issue groups and all other lost slots match the model.
+    for (unsigned n = 1; n <= width; ++n)
+      QCOMPARE(stats->groupSizes.at(n), expected[i].groupSizes.at(n));
+    for (unsigned r = 0; r < IssueStats::s_nReasons; ++r) {
+      if (r != static_cast<unsigned>(Reason::Other))
+        QCOMPARE(stats->lostSlots[r], expected[i].lostSlots[r]);
+    }
+  }
+}
+
+QTEST_APPLESS_MAIN(tst_Issue)
+#include "tst_issue.moc"
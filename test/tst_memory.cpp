@@ -0,0 +1,336 @@
+#include <QtTest/QTest>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "isa/isa_types.h"
+#include "processorhandler.h"
+#include "processorregistry.h"
+#include "processors/interface/pagedaddressspace.h"
+#include "ripessettings.h"
+
+/**
+ * Paged address space
+ * Exercises the memory backend of the processor models directly: accesses
+ * crossing page boundaries, dispatch of accesses to IO regions, sparse 64-bit
+ * addresses, the restoration of the program image upon reset, and the bulk
+ * accessors used by the system calls. Finally, a program is run on the
+ * processor models to check that reset restores the memory it modified.
+ */
+
+using namespace Ripes;
+
+static constexpr VSRTL_VT_U s_page = PagedAddressSpace::s_pageSize;
+static constexpr VSRTL_VT_U s_ioBase = 0xF0000000;
+static constexpr unsigned s_ioSize = 0x10;
+
+class tst_Memory : public QObject {
+  Q_OBJECT
+
+private:
+  struct IOAccess {
+    AInt offset;
+    VInt value;
+    unsigned size;
+  };
+
+  /// Adds an IO region at s_ioBase which records writes into m_ioWrites, and
+  /// returns 0x40 + offset upon reads.
+  void addIORegion(PagedAddressSpace &mem);
+  std::vector<IOAccess> m_ioWrites;
+
+private slots:
+  void testPageCrossing();
+  void testIORegion();
+  void testSparse64();
+  void testReset();
+  void testReferencedImage();
+  void testBlockAccesses();
+  void testCString();
+  void testClearBlock();
+  void testProgramReset();
+};
+
+void tst_Memory::addIORegion(PagedAddressSpace &mem) {
+  m_ioWrites.clear();
+  mem.addIORegion(
+      s_ioBase, s_ioSize,
+      vsrtl::core::IOFunctors{
+          [this](AInt offset, VInt value, unsigned size) {
+            m_ioWrites.push_back({offset, value, size});
+          },
+          [](AInt offset, unsigned) { return VInt(0x40 + offset); }});
+}
+
+void tst_Memory::testPageCrossing() {
+  auto mem = std::make_unique<PagedAddressSpace>();
+
+  // A doubleword straddling the boundary between the second and third page.
+  const VSRTL_VT_U address = 2 * s_page - 4;
+  mem->writeMem(address, 0x1122334455667788, 8);
+  QCOMPARE(mem->readMem(address, 8), VSRTL_VT_U(0x1122334455667788));
+  QCOMPARE(mem->readMemConst(address, 8), VSRTL_VT_U(0x1122334455667788));
+  QCOMPARE(mem->readMem(address + 2, 4), VSRTL_VT_U(0x33445566));
+  QCOMPARE(mem->readMem(2 * s_page, 4), VSRTL_VT_U(0x11223344));
+  QVERIFY(mem->contains(s_page));
+  QVERIFY(mem->contains(2 * s_page));
+
+  // A write through the cached page is visible to a page-crossing read.
+  mem->writeMem(2 * s_page, 0xAABBCCDD, 4);
+  QCOMPARE(mem->readMem(address, 8), VSRTL_VT_U(0xAABBCCDD55667788));
+
+  // Halfword straddling a page boundary into an unallocated page.
+  mem->writeMem(4 * s_page - 1, 0xBEEF, 2);
+  QCOMPARE(mem->readMemConst(4 * s_page - 1, 2), VSRTL_VT_U(0xBEEF));
+  QCOMPARE(mem->readMem(4 * s_page, 1), VSRTL_VT_U(0xBE));
+}
+
+void tst_Memory::testIORegion() {
+  auto mem = std::make_unique<PagedAddressSpace>();
+  // Cache the page containing the IO region before the region is added.
+  mem->writeMem(s_ioBase - 4, 0x12345678, 4);
+  addIORegion(*mem);
+
+  // Accesses to the region are dispatched to the peripheral, with the offset
+  // into the region.
+  mem->writeMem(s_ioBase + 4, 0xCAFE, 2);
+  QCOMPARE(m_ioWrites.size(), size_t{1});
+  QCOMPARE(m_ioWrites[0].offset, AInt(4));
+  QCOMPARE(m_ioWrites[0].value, VInt(0xCAFE));
+  QCOMPARE(m_ioWrites[0].size, 2u);
+  QCOMPARE(mem->readMem(s_ioBase + 8, 4), VSRTL_VT_U(0x48));
+  QCOMPARE(mem->readMemConst(s_ioBase + 8, 4), VSRTL_VT_U(0x48));
+
+  // Memory sharing a page with the region is unaffected.
+  QCOMPARE(mem->readMem(s_ioBase - 4, 4), VSRTL_VT_U(0x12345678));
+  mem->writeMem(s_ioBase + s_ioSize, 0xAB, 1);
+  QCOMPARE(mem->readMem(s_ioBase + s_ioSize, 1), VSRTL_VT_U(0xAB));
+  QCOMPARE(m_ioWrites.size(), size_t{1});
+
+  // Once removed, the region is backed by memory.
+  mem->removeIORegion(s_ioBase, s_ioSize);
+  mem->writeMem(s_ioBase + 4, 0xCAFE, 2);
+  QCOMPARE(m_ioWrites.size(), size_t{1});
+  QCOMPARE(mem->readMem(s_ioBase + 4, 2), VSRTL_VT_U(0xCAFE));
+}
+
+void tst_Memory::testSparse64() {
+  auto mem = std::make_unique<PagedAddressSpace>();
+  const std::vector<VSRTL_VT_U> addresses = {
+      0x0, 0x10000000, 0x7FFFFFFFF000, 0xFFFFFFFFFFFFFFF8};
+  for (const VSRTL_VT_U address : addresses)
+    mem->writeMem(address, address ^ 0x5A5A5A5A5A5A5A5A, 8);
+  for (const VSRTL_VT_U address : addresses) {
+    QCOMPARE(mem->readMem(address, 8), address ^ 0x5A5A5A5A5A5A5A5A);
+    QCOMPARE(mem->readMemConst(address, 8), address ^ 0x5A5A5A5A5A5A5A5A);
+    QVERIFY(mem->contains(address));
+  }
+
+  // Reads of unallocated memory return zero, and do not allocate.
+  const VSRTL_VT_U unallocated = 0x123456789000;
+  QCOMPARE(mem->readMem(unallocated, 8), VSRTL_VT_U(0));
+  QCOMPARE(mem->readMemConst(unallocated, 8), VSRTL_VT_U(0));
+  QVERIFY(!mem->contains(unallocated));
+  // An address in an allocated table, but an unallocated page.
+  QVERIFY(!mem->contains(0x7FFFFFFFE000));
+}
+
+void tst_Memory::testReset() {
+  auto mem = std::make_unique<PagedAddressSpace>();
+  const char image[] = "program image";
+  const VSRTL_VT_U imageAddress = s_page - 4;
+  mem->addInitializationMemory(imageAddress, image, sizeof(image));
+  mem->reset();
+  QCOMPARE(QString::fromStdString(mem->readCString(imageAddress)),
+           QString(image));
+
+  // Store to an image page after it has been cached by a read, and allocate a
+  // fresh page.
+  QCOMPARE(mem->readMem(imageAddress, 1), VSRTL_VT_U('p'));
+  mem->writeMem(imageAddress, 'P', 1);
+  mem->writeMem(s_page, 0, 4);
+  mem->writeMem(8 * s_page, 0xFFFFFFFF, 4);
+  QCOMPARE(QString::fromStdString(mem->readCString(imageAddress)),
+           QString("Prog"));
+  QVERIFY(mem->contains(8 * s_page));
+
+  mem->reset();
+  QCOMPARE(QString::fromStdString(mem->readCString(imageAddress)),
+           QString(image));
+  QCOMPARE(mem->readMem(8 * s_page, 4), VSRTL_VT_U(0));
+  QVERIFY(!mem->contains(8 * s_page));
+
+  // A new program image replaces the previous one upon reset.
+  mem->clearInitializationMemories();
+  mem->addInitializationMemory(2 * s_page, image, sizeof(image));
+  mem->reset();
+  QVERIFY(!mem->contains(imageAddress));
+  QCOMPARE(QString::fromStdString(mem->readCString(2 * s_page)),
+           QString(image));
+}
+
+void tst_Memory::testReferencedImage() {
+  auto mem = std::make_unique<PagedAddressSpace>();
+  // An image of two pages, offset into its memory as an ELF segment would be.
+  auto file = std::make_shared<std::vector<char>>(3 * s_page, 'a');
+  const char *image = file->data() + 8;
+  const VSRTL_VT_U imageAddress = s_page - 8;
+  std::weak_ptr<std::vector<char>> alive = file;
+  mem->addInitializationMemory(imageAddress, image, 2 * s_page, file);
+  file.reset();
+  QVERIFY(!alive.expired());
+  mem->reset();
+  QCOMPARE(mem->readMem(imageAddress, 8), VSRTL_VT_U(0x6161616161616161));
+  QCOMPARE(mem->readMem(3 * s_page - 9, 1), VSRTL_VT_U('a'));
+  QCOMPARE(mem->readMem(3 * s_page - 8, 1), VSRTL_VT_U(0));
+
+  // Writes copy the page, leaving the referenced memory untouched.
+  mem->writeMem(s_page, 'B', 1);
+  QCOMPARE(mem->readMem(s_page, 1), VSRTL_VT_U('B'));
+  QCOMPARE(alive.lock()->at(s_page + 8), 'a');
+  mem->reset();
+  QCOMPARE(mem->readMem(s_page, 1), VSRTL_VT_U('a'));
+
+  // The referenced memory is released with the program image.
+  mem->clearInitializationMemories();
+  mem->reset();
+  QVERIFY(alive.expired());
+}
+
+void tst_Memory::testBlockAccesses() {
+  auto mem = std::make_unique<PagedAddressSpace>();
+  std::vector<uint8_t> data(2 * s_page + 8);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i * 7);
+
+  // A block spanning three pages.
+  const VSRTL_VT_U address = s_page - 8;
+  mem->writeBlock(address, data.data(), data.size());
+  QCOMPARE(mem->readMem(address, 1), VSRTL_VT_U(data[0]));
+  QCOMPARE(mem->readMem(s_page, 1), VSRTL_VT_U(data[8]));
+  QCOMPARE(mem->readMem(address + data.size() - 1, 1),
+           VSRTL_VT_U(data.back()));
+
+  std::vector<uint8_t> read(data.size());
+  mem->readBlock(address, read.data(), read.size());
+  QVERIFY(read == data);
+
+  // A read extending into unallocated memory reads zeros there.
+  std::vector<uint8_t> tail(32, 0xFF);
+  mem->readBlock(address + data.size() - 16, tail.data(), tail.size());
+  QVERIFY(std::equal(tail.begin(), tail.begin() + 16, data.end() - 16));
+  QVERIFY(std::all_of(tail.begin() + 16, tail.end(),
+                      [](uint8_t b) { return b == 0; }));
+
+  // Blocks overlapping an IO region are dispatched byte-wise to the region.
+  addIORegion(*mem);
+  const uint8_t bytes[] = {1, 2, 3, 4};
+  mem->writeBlock(s_ioBase + s_ioSize - 2, bytes, sizeof(bytes));
+  QCOMPARE(m_ioWrites.size(), size_t{2});
+  QCOMPARE(m_ioWrites[0].offset, AInt(s_ioSize - 2));
+  QCOMPARE(m_ioWrites[1].value, VInt(2));
+  QCOMPARE(mem->readMem(s_ioBase + s_ioSize, 2), VSRTL_VT_U(0x0403));
+  uint8_t ioBytes[2];
+  mem->readBlock(s_ioBase, ioBytes, sizeof(ioBytes));
+  QCOMPARE(ioBytes[0], uint8_t(0x40));
+  QCOMPARE(ioBytes[1], uint8_t(0x41));
+}
+
+void tst_Memory::testCString() {
+  auto mem = std::make_unique<PagedAddressSpace>();
+  const char str[] = "crossing";
+  const VSRTL_VT_U address = s_page - 3;
+  mem->writeBlock(address, reinterpret_cast<const uint8_t *>(str),
+                  sizeof(str));
+  QCOMPARE(QString::fromStdString(mem->readCString(address)), QString(str));
+  QCOMPARE(QString::fromStdString(mem->readCString(address, 5)),
+           QString("cross"));
+  QCOMPARE(QString::fromStdString(mem->readCString(address + 3)),
+           QString("ssing"));
+
+  // A string running into unallocated memory is terminated there.
+  mem->writeMem(4 * s_page - 2, 'h' | ('i' << 8), 2);
+  QCOMPARE(QString::fromStdString(mem->readCString(4 * s_page - 2)),
+           QString("hi"));
+  QCOMPARE(QString::fromStdString(mem->readCString(8 * s_page)), QString());
+}
+
+void tst_Memory::testClearBlock() {
+  auto mem = std::make_unique<PagedAddressSpace>();
+  const std::vector<uint8_t> ones(4 * s_page, 0xFF);
+  mem->writeBlock(0, ones.data(), ones.size());
+
+  // Clear the end of the first page, all of the second and third page, and
+  // the start of the fourth page.
+  mem->clearBlock(s_page - 4, 2 * s_page + 8);
+  QCOMPARE(mem->readMem(s_page - 8, 4), VSRTL_VT_U(0xFFFFFFFF));
+  QCOMPARE(mem->readMem(s_page - 4, 4), VSRTL_VT_U(0));
+  QCOMPARE(mem->readMem(3 * s_page, 4), VSRTL_VT_U(0));
+  QCOMPARE(mem->readMem(3 * s_page + 4, 4), VSRTL_VT_U(0xFFFFFFFF));
+  // Whole pages are released.
+  QVERIFY(mem->contains(0));
+  QVERIFY(!mem->contains(s_page));
+  QVERIFY(!mem->contains(2 * s_page));
+  QVERIFY(mem->contains(3 * s_page));
+
+  // Released pages of the program image are restored upon reset.
+  const char image[] = "image";
+  mem->addInitializationMemory(8 * s_page, image, sizeof(image));
+  mem->reset();
+  mem->clearBlock(8 * s_page, s_page);
+  QVERIFY(!mem->contains(8 * s_page));
+  mem->reset();
+  QCOMPARE(QString::fromStdString(mem->readCString(8 * s_page)),
+           QString(image));
+}
+
+void tst_Memory::testProgramReset() {
+  // Stores to the page holding the .data section, and to a fresh page.
+  const QString source = "   .data\n"
+                         "word: .word 0x11223344\n"
+                         "   .text\n"
+                         "la t0, word\n"
+                         "li t1, 0x55\n"
+                         "sw t1, 0(t0)\n"
+                         "li t2, 0x20000000\n"
+                         "sw t1, 0(t2)\n"
+                         "li a7, 10\n"
+                         "ecall\n";
+  const VSRTL_VT_U data =
+      RipesSettings::value(RIPES_SETTING_ASSEMBLER_DATASTART).toULongLong();
+  const VSRTL_VT_U fresh = 0x20000000;
+
+  for (const ProcessorID id : {ProcessorID::RV32_SS, ProcessorID::RV32_5S}) {
+    ProcessorHandler::selectProcessor(id, {"M"});
+    const auto program =
+        ProcessorHandler::getAssembler()->assembleRaw(source);
+    QVERIFY(program.errors.size() == 0);
+    ProcessorHandler::get()->loadProgram(
+        std::make_shared<Program>(program.program));
+    RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+
+    auto &mem = ProcessorHandler::getMemory();
+    // Run the program twice, such that the second run starts from a reset
+    // address space rather than a freshly loaded one.
+    for (unsigned run = 0; run < 2; ++run) {
+      QCOMPARE(mem.readMemConst(data, 4), VSRTL_VT_U(0x11223344));
+      QVERIFY(!mem.contains(fresh));
+
+      auto *proc = ProcessorHandler::getProcessorNonConst();
+      while (!proc->finished() && proc->getCycleCount() < 100)
+        proc->clock();
+      QVERIFY(proc->finished());
+      QCOMPARE(mem.readMemConst(data, 4), VSRTL_VT_U(0x55));
+      QCOMPARE(mem.readMemConst(fresh, 4), VSRTL_VT_U(0x55));
+
+      RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+    }
+    QCOMPARE(mem.readMemConst(data, 4), VSRTL_VT_U(0x11223344));
+    QCOMPARE(mem.readMemConst(fresh, 4), VSRTL_VT_U(0));
+    QVERIFY(!mem.contains(fresh));
+  }
+}
+
+QTEST_APPLESS_MAIN(tst_Memory)
+#include "tst_memory.moc"
@@ -57,6 +57,7 @@ private:
 
   void runTests(const ProcessorID &id, const QStringList &extensions,
                 const QStringList &testdirs);
+  void runProgram(const QString &source);
 
   void trapHandler();
 
@@ -108,6 +109,10 @@ private slots:
     runTests(ProcessorID::RV64_5S_3S, {"M", "C"},
              {RISCV64_TEST_DIR, RISCV64_C_TEST_DIR});
   }
+  void testRV64_5Stage_BranchPrediction() {
+    runTests(ProcessorID::RV64_5S_BP, {"M", "C"},
+             {RISCV64_TEST_DIR, RISCV64_C_TEST_DIR});
+  }
   void testRV32_5Stage_1Slot() {
     runTests(ProcessorID::RV32_5S_1S, {"M", "C"},
              {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR});
@@ -116,8 +121,101 @@ private slots:
     runTests(ProcessorID::RV32_5S_3S, {"M", "C"},
              {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR});
   }
+  void testRV32_5Stage_BranchPrediction() {
+    runTests(ProcessorID::RV32_5S_BP, {"M", "C"},
+             {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR});
+  }
+  void testRV32_OutOfOrder() {
+    runTests(ProcessorID::RV32_OOO, {"M", "C"},
+             {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR});
+  }
+  void testRV32_InOrder2() {
+    runTests(ProcessorID::RV32_INORDER_2, {"M", "C"},
+             {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR});
+  }
+  void testRV32_InOrder4() {
+    runTests(ProcessorID::RV32_INORDER_4, {"M", "C"},
+             {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR});
+  }
+  void testRV32_InOrder8() {
+    runTests(ProcessorID::RV32_INORDER_8, {"M", "C"},
+             {RISCV32_TEST_DIR, RISCV32_C_TEST_DIR});
+  }
+
+  void testCounterCSRs();
 };
 
+/// Reads the counter CSRs through the Zicsr instructions and pseudo
+/// instructions. The instret delta across a straight-line sequence must equal
+/// the length of the sequence, and cycleh:cycle must read as a consistent
+/// 64-bit value.
+static const QString s_counterProgram = R"(
+.text
+test_1: # instret delta over 8 instructions
+    li gp, 1
+    rdinstret t0
+    addi s2, x0, 1
+    addi s3, x0, 2
+    addi s4, x0, 3
+    addi s5, x0, 4
+    addi s6, x0, 5
+    addi s7, x0, 6
+    addi s8, x0, 7
+    rdinstret t1
+    sub t1, t1, t0
+    li t2, 8
+    bne t1, t2, fail
+
+test_2: # csrr by name matches rdinstret
+    li gp, 2
+    csrr t0, instret
+    rdinstret t1
+    sub t1, t1, t0
+    li t2, 1
+    bne t1, t2, fail
+
+test_3: # cycleh:cycle, re-reading cycleh until it is stable
+    li gp, 3
+read_cycle:
+    rdcycleh t0
+    rdcycle t1
+    rdcycleh t2
+    bne t0, t2, read_cycle
+    bnez t0, fail # fewer than 2^32 cycles have elapsed
+    beqz t1, fail
+    rdcycle t3
+    bgeu t1, t3, fail
+
+test_4: # csrrw and csrrwi read the counter into rd
+    li gp, 4
+    li t0, 0
+    csrrw t0, 0xC02, x0
+    beqz t0, fail
+    li t1, 0
+    csrrwi t1, 0xC00, 0
+    beqz t1, fail
+
+pass:
+    li a0, 42
+    li a7, 93
+    ecall
+
+fail:
+    li a0, 0
+    li a7, 93
+    ecall
+)";
+
+void tst_RISCV::testCounterCSRs() {
+  for (const auto id : {ProcessorID::RV32_SS, ProcessorID::RV32_5S}) {
+    ProcessorHandler::selectProcessor(id, {"M"});
+    m_currentTest = "counter CSRs on " + enumToString(id);
+    runProgram(s_counterProgram);
+    if (QTest::currentTestFailed())
+      return;
+  }
+}
+
 bool tst_RISCV::skipTest(const QString &test) {
   for (const auto &t : s_excludedTests) {
     if (test.startsWith(t)) {
@@ -221,42 +319,47 @@ void tst_RISCV::runTests(const ProcessorID &id, const QStringList &extensions,
       if (!f.open(QIODevice::ReadOnly)) {
         QFAIL("Could not open test file");
       }
-      const auto program =
-          ProcessorHandler::getAssembler()->assembleRaw(QString(f.readAll()));
-      if (program.errors.size() != 0) {
-        QString err = "Could not assemble program";
-        err += "\n errors were:";
-        err += program.errors.toString();
-        QFAIL(err.toStdString().c_str());
-      }
-      auto spProgram = std::make_shared<Program>(program.program);
-
-      // Override the ProcessorHandler's ECALL Exit2 handling. In doing so, we
-      // verify whether the correct test value was reached.
-      ProcessorHandler::getProcessorNonConst()->trapHandler = [=] {
-        if (ProcessorHandler::getProcessor()->getRegister(
-                RVISA::GPR, s_ecallopreg) == RVABI::Exit2) {
-          trapHandler();
-        } else {
-          const unsigned int function =
-              ProcessorHandler::getProcessor()->getRegister(RVISA::GPR,
-                                                            s_ecallopreg);
-          ProcessorHandler::getSyscallManagerNonConst().execute(function);
-        }
-      };
-      ProcessorHandler::get()->loadProgram(spProgram);
-      RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
-
-      const QString err = executeSimulator();
-      if (!err.isNull()) {
-        QFAIL(err.toStdString().c_str());
-      }
-
-      qInfo() << "Test '" << m_currentTest << "' succeeded.";
+      runProgram(QString(f.readAll()));
+      if (QTest::currentTestFailed())
+        return;
+    }
+  }
+}
 
-      SystemIO::reset(); // Close open files in between tests
+void tst_RISCV::runProgram(const QString &source) {
+  const auto program = ProcessorHandler::getAssembler()->assembleRaw(source);
+  if (program.errors.size() != 0) {
+    QString err = "Could not assemble program";
+    err += "\n errors were:";
+    err += program.errors.toString();
+    QFAIL(err.toStdString().c_str());
+  }
+  auto spProgram = std::make_shared<Program>(program.program);
+
+  // Override the ProcessorHandler's ECALL Exit2 handling. In doing so, we
+  // verify whether the correct test value was reached.
+  ProcessorHandler::getProcessorNonConst()->trapHandler = [=] {
+    if (ProcessorHandler::getProcessor()->getRegister(
+            RVISA::GPR, s_ecallopreg) == RVABI::Exit2) {
+      trapHandler();
+    } else {
+      const unsigned int function =
+          ProcessorHandler::getProcessor()->getRegister(RVISA::GPR,
+                                                        s_ecallopreg);
+      ProcessorHandler::getSyscallManagerNonConst().execute(function);
     }
+  };
+  ProcessorHandler::get()->loadProgram(spProgram);
+  RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+
+  const QString err = executeSimulator();
+  if (!err.isNull()) {
+    QFAIL(err.toStdString().c_str());
   }
+
+  qInfo() << "Test '" << m_currentTest << "' succeeded.";
+
+  SystemIO::reset(); // Close open files in between tests
 }
 
 QTEST_APPLESS_MAIN(tst_RISCV)
@@ -0,0 +1,197 @@
+#include <QDir>
+#include <QTemporaryDir>
+#include <QtTest/QTest>
+
+#include <iostream>
+
+#include "cli/simpointrunner.h"
+#include "isa/rvisainfo_common.h"
+#include "processorhandler.h"
+#include "regionofinterest.h"
+
+/**
+ * Sampled simulation
+ * Executes the bundled test programs in simpoint mode with validation enabled.
+ * The CPI and cache miss rates extrapolated from the simulation points are
+ * reported alongside those measured by simulating the whole program in detail,
+ * and the test fails if the estimates deviate beyond a fixed tolerance.
+ *
+ * Checkpoints written on the single-cycle processor are resumed on a pipelined
+ * processor (as by the workers of the parallel mode), and the final register
+ * state is compared to that of an uninterrupted run.
+ */
+
+using namespace Ripes;
+
+const QString s_testdir = RISCV32_TEST_DIR;
+
+// Grows the heap and writes to it before the checkpoint, and moves the program
+// break again after it. The program break must be restored along with the
+// checkpoint for the heap to keep its contents.
+static const char s_brkProgram[] = "li a0, 0\n"
+                                   "li a7, 214\n" // brk
+                                   "ecall\n"
+                                   "mv s1, a0\n"
+                                   "addi a0, s1, 64\n"
+                                   "ecall\n"
+                                   "li t0, 0x1234\n"
+                                   "sw t0, 0(s1)\n"
+                                   "li t1, 2000\n"
+                                   "loop:\n"
+                                   "addi t1, t1, -1\n"
+                                   "bnez t1, loop\n"
+                                   "li a0, 0\n"
+                                   "li a7, 214\n" // brk
+                                   "ecall\n"
+                                   "mv s2, a0\n"
+                                   "addi a0, s2, 64\n"
+                                   "ecall\n"
+                                   "mv s3, a0\n"
+                                   "lw s4, 0(s1)\n"
+                                   "li a7, 10\n"
+                                   "ecall\n";
+
+// Maximum relative error of the CPI estimate, and maximum absolute error of the
+// cache miss rate estimates.
+static constexpr double s_cpiTolerance = 0.1;
+static constexpr double s_missRateTolerance = 0.05;
+
+/// Writes a checkpoint of the program after a number of instructions.
+class CheckpointWriter : public CLIRunner {
+public:
+  CheckpointWriter(const CLIModeOptions &options) : CLIRunner(options) {}
+
+  QString write(uint64_t instructions, const QString &path) {
+    if (processInput())
+      return "Failed to process input";
+    reselectProcessor(functionalProcessor());
+    MemoryWriteTracker tracker;
+    runUntilRetired(instructions);
+    return ArchCheckpoint::capture(tracker).write(path);
+  }
+};
+
+class tst_SimPoint : public QObject {
+  Q_OBJECT
+
+private:
+  void sampledSimulation(const QString &program, SourceType type,
+                         ProcessorID id);
+  void checkpointResume(const QString &path, SourceType type, ProcessorID id,
+                        uint64_t instructions);
+  static QString testFile(const QString &program) {
+    return s_testdir + QDir::separator() + program;
+  }
+
+private slots:
+  void testRanPi5S() {
+    sampledSimulation("../../examples/ELF/RanPi-RV32",
+                      SourceType::ExternalELF, ProcessorID::RV32_5S);
+  }
+  void testRanPi6SDual() {
+    sampledSimulation("../../examples/ELF/RanPi-RV32",
+                      SourceType::ExternalELF, ProcessorID::RV32_6S_DUAL);
+  }
+  void testComplexMul5S() {
+    sampledSimulation("../../examples/assembly/complexMul.s",
+                      SourceType::Assembly, ProcessorID::RV32_5S);
+  }
+  void testCheckpointResume5S() {
+    checkpointResume(testFile("../../examples/ELF/RanPi-RV32"),
+                     SourceType::ExternalELF, ProcessorID::RV32_5S, 5000);
+  }
+  void testCheckpointResume6SDual() {
+    checkpointResume(testFile("../../examples/ELF/RanPi-RV32"),
+                     SourceType::ExternalELF, ProcessorID::RV32_6S_DUAL, 5000);
+  }
+  void testCheckpointResumeBrk() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QFile file(dir.filePath("brk.s"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(s_brkProgram);
+    file.close();
+    checkpointResume(file.fileName(), SourceType::Assembly,
+                     ProcessorID::RV32_5S, 50);
+  }
+};
+
+void tst_SimPoint::sampledSimulation(const QString &program, SourceType type,
+                                     ProcessorID id) {
+  CLIModeOptions options;
+  options.src = s_testdir + QDir::separator() + program;
+  options.srcType = type;
+  options.proc = id;
+  options.isaExtensions = {"M"};
+  options.outputFile = QDir::temp().filePath("tst_simpoint.txt");
+  options.dcache = CachePreset{"l1d",
+                               /*blocks=*/2,
+                               /*lines=*/5,
+                               /*ways=*/1,
+                               WritePolicy::WriteBack,
+                               WriteAllocPolicy::WriteAllocate,
+                               ReplPolicy::LRU};
+
+  SimPointOptions spOptions;
+  spOptions.intervalLength = 1000;
+  spOptions.warmup = 1000;
+  spOptions.validate = true;
+
+  SimPointRunner runner(options, spOptions);
+  QCOMPARE(runner.run(), 0);
+  QVERIFY(!runner.points().empty());
+
+  std::cout << program.toStdString() << " on "
+            << ProcessorRegistry::getDescription(id).name.toStdString()
+            << ": " << runner.points().size() << " of "
+            << runner.profile().intervals.size() << " intervals\n";
+  for (const auto &estimate : runner.estimates()) {
+    QVERIFY(estimate.measured.has_value());
+    const double error = estimate.value - *estimate.measured;
+    std::cout << "  " << estimate.name.toStdString()
+              << ": estimated " << estimate.value << " +- " << estimate.bound
+              << ", measured " << *estimate.measured << std::endl;
+    if (estimate.name == "CPI")
+      QVERIFY(std::abs(error) <= s_cpiTolerance * *estimate.measured);
+    else
+      QVERIFY(std::abs(error) <= s_missRateTolerance);
+  }
+}
+
+void tst_SimPoint::checkpointResume(const QString &path, SourceType type,
+                                    ProcessorID id, uint64_t instructions) {
+  constexpr uint64_t warmup = 1000;
+  CLIModeOptions options;
+  options.src = path;
+  options.srcType = type;
+  options.proc = id;
+  options.isaExtensions = {"M"};
+  options.outputFile = QDir::temp().filePath("tst_simpoint.txt");
+
+  // Uninterrupted run.
+  QCOMPARE(CLIRunner(options).run(), 0);
+  const auto *proc = ProcessorHandler::getProcessor();
+  const long long totalInstructions = proc->getInstructionsRetired();
+  std::vector<VInt> expected;
+  for (unsigned i = 0; i < 32; ++i)
+    expected.push_back(proc->getRegister(RVISA::GPR, i));
+
+  const QString checkpoint = QDir::temp().filePath("tst_simpoint.ckpt");
+  const QString err = CheckpointWriter(options).write(instructions, checkpoint);
+  QVERIFY2(err.isEmpty(), err.toStdString().c_str());
+
+  // Resumed run; the region of interest covers all instructions after the
+  // warmup.
+  options.checkpointFile = checkpoint;
+  options.checkpointWarmup = warmup;
+  QCOMPARE(CLIRunner(options).run(), 0);
+  proc = ProcessorHandler::getProcessor();
+  for (unsigned i = 0; i < 32; ++i)
+    QCOMPARE(proc->getRegister(RVISA::GPR, i), expected[i]);
+  const auto roi = RegionOfInterest::report(/*json=*/true).toMap();
+  QCOMPARE(roi["instructions"].toLongLong(),
+           totalInstructions - static_cast<long long>(instructions + warmup));
+}
+
+QTEST_MAIN(tst_SimPoint)
+#include "tst_simpoint.moc"
@@ -0,0 +1,609 @@
+#include <QtTest/QTest>
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "processorhandler.h"
+#include "processorregistry.h"
+#include "processstate.h"
+#include "ripessettings.h"
+#include "rvisainfo_common.h"
+#include "systemio.h"
+
+/**
+ * System calls
+ * Runs assembled programs which exercise the system calls on the single-cycle
+ * processor, and checks their return values, the memory written by them and
+ * the files on disk.
+ */
+
+using namespace Ripes;
+
+// Registers holding the results of the test programs
+static constexpr unsigned s0 = 8, s1 = 9, s2 = 18, s3 = 19, s4 = 20, s5 = 21,
+                          s6 = 22, s7 = 23;
+static constexpr unsigned sp = 2;
+
+static constexpr unsigned s_maxCycles = 1000;
+
+class tst_Syscall : public QObject {
+  Q_OBJECT
+
+private:
+  bool runProgram(const QString &source);
+  QString path(const QString &name) const { return m_dir.filePath(name); }
+  static QByteArray fileContents(const QString &path);
+  static QByteArray readMem(AInt address, unsigned size);
+  static int64_t readInt(AInt address, unsigned size) {
+    return ProcessorHandler::getMemory().readMemConst(address, size);
+  }
+  static AInt dataStart() {
+    return RipesSettings::value(RIPES_SETTING_ASSEMBLER_DATASTART)
+        .toULongLong();
+  }
+  static int32_t reg(unsigned idx) {
+    return static_cast<int32_t>(
+        ProcessorHandler::getRegisterValue(RVISA::GPR, idx));
+  }
+
+  QTemporaryDir m_dir;
+
+private slots:
+  void testBinaryRoundTrip();
+  void testInterleavedAccess();
+  void testFlushOnCloseAndReset();
+  void testManyFiles();
+  void testOutputReset();
+  void testOutputOrdering();
+  void testBrk();
+  void testMmap();
+  void testFStat();
+  void testTime();
+};
+
+/// Assembles, loads and runs @p source until it exits, or for s_maxCycles
+/// cycles. Returns false if the program did not exit.
+bool tst_Syscall::runProgram(const QString &source) {
+  ProcessorHandler::selectProcessor(ProcessorID::RV32_SS, {"M"});
+  const auto program = ProcessorHandler::getAssembler()->assembleRaw(source);
+  if (program.errors.size() != 0)
+    return false;
+  ProcessorHandler::get()->loadProgram(
+      std::make_shared<Program>(program.program));
+  RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+
+  auto *proc = ProcessorHandler::getProcessorNonConst();
+  while (!proc->finished() && proc->getCycleCount() < s_maxCycles)
+    proc->clock();
+  return proc->finished();
+}
+
+QByteArray tst_Syscall::fileContents(const QString &path) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly))
+    return QByteArray();
+  return file.readAll();
+}
+
+QByteArray tst_Syscall::readMem(AInt address, unsigned size) {
+  QByteArray data(size, Qt::Uninitialized);
+  ProcessorHandler::getMemory().readBlock(
+      address, reinterpret_cast<uint8_t *>(data.data()), size);
+  return data;
+}
+
+void tst_Syscall::testBinaryRoundTrip() {
+  QVERIFY(m_dir.isValid());
+  const QString file = path("binary.bin");
+  // Bytes which were mangled by text streams: NUL, line endings, ^Z, and
+  // bytes which are not valid UTF-8.
+  const QByteArray bytes("\x00\x0a\x0d\x1a\x7f\x80\xfe\xff", 8);
+  const QString source = QString("   .data\n"
+                                 "buf: .zero 16\n"
+                                 "bytes: .byte 0x00, 0x0a, 0x0d, 0x1a, 0x7f, "
+                                 "0x80, 0xfe, 0xff\n"
+                                 "path: .string \"%1\"\n"
+                                 "   .text\n"
+                                 "la a0, path\n"
+                                 "li a1, 0x1102\n" // O_RDWR|O_CREAT|O_TRUNC
+                                 "li a7, 1024\n"   // open
+                                 "ecall\n"
+                                 "mv s0, a0\n"
+                                 "la a1, bytes\n"
+                                 "li a2, 8\n"
+                                 "li a7, 64\n" // write
+                                 "ecall\n"
+                                 "mv s1, a0\n"
+                                 "mv a0, s0\n"
+                                 "li a1, 0\n"
+                                 "li a2, 0\n"  // SEEK_SET
+                                 "li a7, 62\n" // lseek
+                                 "ecall\n"
+                                 "mv a0, s0\n"
+                                 "la a1, buf\n"
+                                 "li a2, 16\n"
+                                 "li a7, 63\n" // read
+                                 "ecall\n"
+                                 "mv s2, a0\n"
+                                 "mv a0, s0\n"
+                                 "la a1, buf\n"
+                                 "li a2, 16\n"
+                                 "li a7, 63\n" // read at end of file
+                                 "ecall\n"
+                                 "mv s3, a0\n"
+                                 "mv a0, s0\n"
+                                 "li a7, 57\n" // close
+                                 "ecall\n"
+                                 "li a7, 10\n"
+                                 "ecall\n")
+                             .arg(file);
+  QVERIFY(runProgram(source));
+
+  QVERIFY(reg(s0) >= 3);
+  QCOMPARE(reg(s1), 8);
+  QCOMPARE(reg(s2), 8);
+  QCOMPARE(reg(s3), 0);
+  QCOMPARE(readMem(dataStart(), 16), bytes + QByteArray(8, '\0'));
+  QCOMPARE(fileContents(file), bytes);
+}
+
+void tst_Syscall::testInterleavedAccess() {
+  QVERIFY(m_dir.isValid());
+  const QString file = path("interleaved.txt");
+  const QString source = QString("   .data\n"
+                                 "buf: .zero 16\n"
+                                 "msg: .string \"abcdefXY\"\n"
+                                 "path: .string \"%1\"\n"
+                                 "   .text\n"
+                                 "la a0, path\n"
+                                 "li a1, 0x1102\n" // O_RDWR|O_CREAT|O_TRUNC
+                                 "li a7, 1024\n"   // open
+                                 "ecall\n"
+                                 "mv s0, a0\n"
+                                 // "abcdef"
+                                 "la a1, msg\n"
+                                 "li a2, 6\n"
+                                 "li a7, 64\n" // write
+                                 "ecall\n"
+                                 // Read "cd"
+                                 "mv a0, s0\n"
+                                 "li a1, 2\n"
+                                 "li a2, 0\n"  // SEEK_SET
+                                 "li a7, 62\n" // lseek
+                                 "ecall\n"
+                                 "mv s1, a0\n"
+                                 "mv a0, s0\n"
+                                 "la a1, buf\n"
+                                 "li a2, 2\n"
+                                 "li a7, 63\n" // read
+                                 "ecall\n"
+                                 "mv s2, a0\n"
+                                 // Overwrite "ef" with "XY"
+                                 "mv a0, s0\n"
+                                 "la a1, msg\n"
+                                 "addi a1, a1, 6\n"
+                                 "li a2, 2\n"
+                                 "li a7, 64\n" // write
+                                 "ecall\n"
+                                 "mv a0, s0\n"
+                                 "li a1, 0\n"
+                                 "li a2, 1\n"  // SEEK_CUR
+                                 "li a7, 62\n" // lseek
+                                 "ecall\n"
+                                 "mv s3, a0\n"
+                                 // Read "Y"
+                                 "mv a0, s0\n"
+                                 "li a1, -1\n"
+                                 "li a2, 2\n"  // SEEK_END
+                                 "li a7, 62\n" // lseek
+                                 "ecall\n"
+                                 "mv s4, a0\n"
+                                 "mv a0, s0\n"
+                                 "la a1, buf\n"
+                                 "addi a1, a1, 2\n"
+                                 "li a2, 4\n"
+                                 "li a7, 63\n" // read
+                                 "ecall\n"
+                                 "mv s5, a0\n"
+                                 // Read the whole file
+                                 "mv a0, s0\n"
+                                 "li a1, 0\n"
+                                 "li a2, 0\n"  // SEEK_SET
+                                 "li a7, 62\n" // lseek
+                                 "ecall\n"
+                                 "mv a0, s0\n"
+                                 "la a1, buf\n"
+                                 "addi a1, a1, 3\n"
+                                 "li a2, 16\n"
+                                 "li a7, 63\n" // read
+                                 "ecall\n"
+                                 "mv s6, a0\n"
+                                 "mv a0, s0\n"
+                                 "li a7, 57\n" // close
+                                 "ecall\n"
+                                 "li a7, 10\n"
+                                 "ecall\n")
+                             .arg(file);
+  QVERIFY(runProgram(source));
+
+  QCOMPARE(reg(s1), 2);
+  QCOMPARE(reg(s2), 2);
+  QCOMPARE(reg(s3), 6);
+  QCOMPARE(reg(s4), 5);
+  QCOMPARE(reg(s5), 1);
+  QCOMPARE(reg(s6), 6);
+  QCOMPARE(readMem(dataStart(), 9), QByteArray("cdYabcdXY"));
+  QCOMPARE(fileContents(file), QByteArray("abcdXY"));
+}
+
+void tst_Syscall::testFlushOnCloseAndReset() {
+  QVERIFY(m_dir.isValid());
+  const QString closed = path("closed.txt");
+  const QString open = path("open.txt");
+  // Writes to two files, of which only the first is closed, and spins without
+  // exiting.
+  const QString source = QString("   .data\n"
+                                 "msg: .string \"close reset\"\n"
+                                 "closed: .string \"%1\"\n"
+                                 "open: .string \"%2\"\n"
+                                 "   .text\n"
+                                 "la a0, closed\n"
+                                 "li a1, 0x1101\n" // O_WRONLY|O_CREAT|O_TRUNC
+                                 "li a7, 1024\n"   // open
+                                 "ecall\n"
+                                 "mv s0, a0\n"
+                                 "la a1, msg\n"
+                                 "li a2, 5\n"
+                                 "li a7, 64\n" // write
+                                 "ecall\n"
+                                 "mv a0, s0\n"
+                                 "li a7, 57\n" // close
+                                 "ecall\n"
+                                 "la a0, open\n"
+                                 "li a1, 0x1101\n" // O_WRONLY|O_CREAT|O_TRUNC
+                                 "li a7, 1024\n"   // open
+                                 "ecall\n"
+                                 "la a1, msg\n"
+                                 "addi a1, a1, 6\n"
+                                 "li a2, 5\n"
+                                 "li a7, 64\n" // write
+                                 "ecall\n"
+                                 "loop: j loop\n")
+                             .arg(closed, open);
+  QVERIFY(!runProgram(source));
+
+  // Closing a file writes its buffered data, whereas the data of the file
+  // which is still open remains buffered.
+  QCOMPARE(fileContents(closed), QByteArray("close"));
+  QVERIFY(QFile::exists(open));
+  QCOMPARE(fileContents(open), QByteArray());
+
+  // Reset closes the files of the program.
+  RipesSettings::getObserver(RIPES_GLOBALSIGNAL_REQRESET)->trigger();
+  QCOMPARE(fileContents(open), QByteArray("reset"));
+}
+
+void tst_Syscall::testManyFiles() {
+  QVERIFY(m_dir.isValid());
+  constexpr int nFiles = 200;
+  constexpr unsigned flags = 0x1101; // O_WRONLY|O_CREAT|O_TRUNC
+  SystemIO::reset();
+  std::set<int> fds;
+  for (int i = 0; i < nFiles; ++i) {
+    const int fd = SystemIO::openFile(path(QString("many%1").arg(i)), flags);
+    QVERIFY(fd >= 3);
+    fds.insert(fd);
+    const QByteArray data = QByteArray::number(i);
+    QCOMPARE(SystemIO::writeToFile(fd, data), static_cast<int>(data.size()));
+  }
+  QCOMPARE(fds.size(), size_t{nFiles});
+  for (const int fd : fds)
+    SystemIO::closeFile(fd);
+  for (int i = 0; i < nFiles; ++i)
+    QCOMPARE(fileContents(path(QString("many%1").arg(i))),
+             QByteArray::number(i));
+}
+
+void tst_Syscall::testOutputReset() {
+  QString printed;
+  auto connection = connect(&SystemIO::get(), &SystemIO::doPrint,
+                            [&](const QString &text) {
+                              printed += text;
+                              // Receivers may print while output is delivered.
+                              if (text == "first")
+                                SystemIO::flushOutput();
+                            });
+
+  SystemIO::printString("first");
+  SystemIO::flushOutput();
+  QCOMPARE(printed, QString("first"));
+
+  // Output which has not been delivered is discarded on reset.
+  SystemIO::printString("second");
+  SystemIO::reset();
+  SystemIO::flushOutput();
+  QCOMPARE(printed, QString("first"));
+
+  disconnect(connection);
+}
+
+void tst_Syscall::testOutputOrdering() {
+  constexpr int nPrints = 2000;
+  QString expected;
+  for (int i = 0; i < nPrints; ++i)
+    expected += QString::number(i) + ' ';
+
+  QString printed;
+  std::mutex printedMutex;
+  auto connection = connect(
+      &SystemIO::get(), &SystemIO::doPrint, &SystemIO::get(),
+      [&](const QString &text) {
+        // A slow receiver widens the window in which a delivery could
+        // overtake another.
+        QThread::usleep(20);
+        std::lock_guard<std::mutex> lock(printedMutex);
+        printed += text;
+      },
+      Qt::DirectConnection);
+
+  // One thread prints and delivers the output, while another thread flushes
+  // concurrently, as the flush timer of the GUI thread does.
+  std::atomic<bool> done = false;
+  std::thread printer([&] {
+    for (int i = 0; i < nPrints; ++i) {
+      SystemIO::printString(QString::number(i) + ' ');
+      if (i % 16 == 0)
+        SystemIO::flushOutput();
+    }
+    done = true;
+  });
+  while (!done)
+    SystemIO::flushOutput();
+  printer.join();
+  SystemIO::flushOutput();
+
+  disconnect(connection);
+  QCOMPARE(printed, expected);
+}
+
+void tst_Syscall::testBrk() {
+  const QString source = "   .data\n"
+                         "word: .word 0x11223344\n"
+                         "   .text\n"
+                         "li a0, 0\n"
+                         "li a7, 214\n" // brk
+                         "ecall\n"
+                         "mv s0, a0\n"
+                         "addi a0, s0, 100\n"
+                         "ecall\n"
+                         "mv s1, a0\n"
+                         // The heap is zeroed, and can be written
+                         "lw s2, 96(s0)\n"
+                         "li t0, 0x55\n"
+                         "sw t0, 96(s0)\n"
+                         // Moving the break below the heap fails
+                         "li a0, 4\n"
+                         "ecall\n"
+                         "mv s3, a0\n"
+                         // Shrinking the heap
+                         "mv a0, s0\n"
+                         "ecall\n"
+                         "mv s4, a0\n"
+                         "li a7, 10\n"
+                         "ecall\n";
+  QVERIFY(runProgram(source));
+
+  // The heap starts at the page following the program.
+  const int32_t start = reg(s0);
+  QVERIFY(start > 0);
+  QCOMPARE(start % 4096, 0);
+  QVERIFY(AInt(start) >= dataStart() + 4);
+  QVERIFY(AInt(start) < dataStart() + 4 + 4096);
+  QCOMPARE(reg(s1), start + 100);
+  QCOMPARE(reg(s2), 0);
+  QCOMPARE(readInt(start + 96, 4), int64_t{0x55});
+  // On error, the current break is returned.
+  QCOMPARE(reg(s3), start + 100);
+  QCOMPARE(reg(s4), start);
+}
+
+void tst_Syscall::testMmap() {
+  const QString source = "li a0, 0\n"
+                         "li a1, 8192\n"
+                         "li a2, 3\n"    // PROT_READ|PROT_WRITE
+                         "li a3, 0x22\n" // MAP_PRIVATE|MAP_ANONYMOUS
+                         "li a4, -1\n"
+                         "li a5, 0\n"
+                         "li a7, 222\n" // mmap
+                         "ecall\n"
+                         "mv s0, a0\n"
+                         "li t0, 0x1234\n"
+                         "sw t0, 0(s0)\n"
+                         // A second mapping is placed below the first
+                         "li a0, 0\n"
+                         "li a1, 100\n"
+                         "ecall\n"
+                         "mv s1, a0\n"
+                         // Not an anonymous mapping
+                         "li a1, 4096\n"
+                         "li a3, 0x02\n" // MAP_PRIVATE
+                         "ecall\n"
+                         "mv s2, a0\n"
+                         // Empty mapping
+                         "li a1, 0\n"
+                         "li a3, 0x22\n"
+                         "ecall\n"
+                         "mv s3, a0\n"
+                         // Unmapping the first mapping
+                         "mv a0, s0\n"
+                         "li a1, 8192\n"
+                         "li a7, 215\n" // munmap
+                         "ecall\n"
+                         "mv s4, a0\n"
+                         // Unaligned address
+                         "addi a0, s1, 1\n"
+                         "li a1, 4096\n"
+                         "ecall\n"
+                         "mv s5, a0\n"
+                         // A fixed mapping replaces the contents of memory
+                         "sw t0, 0(s0)\n"
+                         "mv a0, s0\n"
+                         "li a1, 4096\n"
+                         "li a3, 0x32\n" // MAP_PRIVATE|MAP_ANONYMOUS|MAP_FIXED
+                         "li a7, 222\n"  // mmap
+                         "ecall\n"
+                         "mv s6, a0\n"
+                         "lw s7, 0(s0)\n"
+                         "li a7, 10\n"
+                         "ecall\n";
+  QVERIFY(runProgram(source));
+
+  // Mappings are allocated top-down, 8 MiB below the stack.
+  const int32_t top = (reg(sp) & ~0xfff) - 8 * 1024 * 1024;
+  QCOMPARE(reg(s0), top - 8192);
+  QCOMPARE(reg(s1), top - 8192 - 4096);
+  QCOMPARE(reg(s2), -ProcessState::NoDevice);
+  QCOMPARE(reg(s3), -ProcessState::InvalidArgument);
+  QCOMPARE(reg(s4), 0);
+  QCOMPARE(reg(s5), -ProcessState::InvalidArgument);
+  QCOMPARE(reg(s6), reg(s0));
+  QCOMPARE(reg(s7), 0);
+
+  // A mapping which does not fit below the stack
+  const QString tooLarge = "li a0, 0\n"
+                           "li a1, -4096\n"
+                           "li a3, 0x22\n" // MAP_PRIVATE|MAP_ANONYMOUS
+                           "li a7, 222\n"  // mmap
+                           "ecall\n"
+                           "mv s0, a0\n"
+                           "li a7, 10\n"
+                           "ecall\n";
+  QVERIFY(runProgram(tooLarge));
+  QCOMPARE(reg(s0), -ProcessState::NoMemory);
+}
+
+void tst_Syscall::testFStat() {
+  QVERIFY(m_dir.isValid());
+  const QString file = path("fstat.txt");
+  const QString source = QString("   .data\n"
+                                 "st: .zero 128\n"
+                                 "stdout: .zero 128\n"
+                                 "path: .string \"%1\"\n"
+                                 "   .text\n"
+                                 "la a0, path\n"
+                                 "li a1, 0x1101\n" // O_WRONLY|O_CREAT|O_TRUNC
+                                 "li a7, 1024\n"   // open
+                                 "ecall\n"
+                                 "mv s0, a0\n"
+                                 "la a1, path\n"
+                                 "li a2, 10\n"
+                                 "li a7, 64\n" // write
+                                 "ecall\n"
+                                 "mv a0, s0\n"
+                                 "la a1, st\n"
+                                 "li a7, 80\n" // fstat
+                                 "ecall\n"
+                                 "mv s1, a0\n"
+                                 "li a0, 1\n"
+                                 "la a1, stdout\n"
+                                 "ecall\n"
+                                 "mv s2, a0\n"
+                                 // Descriptor which was never opened
+                                 "li a0, 17\n"
+                                 "ecall\n"
+                                 "mv s3, a0\n"
+                                 // Closed descriptor
+                                 "mv a0, s0\n"
+                                 "li a7, 57\n" // close
+                                 "ecall\n"
+                                 "mv a0, s0\n"
+                                 "li a7, 80\n" // fstat
+                                 "ecall\n"
+                                 "mv s4, a0\n"
+                                 "li a7, 10\n"
+                                 "ecall\n")
+                             .arg(file);
+  QVERIFY(runProgram(source));
+
+  const AInt st = dataStart();
+  QCOMPARE(reg(s1), 0);
+  QCOMPARE(readInt(st + 16, 4), int64_t{0100644}); // st_mode
+  QCOMPARE(readInt(st + 20, 4), int64_t{1});       // st_nlink
+  // Buffered data is included in st_size.
+  QCOMPARE(readInt(st + 48, 8), int64_t{10});
+  QCOMPARE(reg(s2), 0);
+  QCOMPARE(readInt(st + 128 + 16, 4), int64_t{0020620});
+  QCOMPARE(reg(s3), -ProcessState::BadFile);
+  QCOMPARE(reg(s4), -ProcessState::BadFile);
+}
+
+void tst_Syscall::testTime() {
+  const QString source = "   .data\n"
+                         "ts1: .zero 16\n"
+                         "ts2: .zero 16\n"
+                         "tv: .zero 16\n"
+                         "tz: .word 1, 1\n"
+                         "   .text\n"
+                         "li a0, 1\n" // CLOCK_MONOTONIC
+                         "la a1, ts1\n"
+                         "li a7, 113\n" // clock_gettime
+                         "ecall\n"
+                         "mv s0, a0\n"
+                         "li a0, 1\n"
+                         "la a1, ts2\n"
+                         "ecall\n"
+                         "mv s1, a0\n"
+                         "la a0, tv\n"
+                         "la a1, tz\n"
+                         "li a7, 169\n" // gettimeofday
+                         "ecall\n"
+                         "mv s2, a0\n"
+                         "li a0, 0\n"
+                         "li a1, 0\n"
+                         "ecall\n"
+                         "mv s3, a0\n"
+                         // Unknown clock
+                         "li a0, 100\n"
+                         "la a1, ts1\n"
+                         "li a7, 113\n" // clock_gettime
+                         "ecall\n"
+                         "mv s4, a0\n"
+                         // Null timespec
+                         "li a0, 1\n"
+                         "li a1, 0\n"
+                         "ecall\n"
+                         "mv s5, a0\n"
+                         "li a7, 10\n"
+                         "ecall\n";
+  const int64_t before = QDateTime::currentSecsSinceEpoch();
+  QVERIFY(runProgram(source));
+  const int64_t after = QDateTime::currentSecsSinceEpoch();
+
+  const AInt data = dataStart();
+  QCOMPARE(reg(s0), 0);
+  QCOMPARE(reg(s1), 0);
+  // Time elapses with the cycle count at 1 GHz; the calls are 5 cycles apart.
+  QCOMPARE(readInt(data, 8), int64_t{0});
+  QCOMPARE(readInt(data + 16, 8), int64_t{0});
+  QCOMPARE(readInt(data + 24, 8) - readInt(data + 8, 8), int64_t{5});
+
+  QCOMPARE(reg(s2), 0);
+  QVERIFY(readInt(data + 32, 8) >= before);
+  QVERIFY(readInt(data + 32, 8) <= after);
+  QVERIFY(readInt(data + 40, 8) < 1000000);
+  QCOMPARE(readInt(data + 48, 8), int64_t{0});
+  QCOMPARE(reg(s3), 0);
+
+  QCOMPARE(reg(s4), -ProcessState::InvalidArgument);
+  QCOMPARE(reg(s5), -ProcessState::BadAddress);
+}
+
+QTEST_APPLESS_MAIN(tst_Syscall)
+#include "tst_syscall.moc"